@@ -0,0 +1,157 @@
+#include "aligned_memory.h"
+#include "mathlib.h"
+#include "reduce.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+//==============================================================================
+// SCRATCH MEMORY PER TIME STEP
+// One "time step" squares a field twice into two temporaries and reduces
+// the result. The temporaries come from std::vector (allocated every step,
+// as in most call sites), from persistent AlignedBuffers, or from the
+// thread's ScratchArena. Counters: heap allocations per step (counted by
+// the global operator new of this binary, only on a thread inside one of
+// these benchmarks) and the 50th/99th
+// percentile and maximum latency of a step, which shows the jitter caused
+// by the allocator and by page faults on freshly mapped memory.
+//==============================================================================
+
+namespace {
+
+// Thread-local, so the other benchmarks in this binary pay one untaken
+// branch per allocation and no shared counter
+thread_local bool t_count_allocations = false;
+thread_local std::size_t t_allocations = 0;
+
+/// Counts the heap allocations of the calling thread during its lifetime
+class AllocationCounter {
+  public:
+    AllocationCounter() noexcept {
+        t_allocations = 0;
+        t_count_allocations = true;
+    }
+    ~AllocationCounter() { t_count_allocations = false; }
+
+    AllocationCounter(const AllocationCounter&) = delete;
+    AllocationCounter& operator=(const AllocationCounter&) = delete;
+
+    std::size_t count() const noexcept { return t_allocations; }
+};
+
+void* counted_malloc(std::size_t size) {
+    if (t_count_allocations) {
+        ++t_allocations;
+    }
+    if (void* p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+/// Per-step latencies, summarized into percentile counters
+class LatencyRecorder {
+  public:
+    LatencyRecorder() : samples_(SAMPLES) {}
+
+    void record(std::chrono::steady_clock::duration elapsed) {
+        samples_[count_++ % SAMPLES] = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+    void report(benchmark::State& state, std::size_t allocations) {
+        const std::size_t n = std::min(count_, SAMPLES);
+        double* begin = samples_.data();
+        std::sort(begin, begin + n);
+        state.counters["allocs_per_step"] =
+            static_cast<double>(allocations) / static_cast<double>(count_);
+        state.counters["p50_ns"] = begin[n / 2];
+        state.counters["p99_ns"] = begin[n * 99 / 100];
+        state.counters["max_ns"] = begin[n - 1];
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+  private:
+    static constexpr std::size_t SAMPLES = std::size_t{1} << 16;
+    mathlib::AlignedBuffer<double> samples_;
+    std::size_t count_ = 0;
+};
+
+double time_step(const double* field, double* t2, double* t4, std::size_t n) {
+    mathlib::square_n(field, t2, n);
+    mathlib::square_n(t2, t4, n);
+    return mathlib::sum(t4, n);
+}
+
+}  // namespace
+
+void* operator new(std::size_t size) { return counted_malloc(size); }
+
+void* operator new[](std::size_t size) { return counted_malloc(size); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete[](void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t /*size*/) noexcept { std::free(p); }
+
+void operator delete[](void* p, std::size_t /*size*/) noexcept { std::free(p); }
+
+static void BM_Scratch_Vector(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const std::vector<double> field(n, 1.001);
+    LatencyRecorder latency;
+    const AllocationCounter allocations;
+    for (auto _ : state) {
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<double> t2(n);
+        std::vector<double> t4(n);
+        benchmark::DoNotOptimize(time_step(field.data(), t2.data(), t4.data(), n));
+        latency.record(std::chrono::steady_clock::now() - start);
+    }
+    latency.report(state, allocations.count());
+}
+BENCHMARK(BM_Scratch_Vector)->Arg(4096)->Arg(1 << 20);
+
+static void BM_Scratch_AlignedBuffer(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const mathlib::AlignedBuffer<double> field(n, 1.001);
+    mathlib::AlignedBuffer<double> t2;
+    mathlib::AlignedBuffer<double> t4;
+    LatencyRecorder latency;
+    const AllocationCounter allocations;
+    for (auto _ : state) {
+        const auto start = std::chrono::steady_clock::now();
+        t2.resize(n);
+        t4.resize(n);
+        benchmark::DoNotOptimize(time_step(field.data(), t2.data(), t4.data(), n));
+        latency.record(std::chrono::steady_clock::now() - start);
+    }
+    latency.report(state, allocations.count());
+}
+BENCHMARK(BM_Scratch_AlignedBuffer)->Arg(4096)->Arg(1 << 20);
+
+static void BM_Scratch_Arena(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    const mathlib::AlignedBuffer<double> field(n, 1.001);
+    mathlib::ScratchArena& arena = mathlib::thread_scratch();
+    LatencyRecorder latency;
+    const AllocationCounter allocations;
+    const std::size_t arena_before = arena.heap_allocations();
+    for (auto _ : state) {
+        const auto start = std::chrono::steady_clock::now();
+        mathlib::ScratchArena::Scope scope(arena);
+        double* t2 = scope.allocate<double>(n);
+        double* t4 = scope.allocate<double>(n);
+        benchmark::DoNotOptimize(time_step(field.data(), t2, t4, n));
+        latency.record(std::chrono::steady_clock::now() - start);
+    }
+    latency.report(state, allocations.count() + arena.heap_allocations() - arena_before);
+}
+BENCHMARK(BM_Scratch_Arena)->Arg(4096)->Arg(1 << 20);
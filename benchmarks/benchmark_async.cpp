@@ -0,0 +1,139 @@
+#include "async.h"
+#include "mathlib.h"
+#include "parallel.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+//==============================================================================
+// ASYNC JOBS
+// range(0) small square jobs of range(1) elements each, submitted
+// back-to-back and then awaited, on the library-wide pool. The TaskPerJob
+// baseline submits one pool task per job, as the batcher would without
+// coalescing; Sync runs the same jobs on the caller.
+//==============================================================================
+
+namespace {
+
+struct Jobs {
+    explicit Jobs(std::size_t count, std::size_t len) : in(count * len, 1.5), out(count * len) {}
+
+    std::vector<double> in;
+    std::vector<double> out;
+};
+
+}  // namespace
+
+static void BM_Async_Batched(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto len = static_cast<std::size_t>(state.range(1));
+    Jobs jobs(count, len);
+    mathlib::AsyncBatcher batcher;
+
+    for (auto _ : state) {
+        for (std::size_t j = 0; j < count; ++j) {
+            batcher.square(&jobs.in[j * len], &jobs.out[j * len], len);
+        }
+        batcher.wait_all();
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+    state.counters["jobs_per_batch"] =
+        static_cast<double>(batcher.jobs()) / static_cast<double>(batcher.batches());
+}
+BENCHMARK(BM_Async_Batched)
+    ->ArgsProduct({{1000, 10000}, {16, 256}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_Async_TaskPerJob(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto len = static_cast<std::size_t>(state.range(1));
+    Jobs jobs(count, len);
+    const auto pool = mathlib::default_thread_pool();
+
+    for (auto _ : state) {
+        std::atomic<std::size_t> remaining{count};
+        std::mutex mutex;
+        std::condition_variable done;
+        for (std::size_t j = 0; j < count; ++j) {
+            pool->submit([&, j] {
+                mathlib::square_n(&jobs.in[j * len], &jobs.out[j * len], len);
+                if (remaining.fetch_sub(1) == 1) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    done.notify_all();
+                }
+            });
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&] { return remaining.load() == 0; });
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_Async_TaskPerJob)
+    ->ArgsProduct({{1000, 10000}, {16, 256}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_Async_Sync(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto len = static_cast<std::size_t>(state.range(1));
+    Jobs jobs(count, len);
+
+    for (auto _ : state) {
+        for (std::size_t j = 0; j < count; ++j) {
+            mathlib::square_n(&jobs.in[j * len], &jobs.out[j * len], len);
+        }
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_Async_Sync)->ArgsProduct({{1000, 10000}, {16, 256}})->Unit(benchmark::kMicrosecond);
+
+//==============================================================================
+// SUBMISSION LATENCY
+// Time for square() to return (the job itself runs later), and time from
+// submission until a job of range(0) elements has completed
+//==============================================================================
+
+static void BM_Async_Submit(benchmark::State& state) {
+    const std::size_t len = 16;
+    const std::size_t slots = 4096;
+    Jobs jobs(slots, len);
+    mathlib::AsyncBatcher batcher;
+    std::size_t j = 0;
+
+    for (auto _ : state) {
+        batcher.square(&jobs.in[j * len], &jobs.out[j * len], len);
+        if (++j == slots) {
+            // Slots are reused: let the submitted jobs finish first
+            state.PauseTiming();
+            batcher.wait_all();
+            state.ResumeTiming();
+            j = 0;
+        }
+    }
+    batcher.wait_all();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Async_Submit);
+
+static void BM_Async_RoundTrip(benchmark::State& state) {
+    const auto len = static_cast<std::size_t>(state.range(0));
+    Jobs jobs(1, len);
+    mathlib::AsyncBatcher batcher;
+
+    for (auto _ : state) {
+        batcher.square(jobs.in.data(), jobs.out.data(), len).wait();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Async_RoundTrip)->Arg(16)->Arg(4096)->UseRealTime();
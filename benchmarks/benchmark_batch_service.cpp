@@ -0,0 +1,131 @@
+#include "batch_service.h"
+#include "mathlib.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#ifdef USE_VCPKG_DEPENDENCIES
+#include <nlohmann/json.hpp>
+#endif
+
+//==============================================================================
+// NDJSON BATCH REQUESTS
+// Alternating square and factorial requests of range(0) values each,
+// answered by BatchService (in-place parsing, batch kernels, to_chars into
+// a reused buffer) and by the nlohmann::json DOM pattern of
+// examples/example.cpp (parse, get<vector>, push_back per result, dump).
+// items_per_second is requests per second; p50/p99 are per-request latencies.
+//==============================================================================
+
+namespace {
+
+constexpr std::size_t REQUEST_POOL = 64;
+
+std::vector<std::string> make_requests(std::size_t values) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> real(-1000.0, 1000.0);
+    std::uniform_int_distribution<int> integer(0, mathlib::FACTORIAL_MAX);
+    std::vector<std::string> requests;
+    for (std::size_t r = 0; r < REQUEST_POOL; ++r) {
+        const bool square = r % 2 == 0;
+        std::string line = "{\"id\":" + std::to_string(r) + ",\"op\":\"" +
+                           (square ? "square" : "factorial") + "\",\"values\":[";
+        for (std::size_t i = 0; i < values; ++i) {
+            line += i > 0 ? "," : "";
+            line += square ? std::to_string(real(rng)) : std::to_string(integer(rng));
+        }
+        line += "]}";
+        requests.push_back(line);
+    }
+    return requests;
+}
+
+std::size_t total_bytes(const std::vector<std::string>& requests) {
+    std::size_t bytes = 0;
+    for (const auto& r : requests) {
+        bytes += r.size() + 1;
+    }
+    return bytes;
+}
+
+class LatencyRecorder {
+  public:
+    LatencyRecorder() { samples_.reserve(SAMPLES); }
+
+    void record(std::chrono::steady_clock::duration elapsed) {
+        const auto ns = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        if (samples_.size() < SAMPLES) {
+            samples_.push_back(ns);
+        } else {
+            samples_[count_ % SAMPLES] = ns;
+        }
+        ++count_;
+    }
+
+    void report(benchmark::State& state, const std::vector<std::string>& requests) {
+        std::sort(samples_.begin(), samples_.end());
+        const std::size_t n = samples_.size();
+        state.counters["p50_ns"] = samples_[n / 2];
+        state.counters["p99_ns"] = samples_[n * 99 / 100];
+        state.SetItemsProcessed(state.iterations());
+        state.SetBytesProcessed(state.iterations() *
+                                static_cast<std::int64_t>(total_bytes(requests) / requests.size()));
+    }
+
+  private:
+    static constexpr std::size_t SAMPLES = std::size_t{1} << 16;
+    std::vector<double> samples_;
+    std::size_t count_ = 0;
+};
+
+}  // namespace
+
+static void BM_Service_Batch(benchmark::State& state) {
+    const auto requests = make_requests(static_cast<std::size_t>(state.range(0)));
+    mathlib::BatchService service;
+    LatencyRecorder latency;
+    std::size_t next = 0;
+    for (auto _ : state) {
+        const auto start = std::chrono::steady_clock::now();
+        benchmark::DoNotOptimize(service.process(requests[next]).data());
+        latency.record(std::chrono::steady_clock::now() - start);
+        next = (next + 1) % requests.size();
+    }
+    latency.report(state, requests);
+}
+BENCHMARK(BM_Service_Batch)->Arg(8)->Arg(64)->Arg(1024);
+
+#ifdef USE_VCPKG_DEPENDENCIES
+static void BM_Service_JsonDom(benchmark::State& state) {
+    using json = nlohmann::json;
+    const auto requests = make_requests(static_cast<std::size_t>(state.range(0)));
+    LatencyRecorder latency;
+    std::size_t next = 0;
+    for (auto _ : state) {
+        const auto start = std::chrono::steady_clock::now();
+        const json request = json::parse(requests[next]);
+        const bool square = request["op"] == "square";
+        const std::vector<double> values = request["values"];
+        json results = json::array();
+        for (double value : values) {
+            results.push_back(square ? mathlib::square(value)
+                                     : mathlib::factorial(static_cast<int>(value)));
+        }
+        const json response = {{"id", request["id"]}, {"results", results}};
+        std::string line = response.dump();
+        line += '\n';
+        benchmark::DoNotOptimize(line.data());
+        latency.record(std::chrono::steady_clock::now() - start);
+        next = (next + 1) % requests.size();
+    }
+    latency.report(state, requests);
+}
+BENCHMARK(BM_Service_JsonDom)->Arg(8)->Arg(64)->Arg(1024);
+#endif
@@ -0,0 +1,31 @@
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+//==============================================================================
+// CPU FREQUENCY CALIBRATION
+// A chain of dependent integer multiply-adds: no memory traffic, no
+// branches to mispredict, one operation latency per step on every core
+// type. Its time is proportional to the clock period, so
+// scripts/compare_benchmarks.py divides the times of a run by the ratio of
+// this benchmark's medians to compare runs made at different clock speeds
+// (turbo, thermal throttling, another CI machine of the same model).
+//==============================================================================
+
+namespace {
+
+constexpr int CALIBRATION_STEPS = 1 << 16;
+
+}  // namespace
+
+static void BM_Calibration_Frequency(benchmark::State& state) {
+    std::uint64_t x = 1;
+    for (auto _ : state) {
+        for (int i = 0; i < CALIBRATION_STEPS; ++i) {
+            x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+            benchmark::DoNotOptimize(x);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * CALIBRATION_STEPS);
+}
+BENCHMARK(BM_Calibration_Frequency);
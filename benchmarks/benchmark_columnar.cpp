@@ -0,0 +1,118 @@
+#include "columnar.h"
+#include "mathlib.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#ifdef USE_VCPKG_DEPENDENCIES
+#include <nlohmann/json.hpp>
+#endif
+
+//==============================================================================
+// RESULT EXPORT
+// range(0) rows of the example program's results (input, square,
+// factorial) written as a columnar file (range(1): 0 raw, 1 shuffle
+// compression) and as the per-entry JSON of examples/example.cpp.
+// bytes_per_second counts the result data (24 bytes per row); file_bytes
+// is the size on disk.
+//==============================================================================
+
+namespace {
+
+struct Results {
+    std::vector<double> input;
+    std::vector<double> square;
+    std::vector<double> factorial;
+};
+
+Results make_results(std::size_t rows) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> value(0, 100);
+    Results r;
+    for (std::size_t i = 0; i < rows; ++i) {
+        const double x = value(rng) * 0.5;
+        r.input.push_back(x);
+        r.square.push_back(mathlib::square(x));
+        r.factorial.push_back(mathlib::factorial(static_cast<int>(x)));
+    }
+    return r;
+}
+
+std::string temp_path(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+void report(benchmark::State& state, std::size_t rows, const std::string& path) {
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(rows * 24));
+    state.counters["file_bytes"] = static_cast<double>(std::filesystem::file_size(path));
+    std::filesystem::remove(path);
+}
+
+}  // namespace
+
+static void BM_Columnar_Write(benchmark::State& state) {
+    const auto rows = static_cast<std::size_t>(state.range(0));
+    const auto compression = static_cast<mathlib::Compression>(state.range(1));
+    const Results r = make_results(rows);
+    const std::string path = temp_path("mathlib_bench_results.mlcol");
+    for (auto _ : state) {
+        mathlib::ColumnarWriter writer(rows, compression);
+        writer.add("input", r.input.data());
+        writer.add("square", r.square.data());
+        writer.add("factorial", r.factorial.data());
+        writer.write(path);
+    }
+    report(state, rows, path);
+}
+BENCHMARK(BM_Columnar_Write)->ArgsProduct({{1000, 1000000}, {0, 1}});
+
+static void BM_Columnar_Read(benchmark::State& state) {
+    const auto rows = static_cast<std::size_t>(state.range(0));
+    const auto compression = static_cast<mathlib::Compression>(state.range(1));
+    const Results r = make_results(rows);
+    const std::string path = temp_path("mathlib_bench_results_read.mlcol");
+    mathlib::ColumnarWriter writer(rows, compression);
+    writer.add("input", r.input.data());
+    writer.add("square", r.square.data());
+    writer.add("factorial", r.factorial.data());
+    writer.write(path);
+    for (auto _ : state) {
+        mathlib::ColumnarReader reader(path);
+        // Touch every column once, as a consumer summing it would
+        double total = 0.0;
+        for (std::size_t c = 0; c < reader.columns(); ++c) {
+            const double* x = reader.values<double>(c);
+            for (std::size_t i = 0; i < rows; i += 512) {
+                total += x[i];
+            }
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    report(state, rows, path);
+}
+BENCHMARK(BM_Columnar_Read)->ArgsProduct({{1000, 1000000}, {0, 1}});
+
+#ifdef USE_VCPKG_DEPENDENCIES
+static void BM_Columnar_JsonDump(benchmark::State& state) {
+    using json = nlohmann::json;
+    const auto rows = static_cast<std::size_t>(state.range(0));
+    const Results r = make_results(rows);
+    const std::string path = temp_path("mathlib_bench_results.json");
+    for (auto _ : state) {
+        json results = json::array();
+        for (std::size_t i = 0; i < rows; ++i) {
+            results.push_back(
+                {{"input", r.input[i]}, {"square", r.square[i]}, {"factorial", r.factorial[i]}});
+        }
+        std::ofstream(path, std::ios::binary) << results.dump();
+    }
+    report(state, rows, path);
+}
+BENCHMARK(BM_Columnar_JsonDump)->Arg(1000)->Arg(1000000);
+#endif
@@ -0,0 +1,140 @@
+#include "combinatorics.h"
+#include "mathlib.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+//==============================================================================
+// BINOMIAL COEFFICIENTS
+// Direct computation versus the factorial(n) / (factorial(k) * factorial(n-k))
+// ratio from the mathlib.h documentation
+//==============================================================================
+
+static void BM_Binomial_FactorialRatio(benchmark::State& state) {
+    int n = state.range(0);
+    int k = n / 3;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(mathlib::factorial(n) /
+                                 (mathlib::factorial(k) * mathlib::factorial(n - k)));
+    }
+}
+BENCHMARK(BM_Binomial_FactorialRatio)->Arg(10)->Arg(60)->Arg(160);
+
+static void BM_Binomial_Exact(benchmark::State& state) {
+    int n = state.range(0);
+    int k = state.range(1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(mathlib::binomial(n, k));
+    }
+}
+// Table lookups (n <= 67) and the multiplicative path beyond
+BENCHMARK(BM_Binomial_Exact)->Args({10, 3})->Args({60, 20})->Args({1000, 5})->Args({100000, 3});
+
+static void BM_LogBinomial(benchmark::State& state) {
+    int n = state.range(0);
+    int k = state.range(1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(mathlib::log_binomial(n, k));
+    }
+}
+BENCHMARK(BM_LogBinomial)->Args({160, 53})->Args({100000, 10})->Args({100000, 50000});
+
+static void BM_LogBinomial_FactorialRatio(benchmark::State& state) {
+    int n = state.range(0);
+    int k = state.range(1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(mathlib::log_factorial(n) - mathlib::log_factorial(k) -
+                                 mathlib::log_factorial(n - k));
+    }
+}
+BENCHMARK(BM_LogBinomial_FactorialRatio)->Args({160, 53})->Args({100000, 10})->Args({100000, 50000});
+
+//==============================================================================
+// ROWS AND BATCHES
+//==============================================================================
+
+static void BM_PascalRow(benchmark::State& state) {
+    int n = state.range(0);
+    std::vector<std::uint64_t> row(n + 1);
+    for (auto _ : state) {
+        mathlib::pascal_row(n, row.data());
+        benchmark::DoNotOptimize(row.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * (n + 1));
+}
+BENCHMARK(BM_PascalRow)->Arg(16)->Arg(mathlib::BINOMIAL_TABLE_MAX);
+
+static void BM_PascalRow_PerElement(benchmark::State& state) {
+    int n = state.range(0);
+    std::vector<std::uint64_t> row(n + 1);
+    for (auto _ : state) {
+        for (int k = 0; k <= n; ++k) {
+            row[k] = mathlib::binomial(n, k);
+        }
+        benchmark::DoNotOptimize(row.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * (n + 1));
+}
+BENCHMARK(BM_PascalRow_PerElement)->Arg(16)->Arg(mathlib::BINOMIAL_TABLE_MAX);
+
+static void BM_PascalRow_Double(benchmark::State& state) {
+    int n = state.range(0);
+    std::vector<double> row(n + 1);
+    for (auto _ : state) {
+        mathlib::pascal_row(n, row.data());
+        benchmark::DoNotOptimize(row.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * (n + 1));
+}
+BENCHMARK(BM_PascalRow_Double)->Arg(mathlib::BINOMIAL_TABLE_MAX)->Arg(1000);
+
+static void BM_BinomialN_Batch(benchmark::State& state) {
+    size_t count = state.range(0);
+    std::vector<int> n(count);
+    std::vector<int> k(count);
+    std::vector<std::uint64_t> out(count);
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> n_dist(0, mathlib::BINOMIAL_TABLE_MAX);
+    for (size_t i = 0; i < count; ++i) {
+        n[i] = n_dist(gen);
+        k[i] = std::uniform_int_distribution<>(0, n[i])(gen);
+    }
+
+    for (auto _ : state) {
+        mathlib::binomial_n(n.data(), k.data(), out.data(), count);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_BinomialN_Batch)->Range(1 << 10, 1 << 16)->Unit(benchmark::kMicrosecond);
+
+static void BM_BinomialN_FactorialRatio(benchmark::State& state) {
+    size_t count = state.range(0);
+    std::vector<int> n(count);
+    std::vector<int> k(count);
+    std::vector<double> out(count);
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> n_dist(0, mathlib::BINOMIAL_TABLE_MAX);
+    for (size_t i = 0; i < count; ++i) {
+        n[i] = n_dist(gen);
+        k[i] = std::uniform_int_distribution<>(0, n[i])(gen);
+    }
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = mathlib::factorial(n[i]) /
+                     (mathlib::factorial(k[i]) * mathlib::factorial(n[i] - k[i]));
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_BinomialN_FactorialRatio)->Range(1 << 10, 1 << 16)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,92 @@
+#include "mathlib.h"
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+//==============================================================================
+// THROWING VS. NON-THROWING ERROR HANDLING
+// Inputs in [0, 170] with the given percentage of negative values.
+//==============================================================================
+
+namespace {
+
+constexpr std::size_t INPUT_SIZE = 4096;
+
+std::vector<int> mixed_inputs(int invalid_percent) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> value(0, mathlib::FACTORIAL_MAX);
+    std::uniform_int_distribution<int> percent(0, 99);
+    std::vector<int> n(INPUT_SIZE);
+    for (auto& k : n) {
+        k = percent(rng) < invalid_percent ? -1 : value(rng);
+    }
+    return n;
+}
+
+}  // namespace
+
+#ifndef MATHLIB_NO_EXCEPTIONS
+// One call per element, invalid elements caught and replaced by NaN
+static void BM_Error_Factorial_Throwing(benchmark::State& state) {
+    const auto n = mixed_inputs(static_cast<int>(state.range(0)));
+    std::vector<double> out(n.size());
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < n.size(); ++i) {
+            try {
+                out[i] = mathlib::factorial(n[i]);
+            } catch (const std::invalid_argument&) {
+                out[i] = std::numeric_limits<double>::quiet_NaN();
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n.size()));
+}
+BENCHMARK(BM_Error_Factorial_Throwing)->Arg(0)->Arg(1)->Arg(10)->Arg(50);
+#endif
+
+// One call per element, status checked instead
+static void BM_Error_Factorial_Try(benchmark::State& state) {
+    const auto n = mixed_inputs(static_cast<int>(state.range(0)));
+    std::vector<double> out(n.size());
+    constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < n.size(); ++i) {
+            out[i] = mathlib::try_factorial(n[i]).value_or(nan);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n.size()));
+}
+BENCHMARK(BM_Error_Factorial_Try)->Arg(0)->Arg(1)->Arg(10)->Arg(50);
+
+// Whole array at once, invalid elements reported in a mask
+static void BM_Error_FactorialN_Try(benchmark::State& state) {
+    const auto n = mixed_inputs(static_cast<int>(state.range(0)));
+    std::vector<double> out(n.size());
+    std::vector<std::uint8_t> invalid(n.size());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            mathlib::try_factorial_n(n.data(), out.data(), invalid.data(), n.size()));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n.size()));
+}
+BENCHMARK(BM_Error_FactorialN_Try)->Arg(0)->Arg(1)->Arg(10)->Arg(50);
+
+// Reference: the throwing batch version on valid input only
+static void BM_Error_FactorialN_Valid(benchmark::State& state) {
+    const auto n = mixed_inputs(0);
+    std::vector<double> out(n.size());
+    for (auto _ : state) {
+        mathlib::factorial_n(n.data(), out.data(), n.size());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n.size()));
+}
+BENCHMARK(BM_Error_FactorialN_Valid);
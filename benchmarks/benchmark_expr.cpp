@@ -0,0 +1,121 @@
+#include "expr.h"
+#include "mathlib.h"
+
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+//==============================================================================
+// FUSED VS MATERIALIZED EVALUATION
+// square(T) / square(P) from BM_MixedOperations, from cache-resident sizes
+// to memory-bound ones (4M elements = 32 MB per array)
+//==============================================================================
+
+namespace {
+
+struct Fields {
+    explicit Fields(size_t n) : temperatures(n), pressures(n), results(n) {
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<> temp_dist(300.0, 2000.0);  // Kelvin
+        std::uniform_real_distribution<> pres_dist(1e5, 10e5);      // Pascal
+        for (size_t i = 0; i < n; ++i) {
+            temperatures[i] = temp_dist(gen);
+            pressures[i] = pres_dist(gen);
+        }
+    }
+
+    std::vector<double> temperatures;
+    std::vector<double> pressures;
+    std::vector<double> results;
+};
+
+}  // namespace
+
+// Each operation writes a temporary array, as vector-style code does
+static void BM_Expr_Materialized(benchmark::State& state) {
+    size_t n = state.range(0);
+    Fields f(n);
+    std::vector<double> t2(n);
+    std::vector<double> p2(n);
+
+    for (auto _ : state) {
+        mathlib::square_n(f.temperatures.data(), t2.data(), n);
+        mathlib::square_n(f.pressures.data(), p2.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            f.results[i] = t2[i] / p2[i];
+        }
+        benchmark::DoNotOptimize(f.results.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * n);
+    // 2 reads + 2 temporaries written and read back + 1 write
+    state.SetBytesProcessed(state.iterations() * n * sizeof(double) * 7);
+}
+BENCHMARK(BM_Expr_Materialized)
+    ->RangeMultiplier(8)
+    ->Range(1 << 12, 1 << 22)
+    ->Unit(benchmark::kMicrosecond);
+
+// Same, but allocating the temporaries every time step
+static void BM_Expr_MaterializedAlloc(benchmark::State& state) {
+    size_t n = state.range(0);
+    Fields f(n);
+
+    for (auto _ : state) {
+        std::vector<double> t2(n);
+        std::vector<double> p2(n);
+        mathlib::square_n(f.temperatures.data(), t2.data(), n);
+        mathlib::square_n(f.pressures.data(), p2.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            f.results[i] = t2[i] / p2[i];
+        }
+        benchmark::DoNotOptimize(f.results.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_Expr_MaterializedAlloc)
+    ->RangeMultiplier(8)
+    ->Range(1 << 12, 1 << 22)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_Expr_Fused(benchmark::State& state) {
+    using mathlib::expr::view;
+    size_t n = state.range(0);
+    Fields f(n);
+
+    for (auto _ : state) {
+        mathlib::expr::evaluate(square(view(f.temperatures)) / square(view(f.pressures)),
+                                f.results.data());
+        benchmark::DoNotOptimize(f.results.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * n);
+    // 2 reads + 1 write
+    state.SetBytesProcessed(state.iterations() * n * sizeof(double) * 3);
+}
+BENCHMARK(BM_Expr_Fused)->RangeMultiplier(8)->Range(1 << 12, 1 << 22)->Unit(benchmark::kMicrosecond);
+
+static void BM_Expr_FusedParallel(benchmark::State& state) {
+    using mathlib::expr::view;
+    size_t n = state.range(0);
+    Fields f(n);
+
+    for (auto _ : state) {
+        mathlib::expr::parallel_evaluate(square(view(f.temperatures)) / square(view(f.pressures)),
+                                         f.results.data());
+        benchmark::DoNotOptimize(f.results.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_Expr_FusedParallel)
+    ->RangeMultiplier(8)
+    ->Range(1 << 12, 1 << 22)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
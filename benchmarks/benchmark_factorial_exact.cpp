@@ -0,0 +1,47 @@
+#include "factorial_exact.h"
+
+#include <benchmark/benchmark.h>
+
+//==============================================================================
+// EXACT FACTORIALS
+//==============================================================================
+
+// Cold computation, no cache involved
+static void BM_FactorialExact_Compute(benchmark::State& state) {
+    const auto n = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(mathlib::compute_factorial_exact(n));
+    }
+}
+BENCHMARK(BM_FactorialExact_Compute)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+
+// Repeated request: a lookup returning the shared result
+static void BM_FactorialExact_CacheHit(benchmark::State& state) {
+    mathlib::FactorialCache cache;
+    const auto n = static_cast<int>(state.range(0));
+    cache.get(n);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cache.get(n));
+    }
+}
+BENCHMARK(BM_FactorialExact_CacheHit)->Arg(1000)->Arg(100000);
+
+// n! from a cached (n - 100)!: the product of the missing factors and one
+// large multiplication
+static void BM_FactorialExact_CacheExtend(benchmark::State& state) {
+    mathlib::FactorialCache cache;
+    const auto n = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        cache.clear();
+        cache.get(n - 100);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(cache.get(n));
+    }
+}
+BENCHMARK(BM_FactorialExact_CacheExtend)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,68 @@
+#include "instrumentation.h"
+#include "mathlib.h"
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+//==============================================================================
+// INSTRUMENTATION OVERHEAD
+// Compare a build with -DMATHLIB_ENABLE_INSTRUMENTATION=ON against the
+// default build; the label shows which one produced the numbers.
+//==============================================================================
+
+namespace {
+
+const char* build_label() {
+    return mathlib::INSTRUMENTATION_ENABLED ? "instrumented" : "plain";
+}
+
+}  // namespace
+
+// Cost of one instrumentation point on its own (always compiled here)
+static void BM_Instrumentation_ScopedCall(benchmark::State& state) {
+    for (auto _ : state) {
+        const mathlib::detail::ScopedCall call(mathlib::InstrumentedFunction::Square);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_Instrumentation_ScopedCall);
+
+static void BM_Instrumentation_Square(benchmark::State& state) {
+    double x = 1.0001;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(x);
+        benchmark::DoNotOptimize(mathlib::square(x));
+    }
+    state.SetLabel(build_label());
+}
+BENCHMARK(BM_Instrumentation_Square);
+
+static void BM_Instrumentation_Factorial(benchmark::State& state) {
+    int n = 20;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(n);
+        benchmark::DoNotOptimize(mathlib::factorial(n));
+    }
+    state.SetLabel(build_label());
+}
+BENCHMARK(BM_Instrumentation_Factorial);
+
+static void BM_Instrumentation_SquareN(benchmark::State& state) {
+    const auto n = static_cast<std::size_t>(state.range(0));
+    std::vector<double> data(n, 1.0001);
+    for (auto _ : state) {
+        mathlib::square_n(data.data(), n);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetLabel(build_label());
+}
+BENCHMARK(BM_Instrumentation_SquareN)->Arg(16)->Arg(1024);
+
+static void BM_Instrumentation_Snapshot(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(mathlib::instrumentation_snapshot());
+    }
+}
+BENCHMARK(BM_Instrumentation_Snapshot);
@@ -0,0 +1,216 @@
+#include "logger.h"
+#include "mathlib.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include <spdlog/sinks/basic_file_sink.h>
+
+//==============================================================================
+// LOGGER LATENCY
+// Per-call cost of Logger::info() seen by the logging threads. The output
+// goes to a file so that the console does not dominate the measurement.
+//==============================================================================
+
+namespace {
+
+spdlog::sink_ptr benchmark_file_sink() {
+    const auto path = std::filesystem::temp_directory_path() / "mathlib_benchmark.log";
+    return std::make_shared<spdlog::sinks::basic_file_sink_mt>(path.string(), true);
+}
+
+void log_loop(benchmark::State& state) {
+    std::int64_t i = 0;
+    for (auto _ : state) {
+        mathlib::Logger::info("Computing square of {} -> {}", i, static_cast<double>(i) * i);
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+static void BM_Logger_Info_Sync(benchmark::State& state) {
+    log_loop(state);
+}
+BENCHMARK(BM_Logger_Info_Sync)
+    ->Setup([](const benchmark::State&) {
+        mathlib::Logger::init(spdlog::level::info, benchmark_file_sink());
+    })
+    ->Teardown([](const benchmark::State&) { mathlib::Logger::flush(); })
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+// Producers wait when the writer falls behind: measures sustained throughput
+static void BM_Logger_Info_AsyncBlock(benchmark::State& state) {
+    log_loop(state);
+}
+BENCHMARK(BM_Logger_Info_AsyncBlock)
+    ->Setup([](const benchmark::State&) {
+        mathlib::Logger::init_async(spdlog::level::info, {}, benchmark_file_sink());
+    })
+    ->Teardown([](const benchmark::State&) { mathlib::Logger::shutdown(); })
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+// Producers never wait: measures the enqueue cost alone
+static void BM_Logger_Info_AsyncDropNewest(benchmark::State& state) {
+    const std::uint64_t dropped_before = mathlib::Logger::dropped_messages();
+    log_loop(state);
+    if (state.thread_index() == 0) {
+        state.counters["dropped"] = benchmark::Counter(
+            static_cast<double>(mathlib::Logger::dropped_messages() - dropped_before));
+    }
+}
+BENCHMARK(BM_Logger_Info_AsyncDropNewest)
+    ->Setup([](const benchmark::State&) {
+        mathlib::Logger::init_async(spdlog::level::info,
+                                    {8192, mathlib::OverflowPolicy::DropNewest},
+                                    benchmark_file_sink());
+    })
+    ->Teardown([](const benchmark::State&) { mathlib::Logger::shutdown(); })
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+// Disabled level: the call must cost next to nothing in either mode
+static void BM_Logger_Debug_Filtered(benchmark::State& state) {
+    for (auto _ : state) {
+        mathlib::Logger::debug("Filtered message {}", state.iterations());
+    }
+}
+BENCHMARK(BM_Logger_Debug_Filtered)
+    ->Setup([](const benchmark::State&) {
+        mathlib::Logger::init_async(spdlog::level::info, {}, benchmark_file_sink());
+    })
+    ->Teardown([](const benchmark::State&) { mathlib::Logger::shutdown(); })
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+//==============================================================================
+// LOG-LEVEL ELISION
+// A debug log of values that are expensive to compute, with debug disabled.
+// Compiled-out calls and the macro/lazy forms should match the empty loop.
+//==============================================================================
+
+namespace {
+
+void init_info_level(const benchmark::State& /*state*/) {
+    mathlib::Logger::init(spdlog::level::info, benchmark_file_sink());
+}
+
+// Something worth not computing: ~20 ns per call
+double expensive_value(std::int64_t i) {
+    return mathlib::log_gamma(static_cast<double>(i % 1000) + 0.5);
+}
+
+}  // namespace
+
+static void BM_Logger_Elision_Baseline(benchmark::State& state) {
+    std::int64_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(++i);
+    }
+}
+BENCHMARK(BM_Logger_Elision_Baseline);
+
+// Below MATHLIB_LOG_LEVEL (trace with the default DEBUG): no code at all
+static void BM_Logger_Elision_CompiledOut(benchmark::State& state) {
+    std::int64_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(++i);
+        MATHLIB_LOG_TRACE("log_gamma({}) = {}", i, expensive_value(i));
+    }
+    state.SetLabel(mathlib::Logger::compiled_in(spdlog::level::trace) ? "compiled in"
+                                                                      : "compiled out");
+}
+BENCHMARK(BM_Logger_Elision_CompiledOut)->Setup(init_info_level);
+
+// Function form: arguments are computed, then the level check discards them
+static void BM_Logger_Elision_RuntimeEager(benchmark::State& state) {
+    std::int64_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(++i);
+        mathlib::Logger::debug("log_gamma({}) = {}", i, expensive_value(i));
+    }
+}
+BENCHMARK(BM_Logger_Elision_RuntimeEager)->Setup(init_info_level);
+
+// Macro form: the level check comes first
+static void BM_Logger_Elision_RuntimeMacro(benchmark::State& state) {
+    std::int64_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(++i);
+        MATHLIB_LOG_DEBUG("log_gamma({}) = {}", i, expensive_value(i));
+    }
+}
+BENCHMARK(BM_Logger_Elision_RuntimeMacro)->Setup(init_info_level);
+
+// Function form with a lazy argument
+static void BM_Logger_Elision_RuntimeLazy(benchmark::State& state) {
+    std::int64_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(++i);
+        mathlib::Logger::debug("log_gamma({}) = {}", i,
+                               mathlib::lazy([i] { return expensive_value(i); }));
+    }
+}
+BENCHMARK(BM_Logger_Elision_RuntimeLazy)->Setup(init_info_level);
+
+//==============================================================================
+// TEXT VS BINARY LOG
+// Same message through the text pattern (file sink) and the binary log;
+// bytes_per_call is the file growth per message
+//==============================================================================
+
+namespace {
+
+constexpr benchmark::IterationCount FORMAT_ITERATIONS = 1 << 20;
+
+std::filesystem::path benchmark_log_path(const char* name) {
+    return std::filesystem::temp_directory_path() / name;
+}
+
+void log_values(benchmark::State& state) {
+    std::int64_t i = 0;
+    for (auto _ : state) {
+        const double x = static_cast<double>(i) * 0.001;
+        mathlib::Logger::info("square({:.6f}) = {:.6e}, step {}", x, mathlib::square(x), i);
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+static void BM_Logger_Format_Text(benchmark::State& state) {
+    const auto path = benchmark_log_path("mathlib_benchmark_text.log");
+    mathlib::Logger::init(spdlog::level::info,
+                          std::make_shared<spdlog::sinks::basic_file_sink_mt>(path.string(), true));
+    mathlib::Logger::flush();
+    const auto size_before = std::filesystem::file_size(path);
+
+    log_values(state);
+
+    mathlib::Logger::flush();
+    state.counters["bytes_per_call"] =
+        static_cast<double>(std::filesystem::file_size(path) - size_before) /
+        static_cast<double>(state.iterations());
+}
+BENCHMARK(BM_Logger_Format_Text)->Iterations(FORMAT_ITERATIONS);
+
+static void BM_Logger_Format_Binary(benchmark::State& state) {
+    const auto path = benchmark_log_path("mathlib_benchmark_binary.mlog");
+    mathlib::Logger::init_binary(spdlog::level::info, path.string(), std::size_t{256} << 20);
+    const auto size_before = mathlib::Logger::binary_log_size();
+
+    log_values(state);
+
+    state.counters["bytes_per_call"] =
+        static_cast<double>(mathlib::Logger::binary_log_size() - size_before) /
+        static_cast<double>(state.iterations());
+    state.counters["dropped"] = static_cast<double>(mathlib::Logger::dropped_messages());
+    mathlib::Logger::shutdown();
+}
+BENCHMARK(BM_Logger_Format_Binary)->Iterations(FORMAT_ITERATIONS);
@@ -1,4 +1,6 @@
 #include "mathlib.h"
+#include "simd.h"
+#include "strided.h"
 
 #include <cmath>
 #include <random>
@@ -83,6 +85,217 @@ BENCHMARK(BM_Square_Vector)
     ->Range(1 << 10, 1 << 20)  // 1K to 1M elements
     ->Unit(benchmark::kMicrosecond);
 
+//==============================================================================
+// INLINE VS OUT-OF-LINE
+// The same loop as BM_Square_Vector, calling the exported out-of-line
+// symbol through an opaque pointer (what every call cost before square()
+// moved into the header, unless built with ENABLE_IPO)
+//==============================================================================
+
+namespace {
+
+// volatile: the compiler cannot see through the pointer and inline the call
+double (*volatile square_out_of_line)(double) = &mathlib::square;
+
+}  // namespace
+
+static void BM_Square_OutOfLine_Single(benchmark::State& state) {
+    double x = 3.14159265358979323846;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(square_out_of_line(x));
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_Square_OutOfLine_Single);
+
+static void BM_Square_OutOfLine_Vector(benchmark::State& state) {
+    size_t n = state.range(0);
+    std::vector<double> input(n);
+    std::vector<double> output(n);
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<> dis(-100.0, 100.0);
+    for (size_t i = 0; i < n; ++i) {
+        input[i] = dis(gen);
+    }
+
+    double (*const square)(double) = square_out_of_line;
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; ++i) {
+            output[i] = square(input[i]);
+        }
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetBytesProcessed(state.iterations() * n * sizeof(double) * 2);
+}
+BENCHMARK(BM_Square_OutOfLine_Vector)
+    ->Range(1 << 10, 1 << 20)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_Square_Generic_Float(benchmark::State& state) {
+    size_t n = state.range(0);
+    std::vector<float> input(n, 1.5F);
+    std::vector<float> output(n);
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; ++i) {
+            output[i] = mathlib::square(input[i]);
+        }
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_Square_Generic_Float)
+    ->Range(1 << 10, 1 << 20)
+    ->Unit(benchmark::kMicrosecond);
+
+//==============================================================================
+// BATCH API
+// Same workload as BM_Square_Vector, but one square_n() call per array
+//==============================================================================
+
+static void BM_SquareN_Batch(benchmark::State& state) {
+    size_t n = state.range(0);
+    std::vector<double> input(n);
+    std::vector<double> output(n);
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<> dis(-100.0, 100.0);
+    for (size_t i = 0; i < n; ++i) {
+        input[i] = dis(gen);
+    }
+
+    for (auto _ : state) {
+        mathlib::square_n(input.data(), output.data(), n);
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetBytesProcessed(state.iterations() * n * sizeof(double) * 2);
+    state.SetLabel(mathlib::simd_isa_name(mathlib::active_simd_isa()));
+}
+BENCHMARK(BM_SquareN_Batch)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond);
+
+static void BM_SquareN_InPlace(benchmark::State& state) {
+    size_t n = state.range(0);
+    std::vector<double> data(n, 1.0);
+
+    for (auto _ : state) {
+        mathlib::square_n(data.data(), n);
+        benchmark::DoNotOptimize(data.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetBytesProcessed(state.iterations() * n * sizeof(double) * 2);
+}
+BENCHMARK(BM_SquareN_InPlace)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond);
+
+static void BM_SquareN_Float(benchmark::State& state) {
+    size_t n = state.range(0);
+    std::vector<float> input(n, 1.5F);
+    std::vector<float> output(n);
+
+    for (auto _ : state) {
+        mathlib::square_n(input.data(), output.data(), n);
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetBytesProcessed(state.iterations() * n * sizeof(float) * 2);
+}
+BENCHMARK(BM_SquareN_Float)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond);
+
+// Compare every kernel available on this machine (arg 0 = SimdIsa)
+static void BM_SquareN_PerIsa(benchmark::State& state) {
+    const auto isa = static_cast<mathlib::SimdIsa>(state.range(0));
+    size_t n = state.range(1);
+    const auto saved = mathlib::active_simd_isa();
+    if (!mathlib::set_simd_isa(isa)) {
+        state.SkipWithError("instruction set not supported");
+        return;
+    }
+
+    std::vector<double> input(n, 3.0);
+    std::vector<double> output(n);
+    for (auto _ : state) {
+        mathlib::square_n(input.data(), output.data(), n);
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+    mathlib::set_simd_isa(saved);
+
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetLabel(mathlib::simd_isa_name(isa));
+}
+BENCHMARK(BM_SquareN_PerIsa)
+    ->ArgsProduct({{static_cast<int>(mathlib::SimdIsa::Scalar),
+                    static_cast<int>(mathlib::SimdIsa::Neon),
+                    static_cast<int>(mathlib::SimdIsa::Avx2),
+                    static_cast<int>(mathlib::SimdIsa::Avx512)},
+                   {1 << 10, 1 << 16}})
+    ->Unit(benchmark::kMicrosecond);
+
+//==============================================================================
+// SINGLE VS. DOUBLE PRECISION
+// The same batch calls on float and double arrays: float halves the bytes
+// per element and doubles the SIMD lanes
+//==============================================================================
+
+template <typename T>
+static void BM_Precision_SquareN(benchmark::State& state) {
+    size_t n = state.range(0);
+    std::vector<T> input(n, T(1.5));
+    std::vector<T> output(n);
+
+    for (auto _ : state) {
+        mathlib::square_n(input.data(), output.data(), n);
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetBytesProcessed(state.iterations() * n * sizeof(T) * 2);
+}
+BENCHMARK_TEMPLATE(BM_Precision_SquareN, float)
+    ->Range(1 << 10, 1 << 20)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Precision_SquareN, double)
+    ->Range(1 << 10, 1 << 20)
+    ->Unit(benchmark::kMicrosecond);
+
+template <typename T>
+static void BM_Precision_FactorialN(benchmark::State& state) {
+    size_t n = state.range(0);
+    std::vector<int> k(n);
+    std::vector<T> out(n);
+    for (size_t i = 0; i < n; ++i) {
+        k[i] = static_cast<int>(i % 35);
+    }
+
+    for (auto _ : state) {
+        mathlib::factorial_n(k.data(), out.data(), n);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetBytesProcessed(state.iterations() * n * (sizeof(int) + sizeof(T)));
+}
+BENCHMARK_TEMPLATE(BM_Precision_FactorialN, float)
+    ->Range(1 << 10, 1 << 20)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Precision_FactorialN, double)
+    ->Range(1 << 10, 1 << 20)
+    ->Unit(benchmark::kMicrosecond);
+
 //==============================================================================
 // MEMORY ACCESS PATTERNS
 // Important for cache performance in HPC applications
@@ -112,7 +325,7 @@ BENCHMARK(BM_Square_Contiguous)->Range(1 << 10, 1 << 20);
 
 static void BM_Square_Strided(benchmark::State& state) {
     size_t n = state.range(0);
-    size_t stride = 16;  // Access every 16th element
+    size_t stride = state.range(1);  // Access every stride-th element
     std::vector<double> data(n * stride);
 
     // Initialize
@@ -131,7 +344,71 @@ static void BM_Square_Strided(benchmark::State& state) {
 
     state.SetItemsProcessed(state.iterations() * n);
 }
-BENCHMARK(BM_Square_Strided)->Range(1 << 10, 1 << 20);
+// n from L2-resident to DRAM-resident, strides from 2 to 8 cache lines
+BENCHMARK(BM_Square_Strided)->ArgsProduct({{1 << 10, 1 << 14, 1 << 18}, {2, 4, 16, 64}});
+
+//==============================================================================
+// STRIDED BATCH API
+// Same access pattern, results stored contiguously: naive loop vs.
+// square_strided() (gathers + software prefetch) vs. aos_to_soa() + square_n()
+//==============================================================================
+
+static void BM_SquareStrided_Naive(benchmark::State& state) {
+    size_t n = state.range(0);
+    size_t stride = state.range(1);
+    std::vector<double> data(n * stride, 1.5);
+    std::vector<double> out(n);
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = mathlib::square(data[i * stride]);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_SquareStrided_Naive)->ArgsProduct({{1 << 10, 1 << 14, 1 << 18}, {2, 4, 16, 64}});
+
+static void BM_SquareStrided_Batch(benchmark::State& state) {
+    size_t n = state.range(0);
+    size_t stride = state.range(1);
+    std::vector<double> data(n * stride, 1.5);
+    std::vector<double> out(n);
+
+    for (auto _ : state) {
+        mathlib::square_strided(data.data(), stride, n, out.data());
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetLabel(mathlib::simd_isa_name(mathlib::active_simd_isa()));
+}
+BENCHMARK(BM_SquareStrided_Batch)->ArgsProduct({{1 << 10, 1 << 14, 1 << 18}, {2, 4, 16, 64}});
+
+// Records of 4 fields: convert once, then every field is contiguous
+static void BM_SquareStrided_AosToSoa(benchmark::State& state) {
+    const size_t n = state.range(0);
+    const size_t fields = 4;
+    std::vector<double> aos(n * fields, 1.5);
+    std::vector<std::vector<double>> columns(fields, std::vector<double>(n));
+    std::vector<double*> soa;
+    for (auto& column : columns) {
+        soa.push_back(column.data());
+    }
+
+    for (auto _ : state) {
+        mathlib::aos_to_soa(aos.data(), fields, n, soa.data());
+        mathlib::square_n(soa[0], n);
+        benchmark::DoNotOptimize(soa[0]);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_SquareStrided_AosToSoa)->Arg(1 << 10)->Arg(1 << 14)->Arg(1 << 18);
 
 //==============================================================================
 // COMPUTATIONAL COMPLEXITY ANALYSIS
@@ -147,8 +424,89 @@ static void BM_Factorial_Complexity(benchmark::State& state) {
 }
 BENCHMARK(BM_Factorial_Complexity)
     ->RangeMultiplier(2)
-    ->Range(1, 20)
-    ->Complexity(benchmark::oN);  // Expected O(n) complexity
+    ->Range(1, mathlib::FACTORIAL_MAX)
+    ->Complexity(benchmark::o1);  // Table lookup: expected O(1) complexity
+
+//==============================================================================
+// LOG-FACTORIAL AND LOG-GAMMA
+// Throughput against std::lgamma (which writes signgam)
+//==============================================================================
+
+static void BM_LogFactorial(benchmark::State& state) {
+    int n = state.range(0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(mathlib::log_factorial(n));
+    }
+}
+BENCHMARK(BM_LogFactorial)->Arg(10)->Arg(170)->Arg(1000)->Arg(1000000);
+
+static void BM_LogFactorial_StdLgamma(benchmark::State& state) {
+    double x = static_cast<double>(state.range(0)) + 1.0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::lgamma(x));
+    }
+}
+BENCHMARK(BM_LogFactorial_StdLgamma)->Arg(10)->Arg(170)->Arg(1000)->Arg(1000000);
+
+static void BM_LogGamma_Array(benchmark::State& state) {
+    size_t n = state.range(0);
+    std::vector<double> x(n);
+    std::vector<double> out(n);
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<> dis(0.1, 1000.0);
+    for (auto& v : x) {
+        v = dis(gen);
+    }
+
+    for (auto _ : state) {
+        mathlib::log_gamma_n(x.data(), out.data(), n);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_LogGamma_Array)->Range(1 << 10, 1 << 16)->Unit(benchmark::kMicrosecond);
+
+static void BM_LogGamma_Array_StdLgamma(benchmark::State& state) {
+    size_t n = state.range(0);
+    std::vector<double> x(n);
+    std::vector<double> out(n);
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<> dis(0.1, 1000.0);
+    for (auto& v : x) {
+        v = dis(gen);
+    }
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = std::lgamma(x[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_LogGamma_Array_StdLgamma)->Range(1 << 10, 1 << 16)->Unit(benchmark::kMicrosecond);
+
+// Poisson-style workload: ln(k!) for counts spread over [0, 10000]
+static void BM_LogFactorial_Array(benchmark::State& state) {
+    size_t n = state.range(0);
+    std::vector<int> k(n);
+    std::vector<double> out(n);
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> dis(0, 10000);
+    for (auto& v : k) {
+        v = dis(gen);
+    }
+
+    for (auto _ : state) {
+        mathlib::log_factorial_n(k.data(), out.data(), n);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_LogFactorial_Array)->Range(1 << 10, 1 << 16)->Unit(benchmark::kMicrosecond);
 
 //==============================================================================
 // REALISTIC WORKLOAD SIMULATION
@@ -187,6 +545,38 @@ static void BM_MixedOperations(benchmark::State& state) {
 }
 BENCHMARK(BM_MixedOperations)->Range(1 << 8, 1 << 18)->Unit(benchmark::kMicrosecond);
 
+static void BM_MixedOperations_Batch(benchmark::State& state) {
+    size_t n = state.range(0);
+    std::vector<double> temperatures(n);
+    std::vector<double> pressures(n);
+    std::vector<double> t2(n);
+    std::vector<double> p2(n);
+    std::vector<double> results(n);
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<> temp_dist(300.0, 2000.0);  // Kelvin
+    std::uniform_real_distribution<> pres_dist(1e5, 10e5);      // Pascal
+
+    for (size_t i = 0; i < n; ++i) {
+        temperatures[i] = temp_dist(gen);
+        pressures[i] = pres_dist(gen);
+    }
+
+    // Benchmark: same computation as BM_MixedOperations using the batch API
+    for (auto _ : state) {
+        mathlib::square_n(temperatures.data(), t2.data(), n);
+        mathlib::square_n(pressures.data(), p2.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            results[i] = t2[i] / p2[i];
+        }
+        benchmark::DoNotOptimize(results.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_MixedOperations_Batch)->Range(1 << 8, 1 << 18)->Unit(benchmark::kMicrosecond);
+
 //==============================================================================
 // WARMUP AND STABILITY TEST
 // Ensure consistent measurements
@@ -0,0 +1,101 @@
+#include "mathlib.h"
+#include "micro_batch.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+//==============================================================================
+// SCALAR CALLS FROM MANY THREADS
+// Every benchmark thread issues one scalar square (range(0) == 0) or
+// factorial (range(0) == 1) per iteration, either directly or through a
+// MicroBatcher shared by all threads. items_per_second is the total
+// throughput; p50/p99 are per-call latencies (every 16th call is timed),
+// averaged over the threads.
+//==============================================================================
+
+namespace {
+
+/// Per-call latencies of one benchmark thread
+class LatencyRecorder {
+  public:
+    LatencyRecorder() { samples_.reserve(SAMPLES); }
+
+    void record(std::chrono::steady_clock::duration elapsed) {
+        if (samples_.size() < SAMPLES) {
+            samples_.push_back(static_cast<double>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        }
+    }
+
+    void report(benchmark::State& state) {
+        state.SetItemsProcessed(state.iterations());
+        if (samples_.empty()) {
+            return;
+        }
+        std::sort(samples_.begin(), samples_.end());
+        const std::size_t n = samples_.size();
+        state.counters["p50_ns"] =
+            benchmark::Counter(samples_[n / 2], benchmark::Counter::kAvgThreads);
+        state.counters["p99_ns"] =
+            benchmark::Counter(samples_[n * 99 / 100], benchmark::Counter::kAvgThreads);
+    }
+
+  private:
+    static constexpr std::size_t SAMPLES = std::size_t{1} << 16;
+    std::vector<double> samples_;
+};
+
+constexpr unsigned TIMED_EVERY = 16;
+
+template <typename Call>
+void run_scalar_calls(benchmark::State& state, Call call) {
+    const bool square = state.range(0) == 0;
+    LatencyRecorder latency;
+    unsigned i = static_cast<unsigned>(state.thread_index()) * 7919;
+    for (auto _ : state) {
+        ++i;
+        if (i % TIMED_EVERY != 0) {
+            benchmark::DoNotOptimize(call(square, i));
+            continue;
+        }
+        const auto start = std::chrono::steady_clock::now();
+        benchmark::DoNotOptimize(call(square, i));
+        latency.record(std::chrono::steady_clock::now() - start);
+    }
+    latency.report(state);
+}
+
+mathlib::MicroBatcher& shared_batcher() {
+    static mathlib::MicroBatcher batcher;
+    return batcher;
+}
+
+}  // namespace
+
+static void BM_Scalar_Direct(benchmark::State& state) {
+    run_scalar_calls(state, [](bool square, unsigned i) {
+        return square ? mathlib::square(i * 0.5) : mathlib::factorial(static_cast<int>(i % 171));
+    });
+}
+BENCHMARK(BM_Scalar_Direct)->Arg(0)->Arg(1)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_Scalar_MicroBatch(benchmark::State& state) {
+    mathlib::MicroBatcher& batcher = shared_batcher();
+    // The batcher outlives the runs: count this run's share (approximate,
+    // the other threads may start or finish slightly earlier)
+    const std::size_t requests = batcher.requests();
+    const std::size_t flushes = batcher.flushes();
+    run_scalar_calls(state, [&batcher](bool square, unsigned i) {
+        return square ? batcher.square(i * 0.5) : batcher.factorial(static_cast<int>(i % 171));
+    });
+    if (state.thread_index() == 0) {
+        state.counters["requests_per_flush"] =
+            static_cast<double>(batcher.requests() - requests) /
+            static_cast<double>(std::max<std::size_t>(batcher.flushes() - flushes, 1));
+    }
+}
+BENCHMARK(BM_Scalar_MicroBatch)->Arg(0)->Arg(1)->ThreadRange(1, 8)->UseRealTime();
@@ -0,0 +1,95 @@
+#include "combinatorics.h"
+#include "modular.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+//==============================================================================
+// MODULAR FACTORIALS
+// n! mod p by Montgomery multiplication versus the `a * b % p` product it
+// replaces, construction of the factorial / inverse-factorial tables
+// (memory_bytes is their footprint), and binomial query throughput
+//==============================================================================
+
+namespace {
+
+constexpr std::uint64_t P = 1000000007;
+
+}  // namespace
+
+static void BM_FactorialU64(benchmark::State& state) {
+    int n = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(mathlib::factorial_u64(n));
+        n = n == mathlib::FACTORIAL_U64_MAX ? 0 : n + 1;
+    }
+}
+BENCHMARK(BM_FactorialU64);
+
+static void BM_FactorialMod(benchmark::State& state) {
+    const auto n = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(mathlib::factorial_mod(n, P));
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_FactorialMod)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond);
+
+#if defined(__SIZEOF_INT128__)
+static void BM_FactorialMod_Division(benchmark::State& state) {
+    const auto n = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        std::uint64_t result = 1;
+        for (int i = 2; i <= n; ++i) {
+            std::uint64_t hi;
+            std::uint64_t lo;
+            mathlib::detail::mul_wide(result, static_cast<std::uint64_t>(i), hi, lo);
+            result = static_cast<std::uint64_t>(
+                (static_cast<mathlib::detail::u128>(hi) << 64 | lo) % P);
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_FactorialMod_Division)->Range(1 << 10, 1 << 20)->Unit(benchmark::kMicrosecond);
+#endif
+
+static void BM_ModularFactorials_Build(benchmark::State& state) {
+    const auto max_n = static_cast<int>(state.range(0));
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        mathlib::ModularFactorials table(max_n, P);
+        bytes = table.memory_bytes();
+        benchmark::DoNotOptimize(table.binomial(max_n, max_n / 2));
+    }
+    state.SetItemsProcessed(state.iterations() * max_n);
+    state.counters["memory_bytes"] = static_cast<double>(bytes);
+}
+BENCHMARK(BM_ModularFactorials_Build)->Range(1 << 10, 1 << 22)->Unit(benchmark::kMicrosecond);
+
+static void BM_ModularBinomial_Query(benchmark::State& state) {
+    const auto max_n = static_cast<int>(state.range(0));
+    const mathlib::ModularFactorials table(max_n, P);
+    const std::size_t count = 4096;
+    std::vector<int> n(count);
+    std::vector<int> k(count);
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> dis(0, max_n);
+    for (std::size_t i = 0; i < count; ++i) {
+        n[i] = dis(gen);
+        k[i] = std::uniform_int_distribution<>(0, n[i])(gen);
+    }
+    std::vector<std::uint64_t> out(count);
+
+    for (auto _ : state) {
+        table.binomial_n(n.data(), k.data(), out.data(), count);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+// Small tables stay in cache; 1 << 22 entries (64 MiB) make every query miss
+BENCHMARK(BM_ModularBinomial_Query)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 22);
@@ -0,0 +1,119 @@
+#include "mathlib.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+//==============================================================================
+// STRONG SCALING
+// Fixed problem size, 1 ... N threads (N = hardware threads)
+//==============================================================================
+
+namespace {
+
+// Registers thread counts 1, 2, 4, ... up to the number of hardware threads
+void thread_counts(benchmark::internal::Benchmark* b) {
+    const int max_threads = static_cast<int>(std::max(1U, std::thread::hardware_concurrency()));
+    for (int t = 1; t < max_threads; t *= 2) {
+        b->Arg(t);
+    }
+    b->Arg(max_threads);
+}
+
+}  // namespace
+
+static void BM_ParallelSquare_Scaling(benchmark::State& state) {
+    const size_t n = 1 << 24;  // 16M elements, 256 MB of traffic per pass
+    std::vector<double> input(n, 1.5);
+    std::vector<double> output(n);
+    mathlib::set_num_threads(state.range(0));
+
+    for (auto _ : state) {
+        mathlib::parallel_square_n(input.data(), output.data(), n);
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+    mathlib::set_num_threads(0);
+
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetBytesProcessed(state.iterations() * n * sizeof(double) * 2);
+}
+BENCHMARK(BM_ParallelSquare_Scaling)
+    ->Apply(thread_counts)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_ParallelFactorial_Scaling(benchmark::State& state) {
+    const size_t n = 1 << 24;
+    std::vector<int> k(n);
+    std::vector<double> out(n);
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> dis(0, 170);
+    for (auto& v : k) {
+        v = dis(gen);
+    }
+    mathlib::set_num_threads(state.range(0));
+
+    for (auto _ : state) {
+        mathlib::parallel_factorial_n(k.data(), out.data(), n);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    mathlib::set_num_threads(0);
+
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_ParallelFactorial_Scaling)
+    ->Apply(thread_counts)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// BM_MixedOperations at production size: T^2 / P^2 over 16M elements
+static void BM_ParallelMixedOperations_Scaling(benchmark::State& state) {
+    const size_t n = 1 << 24;
+    std::vector<double> temperatures(n);
+    std::vector<double> pressures(n);
+    std::vector<double> results(n);
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<> temp_dist(300.0, 2000.0);
+    std::uniform_real_distribution<> pres_dist(1e5, 10e5);
+    for (size_t i = 0; i < n; ++i) {
+        temperatures[i] = temp_dist(gen);
+        pressures[i] = pres_dist(gen);
+    }
+    mathlib::set_num_threads(state.range(0));
+
+    for (auto _ : state) {
+        mathlib::parallel_transform(temperatures.data(), pressures.data(), results.data(), n,
+                                    [](double t, double p) {
+                                        return mathlib::square(t) / mathlib::square(p);
+                                    });
+        benchmark::DoNotOptimize(results.data());
+        benchmark::ClobberMemory();
+    }
+    mathlib::set_num_threads(0);
+
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_ParallelMixedOperations_Scaling)
+    ->Apply(thread_counts)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+//==============================================================================
+// OVERHEAD
+// Cost of a parallel_for() over a range too small to split
+//==============================================================================
+
+static void BM_ParallelFor_Overhead(benchmark::State& state) {
+    std::vector<double> data(state.range(0), 2.0);
+    for (auto _ : state) {
+        mathlib::parallel_square_n(data.data(), data.data(), data.size());
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_ParallelFor_Overhead)->Arg(64)->Arg(4096);
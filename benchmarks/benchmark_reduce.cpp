@@ -0,0 +1,133 @@
+#include "reduce.h"
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+//==============================================================================
+// REDUCTIONS
+// Sum of squares of n uniform values in [0, 1). The "rel_error" counter is
+// the relative error against a long double reference.
+//==============================================================================
+
+namespace {
+
+struct Data {
+    std::vector<double> x;
+    long double reference = 0.0L;
+};
+
+const Data& data(std::size_t n) {
+    static std::vector<std::pair<std::size_t, Data>> cache;
+    for (const auto& entry : cache) {
+        if (entry.first == n) {
+            return entry.second;
+        }
+    }
+    Data d;
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    d.x.resize(n);
+    for (auto& v : d.x) {
+        v = dist(rng);
+        d.reference += static_cast<long double>(v) * v;
+    }
+    cache.emplace_back(n, std::move(d));
+    return cache.back().second;
+}
+
+void report(benchmark::State& state, const Data& d, double result) {
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(d.x.size()));
+    state.SetBytesProcessed(state.iterations() *
+                            static_cast<std::int64_t>(d.x.size() * sizeof(double)));
+    state.counters["rel_error"] =
+        static_cast<double>(std::fabs((result - d.reference) / d.reference));
+}
+
+}  // namespace
+
+static void BM_Reduce_SumSquares_Naive(benchmark::State& state) {
+    const auto& d = data(static_cast<std::size_t>(state.range(0)));
+    double result = 0.0;
+    for (auto _ : state) {
+        double s = 0.0;
+        for (double v : d.x) {
+            s += v * v;
+        }
+        benchmark::DoNotOptimize(result = s);
+    }
+    report(state, d, result);
+}
+BENCHMARK(BM_Reduce_SumSquares_Naive)->Arg(4096)->Arg(1 << 24);
+
+static void BM_Reduce_SumSquares(benchmark::State& state) {
+    const auto& d = data(static_cast<std::size_t>(state.range(0)));
+    const mathlib::ReduceOptions options{static_cast<mathlib::Summation>(state.range(1)),
+                                         state.range(2) != 0};
+    double result = 0.0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(result =
+                                     mathlib::sum_of_squares(d.x.data(), d.x.size(), options));
+    }
+    report(state, d, result);
+    state.SetLabel(std::string(options.summation == mathlib::Summation::Kahan ? "kahan"
+                                                                              : "pairwise") +
+                   (options.parallel ? ",parallel" : ""));
+}
+BENCHMARK(BM_Reduce_SumSquares)
+    ->ArgsProduct({{4096, 1 << 24},
+                   {static_cast<int>(mathlib::Summation::Pairwise),
+                    static_cast<int>(mathlib::Summation::Kahan)},
+                   {0, 1}})
+    ->UseRealTime();
+
+static void BM_Reduce_Variance_Naive(benchmark::State& state) {
+    const auto& d = data(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        // Welford's one-element update
+        double mean = 0.0;
+        double m2 = 0.0;
+        double count = 0.0;
+        for (double v : d.x) {
+            count += 1.0;
+            const double delta = v - mean;
+            mean += delta / count;
+            m2 += delta * (v - mean);
+        }
+        benchmark::DoNotOptimize(m2);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Reduce_Variance_Naive)->Arg(4096)->Arg(1 << 24);
+
+static void BM_Reduce_Moments(benchmark::State& state) {
+    const auto& d = data(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(mathlib::moments(d.x.data(), d.x.size()));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Reduce_Moments)->Arg(4096)->Arg(1 << 24);
+
+//==============================================================================
+// MIXED PRECISION
+// Sum of squares of float arrays accumulated in double, against the same
+// values stored as double
+//==============================================================================
+
+template <typename T>
+static void BM_Reduce_Precision(benchmark::State& state) {
+    const auto& d = data(static_cast<std::size_t>(state.range(0)));
+    const std::vector<T> x(d.x.begin(), d.x.end());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(mathlib::sum_of_squares(x.data(), x.size()));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) *
+                            static_cast<std::int64_t>(sizeof(T)));
+}
+BENCHMARK_TEMPLATE(BM_Reduce_Precision, float)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Reduce_Precision, double)->Range(1 << 10, 1 << 20);
@@ -0,0 +1,149 @@
+#include "mathlib.h"
+#include "series.h"
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+//==============================================================================
+// TAYLOR SERIES
+// exp(x) for x in [-1, 1] to double precision (18 terms), per element
+//==============================================================================
+
+namespace {
+
+constexpr int EXP_TERMS = 18;
+
+std::vector<double> random_arguments(std::size_t n) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    std::vector<double> x(n);
+    for (auto& v : x) {
+        v = dist(rng);
+    }
+    return x;
+}
+
+}  // namespace
+
+// The pattern the series module replaces: pow() and factorial() per term
+static void BM_Series_Exp_NaiveFactorial(benchmark::State& state) {
+    const auto x = random_arguments(static_cast<std::size_t>(state.range(0)));
+    std::vector<double> out(x.size());
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            double sum = 0.0;
+            for (int k = 0; k < EXP_TERMS; ++k) {
+                sum += std::pow(x[i], k) / mathlib::factorial(k);
+            }
+            out[i] = sum;
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Series_Exp_NaiveFactorial)->Arg(4096);
+
+static void BM_Series_Exp_Horner(benchmark::State& state) {
+    const auto series = mathlib::TaylorSeries::exp(EXP_TERMS);
+    const auto x = random_arguments(static_cast<std::size_t>(state.range(0)));
+    std::vector<double> out(x.size());
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            out[i] = series.evaluate(x[i], mathlib::SeriesScheme::Horner);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Series_Exp_Horner)->Arg(4096);
+
+static void BM_Series_Exp_Estrin(benchmark::State& state) {
+    const auto series = mathlib::TaylorSeries::exp(EXP_TERMS);
+    const auto x = random_arguments(static_cast<std::size_t>(state.range(0)));
+    std::vector<double> out(x.size());
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            out[i] = series.evaluate(x[i], mathlib::SeriesScheme::Estrin);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Series_Exp_Estrin)->Arg(4096);
+
+// Latency of one evaluation, where Estrin's shorter dependency chain matters
+static void BM_Series_Exp_Latency(benchmark::State& state) {
+    const auto series = mathlib::TaylorSeries::exp(EXP_TERMS);
+    const auto scheme = static_cast<mathlib::SeriesScheme>(state.range(0));
+    double x = 0.5;
+    for (auto _ : state) {
+        // Each argument depends on the previous result
+        x = series.evaluate(x, scheme) * 0.25;
+    }
+    benchmark::DoNotOptimize(x);
+    state.SetLabel(scheme == mathlib::SeriesScheme::Horner ? "horner" : "estrin");
+}
+BENCHMARK(BM_Series_Exp_Latency)
+    ->Arg(static_cast<int>(mathlib::SeriesScheme::Horner))
+    ->Arg(static_cast<int>(mathlib::SeriesScheme::Estrin));
+
+static void BM_Series_Exp_Batch(benchmark::State& state) {
+    const auto series = mathlib::TaylorSeries::exp(EXP_TERMS);
+    const auto x = random_arguments(static_cast<std::size_t>(state.range(0)));
+    std::vector<double> out(x.size());
+    for (auto _ : state) {
+        series.evaluate_n(x.data(), out.data(), x.size());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Series_Exp_Batch)->Arg(4096);
+
+static void BM_Series_Exp_Libm(benchmark::State& state) {
+    const auto x = random_arguments(static_cast<std::size_t>(state.range(0)));
+    std::vector<double> out(x.size());
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            out[i] = std::exp(x[i]);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Series_Exp_Libm)->Arg(4096);
+
+// sin(x) for x in [-pi/2, pi/2] (11 odd terms) against libm
+static void BM_Series_Sin_Batch(benchmark::State& state) {
+    const auto series = mathlib::TaylorSeries::sin(11);
+    auto x = random_arguments(static_cast<std::size_t>(state.range(0)));
+    for (auto& v : x) {
+        v *= 1.5;
+    }
+    std::vector<double> out(x.size());
+    for (auto _ : state) {
+        series.evaluate_n(x.data(), out.data(), x.size());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Series_Sin_Batch)->Arg(4096);
+
+static void BM_Series_Sin_Libm(benchmark::State& state) {
+    auto x = random_arguments(static_cast<std::size_t>(state.range(0)));
+    for (auto& v : x) {
+        v *= 1.5;
+    }
+    std::vector<double> out(x.size());
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            out[i] = std::sin(x[i]);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Series_Sin_Libm)->Arg(4096);
@@ -0,0 +1,190 @@
+#include "expr.h"
+#include "mathlib.h"
+#include "stream.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+//==============================================================================
+// STREAMING LARGE ARRAY FILES
+// Memory-mapped chunks vs. read() into a buffer + write(). The file size
+// defaults to 64 MiB per input; set MATHLIB_STREAM_BENCH_MB above the free
+// RAM to measure files that do not fit in the page cache. The "Cold"
+// variants evict the inputs from the page cache before each pass (POSIX).
+//==============================================================================
+
+namespace {
+
+constexpr std::size_t BUFFER_ELEMENTS = std::size_t{1} << 20;
+
+std::size_t file_elements() {
+    const char* mb = std::getenv("MATHLIB_STREAM_BENCH_MB");
+    const std::size_t size_mb = mb != nullptr ? std::strtoull(mb, nullptr, 10) : 64;
+    return (size_mb << 20) / sizeof(double);
+}
+
+std::string temp_path(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+void write_field(const std::string& path, double base) {
+    std::vector<double> buffer(BUFFER_ELEMENTS);
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    for (std::size_t done = 0, total = file_elements(); done < total;) {
+        const std::size_t n = std::min(BUFFER_ELEMENTS, total - done);
+        for (std::size_t i = 0; i < n; ++i) {
+            buffer[i] = base + static_cast<double>((done + i) % 1000);
+        }
+        std::fwrite(buffer.data(), sizeof(double), n, file);
+        done += n;
+    }
+    std::fclose(file);
+}
+
+/// Temperature and pressure fields on disk, created on first use, removed at exit
+struct InputFiles {
+    std::string temperatures = temp_path("mathlib_bench_stream_t.f64");
+    std::string pressures = temp_path("mathlib_bench_stream_p.f64");
+
+    InputFiles() {
+        write_field(temperatures, 300.0);
+        write_field(pressures, 1.0);
+    }
+
+    ~InputFiles() {
+        std::filesystem::remove(temperatures);
+        std::filesystem::remove(pressures);
+    }
+};
+
+const InputFiles& inputs() {
+    static const InputFiles files;
+    return files;
+}
+
+/// Drops the clean pages of a file from the page cache
+void evict(const std::string& path) {
+#if !defined(_WIN32)
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+#if defined(POSIX_FADV_DONTNEED)
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+#endif
+        ::close(fd);
+    }
+#else
+    static_cast<void>(path);
+#endif
+}
+
+/// Removes the previous output: freeing its blocks is not part of the measurement
+void fresh(const std::string& output) {
+    std::filesystem::remove(output);
+}
+
+/// Baseline: fread() a buffer, square it, fwrite() the result
+void buffered_square(const std::string& input, const std::string& output) {
+    std::vector<double> in(BUFFER_ELEMENTS);
+    std::vector<double> out(BUFFER_ELEMENTS);
+    std::FILE* src = std::fopen(input.c_str(), "rb");
+    std::FILE* dst = std::fopen(output.c_str(), "wb");
+    std::size_t n = 0;
+    while ((n = std::fread(in.data(), sizeof(double), in.size(), src)) > 0) {
+        mathlib::square_n(in.data(), out.data(), n);
+        std::fwrite(out.data(), sizeof(double), n, dst);
+    }
+    std::fclose(src);
+    std::fclose(dst);
+}
+
+void set_bytes(benchmark::State& state, std::size_t inputs) {
+    // Bytes read plus bytes written
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(file_elements() * sizeof(double) * (inputs + 1)));
+}
+
+}  // namespace
+
+static void BM_Stream_Square_Mapped(benchmark::State& state) {
+    const std::string output = temp_path("mathlib_bench_stream_out.f64");
+    for (auto _ : state) {
+        state.PauseTiming();
+        fresh(output);
+        state.ResumeTiming();
+        mathlib::stream_square_n(inputs().temperatures, output);
+    }
+    set_bytes(state, 1);
+    fresh(output);
+}
+BENCHMARK(BM_Stream_Square_Mapped)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_Stream_Square_Buffered(benchmark::State& state) {
+    const std::string output = temp_path("mathlib_bench_stream_out.f64");
+    for (auto _ : state) {
+        state.PauseTiming();
+        fresh(output);
+        state.ResumeTiming();
+        buffered_square(inputs().temperatures, output);
+    }
+    set_bytes(state, 1);
+    fresh(output);
+}
+BENCHMARK(BM_Stream_Square_Buffered)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_Stream_Square_Mapped_Cold(benchmark::State& state) {
+    const std::string output = temp_path("mathlib_bench_stream_out.f64");
+    for (auto _ : state) {
+        state.PauseTiming();
+        fresh(output);
+        evict(inputs().temperatures);
+        state.ResumeTiming();
+        mathlib::stream_square_n(inputs().temperatures, output);
+    }
+    set_bytes(state, 1);
+    fresh(output);
+}
+BENCHMARK(BM_Stream_Square_Mapped_Cold)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_Stream_Square_Buffered_Cold(benchmark::State& state) {
+    const std::string output = temp_path("mathlib_bench_stream_out.f64");
+    for (auto _ : state) {
+        state.PauseTiming();
+        fresh(output);
+        evict(inputs().temperatures);
+        state.ResumeTiming();
+        buffered_square(inputs().temperatures, output);
+    }
+    set_bytes(state, 1);
+    fresh(output);
+}
+BENCHMARK(BM_Stream_Square_Buffered_Cold)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// T² / P² of two files in one fused pass (BM_MixedOperations on disk)
+static void BM_Stream_FusedRatio_Mapped(benchmark::State& state) {
+    const std::string output = temp_path("mathlib_bench_stream_out.f64");
+    for (auto _ : state) {
+        state.PauseTiming();
+        fresh(output);
+        state.ResumeTiming();
+        mathlib::stream_transform<double, double>(
+            inputs().temperatures, inputs().pressures, output,
+            [](const double* t, const double* p, double* out, std::size_t n) {
+                using namespace mathlib::expr;
+                evaluate(square(view(t, n)) / square(view(p, n)), out);
+            });
+    }
+    set_bytes(state, 2);
+    fresh(output);
+}
+BENCHMARK(BM_Stream_FusedRatio_Mapped)->Unit(benchmark::kMillisecond)->UseRealTime();
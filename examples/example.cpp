@@ -8,10 +8,13 @@
  * - nlohmann_json: JSON library
  */
 
+#include "columnar.h"
 #include "logger.h"
 #include "mathlib.h"
 
+#include <filesystem>
 #include <iostream>
+#include <string>
 #include <vector>
 
 #include <fmt/color.h>
@@ -70,19 +73,40 @@ int main() {
     fmt::print(fmt::emphasis::bold, "Example 3: Results Export\n");
 
     json results = json::array();
+    std::vector<double> squares;
+    std::vector<double> factorials;
 
     for (double value : test_values) {
-        json result_entry = {{"input", value},
-                             {"square", mathlib::square(value)},
-                             {"factorial", mathlib::factorial(static_cast<int>(value))}};
+        const double square_val = mathlib::square(value);
+        const double factorial_val = mathlib::factorial(static_cast<int>(value));
+        json result_entry = {
+            {"input", value}, {"square", square_val}, {"factorial", factorial_val}};
         results.push_back(result_entry);
+        squares.push_back(square_val);
+        factorials.push_back(factorial_val);
 
-        mathlib::Logger::debug("Processed value: {} -> square={}, factorial={}", value,
-                               mathlib::square(value), mathlib::factorial(static_cast<int>(value)));
+        // Compiled out below MATHLIB_LOG_LEVEL, skipped when debug is off at runtime
+        MATHLIB_LOG_DEBUG("Processed value: {} -> square={}, factorial={}", value, square_val,
+                          factorial_val);
     }
 
     // Pretty-print results
-    fmt::print("  Results (JSON):\n{}\n\n", results.dump(2));
+    fmt::print("  Results (JSON):\n{}\n", results.dump(2));
+
+    // Bulk exports: one typed column per result array instead of an object per row
+    const std::string columnar_path =
+        (std::filesystem::temp_directory_path() / "mathlib_example_results.mlcol").string();
+    mathlib::ColumnarWriter writer(test_values.size(), mathlib::Compression::Shuffle);
+    writer.add("input", test_values.data());
+    writer.add("square", squares.data());
+    writer.add("factorial", factorials.data());
+    writer.write(columnar_path);
+    {
+        mathlib::ColumnarReader reader(columnar_path);
+        fmt::print("  Results (columnar): {} rows x {} columns in {}\n\n", reader.rows(),
+                   reader.columns(), columnar_path);
+    }
+    std::filesystem::remove(columnar_path);
 
     // Example 4: Formatted output with colors
     fmt::print(fmt::emphasis::bold, "Example 4: Colored Output\n");
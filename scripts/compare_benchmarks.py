@@ -2,14 +2,49 @@
 """
 Compare benchmark results and detect performance regressions.
 
+Each benchmark is compared sample by sample: run mathlib_benchmarks with
+--benchmark_repetitions=N (N >= 5 recommended) and without
+--benchmark_report_aggregates_only, so that the JSON file holds every
+repetition. A benchmark is reported as a regression when
+
+  * a one-sided Mann-Whitney U test says the current times are larger
+    than the baseline times (p < --alpha), and
+  * the ratio of the medians exceeds 1 + --min-effect.
+
+A bootstrap confidence interval of the median ratio is reported with every
+result. Files with a single sample per benchmark (or only aggregates) fall
+back to the fixed --threshold ratio.
+
+Times are normalized for CPU frequency with BM_Calibration_Frequency (a
+fixed chain of dependent integer operations, see
+benchmarks/benchmark_calibration.cpp) when both files contain it, or else
+with the mhz_per_cpu value of the benchmark context.
+
+Only the Python standard library is used, so the script runs offline.
+
 Usage:
-    python3 compare_benchmarks.py baseline.json current.json [--threshold 1.20]
+    python3 compare_benchmarks.py baseline.json current.json
+        [--alpha 0.05] [--min-effect 0.05] [--threshold 1.20]
+        [--markdown report.md] [--json report.json]
 """
 
+import argparse
 import json
+import math
+import random
+import statistics
 import sys
-import argparse
-from typing import Dict, Tuple, List
+from typing import Dict, List, Tuple
+
+# Benchmark whose time is proportional to the clock period only
+CALIBRATION_BENCHMARK = 'BM_Calibration_Frequency'
+
+# Largest n1 * n2 for which the exact U distribution is computed
+EXACT_U_LIMIT = 2500
+
+# Bootstrap resamples for the confidence interval of the median ratio
+BOOTSTRAP_RESAMPLES = 2000
+
 
 def load_benchmark(filepath: str) -> Dict:
     """Load benchmark JSON file."""
@@ -23,6 +58,7 @@ def load_benchmark(filepath: str) -> Dict:
         print(f"Error: File '{filepath}' is not valid JSON")
         sys.exit(1)
 
+
 def format_time(value: float, unit: str) -> str:
     """Format time value with appropriate unit."""
     if unit == "ns":
@@ -45,30 +81,31 @@ def format_time(value: float, unit: str) -> str:
     else:
         return f"{value:10.2f} {unit}"
 
+
 def should_skip_benchmark(bench: Dict) -> bool:
     """
     Determine if a benchmark result should be skipped.
-    Returns True for aggregate results, complexity analysis, etc.
+    Returns True for complexity analysis and failed runs.
     """
     name = bench.get('name', '')
-    run_type = bench.get('run_type', '')
-    
-    # Skip aggregate results (mean, median, stddev)
-    if any(suffix in name for suffix in ['_mean', '_median', '_stddev', '_cv']):
-        return True
-    
+
     # Skip complexity analysis results (BigO, RMS)
     if 'BigO' in name or 'RMS' in name:
         return True
-    
-    # Skip if run_type indicates it's an aggregate
-    if run_type == 'aggregate':
+
+    # Skip runs that reported an error (e.g. unsupported instruction set)
+    if bench.get('error_occurred', False):
         return True
-    
+
     return False
 
+
 def get_benchmark_time(bench: Dict) -> float:
     """Extract CPU time from benchmark result, handling different formats."""
+    # Benchmarks registered with UseRealTime() (multi-threaded ones) are
+    # timed by the wall clock; their main-thread CPU time means little
+    if bench.get('name', '').endswith('/real_time') and 'real_time' in bench:
+        return bench['real_time']
     # Try different possible keys
     if 'cpu_time' in bench:
         return bench['cpu_time']
@@ -79,201 +116,414 @@ def get_benchmark_time(bench: Dict) -> float:
     else:
         raise KeyError("Could not find time metric in benchmark result")
 
+
 def get_time_unit(bench: Dict) -> str:
     """Extract time unit from benchmark result."""
     return bench.get('time_unit', 'ns')
 
-def compare_benchmarks(baseline_file: str, current_file: str, 
-                      threshold: float = 1.20,
-                      warning_threshold: float = 1.10) -> Tuple[bool, str]:
+
+def collect_samples(data: Dict) -> Dict[str, Dict]:
+    """
+    Group the results of a benchmark file by benchmark.
+
+    Returns {name: {'samples': [times], 'unit': unit}}. Every repetition
+    is one sample; a file with only aggregates contributes its median (or
+    mean) as a single sample.
+    """
+    iterations: Dict[str, Dict] = {}
+    aggregates: Dict[str, Dict] = {}
+    for bench in data.get('benchmarks', []):
+        if should_skip_benchmark(bench):
+            continue
+        try:
+            value = get_benchmark_time(bench)
+        except KeyError:
+            continue
+        name = bench.get('run_name', bench.get('name', ''))
+        unit = get_time_unit(bench)
+        if bench.get('run_type') == 'aggregate':
+            aggregate = bench.get('aggregate_name', '')
+            if aggregate in ('median', 'mean'):
+                entry = aggregates.setdefault(name, {'unit': unit})
+                entry[aggregate] = value
+        else:
+            entry = iterations.setdefault(name, {'samples': [], 'unit': unit})
+            entry['samples'].append(value)
+
+    for name, entry in aggregates.items():
+        if name not in iterations:
+            value = entry.get('median', entry.get('mean'))
+            iterations[name] = {'samples': [value], 'unit': entry['unit']}
+    return iterations
+
+
+def frequency_scale(baseline: Dict, current: Dict,
+                    baseline_samples: Dict[str, Dict],
+                    current_samples: Dict[str, Dict],
+                    mode: str) -> Tuple[float, str]:
     """
-    Compare two benchmark results.
-    
-    Args:
-        baseline_file: Path to baseline benchmark JSON file
-        current_file: Path to current benchmark JSON file
-        threshold: Regression threshold (1.20 = 20% slower triggers alert)
-        warning_threshold: Warning threshold (1.10 = 10% slower shows warning)
-    
-    Returns:
-        (has_regression, report_text)
+    Factor that converts current times to the clock speed of the baseline.
+
+    Returns (factor, description). A factor above 1 means the current
+    machine ran slower, so current times are divided by it.
+    """
+    if mode in ('auto', 'calibration'):
+        base = baseline_samples.get(CALIBRATION_BENCHMARK)
+        curr = current_samples.get(CALIBRATION_BENCHMARK)
+        if base and curr:
+            factor = statistics.median(curr['samples']) / statistics.median(base['samples'])
+            return factor, f"calibration benchmark ({CALIBRATION_BENCHMARK})"
+        if mode == 'calibration':
+            print(f"Warning: {CALIBRATION_BENCHMARK} missing, times not normalized",
+                  file=sys.stderr)
+            return 1.0, "none (calibration benchmark missing)"
+    if mode in ('auto', 'mhz'):
+        base_mhz = baseline.get('context', {}).get('mhz_per_cpu')
+        curr_mhz = current.get('context', {}).get('mhz_per_cpu')
+        if base_mhz and curr_mhz:
+            return base_mhz / curr_mhz, "context mhz_per_cpu"
+    return 1.0, "none"
+
+
+def mann_whitney_u(x: List[float], y: List[float]) -> float:
+    """U statistic: number of pairs with y > x, ties counting one half."""
+    u = 0.0
+    for b in x:
+        for c in y:
+            if c > b:
+                u += 1.0
+            elif c == b:
+                u += 0.5
+    return u
+
+
+def exact_u_distribution(n1: int, n2: int) -> List[int]:
+    """
+    Number of orderings of n1 + n2 distinct values giving each U = 0 ... n1 n2.
+
+    The largest value is either from the first sample (adding nothing to U)
+    or from the second one (larger than all n1 values of the first), so
+    f(n1, n2, u) = f(n1 - 1, n2, u) + f(n1, n2 - 1, u - n1).
+    """
+    # previous[j] is the distribution for (i - 1, j)
+    previous = [[1] for _ in range(n2 + 1)]
+    for i in range(1, n1 + 1):
+        row = [[1]]
+        for j in range(1, n2 + 1):
+            dist = [0] * (i * j + 1)
+            for u, c in enumerate(previous[j]):
+                dist[u] += c
+            for u, c in enumerate(row[j - 1]):
+                dist[u + i] += c
+            row.append(dist)
+        previous = row
+    return previous[n2]
+
+
+def mann_whitney_greater(baseline: List[float], current: List[float]) -> float:
+    """
+    One-sided p-value of the hypothesis that current times are larger.
+
+    Exact for small samples without ties, otherwise the normal
+    approximation with tie and continuity corrections.
+    """
+    n1, n2 = len(baseline), len(current)
+    u = mann_whitney_u(baseline, current)
+    has_ties = len(set(baseline + current)) < n1 + n2
+    if not has_ties and n1 * n2 <= EXACT_U_LIMIT:
+        dist = exact_u_distribution(n1, n2)
+        total = sum(dist)
+        return sum(dist[int(math.ceil(u)):]) / total
+
+    n = n1 + n2
+    ranks_tie_term = 0.0
+    values = sorted(baseline + current)
+    i = 0
+    while i < n:
+        j = i
+        while j < n and values[j] == values[i]:
+            j += 1
+        t = j - i
+        ranks_tie_term += t ** 3 - t
+        i = j
+    mean = n1 * n2 / 2.0
+    variance = n1 * n2 / 12.0 * ((n + 1) - ranks_tie_term / (n * (n - 1)))
+    if variance <= 0.0:
+        return 1.0
+    z = (u - mean - 0.5) / math.sqrt(variance)
+    return 0.5 * math.erfc(z / math.sqrt(2.0))
+
+
+def bootstrap_ratio_interval(baseline: List[float], current: List[float],
+                             confidence: float, seed: int) -> Tuple[float, float]:
+    """Percentile bootstrap interval of median(current) / median(baseline)."""
+    rng = random.Random(seed)
+    ratios = []
+    for _ in range(BOOTSTRAP_RESAMPLES):
+        b = statistics.median(rng.choices(baseline, k=len(baseline)))
+        c = statistics.median(rng.choices(current, k=len(current)))
+        ratios.append(c / b)
+    ratios.sort()
+    tail = (1.0 - confidence) / 2.0
+    low = ratios[int(tail * (BOOTSTRAP_RESAMPLES - 1))]
+    high = ratios[int(math.ceil((1.0 - tail) * (BOOTSTRAP_RESAMPLES - 1)))]
+    return low, high
+
+
+def classify(baseline: List[float], current: List[float], args) -> Dict:
+    """Compare the samples of one benchmark; returns the result record."""
+    base_median = statistics.median(baseline)
+    curr_median = statistics.median(current)
+    ratio = curr_median / base_median
+    result = {
+        'baseline': base_median,
+        'current': curr_median,
+        'ratio': ratio,
+        'change_pct': (ratio - 1.0) * 100.0,
+        'baseline_samples': len(baseline),
+        'current_samples': len(current),
+        'p_slower': None,
+        'p_faster': None,
+        'ci_low': None,
+        'ci_high': None,
+    }
+
+    if len(baseline) < 2 or len(current) < 2:
+        # Not enough samples for a test: fixed thresholds
+        result['method'] = 'threshold'
+        if ratio > args.threshold:
+            result['verdict'] = 'regression'
+        elif ratio > args.warning_threshold:
+            result['verdict'] = 'warning'
+        elif ratio < 1.0 / args.warning_threshold:
+            result['verdict'] = 'improvement'
+        else:
+            result['verdict'] = 'unchanged'
+        return result
+
+    result['method'] = 'mann-whitney'
+    p_slower = mann_whitney_greater(baseline, current)
+    p_faster = mann_whitney_greater(current, baseline)
+    low, high = bootstrap_ratio_interval(baseline, current, 1.0 - args.alpha, args.seed)
+    result.update(p_slower=p_slower, p_faster=p_faster, ci_low=low, ci_high=high)
+
+    if p_slower < args.alpha and ratio > 1.0 + args.min_effect:
+        result['verdict'] = 'regression'
+    elif p_slower < args.alpha and ratio > 1.0:
+        result['verdict'] = 'warning'  # significant, but below the minimum effect
+    elif p_faster < args.alpha and ratio < 1.0 - args.min_effect:
+        result['verdict'] = 'improvement'
+    else:
+        result['verdict'] = 'unchanged'
+    return result
+
+
+def compare(baseline_file: str, current_file: str, args) -> Dict:
+    """
+    Compare two benchmark files.
+
+    Returns a report dictionary with one record per benchmark, the
+    normalization used and summary counts.
     """
     baseline = load_benchmark(baseline_file)
     current = load_benchmark(current_file)
-    
-    # Handle the benchmarks array
-    baseline_benchmarks = baseline.get('benchmarks', [])
-    current_benchmarks = current.get('benchmarks', [])
-    
-    if not baseline_benchmarks:
+    baseline_samples = collect_samples(baseline)
+    current_samples = collect_samples(current)
+
+    if not baseline_samples:
         print("Error: No benchmarks found in baseline file")
         sys.exit(1)
-    if not current_benchmarks:
+    if not current_samples:
         print("Error: No benchmarks found in current file")
         sys.exit(1)
-    
-    # Create lookup for baseline benchmarks
-    baseline_map = {}
-    for b in baseline_benchmarks:
-        if should_skip_benchmark(b):
-            continue
-        name = b.get('name', '')
-        baseline_map[name] = b
-    
-    has_regression = False
-    has_warning = False
-    improvements = []
-    regressions = []
-    warnings = []
-    unchanged = []
+
+    factor, normalization = frequency_scale(baseline, current, baseline_samples,
+                                            current_samples, args.normalize)
+
+    results = []
     new_benchmarks = []
-    
-    # Analyze each current benchmark
-    for curr_bench in current_benchmarks:
-        if should_skip_benchmark(curr_bench):
+    for name, entry in current_samples.items():
+        if name == CALIBRATION_BENCHMARK:
             continue
-            
-        name = curr_bench.get('name', '')
-        
-        try:
-            curr_time = get_benchmark_time(curr_bench)
-            time_unit = get_time_unit(curr_bench)
-        except KeyError:
-            # Silently skip benchmarks without time metrics
+        samples = [t / factor for t in entry['samples']]
+        if name not in baseline_samples:
+            new_benchmarks.append({'name': name, 'time': statistics.median(samples),
+                                   'unit': entry['unit']})
             continue
-        
-        if name in baseline_map:
-            try:
-                base_time = get_benchmark_time(baseline_map[name])
-            except KeyError:
-                continue
-                
-            ratio = curr_time / base_time
-            change_pct = (ratio - 1.0) * 100
-            
-            result = {
-                'name': name,
-                'baseline': base_time,
-                'current': curr_time,
-                'ratio': ratio,
-                'change_pct': change_pct,
-                'unit': time_unit
-            }
-            
-            if ratio > threshold:
-                has_regression = True
-                regressions.append(result)
-            elif ratio > warning_threshold:
-                has_warning = True
-                warnings.append(result)
-            elif ratio < 0.9:  # 10% or more improvement
-                improvements.append(result)
-            else:
-                unchanged.append(result)
-        else:
-            new_benchmarks.append({
-                'name': name,
-                'time': curr_time,
-                'unit': time_unit
-            })
-    
-    # Build report
-    report_lines = []
-    report_lines.append("=" * 80)
-    report_lines.append("PERFORMANCE COMPARISON REPORT")
-    report_lines.append("=" * 80)
-    report_lines.append(f"Baseline: {baseline_file}")
-    report_lines.append(f"Current:  {current_file}")
-    report_lines.append(f"Regression threshold: {(threshold-1)*100:.0f}%")
-    report_lines.append("=" * 80)
-    report_lines.append("")
-    
-    # Report regressions first (most important)
-    if regressions:
-        report_lines.append("🔴 PERFORMANCE REGRESSIONS (>{:.0f}% slower):".format((threshold-1)*100))
-        report_lines.append("-" * 80)
-        for r in sorted(regressions, key=lambda x: x['change_pct'], reverse=True):
-            report_lines.append(f"  {r['name']}")
-            report_lines.append(f"    Baseline: {format_time(r['baseline'], r['unit'])}")
-            report_lines.append(f"    Current:  {format_time(r['current'], r['unit'])}")
-            report_lines.append(f"    Change:   {r['change_pct']:+.1f}%  ⚠️")
-            report_lines.append("")
-    
-    # Report warnings
-    if warnings:
-        report_lines.append("🟡 PERFORMANCE WARNINGS (>{:.0f}% slower):".format((warning_threshold-1)*100))
-        report_lines.append("-" * 80)
-        for w in sorted(warnings, key=lambda x: x['change_pct'], reverse=True):
-            report_lines.append(f"  {w['name']}")
-            report_lines.append(f"    Baseline: {format_time(w['baseline'], w['unit'])}")
-            report_lines.append(f"    Current:  {format_time(w['current'], w['unit'])}")
-            report_lines.append(f"    Change:   {w['change_pct']:+.1f}%")
-            report_lines.append("")
-    
-    # Report improvements
-    if improvements:
-        report_lines.append("🟢 PERFORMANCE IMPROVEMENTS (>10% faster):")
-        report_lines.append("-" * 80)
-        for i in sorted(improvements, key=lambda x: x['change_pct']):
-            report_lines.append(f"  {i['name']}")
-            report_lines.append(f"    Baseline: {format_time(i['baseline'], i['unit'])}")
-            report_lines.append(f"    Current:  {format_time(i['current'], i['unit'])}")
-            report_lines.append(f"    Change:   {i['change_pct']:+.1f}%  ✓")
-            report_lines.append("")
-    
-    # Report new benchmarks
-    if new_benchmarks:
-        report_lines.append("🆕 NEW BENCHMARKS:")
-        report_lines.append("-" * 80)
-        for n in new_benchmarks:
-            report_lines.append(f"  {n['name']}")
-            report_lines.append(f"    Time: {format_time(n['time'], n['unit'])}")
-            report_lines.append("")
-    
-    # Report unchanged (optional - comment out if too verbose)
-    if unchanged and len(unchanged) <= 10:  # Only show if not too many
-        report_lines.append("⚪ UNCHANGED (within ±10%):")
-        report_lines.append("-" * 80)
-        for u in unchanged[:10]:  # Limit to 10
-            report_lines.append(f"  {u['name']}: {u['change_pct']:+.1f}%")
-        if len(unchanged) > 10:
-            report_lines.append(f"  ... and {len(unchanged) - 10} more")
-        report_lines.append("")
-    
-    # Summary statistics
-    report_lines.append("=" * 80)
-    report_lines.append("SUMMARY:")
-    report_lines.append("-" * 80)
-    total = len(regressions) + len(warnings) + len(improvements) + len(unchanged)
-    report_lines.append(f"  Total benchmarks:    {total}")
-    report_lines.append(f"  Regressions:         {len(regressions)}")
-    report_lines.append(f"  Warnings:            {len(warnings)}")
-    report_lines.append(f"  Improvements:        {len(improvements)}")
-    report_lines.append(f"  Unchanged:           {len(unchanged)}")
-    report_lines.append(f"  New:                 {len(new_benchmarks)}")
-    report_lines.append("=" * 80)
-    
-    # Final verdict
-    if has_regression:
-        report_lines.append("")
-        report_lines.append("❌ PERFORMANCE REGRESSION DETECTED!")
-        report_lines.append(f"   {len(regressions)} benchmark(s) are >{(threshold-1)*100:.0f}% slower than baseline.")
-        report_lines.append("   Please investigate before merging.")
-    elif has_warning:
-        report_lines.append("")
-        report_lines.append("⚠️  PERFORMANCE WARNING")
-        report_lines.append(f"   {len(warnings)} benchmark(s) are slightly slower than baseline.")
-        report_lines.append("   Consider reviewing these changes.")
+        result = classify(baseline_samples[name]['samples'], samples, args)
+        result['name'] = name
+        result['unit'] = entry['unit']
+        results.append(result)
+
+    counts = {verdict: sum(1 for r in results if r['verdict'] == verdict)
+              for verdict in ('regression', 'warning', 'improvement', 'unchanged')}
+    return {
+        'baseline_file': baseline_file,
+        'current_file': current_file,
+        'normalization': normalization,
+        'frequency_factor': factor,
+        'alpha': args.alpha,
+        'min_effect': args.min_effect,
+        'results': results,
+        'new': new_benchmarks,
+        'summary': counts,
+    }
+
+
+def describe_test(r: Dict) -> str:
+    """One-line statistics of a result for the text report."""
+    if r['method'] == 'threshold':
+        return "single sample, fixed threshold"
+    p = r['p_slower'] if r['ratio'] >= 1.0 else r['p_faster']
+    return (f"p = {p:.4f}, median ratio CI [{r['ci_low']:.3f}, {r['ci_high']:.3f}], "
+            f"n = {r['baseline_samples']}/{r['current_samples']}")
+
+
+def text_report(report: Dict) -> str:
+    """Human-readable report, printed to stdout."""
+    lines = []
+    lines.append("=" * 80)
+    lines.append("PERFORMANCE COMPARISON REPORT")
+    lines.append("=" * 80)
+    lines.append(f"Baseline: {report['baseline_file']}")
+    lines.append(f"Current:  {report['current_file']}")
+    lines.append(f"Test: one-sided Mann-Whitney U, alpha = {report['alpha']}, "
+                 f"minimum effect {report['min_effect'] * 100:.0f}%")
+    lines.append(f"Frequency normalization: {report['normalization']} "
+                 f"(factor {report['frequency_factor']:.3f})")
+    lines.append("=" * 80)
+    lines.append("")
+
+    sections = [
+        ('regression', "🔴 PERFORMANCE REGRESSIONS (significantly slower):", True),
+        ('warning', "🟡 PERFORMANCE WARNINGS (slower, small effect or single sample):", True),
+        ('improvement', "🟢 PERFORMANCE IMPROVEMENTS (significantly faster):", False),
+    ]
+    for verdict, title, reverse in sections:
+        selected = [r for r in report['results'] if r['verdict'] == verdict]
+        if not selected:
+            continue
+        lines.append(title)
+        lines.append("-" * 80)
+        for r in sorted(selected, key=lambda x: x['change_pct'], reverse=reverse):
+            lines.append(f"  {r['name']}")
+            lines.append(f"    Baseline: {format_time(r['baseline'], r['unit'])}")
+            lines.append(f"    Current:  {format_time(r['current'], r['unit'])}")
+            lines.append(f"    Change:   {r['change_pct']:+.1f}%  ({describe_test(r)})")
+            lines.append("")
+
+    if report['new']:
+        lines.append("🆕 NEW BENCHMARKS:")
+        lines.append("-" * 80)
+        for n in report['new']:
+            lines.append(f"  {n['name']}")
+            lines.append(f"    Time: {format_time(n['time'], n['unit'])}")
+            lines.append("")
+
+    summary = report['summary']
+    lines.append("=" * 80)
+    lines.append("SUMMARY:")
+    lines.append("-" * 80)
+    lines.append(f"  Total benchmarks:    {len(report['results'])}")
+    lines.append(f"  Regressions:         {summary['regression']}")
+    lines.append(f"  Warnings:            {summary['warning']}")
+    lines.append(f"  Improvements:        {summary['improvement']}")
+    lines.append(f"  Unchanged:           {summary['unchanged']}")
+    lines.append(f"  New:                 {len(report['new'])}")
+    lines.append("=" * 80)
+
+    lines.append("")
+    if summary['regression']:
+        lines.append("❌ PERFORMANCE REGRESSION DETECTED!")
+        lines.append(f"   {summary['regression']} benchmark(s) are significantly slower "
+                     "than baseline.")
+        lines.append("   Please investigate before merging.")
+    elif summary['warning']:
+        lines.append("⚠️  PERFORMANCE WARNING")
+        lines.append(f"   {summary['warning']} benchmark(s) are slightly slower than baseline.")
+        lines.append("   Consider reviewing these changes.")
     else:
-        report_lines.append("")
-        report_lines.append("✅ No significant performance regressions detected.")
-        if improvements:
-            report_lines.append(f"   {len(improvements)} benchmark(s) improved!")
-    
-    report_lines.append("=" * 80)
-    
-    report_text = "\n".join(report_lines)
-    return has_regression, report_text
+        lines.append("✅ No significant performance regressions detected.")
+        if summary['improvement']:
+            lines.append(f"   {summary['improvement']} benchmark(s) improved!")
+    lines.append("=" * 80)
+    return "\n".join(lines)
+
+
+def markdown_report(report: Dict) -> str:
+    """Markdown report, e.g. for a pull request comment."""
+    icons = {'regression': '🔴', 'warning': '🟡', 'improvement': '🟢', 'unchanged': '⚪'}
+    summary = report['summary']
+    lines = []
+    lines.append("### Benchmark comparison")
+    lines.append("")
+    lines.append(f"{summary['regression']} regressions, {summary['warning']} warnings, "
+                 f"{summary['improvement']} improvements, {summary['unchanged']} unchanged, "
+                 f"{len(report['new'])} new.")
+    lines.append("")
+    lines.append(f"One-sided Mann-Whitney U test, alpha = {report['alpha']}, minimum effect "
+                 f"{report['min_effect'] * 100:.0f}%. Frequency normalization: "
+                 f"{report['normalization']} (factor {report['frequency_factor']:.3f}).")
+    lines.append("")
+    lines.append("| | Benchmark | Baseline | Current | Change | Ratio CI | p |")
+    lines.append("|---|---|---:|---:|---:|---|---:|")
+    order = {'regression': 0, 'warning': 1, 'improvement': 2, 'unchanged': 3}
+    for r in sorted(report['results'], key=lambda x: (order[x['verdict']], -x['change_pct'])):
+        if r['method'] == 'threshold':
+            ci, p = "n/a", "n/a"
+        else:
+            ci = f"[{r['ci_low']:.3f}, {r['ci_high']:.3f}]"
+            p = f"{(r['p_slower'] if r['ratio'] >= 1.0 else r['p_faster']):.4f}"
+        lines.append(f"| {icons[r['verdict']]} | `{r['name']}` "
+                     f"| {format_time(r['baseline'], r['unit']).strip()} "
+                     f"| {format_time(r['current'], r['unit']).strip()} "
+                     f"| {r['change_pct']:+.1f}% | {ci} | {p} |")
+    return "\n".join(lines) + "\n"
+
+
+def add_arguments(parser: argparse.ArgumentParser) -> None:
+    """Options shared with run_benchmarks.py."""
+    parser.add_argument('--alpha', type=float, default=0.05,
+                        help='Significance level of the one-sided test (default: 0.05)')
+    parser.add_argument('--min-effect', type=float, default=0.05,
+                        help='Smallest slowdown reported as a regression '
+                             '(default: 0.05 = 5%%)')
+    parser.add_argument('--threshold', type=float, default=1.20,
+                        help='Regression ratio for single-sample results '
+                             '(default: 1.20 = 20%% slower)')
+    parser.add_argument('--warning-threshold', type=float, default=1.10,
+                        help='Warning ratio for single-sample results '
+                             '(default: 1.10 = 10%% slower)')
+    parser.add_argument('--normalize', choices=['auto', 'calibration', 'mhz', 'none'],
+                        default='auto',
+                        help='CPU frequency normalization (default: auto = calibration '
+                             'benchmark, else mhz_per_cpu)')
+    parser.add_argument('--seed', type=int, default=1,
+                        help='Seed of the bootstrap resampling (default: 1)')
+    parser.add_argument('--markdown', metavar='FILE', help='Also write a markdown report')
+    parser.add_argument('--json', metavar='FILE', help='Also write a JSON report')
+    parser.add_argument('--fail-on-warning', action='store_true',
+                        help='Exit with error code on warnings (not just regressions)')
+
+
+def write_reports(report: Dict, args) -> None:
+    """Print the text report and write the requested report files."""
+    print(text_report(report))
+    if args.markdown:
+        with open(args.markdown, 'w') as f:
+            f.write(markdown_report(report))
+    if args.json:
+        with open(args.json, 'w') as f:
+            json.dump(report, f, indent=2)
+
+
+def exit_code(report: Dict, args) -> int:
+    """1 on regressions (or warnings with --fail-on-warning), else 0."""
+    summary = report['summary']
+    if summary['regression'] or (args.fail_on_warning and summary['warning']):
+        return 1
+    return 0
+
 
 def main():
     parser = argparse.ArgumentParser(
@@ -281,29 +531,14 @@ def main():
     )
     parser.add_argument('baseline', help='Baseline benchmark JSON file')
     parser.add_argument('current', help='Current benchmark JSON file')
-    parser.add_argument('--threshold', type=float, default=1.20,
-                       help='Regression threshold (default: 1.20 = 20%% slower)')
-    parser.add_argument('--warning-threshold', type=float, default=1.10,
-                       help='Warning threshold (default: 1.10 = 10%% slower)')
-    parser.add_argument('--fail-on-warning', action='store_true',
-                       help='Exit with error code on warnings (not just regressions)')
-    
+    add_arguments(parser)
+
     args = parser.parse_args()
-    
-    has_regression, report = compare_benchmarks(
-        args.baseline, 
-        args.current,
-        args.threshold,
-        args.warning_threshold
-    )
-    
-    print(report)
-    
-    # Exit with error code if regression detected
-    if has_regression or (args.fail_on_warning and "WARNING" in report):
-        sys.exit(1)
-    else:
-        sys.exit(0)
+
+    report = compare(args.baseline, args.current, args)
+    write_reports(report, args)
+    sys.exit(exit_code(report, args))
+
 
 if __name__ == "__main__":
-    main()
\ No newline at end of file
+    main()
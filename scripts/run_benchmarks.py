@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+"""
+Run mathlib_benchmarks, keep a history of results and gate on regressions.
+
+Each invocation runs the benchmark binary with repetitions, stores the JSON
+output in the history directory as <UTC timestamp>-<git commit>.json and
+compares it with the newest entry that passed the gate (or with --baseline)
+using compare_benchmarks.py: one-sided Mann-Whitney U test per benchmark,
+bootstrap confidence interval of the median ratio, CPU frequency
+normalization. The exit status is 1 when a regression is found, so the
+script can gate a build. Everything runs offline; the CMake target
+`benchmark_gate` calls it with the freshly built binary.
+
+Usage:
+    python3 run_benchmarks.py --binary build/bin/mathlib_benchmarks
+        [--history benchmark_history] [--repetitions 10] [--filter REGEX]
+        [--baseline FILE] [--markdown report.md] [--json report.json]
+"""
+
+import argparse
+import datetime
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+import compare_benchmarks
+
+
+def git_commit() -> str:
+    """Short hash of the checked-out commit, or 'unknown' outside git."""
+    try:
+        result = subprocess.run(['git', 'rev-parse', '--short', 'HEAD'],
+                                cwd=os.path.dirname(os.path.abspath(__file__)),
+                                capture_output=True, text=True, check=True)
+        return result.stdout.strip()
+    except (OSError, subprocess.CalledProcessError):
+        return 'unknown'
+
+
+def history_entries(history: str):
+    """Result files of the history directory, oldest first."""
+    if not os.path.isdir(history):
+        return []
+    names = sorted(n for n in os.listdir(history) if n.endswith('.json'))
+    return [os.path.join(history, n) for n in names]
+
+
+def latest_passing(entries):
+    """
+    Newest history entry not marked as a regression.
+
+    Runs that failed the gate stay in the history for inspection but are
+    not used as baselines, so rerunning a regressed build keeps failing.
+    """
+    for path in reversed(entries):
+        try:
+            with open(path, 'r') as f:
+                status = json.load(f).get('context', {}).get('mathlib_gate')
+        except (OSError, json.JSONDecodeError):
+            continue
+        if status != 'regression':
+            return path
+    return None
+
+
+def annotate(path: str, **fields) -> None:
+    """Add fields to the context section of a result file."""
+    with open(path, 'r') as f:
+        data = json.load(f)
+    data.setdefault('context', {}).update(fields)
+    with open(path, 'w') as f:
+        json.dump(data, f, indent=2)
+
+
+def run(args, output: str) -> None:
+    """Run the benchmark binary, writing every repetition to @p output."""
+    command = [
+        args.binary,
+        f'--benchmark_repetitions={args.repetitions}',
+        '--benchmark_display_aggregates_only=true',
+        '--benchmark_format=console',
+        '--benchmark_out_format=json',
+        f'--benchmark_out={output}',
+    ]
+    if args.filter:
+        # The calibration benchmark is needed for frequency normalization
+        pattern = f'({args.filter})|{compare_benchmarks.CALIBRATION_BENCHMARK}'
+        command.append(f'--benchmark_filter={pattern}')
+    if args.min_time is not None:
+        command.append(f'--benchmark_min_time={args.min_time}')
+    print('Running:', ' '.join(command), flush=True)
+    result = subprocess.run(command)
+    if result.returncode != 0:
+        print(f"Error: benchmark binary exited with status {result.returncode}")
+        sys.exit(2)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Run benchmarks, store the results and detect regressions'
+    )
+    parser.add_argument('--binary', required=True, help='Path to mathlib_benchmarks')
+    parser.add_argument('--history', default='benchmark_history',
+                        help='Directory of stored results (default: benchmark_history)')
+    parser.add_argument('--repetitions', type=int, default=10,
+                        help='Repetitions per benchmark (default: 10)')
+    parser.add_argument('--filter', help='Regular expression of benchmarks to run')
+    parser.add_argument('--min-time', type=float,
+                        help='Minimum seconds per repetition (benchmark default if omitted)')
+    parser.add_argument('--baseline',
+                        help='Result file to compare with (default: latest passing history entry)')
+    parser.add_argument('--keep', type=int, default=0,
+                        help='Keep only the newest N history entries (default: all)')
+    parser.add_argument('--no-store', action='store_true',
+                        help='Compare only; do not add this run to the history')
+    compare_benchmarks.add_arguments(parser)
+
+    args = parser.parse_args()
+    if args.repetitions < 2:
+        parser.error('--repetitions must be at least 2 for the statistical test')
+
+    entries = history_entries(args.history)
+    baseline = args.baseline or latest_passing(entries)
+
+    if args.no_store:
+        handle, output = tempfile.mkstemp(suffix='.json')
+        os.close(handle)
+    else:
+        os.makedirs(args.history, exist_ok=True)
+        stamp = datetime.datetime.now(datetime.timezone.utc).strftime('%Y%m%dT%H%M%SZ')
+        output = os.path.join(args.history, f'{stamp}-{git_commit()}.json')
+
+    run(args, output)
+
+    status = 0
+    if baseline is None:
+        print(f"No baseline yet: stored {output} as the first history entry.")
+    else:
+        report = compare_benchmarks.compare(baseline, output, args)
+        compare_benchmarks.write_reports(report, args)
+        status = compare_benchmarks.exit_code(report, args)
+
+    # Record where the run came from next to Google Benchmark's own context
+    annotate(output, mathlib_commit=git_commit(),
+             mathlib_gate='regression' if status else 'pass')
+
+    if args.no_store:
+        os.remove(output)
+    elif args.keep > 0:
+        for old in history_entries(args.history)[:-args.keep]:
+            os.remove(old)
+
+    sys.exit(status)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,159 @@
+/**
+ * @file aligned_memory.cpp
+ * @brief Implementation of aligned allocation and the scratch arena
+ */
+
+#include "aligned_memory.h"
+#include "error.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace mathlib {
+
+namespace {
+
+/// Smallest chunk a ScratchArena allocates
+constexpr std::size_t MIN_CHUNK_SIZE = std::size_t{64} << 10;
+
+constexpr bool is_power_of_two(std::size_t x) { return x != 0 && (x & (x - 1)) == 0; }
+
+constexpr std::size_t round_up(std::size_t x, std::size_t multiple) {
+    return (x + multiple - 1) / multiple * multiple;
+}
+
+}  // namespace
+
+void* allocate_aligned(std::size_t bytes, std::size_t alignment, PageSize pages) {
+    if (!is_power_of_two(alignment)) {
+        detail::raise(std::invalid_argument("Alignment must be a power of two"));
+    }
+    if (bytes == 0) {
+        return nullptr;
+    }
+    alignment = std::max(alignment, sizeof(void*));
+    if (pages == PageSize::Huge) {
+        alignment = std::max(alignment, HUGE_PAGE_SIZE);
+        bytes = round_up(bytes, HUGE_PAGE_SIZE);
+    }
+
+    void* memory = nullptr;
+#if defined(_WIN32)
+    memory = _aligned_malloc(bytes, alignment);
+#else
+    if (posix_memalign(&memory, alignment, bytes) != 0) {
+        memory = nullptr;
+    }
+#endif
+    if (memory == nullptr) {
+        detail::raise(std::bad_alloc());
+    }
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (pages == PageSize::Huge) {
+        // Only a hint: fails harmlessly when transparent huge pages are disabled
+        madvise(memory, bytes, MADV_HUGEPAGE);
+    }
+#endif
+    return memory;
+}
+
+void deallocate_aligned(void* memory) noexcept {
+#if defined(_WIN32)
+    _aligned_free(memory);
+#else
+    std::free(memory);
+#endif
+}
+
+ScratchArena::ScratchArena(std::size_t capacity, PageSize pages) : pages_(pages) {
+    if (capacity > 0) {
+        add_chunk(capacity);
+    }
+}
+
+ScratchArena::~ScratchArena() {
+    for (const Chunk& chunk : chunks_) {
+        deallocate_aligned(chunk.data);
+    }
+}
+
+void* ScratchArena::allocate_bytes(std::size_t bytes, std::size_t alignment) {
+    if (!is_power_of_two(alignment) || alignment > CACHE_LINE_SIZE) {
+        detail::raise(std::invalid_argument("Arena alignment must be a power of two up to 64"));
+    }
+    if (chunks_.size() > 1 && current_ == 0 && offset_ == 0) {
+        merge_chunks();
+    }
+
+    if (!chunks_.empty()) {
+        // Chunks start on a cache line, so aligning the offset aligns the pointer
+        const Chunk& chunk = chunks_[current_];
+        const std::size_t begin = round_up(offset_, alignment);
+        if (begin <= chunk.size && bytes <= chunk.size - begin) {
+            offset_ = begin + bytes;
+            peak_ = std::max(peak_, used());
+            return chunk.data + begin;
+        }
+        // Chunks after the current one are unused: replace them by a larger one
+        for (std::size_t k = current_ + 1; k < chunks_.size(); ++k) {
+            deallocate_aligned(chunks_[k].data);
+        }
+        chunks_.resize(current_ + 1);
+    }
+
+    add_chunk(bytes);
+    current_ = chunks_.size() - 1;
+    offset_ = bytes;
+    peak_ = std::max(peak_, used());
+    return chunks_.back().data;
+}
+
+std::size_t ScratchArena::used() const noexcept {
+    std::size_t total = offset_;
+    for (std::size_t k = 0; k < current_; ++k) {
+        total += chunks_[k].size;
+    }
+    return total;
+}
+
+std::size_t ScratchArena::capacity() const noexcept {
+    std::size_t total = 0;
+    for (const Chunk& chunk : chunks_) {
+        total += chunk.size;
+    }
+    return total;
+}
+
+void ScratchArena::add_chunk(std::size_t min_bytes) {
+    // Geometric growth keeps the number of chunks (and merges) logarithmic
+    std::size_t size = std::max({min_bytes, 2 * capacity(), MIN_CHUNK_SIZE});
+    size = round_up(size, pages_ == PageSize::Huge ? HUGE_PAGE_SIZE : CACHE_LINE_SIZE);
+    chunks_.reserve(chunks_.size() + 1);
+    char* data = static_cast<char*>(allocate_aligned(size, CACHE_LINE_SIZE, pages_));
+    chunks_.push_back({data, size});
+    ++heap_allocations_;
+}
+
+void ScratchArena::merge_chunks() {
+    const std::size_t size = capacity();
+    char* data = static_cast<char*>(allocate_aligned(size, CACHE_LINE_SIZE, pages_));
+    for (const Chunk& chunk : chunks_) {
+        deallocate_aligned(chunk.data);
+    }
+    chunks_.assign(1, {data, size});
+    ++heap_allocations_;
+}
+
+ScratchArena& thread_scratch() {
+    thread_local ScratchArena arena;
+    return arena;
+}
+
+}  // namespace mathlib
@@ -0,0 +1,242 @@
+/**
+ * @file async.cpp
+ * @brief Implementation of the asynchronous batch jobs
+ */
+
+#include "async.h"
+#include "error.h"
+#include "mathlib.h"
+
+#include <utility>
+
+namespace mathlib {
+
+namespace {
+
+bool finished(JobStatus status) {
+    return status == JobStatus::Done || status == JobStatus::Cancelled ||
+           status == JobStatus::Failed;
+}
+
+/**
+ * @brief Publishes the final status of a job and wakes its waiters
+ * @return The registered continuation, for the caller to run
+ */
+std::function<void()> complete(detail::JobState& state, JobStatus status,
+                               std::exception_ptr error = nullptr) {
+    std::function<void()> continuation;
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.error = std::move(error);
+        state.status.store(status, std::memory_order_release);
+        continuation = std::move(state.continuation);
+    }
+    state.done.notify_all();
+    return continuation;
+}
+
+}  // namespace
+
+//==============================================================================
+// AsyncJob
+//==============================================================================
+
+bool AsyncJob::ready() const noexcept {
+    return finished(status());
+}
+
+bool AsyncJob::cancel() {
+    JobStatus expected = JobStatus::Pending;
+    if (!state_->status.compare_exchange_strong(expected, JobStatus::Running,
+                                                std::memory_order_acq_rel)) {
+        return false;
+    }
+    // Claimed like a batch would claim it; the batch now skips the job
+    if (auto continuation = complete(*state_, JobStatus::Cancelled)) {
+        continuation();
+    }
+    return true;
+}
+
+void AsyncJob::wait() const {
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    state_->done.wait(lock, [this] { return ready(); });
+#if MATHLIB_HAS_EXCEPTIONS
+    if (state_->error) {
+        std::rethrow_exception(state_->error);
+    }
+#endif
+}
+
+void AsyncJob::on_complete(std::function<void()> callback) const {
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        if (!ready()) {
+            state_->continuation = std::move(callback);
+            return;
+        }
+    }
+    callback();
+}
+
+bool AsyncJob::on_complete_if_pending(std::function<void()> callback) const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    if (ready()) {
+        return false;
+    }
+    state_->continuation = std::move(callback);
+    return true;
+}
+
+//==============================================================================
+// AsyncBatcher
+//==============================================================================
+
+AsyncBatcher::AsyncBatcher(AsyncOptions options) : options_(std::move(options)) {
+    if (!options_.pool) {
+        options_.pool = default_thread_pool();
+    }
+    if (options_.max_batch == 0) {
+        options_.max_batch = 1;
+    }
+}
+
+AsyncBatcher::~AsyncBatcher() {
+    wait_all();
+}
+
+AsyncJob AsyncBatcher::square(const double* in, double* out, std::size_t n) {
+    return submit(Op::Square, in, out, n);
+}
+
+AsyncJob AsyncBatcher::factorial(const int* n, double* out, std::size_t count) {
+    return submit(Op::Factorial, n, out, count);
+}
+
+/**
+ * @details
+ * The first job queued while no drain task is pending schedules one; jobs
+ * queued until it starts ride along. A queue that reaches max_batch
+ * elements first is handed to the pool as a batch of its own, so a fast
+ * producer keeps several pool threads busy instead of one.
+ */
+AsyncJob AsyncBatcher::submit(Op op, const void* in, double* out, std::size_t n) {
+    auto state = std::make_shared<detail::JobState>();
+    jobs_.fetch_add(1, std::memory_order_relaxed);
+
+    std::vector<Job> full;
+    bool start_drain = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(Job{op, in, out, n, state});
+        queued_elements_ += n;
+        if (queued_elements_ >= options_.max_batch) {
+            full.swap(queue_);
+            queued_elements_ = 0;
+            ++in_flight_;
+        } else if (!drain_scheduled_) {
+            drain_scheduled_ = true;
+            ++in_flight_;
+            start_drain = true;
+        }
+    }
+
+    // Outside the lock: a pool without workers runs the task right here
+    if (!full.empty()) {
+        schedule(std::move(full));
+    }
+    if (start_drain) {
+        options_.pool->submit([this] {
+            std::vector<Job> batch;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                batch.swap(queue_);
+                queued_elements_ = 0;
+                drain_scheduled_ = false;
+            }
+            run(batch);
+        });
+    }
+    return AsyncJob(std::move(state));
+}
+
+void AsyncBatcher::schedule(std::vector<Job> batch) {
+    options_.pool->submit([this, batch = std::move(batch)]() mutable { run(batch); });
+}
+
+void AsyncBatcher::run(std::vector<Job>& batch) {
+    if (!batch.empty()) {
+        batches_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Continuations run after the whole batch, so a resumed coroutine does
+    // not delay the jobs queued behind it
+    std::vector<std::function<void()>> continuations;
+    for (const Job& job : batch) {
+        JobStatus expected = JobStatus::Pending;
+        if (!job.state->status.compare_exchange_strong(expected, JobStatus::Running,
+                                                       std::memory_order_acq_rel)) {
+            continue;  // Cancelled
+        }
+        std::function<void()> continuation;
+#if MATHLIB_HAS_EXCEPTIONS
+        try {
+            run_job(job);
+            continuation = complete(*job.state, JobStatus::Done);
+        } catch (...) {
+            continuation = complete(*job.state, JobStatus::Failed, std::current_exception());
+        }
+#else
+        run_job(job);
+        continuation = complete(*job.state, JobStatus::Done);
+#endif
+        if (continuation) {
+            continuations.push_back(std::move(continuation));
+        }
+    }
+    batch.clear();
+    for (auto& continuation : continuations) {
+        continuation();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--in_flight_ == 0) {
+        // Notified under the lock: the destructor may run as soon as it
+        // is released
+        idle_.notify_all();
+    }
+}
+
+void AsyncBatcher::run_job(const Job& job) {
+    ThreadPool& pool = *options_.pool;
+    const bool split = job.n >= options_.max_batch && pool.num_threads() > 1;
+    if (job.op == Op::Square) {
+        const auto* in = static_cast<const double*>(job.in);
+        if (!split) {
+            square_n(in, job.out, job.n);
+            return;
+        }
+        pool.parallel_for(0, job.n, parallel_grain(job.n, 2 * sizeof(double), pool.num_threads()),
+                          [in, out = job.out](std::size_t begin, std::size_t end) {
+                              square_n(in + begin, out + begin, end - begin);
+                          });
+    } else {
+        const auto* n = static_cast<const int*>(job.in);
+        if (!split) {
+            factorial_n(n, job.out, job.n);
+            return;
+        }
+        pool.parallel_for(0, job.n,
+                          parallel_grain(job.n, sizeof(int) + sizeof(double), pool.num_threads()),
+                          [n, out = job.out](std::size_t begin, std::size_t end) {
+                              factorial_n(n + begin, out + begin, end - begin);
+                          });
+    }
+}
+
+void AsyncBatcher::wait_all() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return in_flight_ == 0; });
+}
+
+}  // namespace mathlib
@@ -0,0 +1,278 @@
+/**
+ * @file async.h
+ * @brief Asynchronous batch jobs, coalesced onto the thread pool
+ *
+ * The batch functions block until their results are ready. A program that
+ * reads its input in chunks (from a file or a socket) can instead submit
+ * each chunk to an AsyncBatcher and go on reading: the job runs on the
+ * thread pool and the caller waits for it, or is notified, when it needs
+ * the results.
+ *
+ * Submitting a pool task per job would cost more than squaring a few
+ * hundred values. The batcher therefore queues jobs and has one pool task
+ * drain the queue: every job submitted before that task starts runs in the
+ * same task, so a burst of thousands of small submissions costs a handful
+ * of pool tasks. Jobs of at least AsyncOptions::max_batch elements are
+ * split over the pool like parallel_square_n().
+ *
+ * In C++20 translation units an AsyncJob can be awaited with `co_await`;
+ * the coroutine resumes on the pool thread that completed the job. The
+ * library itself is built as C++17.
+ *
+ * @par Example:
+ * @code
+ * mathlib::AsyncBatcher batcher;
+ * std::vector<mathlib::AsyncJob> jobs;
+ * while (reader.next(chunk)) {  // chunk.in / chunk.out stay valid until done
+ *     jobs.push_back(batcher.square(chunk.in, chunk.out, chunk.size));
+ * }
+ * for (auto& job : jobs) {
+ *     job.wait();
+ * }
+ * @endcode
+ *
+ * @author Your Name
+ * @date 2026-01-05
+ * @version 1.0.0
+ */
+
+#ifndef ASYNC_H
+#define ASYNC_H
+
+#include "parallel.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>
+/// 1 if the current translation unit can co_await an AsyncJob
+#define MATHLIB_HAS_COROUTINES 1
+#else
+#define MATHLIB_HAS_COROUTINES 0
+#endif
+
+namespace mathlib {
+
+/// State of an AsyncJob
+enum class JobStatus {
+    Pending,    ///< Queued, not started
+    Running,    ///< Being computed
+    Done,       ///< Results written
+    Cancelled,  ///< Cancelled before it started; the output was not written
+    Failed      ///< The kernel threw (e.g. a negative factorial argument)
+};
+
+namespace detail {
+
+/// Completion state shared by an AsyncJob and the batcher running it
+struct JobState {
+    std::atomic<JobStatus> status{JobStatus::Pending};
+    std::mutex mutex;
+    std::condition_variable done;
+    std::exception_ptr error;
+    std::function<void()> continuation;
+};
+
+}  // namespace detail
+
+/**
+ * @class AsyncJob
+ * @brief Handle to a job submitted to an AsyncBatcher
+ *
+ * Copies refer to the same job. The job's input and output arrays must
+ * stay valid until it has finished (or was cancelled), even if every
+ * handle is gone.
+ */
+class AsyncJob {
+  public:
+    /// An empty handle, for containers; only valid() may be called on it
+    AsyncJob() = default;
+
+    /// Whether the handle refers to a job
+    bool valid() const noexcept { return state_ != nullptr; }
+
+    /// Current state of the job
+    JobStatus status() const noexcept { return state_->status.load(std::memory_order_acquire); }
+
+    /// Whether the job has finished (done, cancelled or failed)
+    bool ready() const noexcept;
+
+    /**
+     * @brief Cancels the job if it has not started
+     * @return true if the job will not run; false if it already started
+     *         or finished
+     */
+    bool cancel();
+
+    /**
+     * @brief Blocks until the job has finished
+     *
+     * Must not be called from a task running on the batcher's pool; use
+     * on_complete() or `co_await` there.
+     *
+     * @throw The exception thrown by the kernel of a failed job
+     */
+    void wait() const;
+
+    /**
+     * @brief Calls @p callback once the job has finished
+     *
+     * The callback runs on the pool thread that completes the job, or
+     * immediately on the caller if the job has already finished. At most
+     * one callback may be registered per job; it must not throw.
+     */
+    void on_complete(std::function<void()> callback) const;
+
+    /**
+     * @brief Registers @p callback unless the job has already finished
+     *
+     * Like on_complete(), but a finished job leaves the callback to the
+     * caller instead of running it.
+     *
+     * @return true if the callback was registered, false if the job had
+     *         already finished (the callback is not called)
+     */
+    bool on_complete_if_pending(std::function<void()> callback) const;
+
+  private:
+    friend class AsyncBatcher;
+
+    explicit AsyncJob(std::shared_ptr<detail::JobState> state) : state_(std::move(state)) {}
+
+    std::shared_ptr<detail::JobState> state_;
+};
+
+/// Tuning of an AsyncBatcher
+struct AsyncOptions {
+    /**
+     * Queued elements after which the queue is handed to the pool without
+     * waiting for the running drain task; also the size from which a
+     * single job is split over the pool threads
+     */
+    std::size_t max_batch = 1 << 16;
+
+    /// Pool running the jobs; null means default_thread_pool()
+    std::shared_ptr<ThreadPool> pool;
+};
+
+/**
+ * @class AsyncBatcher
+ * @brief Queues batch jobs and runs them on a thread pool
+ *
+ * Jobs are started in submission order, in batches of queued jobs per pool
+ * task; several batches may run at once on different pool threads. The
+ * destructor waits for all submitted jobs.
+ */
+class AsyncBatcher {
+  public:
+    explicit AsyncBatcher(AsyncOptions options = {});
+
+    /// Waits for every submitted job; must not run on the batcher's pool
+    ~AsyncBatcher();
+
+    AsyncBatcher(const AsyncBatcher&) = delete;
+    AsyncBatcher& operator=(const AsyncBatcher&) = delete;
+    AsyncBatcher(AsyncBatcher&&) = delete;
+    AsyncBatcher& operator=(AsyncBatcher&&) = delete;
+
+    /**
+     * @brief Submits square_n(in, out, n)
+     * @param in  Input array of @p n values (may equal @p out)
+     * @param out Output array of @p n values
+     * @param n   Number of elements
+     */
+    AsyncJob square(const double* in, double* out, std::size_t n);
+
+    /**
+     * @brief Submits factorial_n(n, out, count)
+     *
+     * A negative argument fails the job (JobStatus::Failed; wait() throws
+     * std::invalid_argument) without affecting the other jobs of its
+     * batch.
+     */
+    AsyncJob factorial(const int* n, double* out, std::size_t count);
+
+    /**
+     * @brief Blocks until every job submitted so far has finished
+     * @note Does not throw for failed jobs; check them individually
+     */
+    void wait_all();
+
+    /// Number of jobs submitted
+    std::size_t jobs() const noexcept { return jobs_.load(std::memory_order_relaxed); }
+
+    /// Number of pool tasks that ran batches (jobs() / batches() per task)
+    std::size_t batches() const noexcept { return batches_.load(std::memory_order_relaxed); }
+
+  private:
+    enum class Op { Square, Factorial };
+
+    struct Job {
+        Op op;
+        const void* in;
+        double* out;
+        std::size_t n;
+        std::shared_ptr<detail::JobState> state;
+    };
+
+    AsyncJob submit(Op op, const void* in, double* out, std::size_t n);
+    void schedule(std::vector<Job> batch);
+    void run(std::vector<Job>& batch);
+    void run_job(const Job& job);
+
+    AsyncOptions options_;
+    std::mutex mutex_;
+    std::condition_variable idle_;
+    std::vector<Job> queue_;
+    std::size_t queued_elements_ = 0;
+    bool drain_scheduled_ = false;
+    std::size_t in_flight_ = 0;  ///< Pool tasks scheduled and not finished
+    std::atomic<std::size_t> jobs_{0};
+    std::atomic<std::size_t> batches_{0};
+};
+
+#if MATHLIB_HAS_COROUTINES
+
+/// Awaiter of `co_await job`; rethrows the error of a failed job
+struct AsyncJobAwaiter {
+    AsyncJob job;
+
+    bool await_ready() const noexcept { return job.ready(); }
+
+    /// Stays suspended only if the job was still running: a job finishing
+    /// since await_ready() must not resume the coroutine inside this call
+    bool await_suspend(std::coroutine_handle<> handle) const {
+        return job.on_complete_if_pending([handle] { handle.resume(); });
+    }
+
+    /// Status of the finished job (Done or Cancelled)
+    JobStatus await_resume() const {
+        job.wait();
+        return job.status();
+    }
+};
+
+/**
+ * @brief Suspends the coroutine until @p job has finished
+ *
+ * @code
+ * mathlib::JobStatus status = co_await batcher.square(in, out, n);
+ * @endcode
+ */
+inline AsyncJobAwaiter operator co_await(AsyncJob job) noexcept {
+    return AsyncJobAwaiter{std::move(job)};
+}
+
+#endif  // MATHLIB_HAS_COROUTINES
+
+}  // namespace mathlib
+
+#endif  // ASYNC_H
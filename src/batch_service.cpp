@@ -0,0 +1,581 @@
+/**
+ * @file batch_service.cpp
+ * @brief Implementation of the newline-delimited JSON batch service
+ */
+
+#include "batch_service.h"
+#include "error.h"
+#include "mathlib.h"
+#include "parallel.h"
+#include "reduce.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <system_error>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace mathlib {
+
+namespace {
+
+/// Initial size of the read buffer of serve()
+constexpr std::size_t MIN_INPUT_SIZE = std::size_t{64} << 10;
+
+/// Initial capacity of the values array
+constexpr std::size_t MIN_VALUES = 1024;
+
+/// Longest shortest-round-trip double, e.g. "-2.2250738585072014e-308"
+constexpr std::size_t MAX_NUMBER_CHARS = 24;
+
+/// Doubles below 2^53 in magnitude that are integers are exact integers
+constexpr double EXACT_INTEGER_LIMIT = 9007199254740992.0;
+
+/// Bytes of a response besides the id, the numbers and the error message
+constexpr std::size_t RESPONSE_OVERHEAD = 64;
+
+/// Nesting depth up to which unknown values are skipped
+constexpr int MAX_DEPTH = 64;
+
+constexpr const char* VALUES_ERROR = "values must be an array of finite numbers";
+constexpr const char* MALFORMED_ERROR = "malformed JSON";
+
+/**
+ * In-place reader of JSON tokens. Strings are returned as raw tokens
+ * (quotes and escapes included): the service only compares keys and
+ * echoes ids, so nothing needs to be decoded or copied.
+ */
+class Scanner {
+  public:
+    explicit Scanner(std::string_view text) : p_(text.data()), end_(text.data() + text.size()) {}
+
+    void skip_space() {
+        while (p_ != end_ && (*p_ == ' ' || *p_ == '\t' || *p_ == '\r' || *p_ == '\n')) {
+            ++p_;
+        }
+    }
+
+    char peek() {
+        skip_space();
+        return p_ == end_ ? '\0' : *p_;
+    }
+
+    bool consume(char c) {
+        if (peek() != c) {
+            return false;
+        }
+        ++p_;
+        return true;
+    }
+
+    bool at_end() { return peek() == '\0' && p_ == end_; }
+
+    const char* position() const { return p_; }
+
+    /// String token including its quotes
+    bool string(std::string_view& token) {
+        if (!consume('"')) {
+            return false;
+        }
+        const char* begin = p_ - 1;
+        while (p_ != end_) {
+            const char c = *p_++;
+            if (c == '"') {
+                token = std::string_view(begin, static_cast<std::size_t>(p_ - begin));
+                return true;
+            }
+            if (static_cast<unsigned char>(c) < 0x20) {
+                return false;  // control characters must be escaped
+            }
+            if (c == '\\') {
+                if (p_ == end_) {
+                    return false;
+                }
+                ++p_;
+            }
+        }
+        return false;
+    }
+
+    /// JSON number in the double range
+    bool number(double& value) {
+        skip_space();
+        // from_chars also accepts "inf", "nan" and hexadecimal digits after
+        // a sign, which JSON does not
+        const char* digits = (p_ != end_ && *p_ == '-') ? p_ + 1 : p_;
+        if (digits == end_ || *digits < '0' || *digits > '9') {
+            return false;
+        }
+        const auto [next, ec] = std::from_chars(p_, end_, value);
+        if (ec != std::errc()) {
+            return false;
+        }
+        p_ = next;
+        return true;
+    }
+
+    /// Skips any value (of an unknown key)
+    bool skip_value(int depth = 0) {
+        if (depth > MAX_DEPTH) {
+            return false;
+        }
+        std::string_view token;
+        switch (peek()) {
+            case '"':
+                return string(token);
+            case '{':
+                ++p_;
+                if (consume('}')) {
+                    return true;
+                }
+                do {
+                    if (!string(token) || !consume(':') || !skip_value(depth + 1)) {
+                        return false;
+                    }
+                } while (consume(','));
+                return consume('}');
+            case '[':
+                ++p_;
+                if (consume(']')) {
+                    return true;
+                }
+                do {
+                    if (!skip_value(depth + 1)) {
+                        return false;
+                    }
+                } while (consume(','));
+                return consume(']');
+            case 't':
+                return literal("true");
+            case 'f':
+                return literal("false");
+            case 'n':
+                return literal("null");
+            default: {
+                double ignored;
+                return number(ignored);
+            }
+        }
+    }
+
+  private:
+    bool literal(std::string_view word) {
+        if (static_cast<std::size_t>(end_ - p_) < word.size() ||
+            std::string_view(p_, word.size()) != word) {
+            return false;
+        }
+        p_ += word.size();
+        return true;
+    }
+
+    const char* p_;
+    const char* end_;
+};
+
+bool lookup_op(std::string_view token, BatchOp& op) {
+    struct Entry {
+        std::string_view name;
+        BatchOp op;
+    };
+    static constexpr Entry OPS[] = {
+        {"\"square\"", BatchOp::Square},         {"\"factorial\"", BatchOp::Factorial},
+        {"\"log_factorial\"", BatchOp::LogFactorial}, {"\"log_gamma\"", BatchOp::LogGamma},
+        {"\"sum\"", BatchOp::Sum},               {"\"norm2\"", BatchOp::Norm2},
+        {"\"moments\"", BatchOp::Moments},
+    };
+    for (const Entry& entry : OPS) {
+        if (entry.name == token) {
+            op = entry.op;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool is_blank(std::string_view line) {
+    return std::all_of(line.begin(), line.end(),
+                       [](char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; });
+}
+
+/// Appends response text to memory sized in advance by the caller
+class Writer {
+  public:
+    explicit Writer(char* out) : begin_(out), p_(out) {}
+
+    void raw(std::string_view text) {
+        std::memcpy(p_, text.data(), text.size());
+        p_ += text.size();
+    }
+
+    /**
+     * Shortest representation that reads back to @p value; integers below
+     * 2^53 in plain digits (1000000, not 1e+06); null if not finite
+     */
+    void number(double value) {
+        if (std::abs(value) < EXACT_INTEGER_LIMIT && value == std::trunc(value)) {
+            p_ = std::to_chars(p_, p_ + MAX_NUMBER_CHARS, static_cast<std::int64_t>(value)).ptr;
+        } else if (std::isfinite(value)) {
+            p_ = std::to_chars(p_, p_ + MAX_NUMBER_CHARS, value).ptr;
+        } else {
+            raw("null");
+        }
+    }
+
+    void count(std::size_t value) { p_ = std::to_chars(p_, p_ + MAX_NUMBER_CHARS, value).ptr; }
+
+    /// Opening brace and the echoed id, if any
+    void open(std::string_view id) {
+        raw("{");
+        if (!id.empty()) {
+            raw("\"id\":");
+            raw(id);
+            raw(",");
+        }
+    }
+
+    std::size_t size() const { return static_cast<std::size_t>(p_ - begin_); }
+
+  private:
+    char* begin_;
+    char* p_;
+};
+
+#if defined(_WIN32)
+/// Largest transfer of one _read() or _write() call
+constexpr std::size_t CHUNK = INT_MAX;
+#endif
+
+template <typename T>
+T* ensure(AlignedBuffer<T>& buffer, std::size_t n) {
+    if (buffer.size() < n) {
+        buffer.resize(n);
+    }
+    return buffer.data();
+}
+
+/// read() that retries on EINTR; 0 at end of input or when the peer reset the connection
+std::size_t read_some(int fd, char* data, std::size_t size) {
+    for (;;) {
+#if defined(_WIN32)
+        const int got = _read(fd, data, static_cast<unsigned>(std::min<std::size_t>(size, CHUNK)));
+#else
+        const ssize_t got = ::read(fd, data, size);
+#endif
+        if (got >= 0) {
+            return static_cast<std::size_t>(got);
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno == ECONNRESET) {
+            return 0;
+        }
+        detail::raise(std::system_error(errno, std::generic_category(), "BatchService read"));
+    }
+}
+
+/// Writes everything; false if the peer closed the connection
+bool write_all(int fd, const char* data, std::size_t size) {
+    while (size > 0) {
+#if defined(_WIN32)
+        const int put = _write(fd, data, static_cast<unsigned>(std::min<std::size_t>(size, CHUNK)));
+#else
+        const ssize_t put = ::write(fd, data, size);
+#endif
+        if (put < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EPIPE || errno == ECONNRESET) {
+                return false;
+            }
+            detail::raise(std::system_error(errno, std::generic_category(), "BatchService write"));
+        }
+        data += put;
+        size -= static_cast<std::size_t>(put);
+    }
+    return true;
+}
+
+}  // namespace
+
+/// A parsed request; the values are in values_
+struct BatchService::Request {
+    std::string_view id;  ///< Raw JSON token, empty if absent
+    BatchOp op = BatchOp::Square;
+    std::size_t count = 0;
+    bool has_op = false;
+    bool has_values = false;
+};
+
+BatchService::BatchService(const BatchServiceOptions& options) : options_(options) {}
+
+std::string_view BatchService::process(std::string_view line) {
+    if (is_blank(line)) {
+        return {};
+    }
+    const std::size_t length = respond(line, 0);
+    return {output_.data(), length};
+}
+
+std::size_t BatchService::serve(int in_fd, int out_fd) {
+    const std::size_t before = requests_;
+    ensure(input_, std::min(MIN_INPUT_SIZE, options_.max_request_bytes + 1));
+    std::size_t filled = 0;
+    bool discarding = false;  // inside a line that was too long
+
+    for (;;) {
+        if (filled == input_.size()) {
+            if (input_.size() <= options_.max_request_bytes) {
+                // A long line: grow the buffer up to the limit
+                input_.resize(std::min(2 * input_.size(), options_.max_request_bytes + 1));
+            } else {
+                if (!discarding) {
+                    const std::size_t length = respond_error({}, "request too long", 0);
+                    if (!write_all(out_fd, output_.data(), length)) {
+                        break;
+                    }
+                    discarding = true;
+                }
+                filled = 0;
+            }
+        }
+
+        const std::size_t got = read_some(in_fd, input_.data() + filled, input_.size() - filled);
+        if (got == 0) {
+            break;
+        }
+
+        // Answer every complete line; the responses of one read go out together
+        const char* data = input_.data();
+        const char* scan = data + filled;
+        filled += got;
+        std::size_t begin = 0;
+        std::size_t out = 0;
+        const char* last = data + filled;
+        while (const void* newline =
+                   std::memchr(scan, '\n', static_cast<std::size_t>(last - scan))) {
+            const auto end = static_cast<std::size_t>(static_cast<const char*>(newline) - data);
+            const std::string_view line(data + begin, end - begin);
+            if (discarding) {
+                discarding = false;
+            } else if (!is_blank(line)) {
+                out += respond(line, out);
+            }
+            begin = end + 1;
+            scan = data + begin;
+        }
+        if (out > 0 && !write_all(out_fd, output_.data(), out)) {
+            return requests_ - before;
+        }
+
+        // Keep the incomplete last line for the next read
+        std::memmove(input_.data(), data + begin, filled - begin);
+        filled -= begin;
+    }
+
+    // A last line without newline
+    const std::string_view line(input_.data(), filled);
+    if (!discarding && !is_blank(line)) {
+        write_all(out_fd, output_.data(), respond(line, 0));
+    }
+    return requests_ - before;
+}
+
+std::size_t BatchService::respond(std::string_view line, std::size_t offset) {
+    ++requests_;
+    Request request;
+    const char* message = parse(line, request);
+    if (message == nullptr) {
+        std::size_t length = 0;
+        message = execute(request, offset, length);
+        if (message == nullptr) {
+            return length;
+        }
+    }
+    return respond_error(request.id, message, offset);
+}
+
+std::size_t BatchService::respond_error(std::string_view id, const char* message,
+                                       std::size_t offset) {
+    ++errors_;
+    const std::string_view text(message);
+    Writer writer(output(offset, id.size() + text.size() + RESPONSE_OVERHEAD));
+    writer.open(id);
+    writer.raw("\"error\":\"");
+    writer.raw(text);
+    writer.raw("\"}\n");
+    return writer.size();
+}
+
+const char* BatchService::parse(std::string_view line, Request& request) {
+    Scanner scanner(line);
+    if (!scanner.consume('{')) {
+        return "request must be a JSON object";
+    }
+    if (!scanner.consume('}')) {
+        do {
+            std::string_view key;
+            if (!scanner.string(key) || !scanner.consume(':')) {
+                return MALFORMED_ERROR;
+            }
+            if (key == "\"id\"") {
+                if (scanner.peek() == '"') {
+                    if (!scanner.string(request.id)) {
+                        return MALFORMED_ERROR;
+                    }
+                } else {
+                    const char* begin = scanner.position();
+                    double ignored;
+                    if (!scanner.number(ignored)) {
+                        return "id must be a number or a string";
+                    }
+                    const auto length = static_cast<std::size_t>(scanner.position() - begin);
+                    request.id = std::string_view(begin, length);
+                }
+            } else if (key == "\"op\"") {
+                std::string_view op;
+                if (!scanner.string(op) || !lookup_op(op, request.op)) {
+                    return "unknown op";
+                }
+                request.has_op = true;
+            } else if (key == "\"values\"") {
+                if (!scanner.consume('[')) {
+                    return VALUES_ERROR;
+                }
+                std::size_t count = 0;
+                if (!scanner.consume(']')) {
+                    do {
+                        if (count == values_.size()) {
+                            values_.resize(std::max(2 * count, MIN_VALUES));
+                        }
+                        if (!scanner.number(values_[count])) {
+                            return VALUES_ERROR;
+                        }
+                        ++count;
+                    } while (scanner.consume(','));
+                    if (!scanner.consume(']')) {
+                        return VALUES_ERROR;
+                    }
+                }
+                request.count = count;
+                request.has_values = true;
+            } else if (!scanner.skip_value()) {
+                return MALFORMED_ERROR;
+            }
+        } while (scanner.consume(','));
+        if (!scanner.consume('}')) {
+            return MALFORMED_ERROR;
+        }
+    }
+    if (!scanner.at_end()) {
+        return "unexpected data after the request object";
+    }
+    if (!request.has_op) {
+        return "missing op";
+    }
+    if (!request.has_values) {
+        return "missing values";
+    }
+    return nullptr;
+}
+
+const char* BatchService::execute(const Request& request, std::size_t offset,
+                                  std::size_t& length) {
+    const double* x = values_.data();
+    const std::size_t n = request.count;
+    const ReduceOptions reduce{Summation::Pairwise, options_.parallel};
+
+    double* results = nullptr;
+    switch (request.op) {
+        case BatchOp::Square:
+            results = ensure(results_, n);
+            if (options_.parallel) {
+                parallel_square_n(x, results, n);
+            } else {
+                square_n(x, results, n);
+            }
+            break;
+        case BatchOp::Factorial:
+        case BatchOp::LogFactorial: {
+            int* k = ensure(integers_, n);
+            for (std::size_t i = 0; i < n; ++i) {
+                if (!(x[i] >= INT_MIN && x[i] <= INT_MAX) || x[i] != std::trunc(x[i])) {
+                    return "factorial values must be integers";
+                }
+                k[i] = static_cast<int>(x[i]);
+            }
+            // Negative elements become NaN, written as null
+            results = ensure(results_, n);
+            if (request.op == BatchOp::Factorial) {
+                try_factorial_n(k, results, nullptr, n);
+            } else {
+                try_log_factorial_n(k, results, nullptr, n);
+            }
+            break;
+        }
+        case BatchOp::LogGamma:
+            results = ensure(results_, n);
+            log_gamma_n(x, results, n);
+            break;
+        case BatchOp::Sum:
+        case BatchOp::Norm2: {
+            const double value = request.op == BatchOp::Sum ? sum(x, n, reduce)
+                                                            : norm2(x, n, reduce);
+            Writer writer(output(offset, request.id.size() + RESPONSE_OVERHEAD));
+            writer.open(request.id);
+            writer.raw("\"result\":");
+            writer.number(value);
+            writer.raw("}\n");
+            length = writer.size();
+            return nullptr;
+        }
+        case BatchOp::Moments: {
+            const Moments m = moments(x, n, reduce);
+            Writer writer(output(offset, request.id.size() + RESPONSE_OVERHEAD +
+                                             3 * MAX_NUMBER_CHARS));
+            writer.open(request.id);
+            writer.raw("\"result\":{\"count\":");
+            writer.count(m.count);
+            writer.raw(",\"mean\":");
+            writer.number(m.mean);
+            writer.raw(",\"variance\":");
+            writer.number(m.variance());
+            writer.raw("}}\n");
+            length = writer.size();
+            return nullptr;
+        }
+    }
+
+    Writer writer(output(offset, request.id.size() + RESPONSE_OVERHEAD +
+                                     n * (MAX_NUMBER_CHARS + 1)));
+    writer.open(request.id);
+    writer.raw("\"results\":[");
+    for (std::size_t i = 0; i < n; ++i) {
+        if (i > 0) {
+            writer.raw(",");
+        }
+        writer.number(results[i]);
+    }
+    writer.raw("]}\n");
+    length = writer.size();
+    return nullptr;
+}
+
+char* BatchService::output(std::size_t offset, std::size_t bytes) {
+    if (output_.size() < offset + bytes) {
+        output_.resize(std::max(offset + bytes, 2 * output_.size()));
+    }
+    return output_.data() + offset;
+}
+
+}  // namespace mathlib
@@ -0,0 +1,144 @@
+/**
+ * @file batch_service.h
+ * @brief Newline-delimited JSON batch requests, parsed and answered without a DOM
+ *
+ * Building an `nlohmann::json` tree per request allocates a node per
+ * number, and so does a results array built with `push_back`. BatchService
+ * instead scans each request line in place: numbers are converted with
+ * `std::from_chars` straight into an aligned array, handed to the batch
+ * kernels (square_n(), try_factorial_n(), sum(), ...), and the results are
+ * formatted with `std::to_chars` into a reused output buffer. Once the
+ * buffers have grown to the largest request seen, a request costs no heap
+ * allocations.
+ *
+ * @par Protocol:
+ * One JSON object per line, with an operation and an array of numbers; an
+ * optional `id` (number or string) is echoed in the response:
+ * @code{.json}
+ * {"id": 1, "op": "factorial", "values": [3, 5, 10]}
+ * {"id": 2, "op": "sum", "values": [0.5, 1.5]}
+ * @endcode
+ * Each request produces one response line, in request order:
+ * @code{.json}
+ * {"id":1,"results":[6,120,3628800]}
+ * {"id":2,"result":2}
+ * @endcode
+ *
+ * Element-wise operations (`square`, `factorial`, `log_factorial`,
+ * `log_gamma`) answer with `results`; reductions (`sum`, `norm2`) with a
+ * single `result`; `moments` with `{"count":n,"mean":m,"variance":v}`
+ * (population variance). Values without a JSON representation (infinite
+ * or NaN results, such as 171! or factorial(-1)) are written as `null`.
+ * A request that cannot be parsed or served is answered with
+ * `{"id":...,"error":"message"}`; the service continues with the next line.
+ *
+ * @par Example:
+ * @code
+ * mathlib::BatchService service;
+ * service.serve(STDIN_FILENO, STDOUT_FILENO);  // until end of input
+ * @endcode
+ *
+ * @author Your Name
+ * @date 2026-01-05
+ * @version 1.0.0
+ */
+
+#ifndef BATCH_SERVICE_H
+#define BATCH_SERVICE_H
+
+#include "aligned_memory.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace mathlib {
+
+/// Operation requested by a batch request
+enum class BatchOp {
+    Square,        ///< "square": square_n()
+    Factorial,     ///< "factorial": try_factorial_n(), integer values only
+    LogFactorial,  ///< "log_factorial": try_log_factorial_n(), integer values only
+    LogGamma,      ///< "log_gamma": log_gamma_n()
+    Sum,           ///< "sum": sum()
+    Norm2,         ///< "norm2": norm2()
+    Moments        ///< "moments": moments()
+};
+
+/// Settings of a BatchService
+struct BatchServiceOptions {
+    /// Run square and the reductions on the library thread pool (see parallel.h)
+    bool parallel = false;
+
+    /// Longest accepted request line in bytes; longer lines get an error response
+    std::size_t max_request_bytes = std::size_t{64} << 20;
+};
+
+/**
+ * @class BatchService
+ * @brief Answers newline-delimited JSON batch requests (see the file description)
+ *
+ * Not thread-safe: the buffers are reused from request to request, so
+ * each thread or connection needs its own service (or exclusive access).
+ */
+class BatchService {
+  public:
+    explicit BatchService(const BatchServiceOptions& options = {});
+
+    /**
+     * @brief Answers one request
+     *
+     * Errors in the request are reported in the response, never thrown.
+     *
+     * @param line One request without the trailing newline
+     * @return The response line including its newline; empty for a blank
+     *         @p line. Valid until the next call on this service.
+     */
+    std::string_view process(std::string_view line);
+
+    /**
+     * @brief Answers requests read from a file descriptor until end of input
+     *
+     * Reads as much as is available, answers every complete line and
+     * writes the responses of one read with a single write, so pipelined
+     * requests are batched and an interactive client still gets each
+     * answer as soon as its line arrives. A peer closing the connection
+     * (EPIPE, ECONNRESET) ends the loop like end of input; the caller
+     * should ignore SIGPIPE when writing to sockets or pipes.
+     *
+     * @param in_fd  Descriptor to read requests from (stdin, a socket)
+     * @param out_fd Descriptor to write responses to (may equal @p in_fd)
+     * @return Number of requests answered by this call
+     *
+     * @throw std::system_error if reading or writing fails otherwise
+     */
+    std::size_t serve(int in_fd, int out_fd);
+
+    /// Requests answered so far
+    std::size_t requests() const noexcept { return requests_; }
+
+    /// Requests answered with an error so far
+    std::size_t errors() const noexcept { return errors_; }
+
+  private:
+    struct Request;
+
+    std::size_t respond(std::string_view line, std::size_t offset);
+    std::size_t respond_error(std::string_view id, const char* message, std::size_t offset);
+    const char* parse(std::string_view line, Request& request);
+    const char* execute(const Request& request, std::size_t offset, std::size_t& length);
+    char* output(std::size_t offset, std::size_t bytes);
+
+    BatchServiceOptions options_;
+    AlignedBuffer<double> values_;
+    AlignedBuffer<double> results_;
+    AlignedBuffer<int> integers_;
+    AlignedBuffer<char> input_;
+    AlignedBuffer<char> output_;
+    std::size_t requests_ = 0;
+    std::size_t errors_ = 0;
+};
+
+}  // namespace mathlib
+
+#endif  // BATCH_SERVICE_H
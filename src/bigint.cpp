@@ -0,0 +1,258 @@
+/**
+ * @file bigint.cpp
+ * @brief Implementation of BigUInt arithmetic
+ */
+
+#include "bigint.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace mathlib {
+
+namespace {
+
+using Limb = std::uint32_t;
+using Wide = std::uint64_t;
+
+constexpr int LIMB_BITS = 32;
+
+/// dst[0, dst_len) += src[0, len); the sum must fit in dst_len limbs
+void add_into(Limb* dst, std::size_t dst_len, const Limb* src, std::size_t len) {
+    Wide carry = 0;
+    std::size_t i = 0;
+    for (; i < len; ++i) {
+        const Wide sum = Wide{dst[i]} + src[i] + carry;
+        dst[i] = static_cast<Limb>(sum);
+        carry = sum >> LIMB_BITS;
+    }
+    for (; carry != 0 && i < dst_len; ++i) {
+        const Wide sum = Wide{dst[i]} + carry;
+        dst[i] = static_cast<Limb>(sum);
+        carry = sum >> LIMB_BITS;
+    }
+}
+
+/// dst[0, dst_len) -= src[0, len); the result must not be negative
+void sub_into(Limb* dst, std::size_t dst_len, const Limb* src, std::size_t len) {
+    Limb borrow = 0;
+    std::size_t i = 0;
+    for (; i < len; ++i) {
+        const Wide diff = Wide{dst[i]} - src[i] - borrow;
+        dst[i] = static_cast<Limb>(diff);
+        borrow = static_cast<Limb>((diff >> LIMB_BITS) & 1U);
+    }
+    for (; borrow != 0 && i < dst_len; ++i) {
+        borrow = dst[i] == 0 ? 1 : 0;
+        --dst[i];
+    }
+}
+
+/// Length without leading zero limbs
+std::size_t significant(const Limb* a, std::size_t n) {
+    while (n > 0 && a[n - 1] == 0) {
+        --n;
+    }
+    return n;
+}
+
+/// out[0, na + nb) += a * b, one row per limb of b
+void multiply_schoolbook(const Limb* a, std::size_t na, const Limb* b, std::size_t nb,
+                         Limb* out) {
+    for (std::size_t j = 0; j < nb; ++j) {
+        const Wide factor = b[j];
+        if (factor == 0) {
+            continue;
+        }
+        Wide carry = 0;
+        for (std::size_t i = 0; i < na; ++i) {
+            const Wide t = Wide{a[i]} * factor + out[i + j] + carry;
+            out[i + j] = static_cast<Limb>(t);
+            carry = t >> LIMB_BITS;
+        }
+        out[j + na] = static_cast<Limb>(carry);
+    }
+}
+
+/**
+ * @brief out[0, na + nb) = a * b; @p out must be zero on entry
+ *
+ * @details
+ * Karatsuba on the balanced case: with \f$ a = a_1 B^h + a_0 \f$ and
+ * \f$ b = b_1 B^h + b_0 \f$, the product is
+ * \f$ z_2 B^{2h} + z_1 B^h + z_0 \f$ where \f$ z_0 = a_0 b_0 \f$,
+ * \f$ z_2 = a_1 b_1 \f$ and
+ * \f$ z_1 = (a_0 + a_1)(b_0 + b_1) - z_0 - z_2 \f$: three half-size
+ * products instead of four. Very unbalanced operands are cut into
+ * pieces of the shorter length first.
+ */
+void multiply(const Limb* a, std::size_t na, const Limb* b, std::size_t nb, Limb* out) {
+    if (na < nb) {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+    if (nb == 0) {
+        return;
+    }
+    if (nb < BigUInt::KARATSUBA_THRESHOLD) {
+        multiply_schoolbook(a, na, b, nb, out);
+        return;
+    }
+
+    if (na >= 2 * nb) {
+        std::vector<Limb> piece(2 * nb);
+        for (std::size_t first = 0; first < na; first += nb) {
+            const std::size_t len = std::min(nb, na - first);
+            std::fill(piece.begin(), piece.end(), 0);
+            multiply(a + first, len, b, nb, piece.data());
+            add_into(out + first, na + nb - first, piece.data(), len + nb);
+        }
+        return;
+    }
+
+    // nb ≤ na < 2 nb, so both operands have a non-empty high half
+    const std::size_t h = na / 2;
+    const std::size_t a0_len = significant(a, h);
+    const std::size_t b0_len = significant(b, h);
+    multiply(a, a0_len, b, b0_len, out);                    // z0 → out[0, 2h)
+    multiply(a + h, na - h, b + h, nb - h, out + 2 * h);  // z2 → out[2h, na + nb)
+
+    std::vector<Limb> sum_a(na - h + 1, 0);
+    std::copy(a + h, a + na, sum_a.begin());
+    add_into(sum_a.data(), sum_a.size(), a, h);
+    std::vector<Limb> sum_b(std::max(h, nb - h) + 1, 0);
+    std::copy(b + h, b + nb, sum_b.begin());
+    add_into(sum_b.data(), sum_b.size(), b, h);
+
+    const std::size_t la = significant(sum_a.data(), sum_a.size());
+    const std::size_t lb = significant(sum_b.data(), sum_b.size());
+    std::vector<Limb> z1(la + lb, 0);
+    multiply(sum_a.data(), la, sum_b.data(), lb, z1.data());
+    sub_into(z1.data(), z1.size(), out, significant(out, 2 * h));
+    sub_into(z1.data(), z1.size(), out + 2 * h, significant(out + 2 * h, na + nb - 2 * h));
+    add_into(out + h, na + nb - h, z1.data(), significant(z1.data(), z1.size()));
+}
+
+}  // namespace
+
+BigUInt::BigUInt(std::uint64_t value) {
+    while (value != 0) {
+        limbs_.push_back(static_cast<Limb>(value));
+        value >>= LIMB_BITS;
+    }
+}
+
+void BigUInt::trim() {
+    limbs_.resize(significant(limbs_.data(), limbs_.size()));
+}
+
+std::size_t BigUInt::bit_length() const {
+    if (limbs_.empty()) {
+        return 0;
+    }
+    std::size_t bits = (limbs_.size() - 1) * LIMB_BITS;
+    for (Limb top = limbs_.back(); top != 0; top >>= 1) {
+        ++bits;
+    }
+    return bits;
+}
+
+BigUInt& BigUInt::operator*=(std::uint32_t factor) {
+    Wide carry = 0;
+    for (Limb& limb : limbs_) {
+        const Wide t = Wide{limb} * factor + carry;
+        limb = static_cast<Limb>(t);
+        carry = t >> LIMB_BITS;
+    }
+    if (carry != 0) {
+        limbs_.push_back(static_cast<Limb>(carry));
+    }
+    if (factor == 0) {
+        limbs_.clear();
+    }
+    return *this;
+}
+
+BigUInt& BigUInt::operator*=(const BigUInt& other) {
+    *this = *this * other;
+    return *this;
+}
+
+BigUInt& BigUInt::operator<<=(std::size_t bits) {
+    if (limbs_.empty()) {
+        return *this;
+    }
+    const std::size_t whole = bits / LIMB_BITS;
+    const int part = static_cast<int>(bits % LIMB_BITS);
+    if (part != 0) {
+        Limb carry = 0;
+        for (Limb& limb : limbs_) {
+            const Limb next = limb >> (LIMB_BITS - part);
+            limb = (limb << part) | carry;
+            carry = next;
+        }
+        if (carry != 0) {
+            limbs_.push_back(carry);
+        }
+    }
+    limbs_.insert(limbs_.begin(), whole, 0);
+    return *this;
+}
+
+BigUInt operator*(const BigUInt& a, const BigUInt& b) {
+    BigUInt product;
+    if (a.is_zero() || b.is_zero()) {
+        return product;
+    }
+    product.limbs_.assign(a.limbs_.size() + b.limbs_.size(), 0);
+    multiply(a.limbs_.data(), a.limbs_.size(), b.limbs_.data(), b.limbs_.size(),
+             product.limbs_.data());
+    product.trim();
+    return product;
+}
+
+double BigUInt::to_double() const {
+    // Only the top three limbs (96 bits) affect a 53-bit mantissa
+    double result = 0.0;
+    const std::size_t n = limbs_.size();
+    const std::size_t first = n > 3 ? n - 3 : 0;
+    for (std::size_t i = n; i > first; --i) {
+        result = result * 4294967296.0 + static_cast<double>(limbs_[i - 1]);
+    }
+    if (first * LIMB_BITS > static_cast<std::size_t>(std::numeric_limits<double>::max_exponent)) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return std::ldexp(result, static_cast<int>(first * LIMB_BITS));
+}
+
+std::string BigUInt::to_string() const {
+    if (limbs_.empty()) {
+        return "0";
+    }
+    // Peel off 9 decimal digits at a time, least significant first
+    constexpr Limb CHUNK = 1000000000;
+    std::vector<Limb> rest = limbs_;
+    std::vector<Limb> chunks;
+    while (!rest.empty()) {
+        Wide remainder = 0;
+        for (std::size_t i = rest.size(); i-- > 0;) {
+            const Wide current = (remainder << LIMB_BITS) | rest[i];
+            rest[i] = static_cast<Limb>(current / CHUNK);
+            remainder = current % CHUNK;
+        }
+        chunks.push_back(static_cast<Limb>(remainder));
+        rest.resize(significant(rest.data(), rest.size()));
+    }
+
+    std::string text = std::to_string(chunks.back());
+    for (std::size_t i = chunks.size() - 1; i-- > 0;) {
+        const std::string digits = std::to_string(chunks[i]);
+        text.append(9 - digits.size(), '0');
+        text += digits;
+    }
+    return text;
+}
+
+}  // namespace mathlib
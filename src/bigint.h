@@ -0,0 +1,98 @@
+/**
+ * @file bigint.h
+ * @brief Arbitrary-precision unsigned integers
+ *
+ * A minimal big integer for exact results that exceed 64 bits, such as
+ * factorials (see factorial_exact.h). It supports what those need:
+ * multiplication (Karatsuba for large operands), shifts, comparison and
+ * conversion to decimal text or double.
+ *
+ * @author Your Name
+ * @date 2026-01-05
+ * @version 1.0.0
+ */
+
+#ifndef BIGINT_H
+#define BIGINT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mathlib {
+
+/**
+ * @class BigUInt
+ * @brief Unsigned integer of unlimited size
+ *
+ * Stored as base-2³² limbs, least significant first, without leading
+ * zero limbs (zero has no limbs).
+ *
+ * @par Example:
+ * @code
+ * mathlib::BigUInt x(1);
+ * for (std::uint32_t k = 2; k <= 30; ++k) {
+ *     x *= k;
+ * }
+ * std::cout << x.to_string() << '\n';  // 265252859812191058636308480000000
+ * @endcode
+ */
+class BigUInt {
+  public:
+    /// Zero
+    BigUInt() = default;
+
+    /// Converts a 64-bit value
+    explicit BigUInt(std::uint64_t value);
+
+    /// Limbs, least significant first
+    const std::vector<std::uint32_t>& limbs() const { return limbs_; }
+
+    bool is_zero() const { return limbs_.empty(); }
+
+    /// Number of significant bits (0 for zero)
+    std::size_t bit_length() const;
+
+    /// Multiplies by a 32-bit factor, O(size)
+    BigUInt& operator*=(std::uint32_t factor);
+
+    /// Multiplies by another BigUInt
+    BigUInt& operator*=(const BigUInt& other);
+
+    /// Multiplies by \f$ 2^{bits} \f$
+    BigUInt& operator<<=(std::size_t bits);
+
+    /**
+     * @brief Product of two numbers
+     *
+     * Schoolbook multiplication for short operands, Karatsuba
+     * (\f$ O(n^{1.585}) \f$) above KARATSUBA_THRESHOLD limbs.
+     */
+    friend BigUInt operator*(const BigUInt& a, const BigUInt& b);
+
+    friend bool operator==(const BigUInt& a, const BigUInt& b) { return a.limbs_ == b.limbs_; }
+    friend bool operator!=(const BigUInt& a, const BigUInt& b) { return !(a == b); }
+
+    /// Closest double (within one ulp); infinity beyond the double range
+    double to_double() const;
+
+    /**
+     * @brief Decimal representation
+     * @note Quadratic in the number of digits: meant for results of up to
+     *       some ten thousand digits
+     */
+    std::string to_string() const;
+
+    /// Operand size (in limbs) above which multiplication switches to Karatsuba
+    static constexpr std::size_t KARATSUBA_THRESHOLD = 40;
+
+  private:
+    void trim();
+
+    std::vector<std::uint32_t> limbs_;
+};
+
+}  // namespace mathlib
+
+#endif  // BIGINT_H
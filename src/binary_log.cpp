@@ -0,0 +1,243 @@
+/**
+ * @file binary_log.cpp
+ * @brief Implementation of the binary log writer and reader
+ */
+
+#include "binary_log.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <fmt/args.h>
+
+namespace mathlib {
+
+namespace {
+
+constexpr char MAGIC[8] = {'M', 'L', 'B', 'I', 'N', 'L', 'O', 'G'};
+constexpr std::uint32_t VERSION = 1;
+constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+constexpr std::size_t HEADER_SIZE = sizeof(MAGIC) + 2 * sizeof(std::uint32_t);
+
+/// Distinguishes writers, so that per-thread caches of old writers are ignored
+std::atomic<std::uint64_t> next_generation{1};
+
+/// Per-thread cache of format ids, keyed by the address of the format string
+struct FormatCache {
+    struct Entry {
+        std::string_view registered;  // Owned by the writer's format table
+        std::uint32_t id;
+    };
+
+    std::uint64_t generation = 0;
+    std::unordered_map<const char*, Entry> entries;
+};
+
+thread_local FormatCache format_cache;
+
+/// Bounds-checked sequential reads from the mapping
+class Cursor {
+  public:
+    Cursor(const char* data, std::size_t size) : data_(data), size_(size) {}
+
+    template <typename T>
+    T read() {
+        T value;
+        std::memcpy(&value, take(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    std::string_view read_string() {
+        const auto length = read<std::uint32_t>();
+        return std::string_view(take(length), length);
+    }
+
+    const char* take(std::size_t n) {
+        if (n > size_ - offset_) {
+            throw std::runtime_error("Binary log record is truncated");
+        }
+        const char* p = data_ + offset_;
+        offset_ += n;
+        return p;
+    }
+
+    std::size_t offset() const { return offset_; }
+    bool at_end() const { return offset_ == size_; }
+
+  private:
+    const char* data_;
+    std::size_t size_;
+    std::size_t offset_ = 0;
+};
+
+}  // namespace
+
+//==============================================================================
+// BinaryLogWriter
+//==============================================================================
+
+BinaryLogWriter::BinaryLogWriter(const std::string& path, std::size_t capacity)
+    : file_(MappedFile::create(path, std::max(capacity, HEADER_SIZE))),
+      generation_(next_generation.fetch_add(1, std::memory_order_relaxed)) {
+    detail::BinaryRecordBuffer header;
+    header.append(MAGIC, MAGIC + sizeof(MAGIC));
+    detail::put_raw(header, VERSION);
+    detail::put_raw(header, BYTE_ORDER_MARK);
+    append(header.data(), header.size());
+}
+
+BinaryLogWriter::~BinaryLogWriter() {
+    try {
+        file_.close(bytes_written());
+    } catch (const std::exception&) {
+        // The file keeps its full capacity; the zero tail reads as end of data
+    }
+}
+
+void BinaryLogWriter::sync() {
+    file_.sync();
+}
+
+std::size_t BinaryLogWriter::bytes_written() const {
+    return std::min(reserved_.load(std::memory_order_acquire), file_.size());
+}
+
+bool BinaryLogWriter::append(const char* data, std::size_t size) {
+    const std::size_t offset = reserved_.fetch_add(size, std::memory_order_acq_rel);
+    if (offset + size > file_.size()) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    std::memcpy(file_.data() + offset, data, size);
+    return true;
+}
+
+std::uint32_t BinaryLogWriter::format_id(fmt::string_view format) {
+    const std::string_view text(format.data(), format.size());
+
+    // Fast path: this thread has seen the string before. The contents are
+    // compared too, since a runtime format string may reuse an address.
+    FormatCache& cache = format_cache;
+    if (cache.generation != generation_) {
+        cache.entries.clear();
+        cache.generation = generation_;
+    }
+    const auto cached = cache.entries.find(text.data());
+    if (cached != cache.entries.end() && cached->second.registered == text) {
+        return cached->second.id;
+    }
+
+    std::lock_guard<std::mutex> lock(formats_mutex_);
+    auto [it, inserted] =
+        formats_.try_emplace(std::string(text), static_cast<std::uint32_t>(formats_.size()));
+    if (inserted) {
+        // Appended under the lock, so the definition precedes every use
+        detail::BinaryRecordBuffer record;
+        detail::put_raw(record, detail::BINARY_RECORD_FORMAT);
+        detail::put_raw(record, it->second);
+        detail::put_raw(record, static_cast<std::uint32_t>(text.size()));
+        record.append(text.data(), text.data() + text.size());
+        append(record.data(), record.size());
+    }
+    cache.entries[text.data()] = FormatCache::Entry{it->first, it->second};
+    return it->second;
+}
+
+//==============================================================================
+// BinaryLogReader
+//==============================================================================
+
+BinaryLogReader::BinaryLogReader(const std::string& path) : file_(MappedFile::open(path)) {
+    Cursor cursor(file_.data(), file_.size());
+    try {
+        const char* magic = cursor.take(sizeof(MAGIC));
+        if (std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+            throw std::runtime_error(path + " is not a mathlib binary log");
+        }
+        if (cursor.read<std::uint32_t>() != VERSION) {
+            throw std::runtime_error(path + " has an unsupported binary log version");
+        }
+        if (cursor.read<std::uint32_t>() != BYTE_ORDER_MARK) {
+            throw std::runtime_error(path + " was written with a different byte order");
+        }
+    } catch (const std::runtime_error&) {
+        if (file_.size() < HEADER_SIZE) {
+            throw std::runtime_error(path + " is not a mathlib binary log");
+        }
+        throw;
+    }
+    offset_ = cursor.offset();
+}
+
+bool BinaryLogReader::next(BinaryLogRecord& record) {
+    while (offset_ < file_.size()) {
+        Cursor cursor(file_.data() + offset_, file_.size() - offset_);
+        const auto type = cursor.read<std::uint8_t>();
+
+        if (type == detail::BINARY_RECORD_END) {
+            offset_ = file_.size();
+            return false;
+        }
+        if (type == detail::BINARY_RECORD_FORMAT) {
+            const auto id = cursor.read<std::uint32_t>();
+            formats_[id] = cursor.read_string();
+            offset_ += cursor.offset();
+            continue;
+        }
+        if (type != detail::BINARY_RECORD_MESSAGE) {
+            throw std::runtime_error("Unknown binary log record type");
+        }
+
+        const auto size = cursor.read<std::uint32_t>();
+        Cursor body(cursor.take(size), size);
+        record.level = static_cast<spdlog::level::level_enum>(body.read<std::uint8_t>());
+        record.format_id = body.read<std::uint32_t>();
+        record.time_ns = body.read<std::uint64_t>();
+        record.thread_id = body.read<std::uint64_t>();
+
+        const auto format = formats_.find(record.format_id);
+        if (format == formats_.end()) {
+            throw std::runtime_error("Binary log message refers to an undefined format string");
+        }
+        record.format = format->second;
+
+        record.args.clear();
+        while (!body.at_end()) {
+            switch (static_cast<BinaryArgType>(body.read<std::uint8_t>())) {
+            case BinaryArgType::Int64:
+                record.args.emplace_back(body.read<std::int64_t>());
+                break;
+            case BinaryArgType::UInt64:
+                record.args.emplace_back(body.read<std::uint64_t>());
+                break;
+            case BinaryArgType::Double:
+                record.args.emplace_back(body.read<double>());
+                break;
+            case BinaryArgType::Bool:
+                record.args.emplace_back(body.read<std::uint8_t>() != 0);
+                break;
+            case BinaryArgType::Char:
+                record.args.emplace_back(body.read<char>());
+                break;
+            case BinaryArgType::String:
+                record.args.emplace_back(body.read_string());
+                break;
+            default:
+                throw std::runtime_error("Unknown binary log argument type");
+            }
+        }
+        offset_ += cursor.offset();
+        return true;
+    }
+    return false;
+}
+
+std::string format_record(const BinaryLogRecord& record) {
+    fmt::dynamic_format_arg_store<fmt::format_context> store;
+    for (const BinaryLogArg& arg : record.args) {
+        std::visit([&store](const auto& value) { store.push_back(value); }, arg);
+    }
+    return fmt::vformat(fmt::string_view(record.format.data(), record.format.size()), store);
+}
+
+}  // namespace mathlib
@@ -0,0 +1,266 @@
+/**
+ * @file binary_log.h
+ * @brief Binary structured log with deferred formatting
+ *
+ * Formatting a text message costs more than many of the computations it
+ * describes. A binary log stores each message as the id of its format
+ * string plus the raw bytes of its arguments, appended to a memory-mapped
+ * file; the text is produced later by the `mathlib_logdecode` tool.
+ *
+ * @par File format (native byte order):
+ * - Header: 8-byte magic `MLBINLOG`, `u32` version, `u32` byte-order mark
+ *   `0x01020304`
+ * - Records, each starting with a `u8` type:
+ *   - 1 (format): `u32` id, `u32` length, format string bytes. Written
+ *     before the first message that uses the id.
+ *   - 2 (message): `u32` size of the rest of the record, `u8` spdlog level,
+ *     `u32` format id, `u64` time (ns since the Unix epoch), `u64` thread
+ *     id, then the arguments as a `u8` BinaryArgType tag followed by the
+ *     value: 8 bytes for numbers, 1 for bool/char, `u32` length and bytes
+ *     for strings.
+ *   - 0: end of data (the unused, zero-filled tail of the mapping).
+ *
+ * @author Your Name
+ * @date 2026-01-05
+ * @version 1.0.0
+ */
+
+#ifndef BINARY_LOG_H
+#define BINARY_LOG_H
+
+#include "mapped_file.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include <fmt/format.h>
+#include <spdlog/common.h>
+#include <spdlog/details/os.h>
+
+namespace mathlib {
+
+template <typename F>
+struct LazyArg;
+
+/// Type tags of the arguments stored in a binary log
+enum class BinaryArgType : std::uint8_t {
+    Int64 = 1,   ///< Signed integers
+    UInt64 = 2,  ///< Unsigned integers
+    Double = 3,  ///< Floating-point values
+    Bool = 4,
+    Char = 5,
+    String = 6  ///< Strings, and any other type pre-formatted with "{}"
+};
+
+namespace detail {
+
+/// Encoding buffer; typical records fit without allocating
+using BinaryRecordBuffer = fmt::basic_memory_buffer<char, 256>;
+
+constexpr std::uint8_t BINARY_RECORD_END = 0;
+constexpr std::uint8_t BINARY_RECORD_FORMAT = 1;
+constexpr std::uint8_t BINARY_RECORD_MESSAGE = 2;
+
+template <typename T>
+void put_raw(BinaryRecordBuffer& buffer, const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const auto* bytes = reinterpret_cast<const char*>(&value);
+    buffer.append(bytes, bytes + sizeof(T));
+}
+
+inline void put_string(BinaryRecordBuffer& buffer, std::string_view text) {
+    put_raw(buffer, BinaryArgType::String);
+    put_raw(buffer, static_cast<std::uint32_t>(text.size()));
+    buffer.append(text.data(), text.data() + text.size());
+}
+
+template <typename F>
+void encode_arg(BinaryRecordBuffer& buffer, const LazyArg<F>& value);
+
+/// Appends one argument: numbers and strings raw, anything else pre-formatted
+template <typename T>
+void encode_arg(BinaryRecordBuffer& buffer, const T& value) {
+    if constexpr (std::is_same_v<T, bool>) {
+        put_raw(buffer, BinaryArgType::Bool);
+        put_raw(buffer, static_cast<std::uint8_t>(value ? 1 : 0));
+    } else if constexpr (std::is_same_v<T, char>) {
+        put_raw(buffer, BinaryArgType::Char);
+        put_raw(buffer, value);
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+        put_raw(buffer, BinaryArgType::Int64);
+        put_raw(buffer, static_cast<std::int64_t>(value));
+    } else if constexpr (std::is_integral_v<T>) {
+        put_raw(buffer, BinaryArgType::UInt64);
+        put_raw(buffer, static_cast<std::uint64_t>(value));
+    } else if constexpr (std::is_floating_point_v<T>) {
+        put_raw(buffer, BinaryArgType::Double);
+        put_raw(buffer, static_cast<double>(value));
+    } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+        put_string(buffer, std::string_view(value));
+    } else {
+        fmt::memory_buffer text;
+        fmt::format_to(std::back_inserter(text), "{}", value);
+        put_string(buffer, std::string_view(text.data(), text.size()));
+    }
+}
+
+template <typename F>
+void encode_arg(BinaryRecordBuffer& buffer, const LazyArg<F>& value) {
+    encode_arg(buffer, value.compute());
+}
+
+}  // namespace detail
+
+/**
+ * @class BinaryLogWriter
+ * @brief Appends binary log records to a memory-mapped file
+ *
+ * Any number of threads may log concurrently: a record is encoded on the
+ * calling thread, a range of the file is reserved with one atomic add and
+ * the bytes are copied into the mapping. The file has a fixed capacity;
+ * records that do not fit are dropped and counted. The destructor trims
+ * the file to the bytes written.
+ */
+class BinaryLogWriter {
+  public:
+    /// Default file capacity
+    static constexpr std::size_t DEFAULT_CAPACITY = std::size_t{64} << 20;
+
+    /**
+     * @brief Creates (or truncates) a binary log file
+     * @param path     Output file
+     * @param capacity Maximum file size in bytes
+     * @throw std::system_error if the file cannot be created
+     */
+    explicit BinaryLogWriter(const std::string& path, std::size_t capacity = DEFAULT_CAPACITY);
+
+    ~BinaryLogWriter();
+
+    BinaryLogWriter(const BinaryLogWriter&) = delete;
+    BinaryLogWriter& operator=(const BinaryLogWriter&) = delete;
+
+    /**
+     * @brief Records a message
+     *
+     * @param level  Message level
+     * @param format fmt format string; it is rendered by the decoder
+     * @param args   Arguments. Arithmetic types and strings are stored
+     *               raw; other types are formatted with "{}" now, so a
+     *               type-specific format spec is lost for them.
+     */
+    template <typename... Args>
+    void log(spdlog::level::level_enum level, fmt::string_view format, const Args&... args) {
+        detail::BinaryRecordBuffer record;
+        detail::put_raw(record, detail::BINARY_RECORD_MESSAGE);
+        detail::put_raw(record, std::uint32_t{0});  // Size, patched below
+        detail::put_raw(record, static_cast<std::uint8_t>(level));
+        detail::put_raw(record, format_id(format));
+        detail::put_raw(record, static_cast<std::uint64_t>(
+                                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                        spdlog::log_clock::now().time_since_epoch())
+                                        .count()));
+        detail::put_raw(record, static_cast<std::uint64_t>(spdlog::details::os::thread_id()));
+        (detail::encode_arg(record, args), ...);
+
+        const auto size = static_cast<std::uint32_t>(record.size() - 5);
+        std::memcpy(record.data() + 1, &size, sizeof(size));
+        append(record.data(), record.size());
+    }
+
+    /// Writes the mapped pages back to the file
+    void sync();
+
+    /// Bytes of the file in use (header, format strings and messages)
+    std::size_t bytes_written() const;
+
+    /// Messages dropped because the file was full
+    std::uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+  private:
+    std::uint32_t format_id(fmt::string_view format);
+    bool append(const char* data, std::size_t size);
+
+    MappedFile file_;
+    std::uint64_t generation_;
+    std::atomic<std::size_t> reserved_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+    std::mutex formats_mutex_;
+    std::unordered_map<std::string, std::uint32_t> formats_;
+};
+
+/// A decoded argument
+using BinaryLogArg =
+    std::variant<std::int64_t, std::uint64_t, double, bool, char, std::string_view>;
+
+/**
+ * @brief A decoded message
+ *
+ * The string views point into the reader's mapping and stay valid as long
+ * as the BinaryLogReader.
+ */
+struct BinaryLogRecord {
+    spdlog::level::level_enum level = spdlog::level::off;
+    std::uint64_t time_ns = 0;  ///< Nanoseconds since the Unix epoch
+    std::uint64_t thread_id = 0;
+    std::uint32_t format_id = 0;
+    std::string_view format;
+    std::vector<BinaryLogArg> args;
+};
+
+/**
+ * @class BinaryLogReader
+ * @brief Reads the messages of a binary log file in order
+ *
+ * @par Example:
+ * @code
+ * mathlib::BinaryLogReader reader("run.mlog");
+ * mathlib::BinaryLogRecord record;
+ * while (reader.next(record)) {
+ *     std::cout << mathlib::format_record(record) << '\n';
+ * }
+ * @endcode
+ */
+class BinaryLogReader {
+  public:
+    /**
+     * @brief Opens a binary log
+     * @param path File written by BinaryLogWriter
+     * @throw std::system_error if the file cannot be opened
+     * @throw std::runtime_error if it is not a binary log of this platform
+     */
+    explicit BinaryLogReader(const std::string& path);
+
+    /**
+     * @brief Decodes the next message
+     * @param record Receives the message
+     * @return false at the end of the log
+     * @throw std::runtime_error if the file is corrupt
+     */
+    bool next(BinaryLogRecord& record);
+
+  private:
+    MappedFile file_;
+    std::size_t offset_ = 0;
+    std::unordered_map<std::uint32_t, std::string_view> formats_;
+};
+
+/**
+ * @brief Renders the message text of a decoded record
+ * @throw fmt::format_error if the arguments do not match the format string
+ */
+std::string format_record(const BinaryLogRecord& record);
+
+}  // namespace mathlib
+
+#endif  // BINARY_LOG_H
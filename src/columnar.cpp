@@ -0,0 +1,406 @@
+/**
+ * @file columnar.cpp
+ * @brief Implementation of the columnar file writer, reader and JSON converter
+ */
+
+#include "columnar.h"
+#include "error.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+namespace mathlib {
+
+namespace {
+
+constexpr char MAGIC[8] = {'M', 'L', 'C', 'O', 'L', 'U', 'M', 'N'};
+constexpr std::uint32_t VERSION = 1;
+constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+constexpr std::size_t HEADER_SIZE = 64;
+constexpr std::size_t ENTRY_SIZE = 64;
+constexpr std::size_t NAME_FIELD = 40;
+
+/// Column data starts on a cache line
+constexpr std::size_t COLUMN_ALIGNMENT = 64;
+
+/// Run-length coding: control bytes below 128 precede 1-128 literal bytes,
+/// others repeat the next byte 3-130 times
+constexpr std::size_t MAX_LITERAL = 128;
+constexpr std::size_t MIN_RUN = 3;
+constexpr std::size_t MAX_RUN = 130;
+
+constexpr std::size_t round_up(std::size_t x, std::size_t multiple) {
+    return (x + multiple - 1) / multiple * multiple;
+}
+
+template <typename T>
+void put(char* p, const T& value) {
+    std::memcpy(p, &value, sizeof(T));
+}
+
+template <typename T>
+T get(const char* p) {
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    return value;
+}
+
+/// Largest encoded size of a plane of @p n bytes: one control byte per literal block
+constexpr std::size_t rle_bound(std::size_t n) {
+    return n + (n + MAX_LITERAL - 1) / MAX_LITERAL;
+}
+
+/// Length of the run of equal bytes starting at element i, at most @p limit
+std::size_t run_length(const unsigned char* plane, std::size_t stride, std::size_t i,
+                       std::size_t n, std::size_t limit) {
+    const unsigned char value = plane[i * stride];
+    std::size_t length = 1;
+    while (i + length < n && length < limit && plane[(i + length) * stride] == value) {
+        ++length;
+    }
+    return length;
+}
+
+/**
+ * Byte shuffle plus run-length coding: for each byte position k of the
+ * elements, the bytes k of all elements are encoded in turn (read with a
+ * stride, so no transposed copy is made).
+ */
+std::size_t shuffle_encode(const void* data, std::size_t count, std::size_t element_size,
+                           char* out) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    auto* o = reinterpret_cast<unsigned char*>(out);
+    for (std::size_t k = 0; k < element_size; ++k) {
+        const unsigned char* plane = bytes + k;
+        std::size_t i = 0;
+        while (i < count) {
+            const std::size_t run = run_length(plane, element_size, i, count, MAX_RUN);
+            if (run >= MIN_RUN) {
+                *o++ = static_cast<unsigned char>(MAX_LITERAL + (run - MIN_RUN));
+                *o++ = plane[i * element_size];
+                i += run;
+                continue;
+            }
+            unsigned char* control = o++;
+            std::size_t length = 0;
+            while (i < count && length < MAX_LITERAL &&
+                   run_length(plane, element_size, i, count, MIN_RUN) < MIN_RUN) {
+                *o++ = plane[i * element_size];
+                ++i;
+                ++length;
+            }
+            *control = static_cast<unsigned char>(length - 1);
+        }
+    }
+    return static_cast<std::size_t>(o - reinterpret_cast<unsigned char*>(out));
+}
+
+void shuffle_decode(const char* in, std::size_t size, std::size_t count,
+                    std::size_t element_size, void* data) {
+    const auto* p = reinterpret_cast<const unsigned char*>(in);
+    const unsigned char* end = p + size;
+    auto* bytes = static_cast<unsigned char*>(data);
+    for (std::size_t k = 0; k < element_size; ++k) {
+        unsigned char* plane = bytes + k;
+        std::size_t i = 0;
+        while (i < count) {
+            if (p == end) {
+                detail::raise(std::runtime_error("Columnar data is truncated"));
+            }
+            const std::size_t control = *p++;
+            const bool run = control >= MAX_LITERAL;
+            const std::size_t length = run ? control - MAX_LITERAL + MIN_RUN : control + 1;
+            if (length > count - i || (run ? 1 : length) > static_cast<std::size_t>(end - p)) {
+                detail::raise(std::runtime_error("Columnar data is corrupt"));
+            }
+            for (std::size_t j = 0; j < length; ++j, ++i) {
+                plane[i * element_size] = run ? *p : p[j];
+            }
+            p += run ? 1 : length;
+        }
+    }
+    if (p != end) {
+        detail::raise(std::runtime_error("Columnar data is corrupt"));
+    }
+}
+
+bool valid_type(std::uint8_t type) {
+    return type >= static_cast<std::uint8_t>(ColumnType::Float64) &&
+           type <= static_cast<std::uint8_t>(ColumnType::UInt8);
+}
+
+/// Appends a number in JSON syntax (shortest round-trip form, null if not finite)
+template <typename T>
+void append_number(std::string& out, T value) {
+    char buffer[32];
+    if constexpr (std::is_floating_point_v<T>) {
+        if (!std::isfinite(value)) {
+            out += "null";
+            return;
+        }
+    }
+    if constexpr (std::is_same_v<T, std::uint8_t>) {
+        out.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), unsigned{value}).ptr);
+    } else {
+        out.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr);
+    }
+}
+
+void append_string(std::string& out, std::string_view text) {
+    out += '"';
+    for (const char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char buffer[8];
+            std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned>(c));
+            out += buffer;
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+void append_value(std::string& out, ColumnType type, const void* column, std::size_t row) {
+    switch (type) {
+        case ColumnType::Float64:
+            append_number(out, static_cast<const double*>(column)[row]);
+            break;
+        case ColumnType::Float32:
+            append_number(out, static_cast<const float*>(column)[row]);
+            break;
+        case ColumnType::Int32:
+            append_number(out, static_cast<const std::int32_t*>(column)[row]);
+            break;
+        case ColumnType::Int64:
+            append_number(out, static_cast<const std::int64_t*>(column)[row]);
+            break;
+        case ColumnType::UInt8:
+            append_number(out, static_cast<const std::uint8_t*>(column)[row]);
+            break;
+    }
+}
+
+}  // namespace
+
+std::size_t column_type_size(ColumnType type) {
+    switch (type) {
+        case ColumnType::Float64:
+        case ColumnType::Int64:
+            return 8;
+        case ColumnType::Float32:
+        case ColumnType::Int32:
+            return 4;
+        case ColumnType::UInt8:
+            return 1;
+    }
+    detail::raise(std::invalid_argument("Unknown column type"));
+}
+
+//==============================================================================
+// ColumnarWriter
+//==============================================================================
+
+ColumnarWriter::ColumnarWriter(std::size_t rows, Compression compression)
+    : rows_(rows), compression_(compression) {}
+
+void ColumnarWriter::add_column(std::string_view name, ColumnType type, const void* data) {
+    if (name.empty() || name.size() > COLUMN_NAME_MAX ||
+        name.find('\0') != std::string_view::npos) {
+        detail::raise(std::invalid_argument("Column names must have 1 to 39 bytes"));
+    }
+    for (const Column& column : columns_) {
+        if (column.name == name) {
+            detail::raise(std::invalid_argument("Duplicate column name"));
+        }
+    }
+    columns_.push_back({std::string(name), type, data});
+}
+
+void ColumnarWriter::write(const std::string& path) const {
+    // Reserve the worst case; the file is trimmed to the bytes written
+    const std::size_t data_start = round_up(HEADER_SIZE + ENTRY_SIZE * columns_.size(),
+                                            COLUMN_ALIGNMENT);
+    std::size_t bound = data_start;
+    for (const Column& column : columns_) {
+        const std::size_t bytes = rows_ * column_type_size(column.type);
+        const std::size_t encoded = column_type_size(column.type) * rle_bound(rows_);
+        bound += round_up(compression_ == Compression::None ? bytes : std::max(bytes, encoded),
+                          COLUMN_ALIGNMENT);
+    }
+    MappedFile file = MappedFile::create(path, bound);
+    char* base = file.data();
+
+    put(base, MAGIC);
+    put(base + 8, VERSION);
+    put(base + 12, BYTE_ORDER_MARK);
+    put(base + 16, static_cast<std::uint64_t>(rows_));
+    put(base + 24, static_cast<std::uint32_t>(columns_.size()));
+
+    std::size_t offset = data_start;
+    for (std::size_t c = 0; c < columns_.size(); ++c) {
+        const Column& column = columns_[c];
+        const std::size_t element_size = column_type_size(column.type);
+        const std::size_t bytes = rows_ * element_size;
+
+        Compression stored = Compression::None;
+        std::size_t size = bytes;
+        if (compression_ == Compression::Shuffle && bytes > 0) {
+            size = shuffle_encode(column.data, rows_, element_size, base + offset);
+            stored = Compression::Shuffle;
+            if (size >= bytes) {
+                stored = Compression::None;  // incompressible: keep it mappable
+                size = bytes;
+            }
+        }
+        if (stored == Compression::None && bytes > 0) {
+            std::memcpy(base + offset, column.data, bytes);
+        }
+
+        char* entry = base + HEADER_SIZE + c * ENTRY_SIZE;
+        std::memcpy(entry, column.name.data(), column.name.size());
+        put(entry + NAME_FIELD, static_cast<std::uint8_t>(column.type));
+        put(entry + NAME_FIELD + 1, static_cast<std::uint8_t>(stored));
+        put(entry + 48, static_cast<std::uint64_t>(offset));
+        put(entry + 56, static_cast<std::uint64_t>(size));
+        offset += round_up(size, COLUMN_ALIGNMENT);
+    }
+    file.close(offset);
+}
+
+//==============================================================================
+// ColumnarReader
+//==============================================================================
+
+ColumnarReader::ColumnarReader(const std::string& path) : file_(MappedFile::open(path)) {
+    const char* base = file_.data();
+    const std::size_t size = file_.size();
+    if (size < HEADER_SIZE || std::memcmp(base, MAGIC, sizeof(MAGIC)) != 0) {
+        detail::raise(std::runtime_error(path + " is not a mathlib columnar file"));
+    }
+    if (get<std::uint32_t>(base + 8) != VERSION) {
+        detail::raise(std::runtime_error(path + " has an unsupported columnar file version"));
+    }
+    if (get<std::uint32_t>(base + 12) != BYTE_ORDER_MARK) {
+        detail::raise(std::runtime_error(path + " was written with a different byte order"));
+    }
+    const auto rows = get<std::uint64_t>(base + 16);
+    if (rows > SIZE_MAX / sizeof(std::uint64_t)) {
+        detail::raise(std::runtime_error(path + " has an invalid row count"));
+    }
+    rows_ = static_cast<std::size_t>(rows);
+    const std::size_t count = get<std::uint32_t>(base + 24);
+    if (count > (size - HEADER_SIZE) / ENTRY_SIZE) {
+        detail::raise(std::runtime_error(path + " has a truncated column directory"));
+    }
+
+    columns_.reserve(count);
+    offsets_.reserve(count);
+    for (std::size_t c = 0; c < count; ++c) {
+        const char* entry = base + HEADER_SIZE + c * ENTRY_SIZE;
+        const auto type = get<std::uint8_t>(entry + NAME_FIELD);
+        const auto compression = get<std::uint8_t>(entry + NAME_FIELD + 1);
+        const auto offset = get<std::uint64_t>(entry + 48);
+        const auto stored = get<std::uint64_t>(entry + 56);
+        if (!valid_type(type) || compression > static_cast<std::uint8_t>(Compression::Shuffle)) {
+            detail::raise(std::runtime_error(path + " has an unknown column type or encoding"));
+        }
+        const auto column_type = static_cast<ColumnType>(type);
+        const auto column_compression = static_cast<Compression>(compression);
+        const std::size_t element_size = column_type_size(column_type);
+        const bool fits = offset % COLUMN_ALIGNMENT == 0 && offset <= size &&
+                          stored <= size - offset;
+        const bool sized = column_compression != Compression::None ||
+                           (rows_ <= stored / element_size && stored == rows_ * element_size);
+        if (!fits || !sized) {
+            detail::raise(std::runtime_error(path + " has a column outside the file"));
+        }
+        const char* name_end = std::find(entry, entry + NAME_FIELD, '\0');
+        columns_.push_back({std::string(entry, name_end), column_type,
+                            column_compression, static_cast<std::size_t>(stored)});
+        offsets_.push_back(static_cast<std::size_t>(offset));
+    }
+    decoded_.resize(count);
+    file_.advise(MapAdvice::Sequential);
+}
+
+std::size_t ColumnarReader::find(std::string_view name) const {
+    for (std::size_t c = 0; c < columns_.size(); ++c) {
+        if (columns_[c].name == name) {
+            return c;
+        }
+    }
+    detail::raise(std::invalid_argument("No column named " + std::string(name)));
+}
+
+const void* ColumnarReader::column_data(std::size_t index, ColumnType type) {
+    const ColumnInfo& column = columns_.at(index);
+    if (column.type != type) {
+        detail::raise(std::invalid_argument("Column " + column.name + " has another type"));
+    }
+    const char* stored = file_.data() + offsets_[index];
+    if (column.compression == Compression::None) {
+        return stored;
+    }
+    AlignedBuffer<char>& decoded = decoded_[index];
+    const std::size_t element_size = column_type_size(type);
+    if (decoded.empty() && rows_ > 0) {
+        // A two-byte run token expands to at most MAX_RUN bytes
+        if (rows_ * element_size / (MAX_RUN / 2) > column.stored_bytes) {
+            detail::raise(std::runtime_error("Columnar data is corrupt"));
+        }
+        decoded.resize(rows_ * element_size);
+        shuffle_decode(stored, column.stored_bytes, rows_, element_size, decoded.data());
+    }
+    return decoded.data();
+}
+
+//==============================================================================
+// JSON conversion
+//==============================================================================
+
+void write_json(ColumnarReader& reader, std::ostream& out) {
+    std::vector<const void*> data(reader.columns());
+    for (std::size_t c = 0; c < reader.columns(); ++c) {
+        switch (reader.column(c).type) {
+            case ColumnType::Float64:
+                data[c] = reader.values<double>(c);
+                break;
+            case ColumnType::Float32:
+                data[c] = reader.values<float>(c);
+                break;
+            case ColumnType::Int32:
+                data[c] = reader.values<std::int32_t>(c);
+                break;
+            case ColumnType::Int64:
+                data[c] = reader.values<std::int64_t>(c);
+                break;
+            case ColumnType::UInt8:
+                data[c] = reader.values<std::uint8_t>(c);
+                break;
+        }
+    }
+
+    std::string line;
+    out << '[';
+    for (std::size_t row = 0; row < reader.rows(); ++row) {
+        line.assign(row == 0 ? "\n{" : ",\n{");
+        for (std::size_t c = 0; c < reader.columns(); ++c) {
+            line += c == 0 ? "" : ",";
+            append_string(line, reader.column(c).name);
+            line += ':';
+            append_value(line, reader.column(c).type, data[c], row);
+        }
+        line += '}';
+        out << line;
+    }
+    out << "\n]\n";
+}
+
+}  // namespace mathlib
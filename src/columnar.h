@@ -0,0 +1,236 @@
+/**
+ * @file columnar.h
+ * @brief Columnar binary files for batch results
+ *
+ * A JSON export of batch results (one object per row, every number
+ * printed as text) is several times larger than the data and takes far
+ * longer to write than the results took to compute. A columnar file stores
+ * each result array as one contiguous, typed column: writing is a copy into
+ * a memory-mapped file, and reading maps the file and hands out pointers
+ * into it, without parsing. Columns may be compressed (byte shuffle plus
+ * run-length coding); those are decoded on first access instead.
+ *
+ * @par File format (native byte order):
+ * - Header, 64 bytes: 8-byte magic `MLCOLUMN`, `u32` version, `u32`
+ *   byte-order mark `0x01020304`, `u64` row count, `u32` column count,
+ *   zero padding
+ * - Column directory, 64 bytes per column: name (up to
+ *   COLUMN_NAME_MAX bytes, zero padded to 40), `u8` ColumnType, `u8`
+ *   Compression, 6 zero bytes, `u64` data offset, `u64` stored size in bytes
+ * - Column data, each starting at a multiple of 64 bytes, so uncompressed
+ *   columns of a mapped file are cache-line aligned arrays
+ *
+ * @par Example:
+ * @code
+ * mathlib::ColumnarWriter writer(values.size(), mathlib::Compression::Shuffle);
+ * writer.add("input", values.data());
+ * writer.add("square", squares.data());
+ * writer.add("factorial", factorials.data());
+ * writer.write("results.mlcol");
+ *
+ * mathlib::ColumnarReader reader("results.mlcol");
+ * const double* square = reader.values<double>("square");  // reader.rows() elements
+ * @endcode
+ *
+ * @author Your Name
+ * @date 2026-01-05
+ * @version 1.0.0
+ */
+
+#ifndef COLUMNAR_H
+#define COLUMNAR_H
+
+#include "aligned_memory.h"
+#include "mapped_file.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace mathlib {
+
+/// Longest column name in bytes
+constexpr std::size_t COLUMN_NAME_MAX = 39;
+
+/// Element type of a column
+enum class ColumnType : std::uint8_t {
+    Float64 = 1,  ///< double
+    Float32 = 2,  ///< float
+    Int32 = 3,    ///< std::int32_t
+    Int64 = 4,    ///< std::int64_t
+    UInt8 = 5     ///< std::uint8_t (e.g. the masks of try_factorial_n())
+};
+
+/// Encoding of a column's data
+enum class Compression : std::uint8_t {
+    None = 0,  ///< Raw array; readable in place from the mapped file
+    /**
+     * Byte shuffle plus run-length coding: byte k of every element is
+     * stored together, so the runs of equal bytes in exponents, high bytes
+     * of small integers and zero low bytes of round numbers compress.
+     * Random mantissa bits do not; a column that would not shrink is
+     * stored uncompressed.
+     */
+    Shuffle = 1
+};
+
+/// Size in bytes of an element of @p type
+std::size_t column_type_size(ColumnType type);
+
+namespace detail {
+
+template <typename T>
+constexpr ColumnType column_type_of() {
+    if constexpr (std::is_same_v<T, double>) {
+        return ColumnType::Float64;
+    } else if constexpr (std::is_same_v<T, float>) {
+        return ColumnType::Float32;
+    } else if constexpr (std::is_same_v<T, std::int32_t>) {
+        return ColumnType::Int32;
+    } else if constexpr (std::is_same_v<T, std::int64_t>) {
+        return ColumnType::Int64;
+    } else {
+        static_assert(std::is_same_v<T, std::uint8_t>, "Unsupported column element type");
+        return ColumnType::UInt8;
+    }
+}
+
+}  // namespace detail
+
+/**
+ * @class ColumnarWriter
+ * @brief Collects columns of equal length and writes them as one file
+ *
+ * The writer keeps pointers only: the arrays must stay valid until
+ * write() returns, and are then copied (or encoded) straight into the
+ * mapped output file.
+ */
+class ColumnarWriter {
+  public:
+    /**
+     * @brief Starts a file of @p rows rows
+     * @param rows        Elements in every column
+     * @param compression Encoding of the columns
+     */
+    explicit ColumnarWriter(std::size_t rows, Compression compression = Compression::None);
+
+    /**
+     * @brief Adds a column of rows() elements
+     *
+     * @tparam T double, float, std::int32_t, std::int64_t or std::uint8_t
+     * @param name Unique, non-empty name of at most COLUMN_NAME_MAX bytes
+     * @param data rows() elements, valid until write() returns
+     *
+     * @throw std::invalid_argument for an invalid or duplicate name
+     */
+    template <typename T>
+    void add(std::string_view name, const T* data) {
+        add_column(name, detail::column_type_of<T>(), data);
+    }
+
+    /**
+     * @brief Writes the file (replacing an existing one)
+     * @throw std::system_error if the file cannot be created or written
+     */
+    void write(const std::string& path) const;
+
+    std::size_t rows() const noexcept { return rows_; }
+    std::size_t columns() const noexcept { return columns_.size(); }
+
+  private:
+    struct Column {
+        std::string name;
+        ColumnType type;
+        const void* data;
+    };
+
+    void add_column(std::string_view name, ColumnType type, const void* data);
+
+    std::size_t rows_;
+    Compression compression_;
+    std::vector<Column> columns_;
+};
+
+/// Description of a column of a ColumnarReader
+struct ColumnInfo {
+    std::string name;
+    ColumnType type;
+    Compression compression;
+    std::size_t stored_bytes;  ///< Size in the file (after compression)
+};
+
+/**
+ * @class ColumnarReader
+ * @brief Maps a columnar file and gives typed access to its columns
+ *
+ * Uncompressed columns are returned as pointers into the mapping (no
+ * copy); compressed ones are decoded into a buffer owned by the reader on
+ * first access. Pointers stay valid for the lifetime of the reader.
+ */
+class ColumnarReader {
+  public:
+    /**
+     * @brief Opens and validates a file
+     * @throw std::system_error if the file cannot be opened
+     * @throw std::runtime_error if it is not a valid columnar file
+     */
+    explicit ColumnarReader(const std::string& path);
+
+    std::size_t rows() const noexcept { return rows_; }
+    std::size_t columns() const noexcept { return columns_.size(); }
+
+    /// Name, type and encoding of column @p index (< columns())
+    const ColumnInfo& column(std::size_t index) const { return columns_[index]; }
+
+    /**
+     * @brief Index of the column called @p name
+     * @throw std::invalid_argument if there is none
+     */
+    std::size_t find(std::string_view name) const;
+
+    /**
+     * @brief The rows() elements of column @p index
+     *
+     * @tparam T The element type the column was written with
+     * @throw std::invalid_argument if T does not match the column type
+     * @throw std::runtime_error if compressed data is corrupt
+     */
+    template <typename T>
+    const T* values(std::size_t index) {
+        return static_cast<const T*>(column_data(index, detail::column_type_of<T>()));
+    }
+
+    /// values() of the column called @p name
+    template <typename T>
+    const T* values(std::string_view name) {
+        return values<T>(find(name));
+    }
+
+  private:
+    const void* column_data(std::size_t index, ColumnType type);
+
+    MappedFile file_;
+    std::size_t rows_ = 0;
+    std::vector<ColumnInfo> columns_;
+    std::vector<std::size_t> offsets_;
+    std::vector<AlignedBuffer<char>> decoded_;
+};
+
+/**
+ * @brief Writes the rows of a columnar file as a JSON array of objects
+ *
+ * For inspection and debugging: one object per row (keys are the column
+ * names), one row per line. Non-finite floating-point values are written
+ * as null.
+ *
+ * @throw std::runtime_error if compressed data is corrupt
+ */
+void write_json(ColumnarReader& reader, std::ostream& out);
+
+}  // namespace mathlib
+
+#endif  // COLUMNAR_H
@@ -0,0 +1,184 @@
+/**
+ * @file combinatorics.cpp
+ * @brief Implementation of binomial coefficient functions
+ */
+
+#include "combinatorics.h"
+#include "error.h"
+#include "mathlib.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace mathlib {
+
+namespace {
+
+constexpr std::size_t TRIANGLE_ROWS = BINOMIAL_TABLE_MAX + 1;
+constexpr std::size_t TRIANGLE_SIZE = TRIANGLE_ROWS * (TRIANGLE_ROWS + 1) / 2;
+
+/// Offset of row n in the packed triangle
+constexpr std::size_t row_offset(int n) {
+    return static_cast<std::size_t>(n) * (static_cast<std::size_t>(n) + 1) / 2;
+}
+
+/**
+ * @brief Builds rows 0 ... BINOMIAL_TABLE_MAX of Pascal's triangle
+ *
+ * @details
+ * Rows are packed one after the other (row n has n + 1 entries) and built
+ * with the addition rule \f$ \binom{n}{k} = \binom{n-1}{k-1} + \binom{n-1}{k} \f$,
+ * so no division or overflow check is involved.
+ */
+constexpr std::array<std::uint64_t, TRIANGLE_SIZE> make_pascal_triangle() {
+    std::array<std::uint64_t, TRIANGLE_SIZE> t{};
+    for (int n = 0; n <= BINOMIAL_TABLE_MAX; ++n) {
+        const std::size_t row = row_offset(n);
+        t[row] = 1;
+        t[row + n] = 1;
+        for (int k = 1; k < n; ++k) {
+            const std::size_t prev = row_offset(n - 1);
+            t[row + k] = t[prev + k - 1] + t[prev + k];
+        }
+    }
+    return t;
+}
+
+constexpr std::array<std::uint64_t, TRIANGLE_SIZE> PASCAL_TRIANGLE = make_pascal_triangle();
+
+/// n! for n = 0 ... FACTORIAL_U64_MAX
+constexpr std::array<std::uint64_t, FACTORIAL_U64_MAX + 1> make_factorial_u64_table() {
+    std::array<std::uint64_t, FACTORIAL_U64_MAX + 1> t{};
+    t[0] = 1;
+    for (int n = 1; n <= FACTORIAL_U64_MAX; ++n) {
+        t[n] = t[n - 1] * static_cast<std::uint64_t>(n);
+    }
+    return t;
+}
+
+constexpr std::array<std::uint64_t, FACTORIAL_U64_MAX + 1> FACTORIAL_U64_TABLE =
+    make_factorial_u64_table();
+
+/// Ratio products are used by log_binomial() up to this min(k, n - k)
+constexpr int LOG_BINOMIAL_PRODUCT_MAX_K = 20;
+
+void check_n(int n) {
+    if (n < 0) {
+        detail::raise(std::invalid_argument("Binomial coefficient with negative n is undefined"));
+    }
+}
+
+/// Multiplicative formula with exact overflow detection (n > BINOMIAL_TABLE_MAX)
+std::uint64_t binomial_multiplicative(int n, int k) {
+    constexpr std::uint64_t MAX = std::numeric_limits<std::uint64_t>::max();
+
+    std::uint64_t result = 1;
+    for (int i = 1; i <= k; ++i) {
+        // result * (n - k + i) is divisible by i. Dividing the common factor
+        // g out of result first leaves i / g, which must divide the other
+        // factor, so both steps are exact.
+        auto num = static_cast<std::uint64_t>(n - k + i);
+        auto den = static_cast<std::uint64_t>(i);
+        const std::uint64_t g = std::gcd(result, den);
+        result /= g;
+        den /= g;
+        num /= den;
+        if (result > MAX / num) {
+            detail::raise(std::overflow_error("Binomial coefficient does not fit in 64 bits"));
+        }
+        result *= num;
+    }
+    return result;
+}
+
+std::uint64_t binomial_impl(int n, int k) {
+    if (k < 0 || k > n) {
+        return 0;
+    }
+    if (n <= BINOMIAL_TABLE_MAX) {
+        return PASCAL_TRIANGLE[row_offset(n) + k];
+    }
+    return binomial_multiplicative(n, std::min(k, n - k));
+}
+
+}  // namespace
+
+std::uint64_t factorial_u64(int n) {
+    if (n < 0) {
+        detail::raise(std::invalid_argument("Factorial of negative number is undefined"));
+    }
+    if (n > FACTORIAL_U64_MAX) {
+        detail::raise(std::overflow_error("Factorial does not fit in 64 bits"));
+    }
+    return FACTORIAL_U64_TABLE[n];
+}
+
+std::uint64_t binomial(int n, int k) {
+    check_n(n);
+    return binomial_impl(n, k);
+}
+
+double log_binomial(int n, int k) {
+    check_n(n);
+    if (k < 0 || k > n) {
+        return -std::numeric_limits<double>::infinity();
+    }
+    k = std::min(k, n - k);
+
+    // Small k: product of k ratios, one logarithm, no cancellation
+    if (k <= LOG_BINOMIAL_PRODUCT_MAX_K) {
+        double product = 1.0;
+        for (int i = 1; i <= k; ++i) {
+            product *= static_cast<double>(n - k + i) / i;
+        }
+        return std::log(product);
+    }
+    return log_factorial(n) - log_factorial(k) - log_factorial(n - k);
+}
+
+void pascal_row(int n, std::uint64_t* out) {
+    check_n(n);
+    if (n > BINOMIAL_TABLE_MAX) {
+        detail::raise(std::overflow_error("Pascal row does not fit in 64 bits"));
+    }
+    const std::uint64_t* row = PASCAL_TRIANGLE.data() + row_offset(n);
+    std::copy(row, row + n + 1, out);
+}
+
+void pascal_row(int n, double* out) {
+    check_n(n);
+    if (n <= BINOMIAL_TABLE_MAX) {
+        const std::uint64_t* row = PASCAL_TRIANGLE.data() + row_offset(n);
+        for (int k = 0; k <= n; ++k) {
+            out[k] = static_cast<double>(row[k]);
+        }
+        return;
+    }
+
+    // The row is symmetric: compute the left half and mirror it
+    out[0] = 1.0;
+    out[n] = 1.0;
+    for (int k = 1; k <= n / 2; ++k) {
+        out[k] = out[k - 1] * static_cast<double>(n - k + 1) / k;
+        out[n - k] = out[k];
+    }
+}
+
+void binomial_n(const int* n, const int* k, std::uint64_t* out, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        check_n(n[i]);
+        out[i] = binomial_impl(n[i], k[i]);
+    }
+}
+
+void log_binomial_n(const int* n, const int* k, double* out, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = log_binomial(n[i], k[i]);
+    }
+}
+
+}  // namespace mathlib
@@ -0,0 +1,184 @@
+/**
+ * @file combinatorics.h
+ * @brief Binomial coefficients without factorial ratios, and exact factorials
+ *
+ * Computing \f$ \binom{n}{k} \f$ as `factorial(n) / (factorial(k) * factorial(n - k))`
+ * rounds for n > 20 and overflows for n > 170 even when the coefficient
+ * itself is small. The functions in this file compute binomial
+ * coefficients directly: exactly in 64-bit integers, or as logarithms
+ * for arbitrarily large n. Residues modulo a prime are in modular.h.
+ *
+ * @author Your Name
+ * @date 2026-01-05
+ * @version 1.0.0
+ */
+
+#ifndef COMBINATORICS_H
+#define COMBINATORICS_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mathlib {
+
+/**
+ * @brief Largest n for which every \f$ \binom{n}{k} \f$ fits in 64 bits
+ *
+ * Rows 0 ... 67 of Pascal's triangle are precomputed at compile time.
+ * Beyond this row the central coefficients exceed \f$ 2^{64} - 1 \f$,
+ * although coefficients with small k still fit.
+ */
+constexpr int BINOMIAL_TABLE_MAX = 67;
+
+/// Largest n for which n! fits in 64 bits (20! < 2^64 < 21!)
+constexpr int FACTORIAL_U64_MAX = 20;
+
+/**
+ * @brief Computes n! exactly as a 64-bit integer
+ *
+ * Integer counterpart of factorial() for exact counting and hashing
+ * code: no conversion from double, and a result that does not fit is
+ * reported instead of rounded.
+ *
+ * @param n Non-negative integer, at most FACTORIAL_U64_MAX
+ * @return n!
+ *
+ * @throw std::invalid_argument if n < 0
+ * @throw std::overflow_error if n > FACTORIAL_U64_MAX
+ *
+ * @par Complexity:
+ * O(1) - table lookup
+ *
+ * @see factorial_mod() for n! modulo an integer, factorial_exact() for
+ *      arbitrary n
+ */
+std::uint64_t factorial_u64(int n);
+
+/**
+ * @brief Computes the binomial coefficient exactly
+ *
+ * Calculates \f$ \binom{n}{k} = \frac{n!}{k!(n-k)!} \f$, the number of
+ * ways to choose k elements out of n.
+ *
+ * @param n Number of elements (n ≥ 0)
+ * @param k Number of chosen elements
+ * @return \f$ \binom{n}{k} \f$; 0 if k < 0 or k > n
+ *
+ * @throw std::invalid_argument if n < 0
+ * @throw std::overflow_error if the result does not fit in 64 bits
+ *
+ * @par Example:
+ * @code
+ * std::uint64_t c = mathlib::binomial(10, 3);    // 120
+ * std::uint64_t d = mathlib::binomial(1000, 3);  // 166167000, n! is not representable
+ * @endcode
+ *
+ * @par Complexity:
+ * O(1) for n ≤ BINOMIAL_TABLE_MAX (table lookup), O(min(k, n-k)) otherwise
+ *
+ * @par Implementation Notes:
+ * Beyond the table the multiplicative formula
+ * \f$ \binom{n}{i} = \binom{n}{i-1} \cdot \frac{n-i+1}{i} \f$ (on the
+ * smaller of k and n-k) is used. Every intermediate value is itself a
+ * binomial coefficient; a common factor is divided out before each
+ * multiplication so that overflow is only reported when the result
+ * really exceeds 64 bits.
+ */
+std::uint64_t binomial(int n, int k);
+
+/**
+ * @brief Computes the natural logarithm of the binomial coefficient
+ *
+ * Calculates \f$ \ln\binom{n}{k} \f$ for any n, e.g. for binomial and
+ * hypergeometric log-likelihoods where \f$ \binom{n}{k} \f$ overflows.
+ *
+ * @param n Number of elements (n ≥ 0)
+ * @param k Number of chosen elements
+ * @return \f$ \ln\binom{n}{k} \f$; -infinity if k < 0 or k > n
+ *
+ * @throw std::invalid_argument if n < 0
+ *
+ * @par Example:
+ * @code
+ * double lc = mathlib::log_binomial(100000, 50000);  // 69308.7358...
+ * @endcode
+ *
+ * @par Complexity:
+ * O(1)
+ *
+ * @note For min(k, n-k) ≤ 20 the ratio product is formed directly, which
+ *       keeps the relative error near machine precision even when n is
+ *       huge. Otherwise the result is a difference of log_factorial() values
+ *       and its absolute error is about \f$ 10^{-16} \ln(n!) \f$.
+ *
+ * @see log_factorial()
+ */
+double log_binomial(int n, int k);
+
+/**
+ * @brief Writes row n of Pascal's triangle
+ *
+ * Fills out[k] = \f$ \binom{n}{k} \f$ for k = 0 ... n.
+ *
+ * @param n   Row index, 0 ≤ n ≤ BINOMIAL_TABLE_MAX
+ * @param out Output array of at least n + 1 elements
+ *
+ * @throw std::invalid_argument if n < 0
+ * @throw std::overflow_error if n > BINOMIAL_TABLE_MAX
+ *
+ * @par Complexity:
+ * O(n) - a single copy from the precomputed triangle
+ */
+void pascal_row(int n, std::uint64_t* out);
+
+/**
+ * @brief Writes row n of Pascal's triangle in double precision
+ *
+ * Works for any n. Entries that exceed the double range are +infinity.
+ *
+ * @param n   Row index (n ≥ 0)
+ * @param out Output array of at least n + 1 elements
+ *
+ * @throw std::invalid_argument if n < 0
+ *
+ * @note Rows up to BINOMIAL_TABLE_MAX are exact conversions of the
+ *       integer table; longer rows use the multiplicative recurrence from
+ *       both ends towards the centre, with a relative error of about
+ *       n/2 ulp
+ */
+void pascal_row(int n, double* out);
+
+/**
+ * @brief Computes many binomial coefficients in one pass
+ *
+ * Equivalent to `out[i] = binomial(n[i], k[i])`. Pairs inside the
+ * precomputed triangle are served by a table lookup.
+ *
+ * @param n     Array of @p count values of n
+ * @param k     Array of @p count values of k
+ * @param out   Output array of @p count coefficients
+ * @param count Number of pairs
+ *
+ * @throw std::invalid_argument if any n_i < 0
+ * @throw std::overflow_error if any coefficient does not fit in 64 bits
+ *        (elements before it are already written)
+ */
+void binomial_n(const int* n, const int* k, std::uint64_t* out, std::size_t count);
+
+/**
+ * @brief Computes many log-binomial coefficients in one pass
+ *
+ * Equivalent to `out[i] = log_binomial(n[i], k[i])`.
+ *
+ * @param n     Array of @p count values of n
+ * @param k     Array of @p count values of k
+ * @param out   Output array of @p count values
+ * @param count Number of pairs
+ *
+ * @throw std::invalid_argument if any n_i < 0
+ */
+void log_binomial_n(const int* n, const int* k, double* out, std::size_t count);
+
+}  // namespace mathlib
+
+#endif  // COMBINATORICS_H
@@ -0,0 +1,63 @@
+/**
+ * @file error.cpp
+ * @brief Implementation of status messages and the error handler
+ */
+
+#include "error.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+
+namespace mathlib {
+
+namespace {
+
+void default_handler(const char* message) {
+    std::fprintf(stderr, "mathlib: %s\n", message);
+}
+
+std::atomic<ErrorHandler> current_handler{&default_handler};
+
+template <typename Error>
+[[noreturn]] void raise_error(const Error& error) {
+#if MATHLIB_HAS_EXCEPTIONS
+    throw error;
+#else
+    detail::fail(error.what());
+#endif
+}
+
+}  // namespace
+
+const char* status_message(Status status) noexcept {
+    switch (status) {
+        case Status::Ok:
+            return "Success";
+        case Status::InvalidArgument:
+            return "Invalid argument";
+    }
+    return "Unknown status";
+}
+
+ErrorHandler set_error_handler(ErrorHandler handler) noexcept {
+    return current_handler.exchange(handler != nullptr ? handler : &default_handler);
+}
+
+namespace detail {
+
+void fail(const char* message) noexcept {
+    current_handler.load()(message);
+    std::abort();
+}
+
+void raise(const std::invalid_argument& error) { raise_error(error); }
+void raise(const std::out_of_range& error) { raise_error(error); }
+void raise(const std::overflow_error& error) { raise_error(error); }
+void raise(const std::runtime_error& error) { raise_error(error); }
+void raise(const std::system_error& error) { raise_error(error); }
+void raise(const std::bad_alloc& error) { raise_error(error); }
+
+}  // namespace detail
+
+}  // namespace mathlib
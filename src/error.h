@@ -0,0 +1,125 @@
+/**
+ * @file error.h
+ * @brief Error reporting without exceptions
+ *
+ * Functions of the library report invalid input by throwing standard
+ * exceptions. For hot loops, and for builds without exception support
+ * (`-DMATHLIB_NO_EXCEPTIONS=ON`, i.e. `-fno-exceptions`), the non-throwing
+ * `try_` variants return a Result instead:
+ *
+ * @code
+ * auto r = mathlib::try_factorial(n);
+ * if (!r) {
+ *     report(mathlib::status_message(r.status()));
+ * }
+ * double f = r.value_or(0.0);
+ * @endcode
+ *
+ * In a build without exceptions, the throwing functions call the error
+ * handler (see set_error_handler()) and then abort instead of throwing.
+ * Such builds define `MATHLIB_NO_EXCEPTIONS` for code using the library.
+ *
+ * @author Your Name
+ * @date 2026-01-05
+ * @version 1.0.0
+ */
+
+#ifndef ERROR_H
+#define ERROR_H
+
+#include <new>
+#include <stdexcept>
+#include <system_error>
+
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+/// 1 if the current translation unit is compiled with exception support
+/// (for library sources; inline code must not depend on it)
+#define MATHLIB_HAS_EXCEPTIONS 1
+#else
+#define MATHLIB_HAS_EXCEPTIONS 0
+#endif
+
+namespace mathlib {
+
+/// Outcome of a non-throwing function
+enum class Status {
+    Ok,              ///< Success
+    InvalidArgument  ///< Input outside the domain (the case std::invalid_argument is thrown for)
+};
+
+/// Human-readable description of a status
+const char* status_message(Status status) noexcept;
+
+/**
+ * @class Result
+ * @brief Value of a non-throwing function, or the reason it has none
+ *
+ * A small `std::expected`-like type: trivially copyable for trivially
+ * copyable T, and returned in registers for T = double.
+ */
+template <typename T>
+class Result {
+  public:
+    /// Successful result
+    constexpr Result(T value) noexcept : value_(value), status_(Status::Ok) {}  // NOLINT
+
+    /// Failed result; @p status must not be Status::Ok
+    constexpr Result(Status status) noexcept : value_(), status_(status) {}  // NOLINT
+
+    constexpr bool ok() const noexcept { return status_ == Status::Ok; }
+    constexpr explicit operator bool() const noexcept { return ok(); }
+    constexpr Status status() const noexcept { return status_; }
+
+    /// The value; only meaningful if ok()
+    constexpr T value() const noexcept { return value_; }
+
+    /// The value if ok(), otherwise @p fallback
+    constexpr T value_or(T fallback) const noexcept { return ok() ? value_ : fallback; }
+
+  private:
+    T value_;
+    Status status_;
+};
+
+/// Function called with the error message before aborting, in builds without exceptions
+using ErrorHandler = void (*)(const char* message);
+
+/**
+ * @brief Installs the handler called for errors in builds without exceptions
+ *
+ * The default handler prints the message to stderr. The program aborts
+ * when the handler returns; a handler may instead end the program or
+ * jump out by other means. Ignored in builds with exceptions.
+ *
+ * @param handler New handler, or nullptr for the default
+ * @return The previous handler
+ */
+ErrorHandler set_error_handler(ErrorHandler handler) noexcept;
+
+namespace detail {
+
+/// Calls the error handler, then aborts
+[[noreturn]] void fail(const char* message) noexcept;
+
+/**
+ * @brief Throws @p error, or passes its message to fail() without exceptions
+ *
+ * All errors of the library are raised through these functions, so that
+ * the library compiles with exceptions disabled. They are defined once in
+ * the library rather than inline: header templates calling them behave
+ * the same in every translation unit, whatever its own exception setting.
+ * @{
+ */
+[[noreturn]] void raise(const std::invalid_argument& error);
+[[noreturn]] void raise(const std::out_of_range& error);
+[[noreturn]] void raise(const std::overflow_error& error);
+[[noreturn]] void raise(const std::runtime_error& error);
+[[noreturn]] void raise(const std::system_error& error);
+[[noreturn]] void raise(const std::bad_alloc& error);
+/** @} */
+
+}  // namespace detail
+
+}  // namespace mathlib
+
+#endif  // ERROR_H
@@ -0,0 +1,395 @@
+/**
+ * @file expr.h
+ * @brief Expression templates for fused element-wise array operations
+ *
+ * Writing `square(T) / square(P)` with ordinary vector types evaluates
+ * each operation into a temporary array, so an expression of k operations
+ * streams the data through memory k times. With the types in this file
+ * the same expression builds a lightweight tree of nodes; the whole tree
+ * is evaluated in a single loop when it is assigned, without temporaries.
+ *
+ * @par Example:
+ * @code
+ * using namespace mathlib::expr;
+ * std::vector<double> t = ..., p = ...;
+ * Array ratio = square(view(t)) / square(view(p));  // one fused loop
+ * Array scaled = 0.5 * ratio + 1.0;                 // works on Arrays too
+ * auto lazy = square(Array(t));                     // keeps the temporary Array
+ * @endcode
+ *
+ * An expression kept with `auto` owns the Arrays it was given as rvalues,
+ * but refers to views and named Arrays, which must outlive it.
+ *
+ * @author Your Name
+ * @date 2026-01-05
+ * @version 1.0.0
+ */
+
+#ifndef EXPR_H
+#define EXPR_H
+
+#include "error.h"
+#include "parallel.h"
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace mathlib {
+
+/**
+ * @namespace mathlib::expr
+ * @brief Lazy element-wise array expressions
+ */
+namespace expr {
+
+/**
+ * @brief Base class of every expression node (CRTP)
+ *
+ * @tparam E The concrete node type, which provides `size()` and
+ *           `operator[](std::size_t)`
+ */
+template <typename E>
+struct Expr {
+    /// The concrete node
+    const E& self() const { return static_cast<const E&>(*this); }
+
+    /// Number of elements
+    std::size_t size() const { return self().size(); }
+
+    /// Value of element i (computed on demand)
+    double operator[](std::size_t i) const { return self()[i]; }
+};
+
+/**
+ * @class View
+ * @brief Non-owning leaf referring to an existing array
+ *
+ * @warning The referenced memory must outlive every expression using it
+ */
+class View : public Expr<View> {
+  public:
+    View(const double* data, std::size_t n) : data_(data), n_(n) {}
+
+    std::size_t size() const { return n_; }
+    double operator[](std::size_t i) const { return data_[i]; }
+
+  private:
+    const double* data_;
+    std::size_t n_;
+};
+
+/**
+ * @brief A scalar broadcast to every element
+ *
+ * Created implicitly when a `double` appears in an expression.
+ */
+class Scalar : public Expr<Scalar> {
+  public:
+    explicit Scalar(double value) : value_(value) {}
+
+    /// Scalars adapt to the length of the other operand
+    std::size_t size() const { return 0; }
+    double operator[](std::size_t /*i*/) const { return value_; }
+
+  private:
+    double value_;
+};
+
+/**
+ * @class Array
+ * @brief Owning array that evaluates expressions on assignment
+ *
+ * Constructing or assigning an Array from an expression runs one loop
+ * over all elements; this is the only place where memory is written.
+ */
+class Array : public Expr<Array> {
+  public:
+    Array() = default;
+
+    /// Array of n elements initialized to value
+    explicit Array(std::size_t n, double value = 0.0) : data_(n, value) {}
+
+    /// Copies the values of a vector
+    explicit Array(std::vector<double> values) : data_(std::move(values)) {}
+
+    /// Evaluates an expression
+    template <typename E>
+    Array(const Expr<E>& e) : data_(e.size()) {  // NOLINT(google-explicit-constructor)
+        assign(e);
+    }
+
+    /// Evaluates an expression into this array, resizing it if needed
+    template <typename E>
+    Array& operator=(const Expr<E>& e) {
+        if (data_.size() != e.size()) {
+            // The expression may read from this array: evaluate aside first
+            std::vector<double> result(e.size());
+            evaluate_into(e, result.data());
+            data_ = std::move(result);
+        } else {
+            assign(e);
+        }
+        return *this;
+    }
+
+    std::size_t size() const { return data_.size(); }
+    double operator[](std::size_t i) const { return data_[i]; }
+    double& operator[](std::size_t i) { return data_[i]; }
+    const double* data() const { return data_.data(); }
+    double* data() { return data_.data(); }
+
+    /// Underlying storage
+    const std::vector<double>& values() const { return data_; }
+
+  private:
+    template <typename E>
+    void assign(const Expr<E>& e) {
+        evaluate_into(e, data_.data());
+    }
+
+    template <typename E>
+    static void evaluate_into(const Expr<E>& e, double* out) {
+        const E& node = e.self();
+        const std::size_t n = node.size();
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = node[i];
+        }
+    }
+
+    std::vector<double> data_;
+};
+
+/**
+ * @class Temporary
+ * @brief Leaf that keeps an Array passed to an operator as an rvalue
+ *
+ * Stored in place of a View so that `auto e = square(Array(v));` does not
+ * refer to a destroyed array. Shared, so that copying the expression does
+ * not copy the data.
+ */
+class Temporary : public Expr<Temporary> {
+  public:
+    explicit Temporary(Array&& array) : array_(std::make_shared<const Array>(std::move(array))) {}
+
+    std::size_t size() const { return array_->size(); }
+    double operator[](std::size_t i) const { return (*array_)[i]; }
+
+  private:
+    std::shared_ptr<const Array> array_;
+};
+
+/**
+ * @brief How a node stores its operands
+ *
+ * Nodes are stored by value (they are a few pointers and scalars), except
+ * Array, which is stored as a View so that the data is not copied. An
+ * Array passed as an rvalue becomes a Temporary instead (see leaf_t).
+ */
+template <typename E>
+struct Operand {
+    using type = E;
+};
+
+template <>
+struct Operand<Array> {
+    using type = View;
+};
+
+template <typename E>
+using operand_t = typename Operand<E>::type;
+
+/// Whether T (after removing references and cv) is an expression
+template <typename T>
+inline constexpr bool is_expr_v = std::is_base_of_v<Expr<std::decay_t<T>>, std::decay_t<T>>;
+
+/// Node parameter for an operand forwarded as T&&: an rvalue Array is a Temporary
+template <typename T>
+using leaf_t = std::conditional_t<std::is_same_v<T, Array>, Temporary, std::decay_t<T>>;
+
+/// Converts an expression into its stored operand form
+template <typename E>
+operand_t<E> as_operand(const Expr<E>& e) {
+    if constexpr (std::is_same_v<E, Array>) {
+        return View(e.self().data(), e.self().size());
+    } else {
+        return e.self();
+    }
+}
+
+/// Takes ownership of an Array the caller is done with
+inline Temporary as_operand(Array&& array) {
+    return Temporary(std::move(array));
+}
+
+/**
+ * @brief Element-wise unary operation
+ *
+ * @tparam E  Operand expression
+ * @tparam Op Functor applied to each element
+ */
+template <typename E, typename Op>
+class Unary : public Expr<Unary<E, Op>> {
+  public:
+    /// @param e The operand, converted by as_operand()
+    explicit Unary(operand_t<E> e) : e_(std::move(e)) {}
+
+    std::size_t size() const { return e_.size(); }
+    double operator[](std::size_t i) const { return Op::apply(e_[i]); }
+
+  private:
+    operand_t<E> e_;
+};
+
+/**
+ * @brief Element-wise binary operation
+ *
+ * @tparam L  Left operand expression
+ * @tparam R  Right operand expression
+ * @tparam Op Functor combining two elements
+ */
+template <typename L, typename R, typename Op>
+class Binary : public Expr<Binary<L, R, Op>> {
+  public:
+    /// @param l, r The operands, converted by as_operand()
+    Binary(operand_t<L> l, operand_t<R> r) : l_(std::move(l)), r_(std::move(r)) {
+        if (l_.size() != 0 && r_.size() != 0 && l_.size() != r_.size()) {
+            mathlib::detail::raise(
+                std::invalid_argument("Expression operands have different lengths"));
+        }
+    }
+
+    std::size_t size() const { return l_.size() != 0 ? l_.size() : r_.size(); }
+    double operator[](std::size_t i) const { return Op::apply(l_[i], r_[i]); }
+
+  private:
+    operand_t<L> l_;
+    operand_t<R> r_;
+};
+
+/// Element-wise operations used by the nodes
+struct SquareOp {
+    static double apply(double x) { return x * x; }
+};
+struct NegateOp {
+    static double apply(double x) { return -x; }
+};
+struct AddOp {
+    static double apply(double a, double b) { return a + b; }
+};
+struct SubOp {
+    static double apply(double a, double b) { return a - b; }
+};
+struct MulOp {
+    static double apply(double a, double b) { return a * b; }
+};
+struct DivOp {
+    static double apply(double a, double b) { return a / b; }
+};
+
+//==============================================================================
+// Building expressions
+//==============================================================================
+
+/// Wraps raw memory as an expression leaf
+inline View view(const double* data, std::size_t n) {
+    return View(data, n);
+}
+
+/// Wraps a vector as an expression leaf
+inline View view(const std::vector<double>& v) {
+    return View(v.data(), v.size());
+}
+
+/**
+ * @brief Lazy element-wise square
+ *
+ * @see mathlib::square()
+ */
+template <typename E, typename = std::enable_if_t<is_expr_v<E>>>
+Unary<leaf_t<E>, SquareOp> square(E&& e) {
+    return Unary<leaf_t<E>, SquareOp>(as_operand(std::forward<E>(e)));
+}
+
+template <typename E, typename = std::enable_if_t<is_expr_v<E>>>
+Unary<leaf_t<E>, NegateOp> operator-(E&& e) {
+    return Unary<leaf_t<E>, NegateOp>(as_operand(std::forward<E>(e)));
+}
+
+// Declares expression-expression, expression-scalar and scalar-expression
+// overloads of a binary operator
+#define MATHLIB_EXPR_BINARY_OPERATOR(op, Functor)                                                  \
+    template <typename L, typename R, typename = std::enable_if_t<is_expr_v<L> && is_expr_v<R>>>   \
+    Binary<leaf_t<L>, leaf_t<R>, Functor> operator op(L&& l, R&& r) {                              \
+        return Binary<leaf_t<L>, leaf_t<R>, Functor>(as_operand(std::forward<L>(l)),              \
+                                                     as_operand(std::forward<R>(r)));             \
+    }                                                                                              \
+    template <typename L, typename = std::enable_if_t<is_expr_v<L>>>                               \
+    Binary<leaf_t<L>, Scalar, Functor> operator op(L&& l, double r) {                              \
+        return Binary<leaf_t<L>, Scalar, Functor>(as_operand(std::forward<L>(l)), Scalar(r));      \
+    }                                                                                              \
+    template <typename R, typename = std::enable_if_t<is_expr_v<R>>>                               \
+    Binary<Scalar, leaf_t<R>, Functor> operator op(double l, R&& r) {                              \
+        return Binary<Scalar, leaf_t<R>, Functor>(Scalar(l), as_operand(std::forward<R>(r)));      \
+    }
+
+MATHLIB_EXPR_BINARY_OPERATOR(+, AddOp)
+MATHLIB_EXPR_BINARY_OPERATOR(-, SubOp)
+MATHLIB_EXPR_BINARY_OPERATOR(*, MulOp)
+MATHLIB_EXPR_BINARY_OPERATOR(/, DivOp)
+
+#undef MATHLIB_EXPR_BINARY_OPERATOR
+
+//==============================================================================
+// Evaluation
+//==============================================================================
+
+/**
+ * @brief Evaluates an expression into caller-provided memory
+ *
+ * The loop body is the fully inlined expression tree, so the compiler
+ * sees one loop over the leaves and can vectorize it.
+ *
+ * @param e   The expression
+ * @param out Output array of e.size() elements; must not overlap any leaf
+ *            unless it is read only at the same index (e.g. `x = 2 * x`)
+ */
+template <typename E>
+void evaluate(const Expr<E>& e, double* out) {
+    const E& node = e.self();
+    const std::size_t n = node.size();
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = node[i];
+    }
+}
+
+/**
+ * @brief Evaluates an expression with the library thread pool
+ *
+ * Same as evaluate(), split into cache-sized chunks over the threads
+ * configured with set_num_threads().
+ *
+ * @param e   The expression
+ * @param out Output array of e.size() elements
+ */
+template <typename E>
+void parallel_evaluate(const Expr<E>& e, double* out) {
+    const E& node = e.self();
+    // Bytes touched per element are unknown for a general tree; count one
+    // input and one output stream
+    mathlib::parallel_for(node.size(), 2 * sizeof(double),
+                          [&node, out](std::size_t begin, std::size_t end) {
+                              for (std::size_t i = begin; i < end; ++i) {
+                                  out[i] = node[i];
+                              }
+                          });
+}
+
+}  // namespace expr
+
+}  // namespace mathlib
+
+#endif  // EXPR_H
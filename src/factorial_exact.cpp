@@ -0,0 +1,173 @@
+/**
+ * @file factorial_exact.cpp
+ * @brief Implementation of exact factorials and their cache
+ */
+
+#include "factorial_exact.h"
+#include "error.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace mathlib {
+
+namespace {
+
+/// Factors multiplied one by one at the leaves of the product tree
+constexpr std::uint64_t LEAF_FACTORS = 16;
+
+/**
+ * @brief Product of first, first + step, ..., last as a balanced tree
+ *
+ * Both halves of every node have about the same number of factors, so
+ * the two operands of each multiplication have similar sizes.
+ */
+BigUInt product(std::uint64_t first, std::uint64_t last, std::uint64_t step) {
+    const std::uint64_t count = (last - first) / step + 1;
+    if (count <= LEAF_FACTORS) {
+        BigUInt result(1);
+        for (std::uint64_t k = first; k <= last; k += step) {
+            result *= static_cast<std::uint32_t>(k);
+        }
+        return result;
+    }
+    const std::uint64_t middle = first + (count / 2) * step;
+    return product(first, middle - step, step) * product(middle, last, step);
+}
+
+/// Product of the odd numbers in (low, high]
+BigUInt odd_product(std::uint64_t low, std::uint64_t high) {
+    const std::uint64_t first = (low + 1) | 1;
+    const std::uint64_t last = (high & 1) != 0 ? high : high - 1;
+    return first <= last && high > 0 ? product(first, last, 2) : BigUInt(1);
+}
+
+std::size_t size_bytes(const BigUInt& value) {
+    return value.limbs().size() * sizeof(std::uint32_t);
+}
+
+}  // namespace
+
+BigUInt compute_factorial_exact(int n) {
+    if (n < 0) {
+        detail::raise(std::invalid_argument("Factorial of negative number is undefined"));
+    }
+    const auto m = static_cast<std::uint64_t>(n);
+
+    int top = 0;
+    while ((m >> (top + 1)) != 0) {
+        ++top;
+    }
+
+    // odd = oddprod(m >> i), grown from the smallest i-th quotient upwards
+    BigUInt odd(1);
+    BigUInt result(1);
+    for (int i = top; i >= 0; --i) {
+        odd *= odd_product(m >> (i + 1), m >> i);
+        result *= odd;
+    }
+
+    std::uint64_t ones = 0;
+    for (std::uint64_t bits = m; bits != 0; bits >>= 1) {
+        ones += bits & 1;
+    }
+    result <<= static_cast<std::size_t>(m - ones);
+    return result;
+}
+
+FactorialCache::FactorialCache(std::size_t capacity_bytes) : capacity_bytes_(capacity_bytes) {}
+
+std::shared_ptr<const BigUInt> FactorialCache::get(int n) {
+    if (n < 0) {
+        detail::raise(std::invalid_argument("Factorial of negative number is undefined"));
+    }
+
+    std::shared_ptr<const BigUInt> base;
+    int base_n = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(n);
+        if (it != entries_.end()) {
+            ++hits_;
+            lru_.splice(lru_.begin(), lru_, it->second.position);
+            return it->second.value;
+        }
+        ++misses_;
+
+        // Nearest smaller cached factorial, if close enough to be worth extending
+        it = entries_.lower_bound(n);
+        if (it != entries_.begin()) {
+            --it;
+            if (it->first >= n / 2) {
+                base = it->second.value;
+                base_n = it->first;
+            }
+        }
+    }
+
+    auto value = std::make_shared<BigUInt>(
+        base ? *base * product(static_cast<std::uint64_t>(base_n) + 1,
+                               static_cast<std::uint64_t>(n), 1)
+             : compute_factorial_exact(n));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    insert(n, value);
+    return value;
+}
+
+void FactorialCache::insert(int n, std::shared_ptr<const BigUInt> value) {
+    const std::size_t size = size_bytes(*value);
+    if (size > capacity_bytes_ || entries_.count(n) != 0) {
+        return;  // Too large, or cached by another thread meanwhile
+    }
+    evict_to(capacity_bytes_ - size);
+    lru_.push_front(n);
+    entries_.emplace(n, Entry{std::move(value), lru_.begin()});
+    bytes_ += size;
+}
+
+void FactorialCache::evict_to(std::size_t capacity_bytes) {
+    while (bytes_ > capacity_bytes && !lru_.empty()) {
+        const auto it = entries_.find(lru_.back());
+        bytes_ -= size_bytes(*it->second.value);
+        entries_.erase(it);
+        lru_.pop_back();
+    }
+}
+
+void FactorialCache::set_capacity(std::size_t capacity_bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_bytes_ = capacity_bytes;
+    evict_to(capacity_bytes);
+}
+
+void FactorialCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    lru_.clear();
+    bytes_ = 0;
+    hits_ = 0;
+    misses_ = 0;
+}
+
+FactorialCacheStats FactorialCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    FactorialCacheStats stats;
+    stats.hits = hits_;
+    stats.misses = misses_;
+    stats.entries = entries_.size();
+    stats.bytes = bytes_;
+    stats.capacity_bytes = capacity_bytes_;
+    return stats;
+}
+
+FactorialCache& factorial_cache() {
+    static FactorialCache cache;
+    return cache;
+}
+
+std::shared_ptr<const BigUInt> factorial_exact(int n) {
+    return factorial_cache().get(n);
+}
+
+}  // namespace mathlib
@@ -0,0 +1,137 @@
+/**
+ * @file factorial_exact.h
+ * @brief Exact factorials of any size, with a bounded result cache
+ *
+ * factorial() returns a double and overflows past 170!. factorial_exact()
+ * returns every digit as a BigUInt. The first request for n! costs a
+ * product-tree computation (about 0.1 s at n = 10⁵); the result is kept
+ * in a thread-safe LRU cache, so repeated requests only take a lookup, and
+ * a cached m! close below n is reused as the starting point for n!.
+ *
+ * @par Example:
+ * @code
+ * auto f = mathlib::factorial_exact(1000);  // std::shared_ptr<const BigUInt>
+ * std::cout << f->to_string().size() << " digits\n";  // 2568 digits
+ * @endcode
+ *
+ * @author Your Name
+ * @date 2026-01-05
+ * @version 1.0.0
+ */
+
+#ifndef FACTORIAL_EXACT_H
+#define FACTORIAL_EXACT_H
+
+#include "bigint.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace mathlib {
+
+/**
+ * @brief Computes n! exactly, without any caching
+ *
+ * @param n Non-negative integer
+ * @return n!
+ * @throw std::invalid_argument if n < 0
+ *
+ * @par Implementation Notes:
+ * The power of two is split off: \f$ n! = 2^{n - s(n)} \prod_{i \ge 0}
+ * \mathrm{oddprod}(\lfloor n / 2^i \rfloor) \f$, where s(n) is the number
+ * of one bits of n and oddprod(m) the product of the odd numbers up to m.
+ * The odd products are built incrementally, and each new range of odd
+ * factors is multiplied as a balanced binary tree (binary splitting), so
+ * the expensive multiplications have operands of similar size where
+ * Karatsuba pays off.
+ */
+BigUInt compute_factorial_exact(int n);
+
+/// Counters of a FactorialCache
+struct FactorialCacheStats {
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::size_t entries = 0;
+    std::size_t bytes = 0;           ///< Size of the cached results
+    std::size_t capacity_bytes = 0;  ///< Limit of bytes
+};
+
+/**
+ * @class FactorialCache
+ * @brief Thread-safe LRU cache of exact factorials, bounded in bytes
+ *
+ * Results are shared: a hit returns the cached object without copying,
+ * and it stays valid after eviction for as long as the caller holds it.
+ * Factorials are computed outside the lock, so threads requesting
+ * different n do not wait for each other; two threads missing on the
+ * same n both compute it.
+ */
+class FactorialCache {
+  public:
+    /// Default limit: 64 MiB (10⁶! takes 2.3 MB)
+    static constexpr std::size_t DEFAULT_CAPACITY = std::size_t{64} << 20;
+
+    explicit FactorialCache(std::size_t capacity_bytes = DEFAULT_CAPACITY);
+
+    FactorialCache(const FactorialCache&) = delete;
+    FactorialCache& operator=(const FactorialCache&) = delete;
+
+    /**
+     * @brief Returns n!, computing and caching it on a miss
+     *
+     * On a miss, the largest cached m! with m ≥ n / 2 is extended by the
+     * product m+1 ⋯ n instead of starting over. Results larger than the
+     * capacity are returned but not cached.
+     *
+     * @throw std::invalid_argument if n < 0
+     */
+    std::shared_ptr<const BigUInt> get(int n);
+
+    /// Changes the limit, evicting least recently used entries as needed
+    void set_capacity(std::size_t capacity_bytes);
+
+    /// Removes all entries and resets the counters
+    void clear();
+
+    FactorialCacheStats stats() const;
+
+  private:
+    struct Entry {
+        std::shared_ptr<const BigUInt> value;
+        std::list<int>::iterator position;  // In lru_
+    };
+
+    void insert(int n, std::shared_ptr<const BigUInt> value);
+    void evict_to(std::size_t capacity_bytes);
+
+    mutable std::mutex mutex_;
+    std::map<int, Entry> entries_;  // Ordered: finds the nearest smaller n
+    std::list<int> lru_;            // Most recently used first
+    std::size_t bytes_ = 0;
+    std::size_t capacity_bytes_;
+    std::uint64_t hits_ = 0;
+    std::uint64_t misses_ = 0;
+};
+
+/// The process-wide cache used by factorial_exact()
+FactorialCache& factorial_cache();
+
+/**
+ * @brief Computes n! exactly, using the process-wide cache
+ *
+ * @param n Non-negative integer
+ * @return n!, shared with the cache
+ * @throw std::invalid_argument if n < 0
+ *
+ * @see factorial() for the double approximation, log_factorial() for its
+ *      logarithm
+ */
+std::shared_ptr<const BigUInt> factorial_exact(int n);
+
+}  // namespace mathlib
+
+#endif  // FACTORIAL_EXACT_H
@@ -0,0 +1,186 @@
+/**
+ * @file instrumentation.cpp
+ * @brief Implementation of the per-thread counters and snapshots
+ */
+
+#include "instrumentation.h"
+
+#include <algorithm>
+#include <mutex>
+#include <new>
+
+namespace mathlib {
+
+namespace {
+
+/// Plain (non-atomic) totals used for sums and baselines
+using Totals = std::array<FunctionStats, INSTRUMENTED_FUNCTION_COUNT>;
+
+struct ThreadRegistration;
+
+/**
+ * @brief Counters of all live threads plus the totals of exited threads
+ *
+ * @details
+ * Intentionally leaked: thread_local destructors of threads that exit
+ * during static destruction still merge their counters into it.
+ */
+struct Registry {
+    std::mutex mutex;
+    ThreadRegistration* live = nullptr;  ///< Intrusive list: registering never allocates
+    Totals retired{};
+    Totals baseline{};
+};
+
+Registry& registry() noexcept {
+    // Constructed in static storage, so that the first instrumented call of
+    // a noexcept function cannot fail with bad_alloc
+    alignas(Registry) static unsigned char storage[sizeof(Registry)];
+    static Registry* instance = new (storage) Registry();
+    return *instance;
+}
+
+void add(FunctionStats& sum, const detail::FunctionCounters& counters) {
+    sum.calls += counters.calls.load(std::memory_order_relaxed);
+    sum.elements += counters.elements.load(std::memory_order_relaxed);
+    sum.timed_calls += counters.timed_calls.load(std::memory_order_relaxed);
+    sum.timed_ns += counters.timed_ns.load(std::memory_order_relaxed);
+    for (std::size_t b = 0; b < LATENCY_BUCKETS; ++b) {
+        sum.histogram[b] += counters.histogram[b].load(std::memory_order_relaxed);
+    }
+}
+
+/// Registers the counters of a thread on construction, retires them at thread exit
+struct ThreadRegistration {
+    detail::ThreadCounters counters;
+    ThreadRegistration* prev = nullptr;
+    ThreadRegistration* next = nullptr;
+
+    ThreadRegistration() noexcept {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        next = reg.live;
+        if (next != nullptr) {
+            next->prev = this;
+        }
+        reg.live = this;
+    }
+
+    ~ThreadRegistration() {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        for (std::size_t f = 0; f < INSTRUMENTED_FUNCTION_COUNT; ++f) {
+            add(reg.retired[f], counters[f]);
+        }
+        (prev != nullptr ? prev->next : reg.live) = next;
+        if (next != nullptr) {
+            next->prev = prev;
+        }
+    }
+
+    ThreadRegistration(const ThreadRegistration&) = delete;
+    ThreadRegistration& operator=(const ThreadRegistration&) = delete;
+};
+
+/// Totals of all threads since the program started; the caller holds the mutex
+Totals collect(const Registry& reg) {
+    Totals totals = reg.retired;
+    for (const ThreadRegistration* thread = reg.live; thread != nullptr; thread = thread->next) {
+        for (std::size_t f = 0; f < INSTRUMENTED_FUNCTION_COUNT; ++f) {
+            add(totals[f], thread->counters[f]);
+        }
+    }
+    return totals;
+}
+
+/// Histogram bucket of a latency: floor(log2(ns)), clamped to the last bucket
+std::size_t latency_bucket(std::uint64_t ns) {
+    std::size_t bucket = 0;
+    while (ns > 1 && bucket < LATENCY_BUCKETS - 1) {
+        ns >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+}  // namespace
+
+namespace detail {
+
+ThreadCounters& thread_counters() noexcept {
+    thread_local ThreadRegistration registration;
+    return registration.counters;
+}
+
+void record_latency(FunctionCounters& counters, std::uint64_t ns) {
+    bump(counters.timed_calls, 1);
+    bump(counters.timed_ns, ns);
+    bump(counters.histogram[latency_bucket(ns)], 1);
+}
+
+}  // namespace detail
+
+const char* instrumented_function_name(InstrumentedFunction function) {
+    switch (function) {
+    case InstrumentedFunction::Square:
+        return "square";
+    case InstrumentedFunction::Factorial:
+        return "factorial";
+    case InstrumentedFunction::SquareN:
+        return "square_n";
+    case InstrumentedFunction::FactorialN:
+        return "factorial_n";
+    }
+    return "unknown";
+}
+
+double FunctionStats::mean_ns() const {
+    return timed_calls == 0 ? 0.0 : static_cast<double>(timed_ns) / static_cast<double>(timed_calls);
+}
+
+double FunctionStats::percentile_ns(double p) const {
+    if (timed_calls == 0) {
+        return 0.0;
+    }
+    const auto rank = static_cast<std::uint64_t>(std::clamp(p, 0.0, 1.0) *
+                                                 static_cast<double>(timed_calls - 1)) + 1;
+    std::uint64_t seen = 0;
+    for (std::size_t b = 0; b < LATENCY_BUCKETS; ++b) {
+        seen += histogram[b];
+        if (seen >= rank) {
+            return static_cast<double>(std::uint64_t{2} << b);
+        }
+    }
+    return static_cast<double>(std::uint64_t{2} << (LATENCY_BUCKETS - 1));
+}
+
+InstrumentationSnapshot instrumentation_snapshot() {
+    InstrumentationSnapshot snapshot;
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    const Totals totals = collect(reg);
+
+    snapshot.functions.resize(INSTRUMENTED_FUNCTION_COUNT);
+    for (std::size_t f = 0; f < INSTRUMENTED_FUNCTION_COUNT; ++f) {
+        const FunctionStats& now = totals[f];
+        const FunctionStats& base = reg.baseline[f];
+        FunctionStats& stats = snapshot.functions[f];
+        stats.name = instrumented_function_name(static_cast<InstrumentedFunction>(f));
+        stats.calls = now.calls - base.calls;
+        stats.elements = now.elements - base.elements;
+        stats.timed_calls = now.timed_calls - base.timed_calls;
+        stats.timed_ns = now.timed_ns - base.timed_ns;
+        for (std::size_t b = 0; b < LATENCY_BUCKETS; ++b) {
+            stats.histogram[b] = now.histogram[b] - base.histogram[b];
+        }
+    }
+    return snapshot;
+}
+
+void reset_instrumentation() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.baseline = collect(reg);
+}
+
+}  // namespace mathlib
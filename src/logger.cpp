@@ -4,23 +4,344 @@
  */
 
 #include "logger.h"
+#include "ring_buffer.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include <spdlog/sinks/null_sink.h>
+#include <spdlog/sinks/sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 
 namespace mathlib {
 
-void Logger::init(spdlog::level::level_enum level) {
-    // Create console logger with colors
-    auto console = spdlog::stdout_color_mt("mathlib");
-    spdlog::set_default_logger(console);
+namespace {
+
+constexpr const char* LOGGER_NAME = "mathlib";
+
+// Set pattern: [timestamp] [level] message
+constexpr const char* LOG_PATTERN = "[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] %v";
+
+/**
+ * @brief Waits with increasing cost: yields first, then sleeps
+ *
+ * Short waits (a slot freed by the writer) stay responsive, while an idle
+ * writer thread backs off to about a thousand wake-ups per second.
+ */
+class Backoff {
+  public:
+    void pause() {
+        if (step_ < YIELD_STEPS) {
+            std::this_thread::yield();
+        } else {
+            const int shift = std::min(step_ - YIELD_STEPS, MAX_SLEEP_SHIFT);
+            std::this_thread::sleep_for(MIN_SLEEP * (1 << shift));
+        }
+        ++step_;
+    }
+
+    void reset() { step_ = 0; }
+
+  private:
+    static constexpr int YIELD_STEPS = 64;
+    static constexpr int MAX_SLEEP_SHIFT = 4;  // 50 us ... 800 us
+    static constexpr std::chrono::microseconds MIN_SLEEP{50};
+
+    int step_ = 0;
+};
+
+/// A formatted message waiting for the writer thread
+struct QueuedMessage {
+    spdlog::level::level_enum level = spdlog::level::off;
+    spdlog::log_clock::time_point time;
+    std::size_t thread_id = 0;
+    spdlog::memory_buf_t payload;  // Inline storage: typical messages do not allocate
+};
+
+/**
+ * @brief Sink that hands messages to a writer thread through a RingBuffer
+ *
+ * @details
+ * The logger formats the message on the calling thread (only if its level
+ * is enabled) and this sink copies the text into a queue slot. The writer
+ * thread applies the pattern and performs the I/O on the target sink.
+ */
+class AsyncRingSink final : public spdlog::sinks::sink {
+  public:
+    AsyncRingSink(spdlog::sink_ptr target, const AsyncLogOptions& options)
+        : target_(std::move(target)),
+          queue_(options.queue_size),
+          policy_(options.overflow_policy),
+          writer_([this] { writer_loop(); }) {}
+
+    ~AsyncRingSink() override { stop(); }
+
+    AsyncRingSink(const AsyncRingSink&) = delete;
+    AsyncRingSink& operator=(const AsyncRingSink&) = delete;
+
+    void log(const spdlog::details::log_msg& msg) override {
+        if (stopped_.load(std::memory_order_acquire)) {
+            target_->log(msg);
+            return;
+        }
+        QueuedMessage message;
+        message.level = msg.level;
+        message.time = msg.time;
+        message.thread_id = msg.thread_id;
+        message.payload.append(msg.payload.begin(), msg.payload.end());
+
+        // The count tells the writer thread that a message may still be
+        // pushed; it is raised before stopping_ is read (see writer_loop())
+        producers_.fetch_add(1, std::memory_order_seq_cst);
+        if (stopping_.load(std::memory_order_seq_cst)) {
+            producers_.fetch_sub(1, std::memory_order_release);
+            write_after_stop(msg);
+            return;
+        }
+        enqueue(std::move(message));
+        producers_.fetch_sub(1, std::memory_order_release);
+    }
+
+    void flush() override {
+        // Wait for everything queued before this call, then flush the output
+        const std::uint64_t target = enqueued_.load(std::memory_order_acquire);
+        Backoff backoff;
+        while (completed_.load(std::memory_order_acquire) < target &&
+               !stopped_.load(std::memory_order_acquire)) {
+            backoff.pause();
+        }
+        target_->flush();
+    }
+
+    void set_pattern(const std::string& pattern) override { target_->set_pattern(pattern); }
+
+    void set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter) override {
+        target_->set_formatter(std::move(sink_formatter));
+    }
+
+    std::uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    /// Drains the queue and joins the writer; later messages are written directly
+    void stop() {
+        if (stopping_.exchange(true, std::memory_order_seq_cst)) {
+            return;
+        }
+        writer_.join();
+        stopped_.store(true, std::memory_order_release);
+        target_->flush();
+    }
+
+  private:
+    void enqueue(QueuedMessage&& message) {
+        switch (policy_) {
+        case OverflowPolicy::Block: {
+            Backoff backoff;
+            while (!queue_.try_push(std::move(message))) {
+                backoff.pause();
+            }
+            break;
+        }
+        case OverflowPolicy::DropNewest:
+            if (!queue_.try_push(std::move(message))) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            break;
+        case OverflowPolicy::DropOldest: {
+            QueuedMessage evicted;
+            while (!queue_.try_push(std::move(message))) {
+                if (queue_.try_pop(evicted)) {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    completed_.fetch_add(1, std::memory_order_release);
+                }
+            }
+            break;
+        }
+        }
+        enqueued_.fetch_add(1, std::memory_order_release);
+    }
+
+    void writer_loop() {
+        QueuedMessage message;
+        Backoff backoff;
+        while (true) {
+            if (queue_.try_pop(message)) {
+                write(message);
+                completed_.fetch_add(1, std::memory_order_release);
+                backoff.reset();
+            } else if (stopping_.load(std::memory_order_seq_cst) &&
+                       producers_.load(std::memory_order_seq_cst) == 0) {
+                // Every producer that saw stopping_ == false has pushed its
+                // message by now, and later ones write directly
+                while (queue_.try_pop(message)) {
+                    write(message);
+                    completed_.fetch_add(1, std::memory_order_release);
+                }
+                return;
+            } else {
+                backoff.pause();
+            }
+        }
+    }
+
+    /// Writes to the target once the messages queued before are written
+    void write_after_stop(const spdlog::details::log_msg& msg) {
+        Backoff backoff;
+        while (!stopped_.load(std::memory_order_acquire)) {
+            backoff.pause();
+        }
+        target_->log(msg);
+    }
+
+    void write(const QueuedMessage& message) {
+        spdlog::details::log_msg msg(message.time, spdlog::source_loc{}, LOGGER_NAME,
+                                     message.level,
+                                     spdlog::string_view_t(message.payload.data(),
+                                                           message.payload.size()));
+        msg.thread_id = message.thread_id;
+        try {
+            target_->log(msg);
+        } catch (const std::exception& e) {
+            // A failing sink must not terminate the writer thread
+            std::fprintf(stderr, "mathlib logger: %s\n", e.what());
+        }
+    }
+
+    spdlog::sink_ptr target_;
+    RingBuffer<QueuedMessage> queue_;
+    OverflowPolicy policy_;
+    std::atomic<std::uint64_t> enqueued_{0};
+    std::atomic<std::uint64_t> completed_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+    std::atomic<std::size_t> producers_{0};  ///< Calls of log() between the check and the push
+    std::atomic<bool> stopping_{false};
+    std::atomic<bool> stopped_{false};
+    std::thread writer_;  // Last member: started after everything it uses
+};
 
-    // Set log level
+struct LoggerState {
+    std::mutex mutex;
+    std::shared_ptr<AsyncRingSink> async_sink;
+    std::unique_ptr<BinaryLogWriter> binary_log;
+};
+
+LoggerState& logger_state() {
+    static LoggerState state;
+    return state;
+}
+
+spdlog::sink_ptr default_sink() {
+    // Console logger with colors
+    return std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+}
+
+void install(spdlog::sink_ptr sink, spdlog::level::level_enum level) {
+    spdlog::set_default_logger(std::make_shared<spdlog::logger>(LOGGER_NAME, std::move(sink)));
     spdlog::set_level(level);
+    spdlog::set_pattern(LOG_PATTERN);
+}
 
-    // Set pattern: [timestamp] [level] message
-    spdlog::set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] %v");
+/// Detaches the binary log and destroys it once no Logger call still uses it
+void close_binary_log(LoggerState& state) {
+    if (!state.binary_log) {
+        return;
+    }
+    detail::active_binary_log.store(nullptr, std::memory_order_seq_cst);
+    Backoff backoff;
+    while (detail::binary_log_users.load(std::memory_order_seq_cst) != 0) {
+        backoff.pause();
+    }
+    state.binary_log.reset();
+}
+
+/// Writes out and stops a previous asynchronous or binary configuration
+void stop_outputs(LoggerState& state) {
+    if (state.async_sink) {
+        state.async_sink->stop();
+        state.async_sink.reset();
+    }
+    close_binary_log(state);
+}
+
+}  // namespace
+
+void Logger::init(spdlog::level::level_enum level, spdlog::sink_ptr sink) {
+    LoggerState& state = logger_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    stop_outputs(state);
+    install(sink ? std::move(sink) : default_sink(), level);
 
     spdlog::info("MathLib logger initialized");
 }
 
-}  // namespace mathlib
\ No newline at end of file
+void Logger::init_async(spdlog::level::level_enum level, AsyncLogOptions options,
+                        spdlog::sink_ptr sink) {
+    LoggerState& state = logger_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    stop_outputs(state);
+    auto async_sink = std::make_shared<AsyncRingSink>(sink ? std::move(sink) : default_sink(),
+                                                      options);
+    state.async_sink = async_sink;
+    install(std::move(async_sink), level);
+
+    spdlog::info("MathLib logger initialized (asynchronous, queue size {})", options.queue_size);
+}
+
+void Logger::init_binary(spdlog::level::level_enum level, const std::string& path,
+                         std::size_t capacity) {
+    LoggerState& state = logger_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    stop_outputs(state);
+    state.binary_log = std::make_unique<BinaryLogWriter>(path, capacity);
+
+    // The default logger only provides the level check
+    install(std::make_shared<spdlog::sinks::null_sink_mt>(), level);
+    detail::active_binary_log.store(state.binary_log.get(), std::memory_order_release);
+
+    Logger::info("MathLib logger initialized (binary, {})", path);
+}
+
+void Logger::flush() {
+    LoggerState& state = logger_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (state.binary_log) {
+        state.binary_log->sync();
+        return;
+    }
+    if (auto logger = spdlog::default_logger()) {
+        logger->flush();
+    }
+}
+
+void Logger::shutdown() {
+    LoggerState& state = logger_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (state.async_sink) {
+        state.async_sink->stop();
+    }
+    close_binary_log(state);
+}
+
+std::uint64_t Logger::dropped_messages() {
+    LoggerState& state = logger_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (state.binary_log) {
+        return state.binary_log->dropped();
+    }
+    return state.async_sink ? state.async_sink->dropped() : 0;
+}
+
+std::size_t Logger::binary_log_size() {
+    LoggerState& state = logger_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return state.binary_log ? state.binary_log->bytes_written() : 0;
+}
+
+}  // namespace mathlib
@@ -13,16 +13,85 @@
 #ifndef LOGGER_H
 #define LOGGER_H
 
+#include "binary_log.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 #include <spdlog/spdlog.h>
 
+/**
+ * @brief Lowest level whose Logger calls are compiled
+ *
+ * One of the `SPDLOG_LEVEL_*` values, set from the `MATHLIB_LOG_LEVEL`
+ * CMake option. Calls below it are removed at compile time. The default,
+ * `SPDLOG_LEVEL_DEBUG`, removes only trace messages.
+ */
+#ifndef MATHLIB_ACTIVE_LOG_LEVEL
+#define MATHLIB_ACTIVE_LOG_LEVEL SPDLOG_LEVEL_DEBUG
+#endif
+
 /**
  * @namespace mathlib
  * @brief Mathematical operations namespace
  */
 namespace mathlib {
 
+/**
+ * @brief What an asynchronous logger does when its queue is full
+ */
+enum class OverflowPolicy {
+    Block,       ///< The logging thread waits until the writer frees a slot (nothing is lost)
+    DropNewest,  ///< The new message is discarded
+    DropOldest   ///< The oldest queued message is discarded to make room
+};
+
+/**
+ * @brief Configuration of Logger::init_async()
+ */
+struct AsyncLogOptions {
+    /// Number of queued messages (rounded up to a power of two)
+    std::size_t queue_size = 8192;
+
+    /// Behaviour when the writer thread falls behind
+    OverflowPolicy overflow_policy = OverflowPolicy::Block;
+};
+
+namespace detail {
+
+/// Binary log that receives Logger messages, if Logger::init_binary() is active
+inline std::atomic<BinaryLogWriter*> active_binary_log{nullptr};
+
+/// Logger calls currently writing to the binary log; the writer is
+/// destroyed only once this drops to zero
+inline std::atomic<std::size_t> binary_log_users{0};
+
+/**
+ * @brief Keeps the active binary log alive while a message is written
+ *
+ * The count is raised before the pointer is re-read, so a shutdown that
+ * has cleared active_binary_log either sees this user or is seen by it.
+ */
+class BinaryLogUse {
+  public:
+    BinaryLogUse() noexcept { binary_log_users.fetch_add(1, std::memory_order_seq_cst); }
+    ~BinaryLogUse() { binary_log_users.fetch_sub(1, std::memory_order_release); }
+
+    BinaryLogUse(const BinaryLogUse&) = delete;
+    BinaryLogUse& operator=(const BinaryLogUse&) = delete;
+
+    /// The binary log, or nullptr if it was closed meanwhile
+    BinaryLogWriter* get() const noexcept {
+        return active_binary_log.load(std::memory_order_seq_cst);
+    }
+};
+
+}  // namespace detail
+
 /**
  * @class Logger
  * @brief Wrapper around spdlog for mathematical library logging
@@ -36,14 +105,145 @@ namespace mathlib {
  * Logger::warn("Large value detected: {}", 1e100);
  * Logger::error("Invalid input: {}", -1);
  * @endcode
+ *
+ * Levels below `MATHLIB_ACTIVE_LOG_LEVEL` (CMake option `MATHLIB_LOG_LEVEL`)
+ * are compiled out: the call formats and writes nothing, although its
+ * arguments are still evaluated. The MATHLIB_LOG_DEBUG() family of macros
+ * and lazy() arguments avoid that cost as well.
+ *
+ * By default every call writes to the console before returning. For
+ * logging from hot loops, init_async() moves the output to a writer
+ * thread: the calling thread only formats the message and places it in a
+ * lock-free queue. init_binary() goes further and skips formatting
+ * altogether: messages are stored as a format-string id plus raw argument
+ * bytes and rendered offline by `mathlib_logdecode`.
  */
 class Logger {
   public:
     /**
      * @brief Initialize the logger
+     *
+     * Messages are written synchronously by the calling thread. Calling
+     * init() again replaces the previous configuration.
+     *
      * @param level Logging level (trace, debug, info, warn, error, critical)
+     * @param sink  Output; defaults to the colored console
+     */
+    static void init(spdlog::level::level_enum level = spdlog::level::info,
+                     spdlog::sink_ptr sink = nullptr);
+
+    /**
+     * @brief Initialize the logger in asynchronous mode
+     *
+     * Formatted messages go into a bounded lock-free ring buffer that a
+     * dedicated thread drains into @p sink, so console or file I/O never
+     * blocks the caller (unless the queue is full and the policy is
+     * OverflowPolicy::Block). Messages below @p level are filtered before
+     * formatting. Calling init() or init_async() again drains and replaces
+     * the previous configuration.
+     *
+     * @param level   Logging level
+     * @param options Queue size and overflow policy
+     * @param sink    Output; defaults to the colored console. It is used by
+     *                the writer thread and by flush(), so it must be a
+     *                thread-safe (`_mt`) sink.
+     *
+     * @throw std::invalid_argument if options.queue_size is 0
+     *
+     * @par Example:
+     * @code
+     * mathlib::Logger::init_async(spdlog::level::info,
+     *                             {1 << 16, mathlib::OverflowPolicy::DropOldest});
+     * // ... hot loop calling Logger::info() ...
+     * mathlib::Logger::shutdown();  // writes what is still queued
+     * @endcode
+     */
+    static void init_async(spdlog::level::level_enum level = spdlog::level::info,
+                           AsyncLogOptions options = {}, spdlog::sink_ptr sink = nullptr);
+
+    /**
+     * @brief Initialize the logger in binary mode
+     *
+     * Messages are not formatted: each call appends the id of its format
+     * string, a timestamp and the raw argument values to a memory-mapped
+     * file (see binary_log.h). Render the file with
+     * `mathlib_logdecode [--json] <path>`.
+     *
+     * @param level    Logging level
+     * @param path     Output file (created or truncated)
+     * @param capacity Maximum file size; messages beyond it are dropped
+     *
+     * @throw std::system_error if the file cannot be created
+     *
+     * @par Example:
+     * @code
+     * mathlib::Logger::init_binary(spdlog::level::info, "run.mlog");
+     * mathlib::Logger::info("square({}) = {:.3f}", x, mathlib::square(x));
+     * mathlib::Logger::shutdown();  // trims the file to its contents
+     * @endcode
+     */
+    static void init_binary(spdlog::level::level_enum level, const std::string& path,
+                            std::size_t capacity = BinaryLogWriter::DEFAULT_CAPACITY);
+
+    /**
+     * @brief Waits until all queued messages are written, then flushes the sink
+     *
+     * In binary mode, writes the mapped file back to disk.
+     */
+    static void flush();
+
+    /**
+     * @brief Drains the queue and stops the writer thread
+     *
+     * Call before the end of main() in asynchronous mode. Messages logged
+     * afterwards are written synchronously. In binary mode the file is
+     * closed once calls already writing to it return, and later messages
+     * are discarded.
+     */
+    static void shutdown();
+
+    /**
+     * @brief Number of messages discarded because the queue was full
+     * @return Count since the last init_async() or init_binary() (binary
+     *         logs drop messages once the file is full); always 0 in
+     *         synchronous mode and with OverflowPolicy::Block
+     */
+    static std::uint64_t dropped_messages();
+
+    /**
+     * @brief Size of the binary log so far
+     * @return Bytes written since init_binary(); 0 in other modes
+     */
+    static std::size_t binary_log_size();
+
+    /**
+     * @brief Whether messages of @p level are compiled in
+     *
+     * False for levels below `MATHLIB_ACTIVE_LOG_LEVEL`; such calls
+     * compile to nothing.
+     */
+    static constexpr bool compiled_in(spdlog::level::level_enum level) {
+        return level >= ACTIVE_LOG_LEVEL;
+    }
+
+    /**
+     * @brief Whether a message of @p level would currently be written
+     *
+     * Combines the compile-time minimum with the runtime level.
      */
-    static void init(spdlog::level::level_enum level = spdlog::level::info);
+    static bool enabled(spdlog::level::level_enum level) {
+        return compiled_in(level) && spdlog::default_logger_raw()->should_log(level);
+    }
+
+    /**
+     * @brief Log a trace message
+     * @param format Format string (fmt library syntax)
+     * @param args Arguments to format
+     */
+    template <typename... Args>
+    static void trace(fmt::format_string<Args...> format, Args&&... args) {
+        write<spdlog::level::trace>(format, std::forward<Args>(args)...);
+    }
 
     /**
      * @brief Log an info message
@@ -52,7 +252,7 @@ class Logger {
      */
     template <typename... Args>
     static void info(fmt::format_string<Args...> format, Args&&... args) {
-        spdlog::info(format, std::forward<Args>(args)...);
+        write<spdlog::level::info>(format, std::forward<Args>(args)...);
     }
 
     /**
@@ -62,7 +262,7 @@ class Logger {
      */
     template <typename... Args>
     static void warn(fmt::format_string<Args...> format, Args&&... args) {
-        spdlog::warn(format, std::forward<Args>(args)...);
+        write<spdlog::level::warn>(format, std::forward<Args>(args)...);
     }
 
     /**
@@ -72,7 +272,7 @@ class Logger {
      */
     template <typename... Args>
     static void error(fmt::format_string<Args...> format, Args&&... args) {
-        spdlog::error(format, std::forward<Args>(args)...);
+        write<spdlog::level::err>(format, std::forward<Args>(args)...);
     }
 
     /**
@@ -82,10 +282,101 @@ class Logger {
      */
     template <typename... Args>
     static void debug(fmt::format_string<Args...> format, Args&&... args) {
-        spdlog::debug(format, std::forward<Args>(args)...);
+        write<spdlog::level::debug>(format, std::forward<Args>(args)...);
+    }
+
+  private:
+    static constexpr auto ACTIVE_LOG_LEVEL =
+        static_cast<spdlog::level::level_enum>(MATHLIB_ACTIVE_LOG_LEVEL);
+
+    template <spdlog::level::level_enum Level, typename... Args>
+    static void write([[maybe_unused]] fmt::format_string<Args...> format,
+                      [[maybe_unused]] Args&&... args) {
+        if constexpr (compiled_in(Level)) {
+            // Only binary mode pays for the reference count
+            if (detail::active_binary_log.load(std::memory_order_relaxed) != nullptr) {
+                const detail::BinaryLogUse use;
+                BinaryLogWriter* binary = use.get();
+                if (binary != nullptr && spdlog::default_logger_raw()->should_log(Level)) {
+                    binary->log(Level, fmt::string_view(format), args...);
+                }
+            } else {
+                spdlog::log(Level, format, std::forward<Args>(args)...);
+            }
+        }
     }
 };
 
+/**
+ * @brief Log argument computed only when the message is formatted
+ *
+ * Created with lazy().
+ */
+template <typename F>
+struct LazyArg {
+    F compute;
+};
+
+/**
+ * @brief Defers computing a log argument until it is needed
+ *
+ * The arguments of a Logger call are evaluated before the call, even when
+ * the message is then filtered out. Wrapping an expensive argument in
+ * lazy() postpones it to formatting time, which never happens for
+ * disabled levels.
+ *
+ * @param compute Callable returning a formattable value
+ *
+ * @par Example:
+ * @code
+ * Logger::debug("factorial({}) = {}", n, lazy([n] { return mathlib::factorial(n); }));
+ * @endcode
+ */
+template <typename F>
+LazyArg<std::decay_t<F>> lazy(F&& compute) {
+    return {std::forward<F>(compute)};
+}
+
 }  // namespace mathlib
 
-#endif  // LOGGER_H
\ No newline at end of file
+/// Formats a LazyArg like the value its callable returns
+template <typename F, typename Char>
+struct fmt::formatter<mathlib::LazyArg<F>, Char>
+    : fmt::formatter<std::decay_t<std::invoke_result_t<const F&>>, Char> {
+    template <typename FormatContext>
+    auto format(const mathlib::LazyArg<F>& arg, FormatContext& ctx) const -> decltype(ctx.out()) {
+        return fmt::formatter<std::decay_t<std::invoke_result_t<const F&>>, Char>::format(
+            arg.compute(), ctx);
+    }
+};
+
+/**
+ * @name Logging macros
+ *
+ * Unlike the Logger functions, the macros do not evaluate their arguments
+ * unless the message is written: a level below `MATHLIB_ACTIVE_LOG_LEVEL`
+ * expands to a discarded `if constexpr` branch, and a level disabled at
+ * runtime skips the call.
+ *
+ * @code
+ * MATHLIB_LOG_DEBUG("Processed value: {} -> square={}", value, mathlib::square(value));
+ * @endcode
+ * @{
+ */
+#define MATHLIB_LOG_AT(level, function, ...)                                                       \
+    do {                                                                                           \
+        if constexpr (::mathlib::Logger::compiled_in(level)) {                                     \
+            if (::mathlib::Logger::enabled(level)) {                                               \
+                ::mathlib::Logger::function(__VA_ARGS__);                                          \
+            }                                                                                      \
+        }                                                                                          \
+    } while (false)
+
+#define MATHLIB_LOG_TRACE(...) MATHLIB_LOG_AT(spdlog::level::trace, trace, __VA_ARGS__)
+#define MATHLIB_LOG_DEBUG(...) MATHLIB_LOG_AT(spdlog::level::debug, debug, __VA_ARGS__)
+#define MATHLIB_LOG_INFO(...) MATHLIB_LOG_AT(spdlog::level::info, info, __VA_ARGS__)
+#define MATHLIB_LOG_WARN(...) MATHLIB_LOG_AT(spdlog::level::warn, warn, __VA_ARGS__)
+#define MATHLIB_LOG_ERROR(...) MATHLIB_LOG_AT(spdlog::level::err, error, __VA_ARGS__)
+/** @} */
+
+#endif  // LOGGER_H
@@ -0,0 +1,294 @@
+/**
+ * @file mapped_file.cpp
+ * @brief Implementation of memory-mapped files for POSIX and Windows
+ */
+
+#include "mapped_file.h"
+#include "error.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mathlib {
+
+namespace {
+
+[[noreturn]] void raise_last_error(const std::string& what) {
+#if defined(_WIN32)
+    detail::raise(
+        std::system_error(static_cast<int>(GetLastError()), std::system_category(), what));
+#else
+    detail::raise(std::system_error(errno, std::generic_category(), what));
+#endif
+}
+
+}  // namespace
+
+#if defined(_WIN32)
+
+MappedFile MappedFile::create(const std::string& path, std::size_t size) {
+    if (size == 0) {
+        detail::raise(std::invalid_argument("Mapped file size must be positive"));
+    }
+    MappedFile file;
+    file.writable_ = true;
+    file.file_ = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                             CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file.file_ == INVALID_HANDLE_VALUE) {
+        file.file_ = nullptr;
+        raise_last_error("Cannot create " + path);
+    }
+    const auto size64 = static_cast<unsigned long long>(size);
+    file.mapping_ = CreateFileMappingA(file.file_, nullptr, PAGE_READWRITE,
+                                       static_cast<DWORD>(size64 >> 32),
+                                       static_cast<DWORD>(size64 & 0xFFFFFFFFULL), nullptr);
+    if (file.mapping_ == nullptr) {
+        raise_last_error("Cannot map " + path);
+    }
+    file.data_ = static_cast<char*>(MapViewOfFile(file.mapping_, FILE_MAP_WRITE, 0, 0, size));
+    if (file.data_ == nullptr) {
+        raise_last_error("Cannot map " + path);
+    }
+    file.size_ = size;
+    return file;
+}
+
+MappedFile MappedFile::open(const std::string& path) {
+    MappedFile file;
+    file.file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                             nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file.file_ == INVALID_HANDLE_VALUE) {
+        file.file_ = nullptr;
+        raise_last_error("Cannot open " + path);
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file.file_, &size)) {
+        raise_last_error("Cannot query the size of " + path);
+    }
+    if (size.QuadPart == 0) {
+        return file;
+    }
+    file.mapping_ = CreateFileMappingA(file.file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (file.mapping_ == nullptr) {
+        raise_last_error("Cannot map " + path);
+    }
+    file.data_ = static_cast<char*>(MapViewOfFile(file.mapping_, FILE_MAP_READ, 0, 0, 0));
+    if (file.data_ == nullptr) {
+        raise_last_error("Cannot map " + path);
+    }
+    file.size_ = static_cast<std::size_t>(size.QuadPart);
+    return file;
+}
+
+void MappedFile::sync() {
+    if (data_ != nullptr && writable_ && !FlushViewOfFile(data_, 0)) {
+        raise_last_error("Cannot write back mapped file");
+    }
+}
+
+void MappedFile::advise(MapAdvice, std::size_t, std::size_t) noexcept {
+    // Windows relies on its own read-ahead for mapped views
+}
+
+void MappedFile::close(std::size_t final_size) {
+    if (data_ != nullptr) {
+        UnmapViewOfFile(data_);
+        data_ = nullptr;
+    }
+    if (mapping_ != nullptr) {
+        CloseHandle(mapping_);
+        mapping_ = nullptr;
+    }
+    if (file_ != nullptr && writable_) {
+        LARGE_INTEGER end;
+        end.QuadPart = static_cast<LONGLONG>(final_size);
+        if (!SetFilePointerEx(file_, end, nullptr, FILE_BEGIN) || !SetEndOfFile(file_)) {
+            release();
+            raise_last_error("Cannot truncate mapped file");
+        }
+    }
+    release();
+}
+
+void MappedFile::release() noexcept {
+    if (data_ != nullptr) {
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_ != nullptr) {
+        CloseHandle(mapping_);
+    }
+    if (file_ != nullptr) {
+        CloseHandle(file_);
+    }
+    data_ = nullptr;
+    mapping_ = nullptr;
+    file_ = nullptr;
+    size_ = 0;
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      writable_(other.writable_),
+      file_(std::exchange(other.file_, nullptr)),
+      mapping_(std::exchange(other.mapping_, nullptr)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        writable_ = other.writable_;
+        file_ = std::exchange(other.file_, nullptr);
+        mapping_ = std::exchange(other.mapping_, nullptr);
+    }
+    return *this;
+}
+
+#else  // POSIX
+
+MappedFile MappedFile::create(const std::string& path, std::size_t size) {
+    if (size == 0) {
+        detail::raise(std::invalid_argument("Mapped file size must be positive"));
+    }
+    MappedFile file;
+    file.writable_ = true;
+    file.fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (file.fd_ < 0) {
+        raise_last_error("Cannot create " + path);
+    }
+    if (::ftruncate(file.fd_, static_cast<off_t>(size)) != 0) {
+        raise_last_error("Cannot resize " + path);
+    }
+    void* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file.fd_, 0);
+    if (data == MAP_FAILED) {
+        raise_last_error("Cannot map " + path);
+    }
+    file.data_ = static_cast<char*>(data);
+    file.size_ = size;
+    return file;
+}
+
+MappedFile MappedFile::open(const std::string& path) {
+    MappedFile file;
+    file.fd_ = ::open(path.c_str(), O_RDONLY);
+    if (file.fd_ < 0) {
+        raise_last_error("Cannot open " + path);
+    }
+    struct stat info {};
+    if (::fstat(file.fd_, &info) != 0) {
+        raise_last_error("Cannot query the size of " + path);
+    }
+    if (info.st_size == 0) {
+        return file;
+    }
+    const auto size = static_cast<std::size_t>(info.st_size);
+    void* data = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, file.fd_, 0);
+    if (data == MAP_FAILED) {
+        raise_last_error("Cannot map " + path);
+    }
+    file.data_ = static_cast<char*>(data);
+    file.size_ = size;
+    return file;
+}
+
+void MappedFile::sync() {
+    if (data_ != nullptr && writable_ && ::msync(data_, size_, MS_SYNC) != 0) {
+        raise_last_error("Cannot write back mapped file");
+    }
+}
+
+void MappedFile::advise(MapAdvice advice, std::size_t offset, std::size_t length) noexcept {
+    if (data_ == nullptr || offset >= size_) {
+        return;
+    }
+    length = std::min(length, size_ - offset);
+
+    // madvise() needs a page-aligned start
+    static const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const std::size_t begin = offset / page * page;
+
+    int flag = MADV_NORMAL;
+    switch (advice) {
+    case MapAdvice::Normal:
+        flag = MADV_NORMAL;
+        break;
+    case MapAdvice::Sequential:
+        flag = MADV_SEQUENTIAL;
+        break;
+    case MapAdvice::WillNeed:
+        flag = MADV_WILLNEED;
+        break;
+    case MapAdvice::DontNeed:
+        flag = MADV_DONTNEED;
+        break;
+    }
+    ::madvise(data_ + begin, offset + length - begin, flag);
+}
+
+void MappedFile::close(std::size_t final_size) {
+    if (data_ != nullptr) {
+        ::munmap(data_, size_);
+        data_ = nullptr;
+    }
+    if (fd_ >= 0 && writable_ && ::ftruncate(fd_, static_cast<off_t>(final_size)) != 0) {
+        const int error = errno;
+        release();
+        detail::raise(
+            std::system_error(error, std::generic_category(), "Cannot truncate mapped file"));
+    }
+    release();
+}
+
+void MappedFile::release() noexcept {
+    if (data_ != nullptr) {
+        ::munmap(data_, size_);
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    fd_ = -1;
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      writable_(other.writable_),
+      fd_(std::exchange(other.fd_, -1)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        writable_ = other.writable_;
+        fd_ = std::exchange(other.fd_, -1);
+    }
+    return *this;
+}
+
+#endif
+
+MappedFile::~MappedFile() {
+    release();
+}
+
+}  // namespace mathlib
@@ -0,0 +1,137 @@
+/**
+ * @file mapped_file.h
+ * @brief Portable memory-mapped files
+ *
+ * @author Your Name
+ * @date 2026-01-05
+ * @version 1.0.0
+ */
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+namespace mathlib {
+
+/// Expected access pattern of a mapped range, see MappedFile::advise()
+enum class MapAdvice {
+    Normal,      ///< No particular pattern (the default)
+    Sequential,  ///< Read ahead aggressively, free pages soon after use
+    WillNeed,    ///< Start reading the range in now
+    DontNeed     ///< Release the pages; they are read back from the file if touched
+};
+
+/**
+ * @class MappedFile
+ * @brief A file mapped into memory (mmap on POSIX, file mappings on Windows)
+ *
+ * Reading or writing the mapping reads or writes the file without system
+ * calls or copies through a user-space buffer. Move-only; the mapping is
+ * released by the destructor.
+ *
+ * @par Example:
+ * @code
+ * auto out = mathlib::MappedFile::create("data.bin", 1 << 20);
+ * std::memcpy(out.data(), bytes, n);
+ * out.close(n);  // shrink the file to the bytes actually written
+ *
+ * auto in = mathlib::MappedFile::open("data.bin");
+ * process(in.data(), in.size());
+ * @endcode
+ */
+class MappedFile {
+  public:
+    /**
+     * @brief Creates (or truncates) a file of @p size bytes, mapped read-write
+     *
+     * The new contents are zero. Pages are only allocated on disk when
+     * written, where the file system supports sparse files.
+     *
+     * @param path File to create
+     * @param size File and mapping size in bytes (> 0)
+     *
+     * @throw std::invalid_argument if size is 0
+     * @throw std::system_error if the file cannot be created or mapped
+     */
+    static MappedFile create(const std::string& path, std::size_t size);
+
+    /**
+     * @brief Maps an existing file read-only
+     *
+     * @param path File to open
+     *
+     * @throw std::system_error if the file cannot be opened or mapped
+     *
+     * @note An empty file yields a mapping with size() == 0 and
+     *       data() == nullptr
+     */
+    static MappedFile open(const std::string& path);
+
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// Start of the mapping (nullptr if nothing is mapped)
+    char* data() { return data_; }
+    const char* data() const { return data_; }
+
+    /// Mapping size in bytes
+    std::size_t size() const { return size_; }
+
+    /// Whether a file is mapped
+    bool is_open() const { return data_ != nullptr; }
+
+    /**
+     * @brief Writes modified pages back to the file
+     * @throw std::system_error on failure
+     */
+    void sync();
+
+    /**
+     * @brief Tells the OS how a range of the mapping will be used
+     *
+     * A hint only (madvise() on POSIX): the contents are unaffected,
+     * failures are ignored, and it does nothing on Windows. The range is
+     * widened to whole pages.
+     *
+     * @param advice Access pattern
+     * @param offset Start of the range in bytes
+     * @param length Length of the range in bytes, clamped to the mapping
+     */
+    void advise(MapAdvice advice, std::size_t offset = 0,
+                std::size_t length = static_cast<std::size_t>(-1)) noexcept;
+
+    /**
+     * @brief Unmaps the file, keeping only its first @p final_size bytes
+     *
+     * Used to trim a file created with create() to the bytes that were
+     * actually written.
+     *
+     * @param final_size New file size (≤ size())
+     * @throw std::system_error if the file cannot be truncated
+     */
+    void close(std::size_t final_size);
+
+  private:
+    void release() noexcept;
+
+    char* data_ = nullptr;
+    std::size_t size_ = 0;
+    bool writable_ = false;
+#if defined(_WIN32)
+    void* file_ = nullptr;
+    void* mapping_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+};
+
+}  // namespace mathlib
+
+#endif  // MAPPED_FILE_H
@@ -3,68 +3,116 @@
  * @brief Implementation of mathematical library functions
  */
 
+#include "error.h"
+#include "instrumentation.h"
 #include "mathlib.h"
 
+#include <limits>
 #include <stdexcept>
 
 namespace mathlib {
 
+#ifdef MATHLIB_ENABLE_INSTRUMENTATION
+
 /**
- * @brief Implementation of square function
- *
- * Simple multiplication: x * x
+ * @brief Implementation of square function (instrumented builds)
  *
- * @details
- * This implementation uses direct multiplication rather than pow(x, 2)
- * for efficiency. Direct multiplication is:
- * - Faster (no function call overhead)
- * - More accurate (no floating-point exponentiation)
- * - Compiler can optimize effectively
+ * Simple multiplication: x * x, counted by the instrumentation point
  */
 double square(double x) {
+    MATHLIB_INSTRUMENT(Square);
     return x * x;
 }
 
+#else
+
+namespace detail {
+
+/**
+ * @brief Keeps the out-of-line `mathlib::square(double)` symbol
+ *
+ * square(double) is inline in the header; taking its address here makes
+ * the library emit a definition for binaries compiled against the 1.0
+ * header, which call it out of line.
+ */
+extern double (*const SQUARE_SYMBOL)(double);
+double (*const SQUARE_SYMBOL)(double) = &square;
+
+}  // namespace detail
+
+#endif
+
 /**
  * @brief Implementation of factorial function
  *
- * Iterative computation from 1 to n
+ * Table lookup into detail::FACTORIAL_TABLE
  *
  * @details
- * Uses iterative approach instead of recursive for:
- * - Better performance (no stack overhead)
- * - No stack overflow risk for large n
- * - Easier to optimize by compiler
+ * The table is computed at compile time with the iterative product
+ * \f$ k! = (k-1)! \cdot k \f$, so a call costs a bounds check and a load
+ * instead of a loop of n multiplications.
  *
  * Algorithm:
  * 1. Check for negative input (throw exception)
- * 2. Handle base cases (0! = 1, 1! = 1)
- * 3. Multiply from 2 to n iteratively
+ * 2. Return infinity past the last finite entry (n > 170)
+ * 3. Load n! from the table
  *
  * @par Time Complexity:
- * O(n) where n is the input value
+ * O(1)
  *
  * @par Space Complexity:
- * O(1) - uses only constant extra space
+ * O(1) - the 171-entry table (1.3 KiB) is static read-only data
  */
 double factorial(int n) {
+    MATHLIB_INSTRUMENT(Factorial);
+
     // Input validation
     if (n < 0) {
-        throw std::invalid_argument("Factorial of negative number is undefined");
+        detail::raise(std::invalid_argument("Factorial of negative number is undefined"));
+    }
+
+    // Overflow: n! exceeds the double range
+    if (n > FACTORIAL_MAX) {
+        return std::numeric_limits<double>::infinity();
     }
 
-    // Base cases
-    if (n == 0 || n == 1) {
-        return 1.0;
+    return detail::FACTORIAL_TABLE[n];
+}
+
+Result<double> try_factorial(int n) noexcept {
+    MATHLIB_INSTRUMENT(Factorial);
+
+    if (n < 0) {
+        return Status::InvalidArgument;
     }
+    if (n > FACTORIAL_MAX) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return detail::FACTORIAL_TABLE[n];
+}
+
+float factorialf(int n) {
+    MATHLIB_INSTRUMENT(Factorial);
 
-    // Iterative computation
-    double result = 1.0;
-    for (int i = 2; i <= n; ++i) {
-        result *= i;
+    if (n < 0) {
+        detail::raise(std::invalid_argument("Factorial of negative number is undefined"));
+    }
+    if (n > FACTORIAL_MAX_FLOAT) {
+        return std::numeric_limits<float>::infinity();
     }
+    return detail::FACTORIAL_TABLE_FLOAT[n];
+}
+
+Result<float> try_factorialf(int n) noexcept {
+    MATHLIB_INSTRUMENT(Factorial);
 
-    return result;
+    if (n < 0) {
+        return Status::InvalidArgument;
+    }
+    if (n > FACTORIAL_MAX_FLOAT) {
+        return std::numeric_limits<float>::infinity();
+    }
+    return detail::FACTORIAL_TABLE_FLOAT[n];
 }
 
 }  // namespace mathlib
\ No newline at end of file
@@ -0,0 +1,252 @@
+/**
+ * @file mathlib_batch.cpp
+ * @brief Implementation of batch (array) versions of mathlib functions
+ */
+
+#include "error.h"
+#include "instrumentation.h"
+#include "mathlib.h"
+#include "simd.h"
+#include "simd_internal.h"
+
+#include <limits>
+#include <stdexcept>
+
+namespace mathlib {
+
+namespace {
+
+//==============================================================================
+// Portable kernels
+//==============================================================================
+
+template <typename T>
+void square_scalar(const T* in, T* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = in[i] * in[i];
+    }
+}
+
+//==============================================================================
+// x86 kernels
+//==============================================================================
+
+#if MATHLIB_SIMD_X86
+
+/**
+ * @brief AVX2 kernel: two 4-wide vectors per iteration
+ *
+ * @details
+ * Unrolling by two keeps both load ports busy; the scalar tail handles
+ * the last n % 8 elements.
+ */
+MATHLIB_TARGET_AVX2 void square_avx2(const double* in, double* out, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256d a = _mm256_loadu_pd(in + i);
+        const __m256d b = _mm256_loadu_pd(in + i + 4);
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(a, a));
+        _mm256_storeu_pd(out + i + 4, _mm256_mul_pd(b, b));
+    }
+    for (; i < n; ++i) {
+        out[i] = in[i] * in[i];
+    }
+}
+
+MATHLIB_TARGET_AVX2 void square_avx2(const float* in, float* out, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m256 a = _mm256_loadu_ps(in + i);
+        const __m256 b = _mm256_loadu_ps(in + i + 8);
+        _mm256_storeu_ps(out + i, _mm256_mul_ps(a, a));
+        _mm256_storeu_ps(out + i + 8, _mm256_mul_ps(b, b));
+    }
+    for (; i < n; ++i) {
+        out[i] = in[i] * in[i];
+    }
+}
+
+/**
+ * @brief AVX-512 kernel
+ *
+ * @details
+ * The tail is processed with a masked load/store instead of a scalar loop.
+ */
+MATHLIB_TARGET_AVX512 void square_avx512(const double* in, double* out, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m512d a = _mm512_loadu_pd(in + i);
+        const __m512d b = _mm512_loadu_pd(in + i + 8);
+        _mm512_storeu_pd(out + i, _mm512_mul_pd(a, a));
+        _mm512_storeu_pd(out + i + 8, _mm512_mul_pd(b, b));
+    }
+    for (; i < n; i += 8) {
+        const std::size_t left = n - i;
+        const __mmask8 mask =
+            left >= 8 ? static_cast<__mmask8>(0xFF) : static_cast<__mmask8>((1U << left) - 1U);
+        const __m512d a = _mm512_maskz_loadu_pd(mask, in + i);
+        _mm512_mask_storeu_pd(out + i, mask, _mm512_mul_pd(a, a));
+    }
+}
+
+MATHLIB_TARGET_AVX512 void square_avx512(const float* in, float* out, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m512 a = _mm512_loadu_ps(in + i);
+        const __m512 b = _mm512_loadu_ps(in + i + 16);
+        _mm512_storeu_ps(out + i, _mm512_mul_ps(a, a));
+        _mm512_storeu_ps(out + i + 16, _mm512_mul_ps(b, b));
+    }
+    for (; i < n; i += 16) {
+        const std::size_t left = n - i;
+        const __mmask16 mask = left >= 16 ? static_cast<__mmask16>(0xFFFF)
+                                          : static_cast<__mmask16>((1U << left) - 1U);
+        const __m512 a = _mm512_maskz_loadu_ps(mask, in + i);
+        _mm512_mask_storeu_ps(out + i, mask, _mm512_mul_ps(a, a));
+    }
+}
+
+#endif  // MATHLIB_SIMD_X86
+
+//==============================================================================
+// ARM kernels
+//==============================================================================
+
+#if MATHLIB_SIMD_NEON
+
+void square_neon(const double* in, double* out, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const float64x2_t a = vld1q_f64(in + i);
+        const float64x2_t b = vld1q_f64(in + i + 2);
+        vst1q_f64(out + i, vmulq_f64(a, a));
+        vst1q_f64(out + i + 2, vmulq_f64(b, b));
+    }
+    for (; i < n; ++i) {
+        out[i] = in[i] * in[i];
+    }
+}
+
+void square_neon(const float* in, float* out, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const float32x4_t a = vld1q_f32(in + i);
+        const float32x4_t b = vld1q_f32(in + i + 4);
+        vst1q_f32(out + i, vmulq_f32(a, a));
+        vst1q_f32(out + i + 4, vmulq_f32(b, b));
+    }
+    for (; i < n; ++i) {
+        out[i] = in[i] * in[i];
+    }
+}
+
+#endif  // MATHLIB_SIMD_NEON
+
+/// Dispatches to the kernel of the active instruction set
+template <typename T>
+void square_dispatch(const T* in, T* out, std::size_t n) {
+    MATHLIB_INSTRUMENT_N(SquareN, n);
+
+    switch (active_simd_isa()) {
+#if MATHLIB_SIMD_X86
+        case SimdIsa::Avx512:
+            square_avx512(in, out, n);
+            return;
+        case SimdIsa::Avx2:
+            square_avx2(in, out, n);
+            return;
+#endif
+#if MATHLIB_SIMD_NEON
+        case SimdIsa::Neon:
+            square_neon(in, out, n);
+            return;
+#endif
+        default:
+            square_scalar(in, out, n);
+            return;
+    }
+}
+
+}  // namespace
+
+void square_n(const double* in, double* out, std::size_t n) {
+    square_dispatch(in, out, n);
+}
+
+void square_n(double* data, std::size_t n) {
+    square_dispatch<double>(data, data, n);
+}
+
+void square_n(const float* in, float* out, std::size_t n) {
+    square_dispatch(in, out, n);
+}
+
+void square_n(float* data, std::size_t n) {
+    square_dispatch<float>(data, data, n);
+}
+
+void factorial_n(const int* n, double* out, std::size_t count) {
+    MATHLIB_INSTRUMENT_N(FactorialN, count);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const int k = n[i];
+        if (k < 0) {
+            detail::raise(std::invalid_argument("Factorial of negative number is undefined"));
+        }
+        out[i] = k <= FACTORIAL_MAX ? detail::FACTORIAL_TABLE[k]
+                                    : std::numeric_limits<double>::infinity();
+    }
+}
+
+std::size_t try_factorial_n(const int* n, double* out, std::uint8_t* invalid,
+                            std::size_t count) noexcept {
+    MATHLIB_INSTRUMENT_N(FactorialN, count);
+
+    std::size_t invalid_count = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const int k = n[i];
+        const bool bad = k < 0;
+        out[i] = bad                  ? std::numeric_limits<double>::quiet_NaN()
+                 : k <= FACTORIAL_MAX ? detail::FACTORIAL_TABLE[k]
+                                      : std::numeric_limits<double>::infinity();
+        if (invalid != nullptr) {
+            invalid[i] = static_cast<std::uint8_t>(bad);
+        }
+        invalid_count += static_cast<std::size_t>(bad);
+    }
+    return invalid_count;
+}
+
+void factorial_n(const int* n, float* out, std::size_t count) {
+    MATHLIB_INSTRUMENT_N(FactorialN, count);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const int k = n[i];
+        if (k < 0) {
+            detail::raise(std::invalid_argument("Factorial of negative number is undefined"));
+        }
+        out[i] = k <= FACTORIAL_MAX_FLOAT ? detail::FACTORIAL_TABLE_FLOAT[k]
+                                          : std::numeric_limits<float>::infinity();
+    }
+}
+
+std::size_t try_factorial_n(const int* n, float* out, std::uint8_t* invalid,
+                            std::size_t count) noexcept {
+    MATHLIB_INSTRUMENT_N(FactorialN, count);
+
+    std::size_t invalid_count = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const int k = n[i];
+        const bool bad = k < 0;
+        out[i] = bad                        ? std::numeric_limits<float>::quiet_NaN()
+                 : k <= FACTORIAL_MAX_FLOAT ? detail::FACTORIAL_TABLE_FLOAT[k]
+                                            : std::numeric_limits<float>::infinity();
+        if (invalid != nullptr) {
+            invalid[i] = static_cast<std::uint8_t>(bad);
+        }
+        invalid_count += static_cast<std::size_t>(bad);
+    }
+    return invalid_count;
+}
+
+}  // namespace mathlib
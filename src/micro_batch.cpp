@@ -0,0 +1,176 @@
+/**
+ * @file micro_batch.cpp
+ * @brief Implementation of the scalar request micro-batcher
+ */
+
+#include "micro_batch.h"
+#include "aligned_memory.h"
+#include "error.h"
+#include "mathlib.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+namespace mathlib {
+
+namespace {
+
+/// Source of per-thread queue assignments
+std::atomic<std::size_t> next_ticket{0};
+
+/// The calling thread's queue assignment (taken modulo the queue count)
+std::size_t thread_ticket() {
+    thread_local const std::size_t ticket = next_ticket.fetch_add(1, std::memory_order_relaxed);
+    return ticket;
+}
+
+/// Deadline checks call the clock; between them, only poll the flag
+constexpr unsigned POLLS_PER_CLOCK_CHECK = 16;
+
+}  // namespace
+
+struct MicroBatcher::Shard {
+    explicit Shard(std::size_t capacity) : queue(capacity) {}
+
+    RingBuffer<Request> queue;
+    /// Updated by flushing callers only
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> requests{0};
+    std::atomic<std::size_t> flushes{0};
+};
+
+//==============================================================================
+// Completion
+//==============================================================================
+
+double MicroBatcher::Completion::wait() {
+    unsigned polls = 0;
+    while (!ready()) {
+        if (polls++ % POLLS_PER_CLOCK_CHECK == 0 &&
+            std::chrono::steady_clock::now() >= deadline_) {
+            // Our request is queued or being evaluated by another caller;
+            // in the first case this flush delivers it
+            if (owner_->flush(shard_)) {
+                continue;
+            }
+        }
+        std::this_thread::yield();
+    }
+    return result_;
+}
+
+//==============================================================================
+// MicroBatcher
+//==============================================================================
+
+MicroBatcher::MicroBatcher(MicroBatchOptions options) : options_(options) {
+    if (options_.shards == 0) {
+        options_.shards = std::max(1U, std::thread::hardware_concurrency());
+    }
+    options_.batch_size = std::max<std::size_t>(options_.batch_size, 1);
+    options_.queue_capacity = std::max(options_.queue_capacity, options_.batch_size);
+    shards_.reserve(options_.shards);
+    for (std::size_t i = 0; i < options_.shards; ++i) {
+        shards_.push_back(std::make_unique<Shard>(options_.queue_capacity));
+    }
+}
+
+MicroBatcher::~MicroBatcher() = default;
+
+void MicroBatcher::submit_square(double x, Completion& completion) {
+    submit(Request{x, 0, Op::Square, &completion}, completion);
+}
+
+void MicroBatcher::submit_factorial(int n, Completion& completion) {
+    if (n < 0) {
+        detail::raise(std::invalid_argument("Factorial of negative number is undefined"));
+    }
+    submit(Request{0.0, n, Op::Factorial, &completion}, completion);
+}
+
+void MicroBatcher::submit(const Request& request, Completion& completion) {
+    const std::size_t shard = thread_ticket() % shards_.size();
+    completion.ready_.store(false, std::memory_order_relaxed);
+    completion.owner_ = this;
+    completion.shard_ = shard;
+    completion.deadline_ = std::chrono::steady_clock::now() + options_.deadline;
+
+    RingBuffer<Request>& queue = shards_[shard]->queue;
+    while (!queue.try_push(request)) {
+        flush(shard);  // Full: make room by evaluating what is queued
+    }
+    if (queue.size() >= options_.batch_size) {
+        flush(shard);
+    }
+}
+
+/**
+ * @details
+ * Takes up to batch_size requests off the queue, gathers the arguments of
+ * each operation into contiguous scratch arrays, runs one kernel call per
+ * operation and scatters the results to the completions. Several callers
+ * may flush the same queue at once; each takes different requests.
+ *
+ * @return false if the queue was empty
+ */
+bool MicroBatcher::flush(std::size_t shard) {
+    Shard& s = *shards_[shard];
+    ScratchArena::Scope scope(thread_scratch());
+    const std::size_t capacity = options_.batch_size;
+    Request* requests = scope.allocate<Request>(capacity);
+    std::size_t count = 0;
+    while (count < capacity && s.queue.try_pop(requests[count])) {
+        ++count;
+    }
+    if (count == 0) {
+        return false;
+    }
+
+    double* x = scope.allocate<double>(count);
+    int* n = scope.allocate<int>(count);
+    std::size_t squares = 0;
+    std::size_t factorials = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (requests[i].op == Op::Square) {
+            x[squares++] = requests[i].x;
+        } else {
+            n[factorials++] = requests[i].n;
+        }
+    }
+    double* square_out = scope.allocate<double>(squares);
+    double* factorial_out = scope.allocate<double>(factorials);
+    square_n(x, square_out, squares);
+    factorial_n(n, factorial_out, factorials);
+
+    squares = 0;
+    factorials = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        Completion& completion = *requests[i].completion;
+        completion.result_ = requests[i].op == Op::Square ? square_out[squares++]
+                                                          : factorial_out[factorials++];
+        // Last access: the waiting caller may return and destroy it
+        completion.ready_.store(true, std::memory_order_release);
+    }
+
+    s.requests.fetch_add(count, std::memory_order_relaxed);
+    s.flushes.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+std::size_t MicroBatcher::requests() const noexcept {
+    std::size_t total = 0;
+    for (const auto& shard : shards_) {
+        total += shard->requests.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+std::size_t MicroBatcher::flushes() const noexcept {
+    std::size_t total = 0;
+    for (const auto& shard : shards_) {
+        total += shard->flushes.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+}  // namespace mathlib
@@ -0,0 +1,169 @@
+/**
+ * @file micro_batch.h
+ * @brief Coalesces scalar calls from many threads into batch kernel calls
+ *
+ * Threads that each compute one value at a time cannot use the SIMD batch
+ * kernels. A MicroBatcher collects their scalar requests in per-core
+ * queues and evaluates a queue with square_n() / factorial_n() once it
+ * holds a batch, or once its oldest waiting caller's deadline has passed.
+ * There is no background thread: the caller whose request fills a batch,
+ * or whose deadline expires, runs the flush for everyone queued with it.
+ *
+ * This trades latency for throughput and only pays off when many threads
+ * issue requests concurrently and the per-value work is large enough to
+ * amortize the hand-off; for a single inline square() it never does.
+ * Measure with the BM_MicroBatch benchmarks before opting in.
+ *
+ * @par Example:
+ * @code
+ * mathlib::MicroBatcher batcher;  // shared by the worker threads
+ * double y = batcher.square(x);   // blocks until the batch ran
+ *
+ * // Or issue several requests before waiting
+ * mathlib::MicroBatcher::Completion a, b;
+ * batcher.submit_factorial(10, a);
+ * batcher.submit_factorial(20, b);
+ * double ratio = b.wait() / a.wait();
+ * @endcode
+ *
+ * @author Your Name
+ * @date 2026-01-05
+ * @version 1.0.0
+ */
+
+#ifndef MICRO_BATCH_H
+#define MICRO_BATCH_H
+
+#include "ring_buffer.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace mathlib {
+
+/// Tuning of a MicroBatcher
+struct MicroBatchOptions {
+    /// Number of queues; 0 means one per hardware thread
+    std::size_t shards = 0;
+
+    /// Queued requests at which a queue is flushed by the submitting caller
+    std::size_t batch_size = 64;
+
+    /// Longest a caller waits for a batch to fill before flushing it itself
+    std::chrono::nanoseconds deadline = std::chrono::microseconds(20);
+
+    /// Capacity of each queue; a caller finding its queue full flushes it
+    std::size_t queue_capacity = 1024;
+};
+
+/**
+ * @class MicroBatcher
+ * @brief Per-core request queues flushed through the batch kernels
+ *
+ * Each thread is assigned a queue (round-robin on its first request);
+ * queues are lock-free (RingBuffer), so callers on different queues never
+ * contend and callers on the same queue contend on a single atomic.
+ * Results are returned through a Completion owned by the caller.
+ *
+ * Thread-safe. The batcher must outlive every pending request.
+ */
+class MicroBatcher {
+  public:
+    /**
+     * @class Completion
+     * @brief Result slot of one request
+     *
+     * Lives with the caller (typically on its stack) and must stay in
+     * place until wait() has returned.
+     */
+    class Completion {
+      public:
+        Completion() = default;
+        Completion(const Completion&) = delete;
+        Completion& operator=(const Completion&) = delete;
+
+        /// Whether the result is available
+        bool ready() const noexcept { return ready_.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Waits for the result, flushing the queue past the deadline
+         * @return The result of the request
+         */
+        double wait();
+
+      private:
+        friend class MicroBatcher;
+
+        double result_ = 0.0;
+        std::atomic<bool> ready_{false};
+        MicroBatcher* owner_ = nullptr;
+        std::size_t shard_ = 0;
+        std::chrono::steady_clock::time_point deadline_;
+    };
+
+    explicit MicroBatcher(MicroBatchOptions options = {});
+    ~MicroBatcher();
+
+    MicroBatcher(const MicroBatcher&) = delete;
+    MicroBatcher& operator=(const MicroBatcher&) = delete;
+
+    /// Queues square(x); the result is delivered to @p completion
+    void submit_square(double x, Completion& completion);
+
+    /**
+     * @brief Queues factorial(n); the result is delivered to @p completion
+     * @throw std::invalid_argument if n < 0 (checked before queueing)
+     */
+    void submit_factorial(int n, Completion& completion);
+
+    /// square(x), computed in a batch
+    double square(double x) {
+        Completion completion;
+        submit_square(x, completion);
+        return completion.wait();
+    }
+
+    /**
+     * @brief factorial(n), computed in a batch
+     * @throw std::invalid_argument if n < 0
+     */
+    double factorial(int n) {
+        Completion completion;
+        submit_factorial(n, completion);
+        return completion.wait();
+    }
+
+    /// Number of queues
+    std::size_t shards() const noexcept { return shards_.size(); }
+
+    /// Requests evaluated so far
+    std::size_t requests() const noexcept;
+
+    /// Batches (kernel calls per operation) evaluated so far
+    std::size_t flushes() const noexcept;
+
+  private:
+    enum class Op : unsigned char { Square, Factorial };
+
+    struct Request {
+        double x;
+        int n;
+        Op op;
+        Completion* completion;
+    };
+
+    struct Shard;
+
+    void submit(const Request& request, Completion& completion);
+    bool flush(std::size_t shard);
+
+    MicroBatchOptions options_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+}  // namespace mathlib
+
+#endif  // MICRO_BATCH_H
@@ -0,0 +1,204 @@
+/**
+ * @file modular.cpp
+ * @brief Implementation of modular factorials and binomial coefficients
+ */
+
+#include "modular.h"
+#include "error.h"
+
+#include <stdexcept>
+
+namespace mathlib {
+
+namespace {
+
+/// Bases making Miller-Rabin deterministic for all 64-bit integers
+constexpr std::uint64_t PRIME_TEST_BASES[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+
+/// Montgomery form of x - 1 for the Montgomery form x
+std::uint64_t decrement(const Montgomery& mont, std::uint64_t x) {
+    return x >= mont.one() ? x - mont.one() : x + (mont.modulus() - mont.one());
+}
+
+/// Deterministic Miller-Rabin test of the (odd, > 1) modulus of @p mont
+bool is_prime(const Montgomery& mont) {
+    const std::uint64_t p = mont.modulus();
+    for (const std::uint64_t base : PRIME_TEST_BASES) {
+        if (p == base) {
+            return true;
+        }
+        if (p % base == 0) {
+            return false;
+        }
+    }
+
+    std::uint64_t d = p - 1;
+    int s = 0;
+    while ((d & 1) == 0) {
+        d >>= 1;
+        ++s;
+    }
+    const std::uint64_t minus_one = p - mont.one();
+    for (const std::uint64_t base : PRIME_TEST_BASES) {
+        std::uint64_t x = mont.pow(mont.to_montgomery(base), d);
+        if (x == mont.one() || x == minus_one) {
+            continue;
+        }
+        bool witness = true;
+        for (int r = 1; r < s && witness; ++r) {
+            x = mont.mul(x, x);
+            witness = x != minus_one;
+        }
+        if (witness) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// a * b mod m by shift-and-add, for even m (m < 2^63, a, b < m)
+std::uint64_t mul_mod_slow(std::uint64_t a, std::uint64_t b, std::uint64_t m) {
+    std::uint64_t result = 0;
+    while (b != 0) {
+        if ((b & 1) != 0) {
+            result += a;
+            result = result >= m ? result - m : result;
+        }
+        a += a;
+        a = a >= m ? a - m : a;
+        b >>= 1;
+    }
+    return result;
+}
+
+}  // namespace
+
+//==============================================================================
+// Montgomery
+//==============================================================================
+
+Montgomery::Montgomery(std::uint64_t modulus) : p_(modulus) {
+    if (modulus < 3 || (modulus & 1) == 0 || modulus > MODULUS_MAX) {
+        detail::raise(std::invalid_argument("Montgomery modulus must be odd and in [3, 2^63)"));
+    }
+
+    // Newton's iteration doubles the number of correct low bits; p is its
+    // own inverse modulo 8, so five steps reach 96 > 64 bits
+    std::uint64_t inv = p_;
+    for (int i = 0; i < 5; ++i) {
+        inv *= 2 - p_ * inv;
+    }
+    neg_inv_ = 0 - inv;
+
+    one_ = (0 - p_) % p_;  // 2^64 mod p
+    r2_ = one_;
+    for (int i = 0; i < 64; ++i) {
+        r2_ = add(r2_, r2_);
+    }
+}
+
+std::uint64_t Montgomery::pow(std::uint64_t x, std::uint64_t e) const noexcept {
+    std::uint64_t result = one_;
+    while (e != 0) {
+        if ((e & 1) != 0) {
+            result = mul(result, x);
+        }
+        x = mul(x, x);
+        e >>= 1;
+    }
+    return result;
+}
+
+//==============================================================================
+// Factorials
+//==============================================================================
+
+std::uint64_t factorial_mod(int n, std::uint64_t m) {
+    if (n < 0) {
+        detail::raise(std::invalid_argument("Factorial of negative number is undefined"));
+    }
+    if (m == 0 || m > Montgomery::MODULUS_MAX) {
+        detail::raise(std::invalid_argument("Factorial modulus must be in [1, 2^63)"));
+    }
+    if (static_cast<std::uint64_t>(n) >= m) {
+        return 0;
+    }
+    if (m < 3) {
+        return 1 % m;  // n < m ≤ 2: n! = 1
+    }
+
+    if ((m & 1) == 0) {
+        std::uint64_t result = 1;
+        for (int i = 2; i <= n; ++i) {
+            result = mul_mod_slow(result, static_cast<std::uint64_t>(i), m);
+        }
+        return result;
+    }
+
+    // Four interleaved products hide the latency of the multiplications;
+    // v[j] steps through the Montgomery forms of j + 1, j + 5, ...
+    const Montgomery mont(m);
+    const std::uint64_t four = mont.to_montgomery(4);
+    std::uint64_t acc[4] = {mont.one(), mont.one(), mont.one(), mont.one()};
+    std::uint64_t v[4] = {mont.one(), mont.to_montgomery(2), mont.to_montgomery(3), four};
+    int i = 1;
+    for (; i + 3 <= n; i += 4) {
+        for (int j = 0; j < 4; ++j) {
+            acc[j] = mont.mul(acc[j], v[j]);
+            v[j] = mont.add(v[j], four);
+        }
+    }
+    for (int j = 0; i + j <= n; ++j) {
+        acc[j] = mont.mul(acc[j], v[j]);
+    }
+    return mont.from_montgomery(mont.mul(mont.mul(acc[0], acc[1]), mont.mul(acc[2], acc[3])));
+}
+
+ModularFactorials::ModularFactorials(int max_n, std::uint64_t p) : mont_(p) {
+    if (max_n < 0) {
+        detail::raise(std::invalid_argument("Modular factorial table size must be non-negative"));
+    }
+    if (p <= static_cast<std::uint64_t>(max_n) || !is_prime(mont_)) {
+        detail::raise(
+            std::invalid_argument("Modular factorial tables need a prime modulus above max_n"));
+    }
+
+    const auto size = static_cast<std::size_t>(max_n) + 1;
+    factorial_.resize(size);
+    inverse_.resize(size);
+
+    // Montgomery forms first: k! upwards, then (k!)^-1 downwards from a
+    // single Fermat inversion of (max_n)!
+    std::uint64_t k = 0;  // Montgomery form of the current k
+    factorial_[0] = mont_.one();
+    for (std::size_t i = 1; i < size; ++i) {
+        k = mont_.add(k, mont_.one());
+        factorial_[i] = mont_.mul(factorial_[i - 1], k);
+    }
+    inverse_[size - 1] = mont_.pow(factorial_[size - 1], p - 2);
+    for (std::size_t i = size - 1; i > 0; --i) {
+        inverse_[i - 1] = mont_.mul(inverse_[i], k);
+        k = decrement(mont_, k);
+    }
+
+    // Stored forms: k! R^2 (two reductions in binomial() leave the value)
+    // and plain (k!)^-1
+    const std::uint64_t r2 = mont_.to_montgomery(mont_.one());
+    for (std::size_t i = 0; i < size; ++i) {
+        factorial_[i] = mont_.mul(factorial_[i], r2);
+        inverse_[i] = mont_.from_montgomery(inverse_[i]);
+    }
+}
+
+void ModularFactorials::binomial_n(const int* n, const int* k, std::uint64_t* out,
+                                   std::size_t count) const {
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = binomial(n[i], k[i]);
+    }
+}
+
+void ModularFactorials::out_of_range() {
+    detail::raise(std::out_of_range("Modular factorial table index out of range"));
+}
+
+}  // namespace mathlib
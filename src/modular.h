@@ -0,0 +1,237 @@
+/**
+ * @file modular.h
+ * @brief Factorials and binomial coefficients modulo a 64-bit integer
+ *
+ * Hashing and counting code needs \f$ n! \bmod p \f$ and
+ * \f$ \binom{n}{k} \bmod p \f$ for n far beyond the 64-bit range of n!.
+ * The products are reduced with Montgomery multiplication, which replaces
+ * the 128-by-64-bit division of `a * b % p` by two multiplications and
+ * a conditional subtraction.
+ *
+ * @par Example:
+ * @code
+ * constexpr std::uint64_t P = 1000000007;
+ * std::uint64_t f = mathlib::factorial_mod(100000, P);
+ *
+ * mathlib::ModularFactorials table(1000000, P);  // O(N) once, 16 bytes per entry
+ * std::uint64_t c = table.binomial(1000000, 500000);  // O(1)
+ * @endcode
+ *
+ * @author Your Name
+ * @date 2026-01-05
+ * @version 1.0.0
+ */
+
+#ifndef MODULAR_H
+#define MODULAR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace mathlib {
+
+namespace detail {
+
+#if defined(__SIZEOF_INT128__)
+/// Compiler-provided 128-bit integer (`__extension__` keeps -Wpedantic quiet)
+__extension__ typedef unsigned __int128 u128;
+#endif
+
+/// Full 128-bit product of a and b as (hi, lo)
+inline void mul_wide(std::uint64_t a, std::uint64_t b, std::uint64_t& hi, std::uint64_t& lo) {
+#if defined(__SIZEOF_INT128__)
+    const u128 product = static_cast<u128>(a) * b;
+    hi = static_cast<std::uint64_t>(product >> 64);
+    lo = static_cast<std::uint64_t>(product);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    lo = _umul128(a, b, &hi);
+#else
+    const std::uint64_t a_lo = a & 0xffffffffU;
+    const std::uint64_t a_hi = a >> 32;
+    const std::uint64_t b_lo = b & 0xffffffffU;
+    const std::uint64_t b_hi = b >> 32;
+    const std::uint64_t ll = a_lo * b_lo;
+    const std::uint64_t lh = a_lo * b_hi;
+    const std::uint64_t hl = a_hi * b_lo;
+    const std::uint64_t mid = (ll >> 32) + (lh & 0xffffffffU) + (hl & 0xffffffffU);
+    hi = a_hi * b_hi + (lh >> 32) + (hl >> 32) + (mid >> 32);
+    lo = (mid << 32) | (ll & 0xffffffffU);
+#endif
+}
+
+}  // namespace detail
+
+/**
+ * @class Montgomery
+ * @brief Arithmetic modulo an odd 64-bit modulus in Montgomery form
+ *
+ * A residue a is represented as \f$ aR \bmod p \f$ with \f$ R = 2^{64} \f$.
+ * mul() computes \f$ xyR^{-1} \bmod p \f$, so the product of two
+ * Montgomery forms is again a Montgomery form; additions work on the
+ * forms unchanged. Convert with to_montgomery() / from_montgomery() at
+ * the boundaries only.
+ */
+class Montgomery {
+  public:
+    /// Largest supported modulus (keeps sums of two residues below 2^64)
+    static constexpr std::uint64_t MODULUS_MAX = (std::uint64_t{1} << 63) - 1;
+
+    /**
+     * @brief Prepares arithmetic modulo @p modulus
+     * @throw std::invalid_argument unless modulus is odd, > 1 and
+     *        ≤ MODULUS_MAX
+     */
+    explicit Montgomery(std::uint64_t modulus);
+
+    std::uint64_t modulus() const noexcept { return p_; }
+
+    /// Montgomery form of 1
+    std::uint64_t one() const noexcept { return one_; }
+
+    /// Montgomery form of @p a (any 64-bit value)
+    std::uint64_t to_montgomery(std::uint64_t a) const noexcept { return mul(a % p_, r2_); }
+
+    /// Residue in [0, p) of the Montgomery form @p a
+    std::uint64_t from_montgomery(std::uint64_t a) const noexcept { return reduce(0, a); }
+
+    /// \f$ xyR^{-1} \bmod p \f$ for x, y < p
+    std::uint64_t mul(std::uint64_t x, std::uint64_t y) const noexcept {
+        std::uint64_t hi;
+        std::uint64_t lo;
+        detail::mul_wide(x, y, hi, lo);
+        return reduce(hi, lo);
+    }
+
+    /// (x + y) mod p for x, y < p
+    std::uint64_t add(std::uint64_t x, std::uint64_t y) const noexcept {
+        const std::uint64_t sum = x + y;
+        return sum >= p_ ? sum - p_ : sum;
+    }
+
+    /// \f$ x^e \f$ for a Montgomery form x; the result is a Montgomery form
+    std::uint64_t pow(std::uint64_t x, std::uint64_t e) const noexcept;
+
+  private:
+    /// REDC: \f$ TR^{-1} \bmod p \f$ for \f$ T = hi \cdot 2^{64} + lo < pR \f$
+    std::uint64_t reduce(std::uint64_t hi, std::uint64_t lo) const noexcept {
+        std::uint64_t mp_hi;
+        std::uint64_t mp_lo;
+        detail::mul_wide(lo * neg_inv_, p_, mp_hi, mp_lo);
+        // lo + mp_lo is 0 mod 2^64 by construction: it carries unless lo == 0
+        const std::uint64_t t = hi + mp_hi + (lo != 0 ? 1 : 0);
+        return t >= p_ ? t - p_ : t;
+    }
+
+    std::uint64_t p_;
+    std::uint64_t neg_inv_;  ///< \f$ -p^{-1} \bmod 2^{64} \f$
+    std::uint64_t one_;      ///< \f$ R \bmod p \f$
+    std::uint64_t r2_;       ///< \f$ R^2 \bmod p \f$
+};
+
+/**
+ * @brief Computes \f$ n! \bmod m \f$
+ *
+ * @param n Non-negative integer
+ * @param m Modulus (m ≥ 1, any m up to Montgomery::MODULUS_MAX)
+ * @return n! mod m; 0 whenever n ≥ m, since m then divides n!
+ *
+ * @throw std::invalid_argument if n < 0, m == 0 or m > Montgomery::MODULUS_MAX
+ *
+ * @par Complexity:
+ * O(min(n, m)) Montgomery multiplications, in four independent chains.
+ * Even moduli fall back to shift-and-add multiplication, about 20 times
+ * slower. For many queries against one prime, use ModularFactorials.
+ */
+std::uint64_t factorial_mod(int n, std::uint64_t m);
+
+/**
+ * @class ModularFactorials
+ * @brief Tables of \f$ k! \f$ and \f$ (k!)^{-1} \bmod p \f$ for O(1) queries
+ *
+ * Built in O(N) multiplications plus one modular exponentiation. Each
+ * binomial() is then two Montgomery multiplications: the factorials are
+ * stored pre-multiplied by \f$ R^2 \f$, which the two reductions remove.
+ * Memory: 16 (N + 1) bytes.
+ */
+class ModularFactorials {
+  public:
+    /**
+     * @brief Builds the tables for 0 ... max_n modulo the prime @p p
+     *
+     * @param max_n Largest n that will be queried (≥ 0)
+     * @param p     Prime with max_n < p ≤ Montgomery::MODULUS_MAX
+     *
+     * @throw std::invalid_argument if max_n < 0, p is not an odd prime,
+     *        p > Montgomery::MODULUS_MAX or p ≤ max_n (k! would not be
+     *        invertible)
+     */
+    ModularFactorials(int max_n, std::uint64_t p);
+
+    int max_n() const noexcept { return static_cast<int>(inverse_.size()) - 1; }
+    std::uint64_t modulus() const noexcept { return mont_.modulus(); }
+
+    /// Bytes held by the tables
+    std::size_t memory_bytes() const noexcept {
+        return (factorial_.capacity() + inverse_.capacity()) * sizeof(std::uint64_t);
+    }
+
+    /**
+     * @brief n! mod p
+     * @throw std::out_of_range unless 0 ≤ n ≤ max_n()
+     */
+    std::uint64_t factorial(int n) const {
+        check(n);
+        return mont_.from_montgomery(mont_.from_montgomery(factorial_[n]));
+    }
+
+    /**
+     * @brief \f$ (n!)^{-1} \bmod p \f$
+     * @throw std::out_of_range unless 0 ≤ n ≤ max_n()
+     */
+    std::uint64_t inverse_factorial(int n) const {
+        check(n);
+        return inverse_[n];
+    }
+
+    /**
+     * @brief \f$ \binom{n}{k} \bmod p \f$
+     * @return 0 if k < 0 or k > n
+     * @throw std::out_of_range unless 0 ≤ n ≤ max_n()
+     */
+    std::uint64_t binomial(int n, int k) const {
+        check(n);
+        if (k < 0 || k > n) {
+            return 0;
+        }
+        return mont_.mul(mont_.mul(factorial_[n], inverse_[k]), inverse_[n - k]);
+    }
+
+    /**
+     * @brief Batch binomial(): `out[i] = binomial(n[i], k[i])`
+     * @throw std::out_of_range if any n_i is outside [0, max_n()]
+     *        (elements before it are already written)
+     */
+    void binomial_n(const int* n, const int* k, std::uint64_t* out, std::size_t count) const;
+
+  private:
+    void check(int n) const {
+        if (n < 0 || n > max_n()) {
+            out_of_range();
+        }
+    }
+
+    [[noreturn]] static void out_of_range();
+
+    Montgomery mont_;
+    std::vector<std::uint64_t> factorial_;  ///< \f$ k! R^2 \bmod p \f$
+    std::vector<std::uint64_t> inverse_;    ///< \f$ (k!)^{-1} \bmod p \f$
+};
+
+}  // namespace mathlib
+
+#endif  // MODULAR_H
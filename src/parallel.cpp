@@ -0,0 +1,328 @@
+/**
+ * @file parallel.cpp
+ * @brief Implementation of the thread pool and parallel batch operations
+ */
+
+#include "error.h"
+#include "mathlib.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <utility>
+
+#if defined(__APPLE__)
+#include <sys/sysctl.h>
+#elif defined(__unix__)
+#include <unistd.h>
+#endif
+
+namespace mathlib {
+
+namespace {
+
+/// Pool and worker index of the current thread (null outside workers)
+thread_local const ThreadPool* tls_pool = nullptr;
+thread_local std::size_t tls_index = 0;
+
+/// Fallback when the L2 size cannot be queried
+constexpr std::size_t DEFAULT_L2_BYTES = 256 * 1024;
+
+/// Below this many bytes per chunk the scheduling overhead dominates
+constexpr std::size_t MIN_CHUNK_BYTES = 64 * 1024;
+
+/// Each thread should receive at least this many chunks for load balance
+constexpr std::size_t CHUNKS_PER_THREAD = 4;
+
+std::size_t l2_cache_bytes() {
+    static const std::size_t bytes = [] {
+        long size = 0;
+#if defined(__APPLE__)
+        std::size_t len = sizeof(size);
+        if (sysctlbyname("hw.l2cachesize", &size, &len, nullptr, 0) != 0) {
+            size = 0;
+        }
+#elif defined(_SC_LEVEL2_CACHE_SIZE)
+        size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+#endif
+        return size > 0 ? static_cast<std::size_t>(size) : DEFAULT_L2_BYTES;
+    }();
+    return bytes;
+}
+
+unsigned default_num_threads() {
+    if (const char* env = std::getenv("MATHLIB_NUM_THREADS")) {
+        const long value = std::strtol(env, nullptr, 10);
+        if (value > 0) {
+            return static_cast<unsigned>(value);
+        }
+    }
+    return std::max(1U, std::thread::hardware_concurrency());
+}
+
+struct GlobalPool {
+    std::mutex mutex;
+    std::shared_ptr<ThreadPool> pool;
+};
+
+GlobalPool& global_pool() {
+    static GlobalPool global;
+    return global;
+}
+
+/// Completion tracking shared by the chunks of one parallel_for()
+struct LoopState {
+    explicit LoopState(std::size_t chunks) : remaining(chunks) {}
+
+    std::atomic<std::size_t> remaining;
+    std::mutex mutex;
+    std::condition_variable done;
+    std::exception_ptr error;
+
+    void run(const ThreadPool::RangeBody& body, std::size_t begin, std::size_t end) {
+#if MATHLIB_HAS_EXCEPTIONS
+        try {
+            body(begin, end);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+#else
+        body(begin, end);
+#endif
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(mutex);
+            done.notify_all();
+        }
+    }
+};
+
+}  // namespace
+
+//==============================================================================
+// ThreadPool
+//==============================================================================
+
+ThreadPool::ThreadPool(unsigned num_threads) {
+    const unsigned workers = num_threads > 1 ? num_threads - 1 : 0;
+    queues_.reserve(workers);
+    for (unsigned i = 0; i < workers; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+    workers_.reserve(workers);
+    for (unsigned i = 0; i < workers; ++i) {
+        workers_.emplace_back([this, i] { worker_loop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stop_ = true;
+    }
+    sleep_cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::submit(Task task) {
+    if (queues_.empty()) {
+        task();
+        return;
+    }
+
+    const std::size_t index = tls_pool == this
+                                  ? tls_index
+                                  : next_queue_.fetch_add(1, std::memory_order_relaxed) %
+                                        queues_.size();
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        queues_[index]->tasks.push_back(std::move(task));
+    }
+    queued_.fetch_add(1, std::memory_order_release);
+
+    // Taking the mutex orders this notification after a worker that just
+    // found no work has started waiting, so the wake-up cannot be lost
+    { std::lock_guard<std::mutex> lock(sleep_mutex_); }
+    sleep_cv_.notify_one();
+}
+
+/**
+ * @brief Takes one task: own queue first (LIFO), then steals (FIFO)
+ *
+ * @details
+ * Popping the newest task from the own queue keeps recently touched data
+ * in cache; stealing the oldest task from another queue takes the work
+ * its owner is least likely to reach soon.
+ */
+bool ThreadPool::try_pop(std::size_t preferred, Task& task) {
+    if (queued_.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+
+    const std::size_t count = queues_.size();
+    if (preferred < count) {
+        Queue& own = *queues_[preferred];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    for (std::size_t offset = 1; offset <= count; ++offset) {
+        Queue& victim = *queues_[(preferred + offset) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::run_one(std::size_t preferred) {
+    Task task;
+    if (!try_pop(preferred, task)) {
+        return false;
+    }
+    task();
+    return true;
+}
+
+void ThreadPool::worker_loop(std::size_t index) {
+    tls_pool = this;
+    tls_index = index;
+
+    while (true) {
+        if (run_one(index)) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        sleep_cv_.wait(lock, [this] { return stop_ || queued_.load() > 0; });
+        if (stop_ && queued_.load() == 0) {
+            return;
+        }
+    }
+}
+
+void ThreadPool::parallel_for(std::size_t begin, std::size_t end, std::size_t grain,
+                              const RangeBody& body) {
+    if (end <= begin) {
+        return;
+    }
+    grain = std::max<std::size_t>(grain, 1);
+    const std::size_t chunks = (end - begin + grain - 1) / grain;
+
+    if (chunks == 1 || queues_.empty()) {
+        for (std::size_t b = begin; b < end; b += grain) {
+            body(b, std::min(b + grain, end));
+        }
+        return;
+    }
+
+    // Chunks 1 ... n-1 go to the workers, chunk 0 runs here
+    auto state = std::make_shared<LoopState>(chunks);
+    for (std::size_t c = 1; c < chunks; ++c) {
+        const std::size_t b = begin + c * grain;
+        const std::size_t e = std::min(b + grain, end);
+        submit([state, &body, b, e] { state->run(body, b, e); });
+    }
+    state->run(body, begin, std::min(begin + grain, end));
+
+    // Help with queued work instead of blocking
+    const std::size_t preferred = tls_pool == this ? tls_index : queues_.size();
+    while (state->remaining.load(std::memory_order_acquire) > 0) {
+        if (!run_one(preferred)) {
+            std::unique_lock<std::mutex> lock(state->mutex);
+            state->done.wait(lock, [&] { return state->remaining.load() == 0; });
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(state->mutex);
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+//==============================================================================
+// Library-wide pool
+//==============================================================================
+
+void set_num_threads(unsigned num_threads) {
+    auto pool = std::make_shared<ThreadPool>(num_threads == 0 ? default_num_threads()
+                                                              : num_threads);
+    std::shared_ptr<ThreadPool> previous;
+    {
+        GlobalPool& global = global_pool();
+        std::lock_guard<std::mutex> lock(global.mutex);
+        previous = std::exchange(global.pool, std::move(pool));
+    }
+    // The previous pool is destroyed here, or by the last thread using it
+}
+
+std::shared_ptr<ThreadPool> default_thread_pool() {
+    GlobalPool& global = global_pool();
+    std::lock_guard<std::mutex> lock(global.mutex);
+    if (!global.pool) {
+        global.pool = std::make_shared<ThreadPool>(default_num_threads());
+    }
+    return global.pool;
+}
+
+unsigned get_num_threads() {
+    return default_thread_pool()->num_threads();
+}
+
+std::size_t parallel_grain(std::size_t n, std::size_t bytes_per_element, unsigned num_threads) {
+    bytes_per_element = std::max<std::size_t>(bytes_per_element, 1);
+    const std::size_t cache_grain = std::max<std::size_t>(l2_cache_bytes() / 2 / bytes_per_element, 1);
+    const std::size_t min_grain = std::max<std::size_t>(MIN_CHUNK_BYTES / bytes_per_element, 1);
+    const std::size_t balance_grain = n / (std::max(num_threads, 1U) * CHUNKS_PER_THREAD);
+    return std::max(std::min(cache_grain, balance_grain), std::min(min_grain, cache_grain));
+}
+
+void parallel_for(std::size_t n, std::size_t bytes_per_element,
+                  const ThreadPool::RangeBody& body) {
+    const auto pool = default_thread_pool();
+    const std::size_t grain = parallel_grain(n, bytes_per_element, pool->num_threads());
+    pool->parallel_for(0, n, grain, body);
+}
+
+//==============================================================================
+// Parallel batch operations
+//==============================================================================
+
+void parallel_square_n(const double* in, double* out, std::size_t n) {
+    parallel_for(n, 2 * sizeof(double), [in, out](std::size_t begin, std::size_t end) {
+        square_n(in + begin, out + begin, end - begin);
+    });
+}
+
+void parallel_square_n(const float* in, float* out, std::size_t n) {
+    parallel_for(n, 2 * sizeof(float), [in, out](std::size_t begin, std::size_t end) {
+        square_n(in + begin, out + begin, end - begin);
+    });
+}
+
+void parallel_factorial_n(const int* n, double* out, std::size_t count) {
+    parallel_for(count, sizeof(int) + sizeof(double), [n, out](std::size_t begin, std::size_t end) {
+        factorial_n(n + begin, out + begin, end - begin);
+    });
+}
+
+void parallel_factorial_n(const int* n, float* out, std::size_t count) {
+    parallel_for(count, sizeof(int) + sizeof(float), [n, out](std::size_t begin, std::size_t end) {
+        factorial_n(n + begin, out + begin, end - begin);
+    });
+}
+
+}  // namespace mathlib
@@ -0,0 +1,265 @@
+/**
+ * @file parallel.h
+ * @brief Work-stealing thread pool and multithreaded batch operations
+ *
+ * The batch functions in mathlib.h run on the calling thread. For arrays
+ * with millions of elements the functions in this file split the work
+ * into cache-sized chunks and spread them over a pool of worker threads.
+ *
+ * The number of threads is configured once for the whole library with
+ * set_num_threads() or the `MATHLIB_NUM_THREADS` environment variable;
+ * the default is the number of hardware threads.
+ *
+ * @author Your Name
+ * @date 2026-01-05
+ * @version 1.0.0
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mathlib {
+
+/**
+ * @class ThreadPool
+ * @brief Fixed-size pool of worker threads with per-worker task queues
+ *
+ * Each worker owns a double-ended queue. A worker pops tasks from the back
+ * of its own queue and, when that is empty, steals from the front of the
+ * other queues, so uneven chunks balance themselves without a central
+ * queue becoming a bottleneck. Threads that wait for a parallel_for()
+ * help executing queued tasks, which also makes nested parallel loops
+ * safe.
+ *
+ * @par Example:
+ * @code
+ * mathlib::ThreadPool pool(4);
+ * pool.parallel_for(0, n, 4096, [&](std::size_t begin, std::size_t end) {
+ *     for (std::size_t i = begin; i < end; ++i) {
+ *         out[i] = f(in[i]);
+ *     }
+ * });
+ * @endcode
+ */
+class ThreadPool {
+  public:
+    /// Unit of work executed by the pool
+    using Task = std::function<void()>;
+
+    /// Body of a parallel loop, called with a half-open range [begin, end)
+    using RangeBody = std::function<void(std::size_t, std::size_t)>;
+
+    /**
+     * @brief Creates a pool
+     * @param num_threads Number of threads that execute a parallel_for(),
+     *        counting the calling thread: `num_threads - 1` workers are
+     *        started. 0 and 1 both mean "run on the caller only".
+     */
+    explicit ThreadPool(unsigned num_threads);
+
+    /// Finishes all queued tasks and joins the workers
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    /**
+     * @brief Number of threads taking part in a parallel_for()
+     * @return Number of workers plus one (the caller)
+     */
+    unsigned num_threads() const { return static_cast<unsigned>(queues_.size()) + 1; }
+
+    /**
+     * @brief Queues a task for asynchronous execution
+     *
+     * Tasks submitted from a worker go to that worker's own queue;
+     * tasks submitted from other threads are distributed round-robin.
+     * With no workers the task runs immediately on the caller.
+     *
+     * @param task The task; it must not throw
+     */
+    void submit(Task task);
+
+    /**
+     * @brief Runs @p body over [begin, end) split into chunks of @p grain
+     *
+     * Blocks until every chunk has finished. The calling thread executes
+     * chunks as well.
+     *
+     * @param begin First index
+     * @param end   One past the last index
+     * @param grain Chunk length (0 is treated as 1)
+     * @param body  Called once per chunk with its [begin, end) range
+     *
+     * @throw Any exception thrown by @p body (the first one is rethrown
+     *        after all chunks have completed)
+     */
+    void parallel_for(std::size_t begin, std::size_t end, std::size_t grain,
+                      const RangeBody& body);
+
+  private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void worker_loop(std::size_t index);
+    bool try_pop(std::size_t preferred, Task& task);
+    bool run_one(std::size_t preferred);
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<std::size_t> queued_{0};
+    std::atomic<std::size_t> next_queue_{0};
+    std::mutex sleep_mutex_;
+    std::condition_variable sleep_cv_;
+    bool stop_ = false;
+};
+
+/**
+ * @brief Sets the number of threads used by the parallel batch operations
+ *
+ * Replaces the library-wide pool. Work already running on the previous
+ * pool completes before its threads exit.
+ *
+ * @param num_threads Total number of threads (including the caller);
+ *        0 restores the default
+ */
+void set_num_threads(unsigned num_threads);
+
+/**
+ * @brief Returns the number of threads used by the parallel batch operations
+ *
+ * The default is `MATHLIB_NUM_THREADS` if set, otherwise
+ * `std::thread::hardware_concurrency()`.
+ */
+unsigned get_num_threads();
+
+/**
+ * @brief Returns the library-wide thread pool
+ *
+ * The returned pointer keeps the pool alive even if set_num_threads()
+ * replaces it concurrently.
+ */
+std::shared_ptr<ThreadPool> default_thread_pool();
+
+/**
+ * @brief Chooses a chunk length for a streaming loop
+ *
+ * Chunks are sized so that the data touched by one chunk
+ * (`bytes_per_element` per index) fills about half of the L2 cache, but
+ * are made smaller if needed to give every thread several chunks.
+ *
+ * @param n                 Number of elements
+ * @param bytes_per_element Bytes read plus written per element
+ * @param num_threads       Threads sharing the work
+ * @return Chunk length (≥ 1)
+ */
+std::size_t parallel_grain(std::size_t n, std::size_t bytes_per_element, unsigned num_threads);
+
+/**
+ * @brief Runs @p body over [0, n) on the library-wide pool
+ *
+ * Small ranges (a single chunk) run directly on the caller.
+ *
+ * @param n                 Number of elements
+ * @param bytes_per_element Bytes touched per element, for chunk sizing
+ * @param body              Called with [begin, end) ranges
+ */
+void parallel_for(std::size_t n, std::size_t bytes_per_element,
+                  const ThreadPool::RangeBody& body);
+
+/**
+ * @brief Multithreaded square_n()
+ *
+ * Each chunk is processed by the SIMD kernel of square_n().
+ *
+ * @param in  Input array of @p n values
+ * @param out Output array of @p n values (may equal @p in)
+ * @param n   Number of elements
+ *
+ * @see square_n(const double*, double*, std::size_t)
+ */
+void parallel_square_n(const double* in, double* out, std::size_t n);
+
+/// Single-precision parallel_square_n()
+void parallel_square_n(const float* in, float* out, std::size_t n);
+
+/**
+ * @brief Multithreaded factorial_n()
+ *
+ * @param n     Input array of @p count non-negative integers
+ * @param out   Output array of @p count values
+ * @param count Number of elements
+ *
+ * @throw std::invalid_argument if any n_i < 0
+ *
+ * @see factorial_n()
+ */
+void parallel_factorial_n(const int* n, double* out, std::size_t count);
+
+/// parallel_factorial_n() with single-precision results
+void parallel_factorial_n(const int* n, float* out, std::size_t count);
+
+/**
+ * @brief Multithreaded element-wise transformation
+ *
+ * Computes `out[i] = f(in[i])`. The lambda is inlined into the chunk loop,
+ * so the compiler can vectorize it.
+ *
+ * @param in  Input array of @p n values
+ * @param out Output array of @p n values
+ * @param n   Number of elements
+ * @param f   Element-wise function
+ *
+ * @par Example:
+ * @code
+ * mathlib::parallel_transform(t.data(), out.data(), t.size(),
+ *                             [](double x) { return mathlib::square(x) / 2.0; });
+ * @endcode
+ */
+template <typename T, typename U, typename F>
+void parallel_transform(const T* in, U* out, std::size_t n, F f) {
+    parallel_for(n, sizeof(T) + sizeof(U), [in, out, &f](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            out[i] = f(in[i]);
+        }
+    });
+}
+
+/**
+ * @brief Multithreaded element-wise transformation of two arrays
+ *
+ * Computes `out[i] = f(a[i], b[i])`, e.g. `square(T) / square(P)`.
+ *
+ * @param a   First input array of @p n values
+ * @param b   Second input array of @p n values
+ * @param out Output array of @p n values
+ * @param n   Number of elements
+ * @param f   Element-wise function of two arguments
+ */
+template <typename T1, typename T2, typename U, typename F>
+void parallel_transform(const T1* a, const T2* b, U* out, std::size_t n, F f) {
+    parallel_for(n, sizeof(T1) + sizeof(T2) + sizeof(U),
+                 [a, b, out, &f](std::size_t begin, std::size_t end) {
+                     for (std::size_t i = begin; i < end; ++i) {
+                         out[i] = f(a[i], b[i]);
+                     }
+                 });
+}
+
+}  // namespace mathlib
+
+#endif  // PARALLEL_H
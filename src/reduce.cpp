@@ -0,0 +1,650 @@
+/**
+ * @file reduce.cpp
+ * @brief Implementation of the blocked, multi-accumulator reductions
+ */
+
+#include "reduce.h"
+#include "aligned_memory.h"
+#include "parallel.h"
+#include "simd.h"
+#include "simd_internal.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace mathlib {
+
+namespace {
+
+/**
+ * @brief Term accumulated per element by a block kernel
+ *
+ * Computed from a[i], b[i] and a constant c; all but Value are squares
+ * of the listed difference or product.
+ */
+enum class Term {
+    Value,            ///< a
+    Square,           ///< a
+    ScaledSquare,     ///< a c
+    Deviation,        ///< a - c
+    Difference,       ///< a - b
+    ScaledDifference  ///< a c - b c
+};
+
+template <Term T>
+constexpr bool USES_B = T == Term::Difference || T == Term::ScaledDifference;
+
+/// Reduces the terms of elements [0, m) of arrays of E, accumulating in double
+template <typename E>
+using BlockKernel = double (*)(const E* a, const E* b, double c, std::size_t m);
+
+/// Below this sum of squares, squares of the elements may have lost precision to underflow
+constexpr double UNSCALED_MIN = 0x1p-968;
+
+constexpr double INF = std::numeric_limits<double>::infinity();
+
+/// Adds y to the compensated sum (sum, comp); the exact sum is sum - comp
+///
+/// An infinite sum has no rounding error to carry: `inf - inf` would make
+/// the compensation, and every later sum, NaN. The kernels below do the same.
+inline void kahan_add(double& sum, double& comp, double y) {
+    y -= comp;
+    const double t = sum + y;
+    comp = std::isfinite(t) ? (t - sum) - y : 0.0;
+    sum = t;
+}
+
+/// Sums the accumulators of a kernel in a fixed order; @p lanes is a power of two
+template <bool Kahan>
+double combine_lanes(double* sum, const double* comp, std::size_t lanes) {
+    if constexpr (Kahan) {
+        double total = 0.0;
+        double error = 0.0;
+        for (std::size_t l = 0; l < lanes; ++l) {
+            kahan_add(total, error, sum[l]);
+            kahan_add(total, error, -comp[l]);
+        }
+        return total - error;
+    } else {
+        for (std::size_t width = lanes / 2; width > 0; width /= 2) {
+            for (std::size_t l = 0; l < width; ++l) {
+                sum[l] += sum[l + width];
+            }
+        }
+        return sum[0];
+    }
+}
+
+/**
+ * @brief Combines partial results as a binary tree: p[i] = f(p[2i], p[2i + 1])
+ *
+ * The shape of the tree depends only on the number of partials.
+ */
+template <typename T, typename Combine>
+T combine_tree(T* p, std::size_t size, Combine combine) {
+    for (std::size_t count = size; count > 1; count = (count + 1) / 2) {
+        const std::size_t pairs = count / 2;
+        for (std::size_t i = 0; i < pairs; ++i) {
+            p[i] = combine(p[2 * i], p[2 * i + 1]);
+        }
+        if ((count & 1U) != 0) {
+            p[pairs] = p[count - 1];
+        }
+    }
+    return p[0];
+}
+
+//==============================================================================
+// Portable kernel
+//==============================================================================
+
+template <Term T, typename E>
+double base(const E* a, const E* b, double c, std::size_t i) {
+    const double x = a[i];
+    if constexpr (T == Term::Value || T == Term::Square) {
+        return x;
+    } else if constexpr (T == Term::ScaledSquare) {
+        return x * c;
+    } else if constexpr (T == Term::Deviation) {
+        return x - c;
+    } else if constexpr (T == Term::Difference) {
+        return x - static_cast<double>(b[i]);
+    } else {
+        return x * c - static_cast<double>(b[i]) * c;
+    }
+}
+
+template <Term T, typename E>
+double term(const E* a, const E* b, double c, std::size_t i) {
+    const double d = base<T>(a, b, c, i);
+    if constexpr (T == Term::Value) {
+        return d;
+    } else {
+        return d * d;
+    }
+}
+
+/// Adds the term of element i to one accumulator
+template <Term T, bool Kahan, typename E>
+void accumulate_scalar(double& sum, double& comp, const E* a, const E* b, double c,
+                       std::size_t i) {
+    if constexpr (Kahan) {
+        kahan_add(sum, comp, term<T>(a, b, c, i));
+    } else {
+        sum += term<T>(a, b, c, i);
+    }
+}
+
+/// Four accumulators, element i going to accumulator i % 4
+template <Term T, bool Kahan, typename E>
+double reduce_scalar(const E* a, const E* b, double c, std::size_t m) {
+    constexpr std::size_t LANES = 4;
+    double sum[LANES] = {};
+    double comp[LANES] = {};
+    std::size_t i = 0;
+    for (; i + LANES <= m; i += LANES) {
+        for (std::size_t l = 0; l < LANES; ++l) {
+            accumulate_scalar<T, Kahan>(sum[l], comp[l], a, b, c, i + l);
+        }
+    }
+    for (; i < m; ++i) {
+        accumulate_scalar<T, Kahan>(sum[0], comp[0], a, b, c, i);
+    }
+    return combine_lanes<Kahan>(sum, comp, LANES);
+}
+
+//==============================================================================
+// x86 kernels
+//==============================================================================
+
+#if MATHLIB_SIMD_X86
+
+/// Loads four elements as doubles
+MATHLIB_TARGET_AVX2 __m256d load_avx2(const double* p) {
+    return _mm256_loadu_pd(p);
+}
+
+MATHLIB_TARGET_AVX2 __m256d load_avx2(const float* p) {
+    return _mm256_cvtps_pd(_mm_loadu_ps(p));
+}
+
+template <Term T>
+MATHLIB_TARGET_AVX2 __m256d base_avx2(__m256d a, __m256d b, __m256d c) {
+    if constexpr (T == Term::Value || T == Term::Square) {
+        return a;
+    } else if constexpr (T == Term::ScaledSquare) {
+        return _mm256_mul_pd(a, c);
+    } else if constexpr (T == Term::Deviation) {
+        return _mm256_sub_pd(a, c);
+    } else if constexpr (T == Term::Difference) {
+        return _mm256_sub_pd(a, b);
+    } else {
+        return _mm256_sub_pd(_mm256_mul_pd(a, c), _mm256_mul_pd(b, c));
+    }
+}
+
+template <Term T, bool Kahan>
+MATHLIB_TARGET_AVX2 void accumulate_avx2(__m256d& sum, __m256d& comp, __m256d a, __m256d b,
+                                         __m256d c) {
+    const __m256d d = base_avx2<T>(a, b, c);
+    if constexpr (Kahan) {
+        const __m256d t = T == Term::Value ? d : _mm256_mul_pd(d, d);
+        const __m256d y = _mm256_sub_pd(t, comp);
+        const __m256d s = _mm256_add_pd(sum, y);
+        const __m256d abs_s = _mm256_andnot_pd(_mm256_set1_pd(-0.0), s);
+        const __m256d finite = _mm256_cmp_pd(abs_s, _mm256_set1_pd(INF), _CMP_LT_OQ);
+        comp = _mm256_and_pd(_mm256_sub_pd(_mm256_sub_pd(s, sum), y), finite);
+        sum = s;
+    } else if constexpr (T == Term::Value) {
+        sum = _mm256_add_pd(sum, d);
+    } else {
+        sum = _mm256_fmadd_pd(d, d, sum);
+    }
+}
+
+/**
+ * @brief AVX2 kernel: four 4-wide accumulators (16 partial sums)
+ *
+ * @details
+ * Four independent vectors cover the 4-cycle latency of the additions;
+ * the last m % 16 elements go to the first partial sum.
+ */
+template <Term T, bool Kahan, typename E>
+MATHLIB_TARGET_AVX2 double reduce_avx2(const E* a, const E* b, double c, std::size_t m) {
+    constexpr std::size_t VECTORS = 4;
+    const __m256d cv = _mm256_set1_pd(c);
+    __m256d sum[VECTORS];
+    __m256d comp[VECTORS];
+    for (std::size_t v = 0; v < VECTORS; ++v) {
+        sum[v] = _mm256_setzero_pd();
+        comp[v] = _mm256_setzero_pd();
+    }
+    std::size_t i = 0;
+    for (; i + 4 * VECTORS <= m; i += 4 * VECTORS) {
+        for (std::size_t v = 0; v < VECTORS; ++v) {
+            const __m256d av = load_avx2(a + i + 4 * v);
+            const __m256d bv = USES_B<T> ? load_avx2(b + i + 4 * v) : _mm256_setzero_pd();
+            accumulate_avx2<T, Kahan>(sum[v], comp[v], av, bv, cv);
+        }
+    }
+
+    double sums[4 * VECTORS];
+    double comps[4 * VECTORS];
+    for (std::size_t v = 0; v < VECTORS; ++v) {
+        _mm256_storeu_pd(sums + 4 * v, sum[v]);
+        _mm256_storeu_pd(comps + 4 * v, comp[v]);
+    }
+    for (; i < m; ++i) {
+        accumulate_scalar<T, Kahan>(sums[0], comps[0], a, b, c, i);
+    }
+    return combine_lanes<Kahan>(sums, comps, 4 * VECTORS);
+}
+
+constexpr __mmask8 ALL_LANES = 0xFF;
+
+/// Loads eight elements as doubles
+MATHLIB_TARGET_AVX512 __m512d load_avx512(const double* p) {
+    return _mm512_loadu_pd(p);
+}
+
+// The float loads use masked intrinsics with zeroed sources throughout: GCC
+// implements the unmasked conversions on an undefined vector, which it then
+// reports with -Wmaybe-uninitialized. The instructions are the same.
+MATHLIB_TARGET_AVX512 __m512d load_avx512(const float* p) {
+    return _mm512_mask_cvtps_pd(_mm512_setzero_pd(), ALL_LANES, _mm256_loadu_ps(p));
+}
+
+/// Loads the elements selected by @p mask as doubles, zero elsewhere
+MATHLIB_TARGET_AVX512 __m512d load_avx512(const double* p, __mmask8 mask) {
+    return _mm512_maskz_loadu_pd(mask, p);
+}
+
+MATHLIB_TARGET_AVX512 __m512d load_avx512(const float* p, __mmask8 mask) {
+    const __m512 wide = _mm512_mask_loadu_ps(_mm512_setzero_ps(), mask, p);
+    const __m256d low = _mm512_mask_extractf64x4_pd(_mm256_setzero_pd(), 0xF,
+                                                    _mm512_castps_pd(wide), 0);
+    return _mm512_mask_cvtps_pd(_mm512_setzero_pd(), ALL_LANES, _mm256_castpd_ps(low));
+}
+
+template <Term T>
+MATHLIB_TARGET_AVX512 __m512d base_avx512(__m512d a, __m512d b, __m512d c) {
+    if constexpr (T == Term::Value || T == Term::Square) {
+        return a;
+    } else if constexpr (T == Term::ScaledSquare) {
+        return _mm512_mul_pd(a, c);
+    } else if constexpr (T == Term::Deviation) {
+        return _mm512_sub_pd(a, c);
+    } else if constexpr (T == Term::Difference) {
+        return _mm512_sub_pd(a, b);
+    } else {
+        return _mm512_sub_pd(_mm512_mul_pd(a, c), _mm512_mul_pd(b, c));
+    }
+}
+
+template <Term T, bool Kahan>
+MATHLIB_TARGET_AVX512 void accumulate_avx512(__m512d& sum, __m512d& comp, __m512d a, __m512d b,
+                                             __m512d c) {
+    const __m512d d = base_avx512<T>(a, b, c);
+    if constexpr (Kahan) {
+        const __m512d t = T == Term::Value ? d : _mm512_mul_pd(d, d);
+        const __m512d y = _mm512_sub_pd(t, comp);
+        const __m512d s = _mm512_add_pd(sum, y);
+        const __mmask8 finite =
+            _mm512_cmp_pd_mask(_mm512_abs_pd(s), _mm512_set1_pd(INF), _CMP_LT_OQ);
+        comp = _mm512_maskz_sub_pd(finite, _mm512_sub_pd(s, sum), y);
+        sum = s;
+    } else if constexpr (T == Term::Value) {
+        sum = _mm512_add_pd(sum, d);
+    } else {
+        sum = _mm512_fmadd_pd(d, d, sum);
+    }
+}
+
+/**
+ * @brief AVX-512 kernel: four 8-wide accumulators (32 partial sums)
+ *
+ * @details
+ * The remaining vectors go to the first accumulator, the last one with a
+ * masked load; masked-off lanes hold a value whose term is zero.
+ */
+template <Term T, bool Kahan, typename E>
+MATHLIB_TARGET_AVX512 double reduce_avx512(const E* a, const E* b, double c, std::size_t m) {
+    constexpr std::size_t VECTORS = 4;
+    const __m512d cv = _mm512_set1_pd(c);
+    __m512d sum[VECTORS];
+    __m512d comp[VECTORS];
+    for (std::size_t v = 0; v < VECTORS; ++v) {
+        sum[v] = _mm512_setzero_pd();
+        comp[v] = _mm512_setzero_pd();
+    }
+    std::size_t i = 0;
+    for (; i + 8 * VECTORS <= m; i += 8 * VECTORS) {
+        for (std::size_t v = 0; v < VECTORS; ++v) {
+            const __m512d av = load_avx512(a + i + 8 * v);
+            const __m512d bv = USES_B<T> ? load_avx512(b + i + 8 * v) : _mm512_setzero_pd();
+            accumulate_avx512<T, Kahan>(sum[v], comp[v], av, bv, cv);
+        }
+    }
+    const __m512d neutral = T == Term::Deviation ? cv : _mm512_setzero_pd();
+    for (; i < m; i += 8) {
+        const std::size_t left = m - i;
+        const __mmask8 mask =
+            left >= 8 ? static_cast<__mmask8>(0xFF) : static_cast<__mmask8>((1U << left) - 1U);
+        const __m512d av = _mm512_mask_mov_pd(neutral, mask, load_avx512(a + i, mask));
+        const __m512d bv = USES_B<T> ? load_avx512(b + i, mask) : _mm512_setzero_pd();
+        accumulate_avx512<T, Kahan>(sum[0], comp[0], av, bv, cv);
+    }
+
+    double sums[8 * VECTORS];
+    double comps[8 * VECTORS];
+    for (std::size_t v = 0; v < VECTORS; ++v) {
+        _mm512_storeu_pd(sums + 8 * v, sum[v]);
+        _mm512_storeu_pd(comps + 8 * v, comp[v]);
+    }
+    return combine_lanes<Kahan>(sums, comps, 8 * VECTORS);
+}
+
+#endif  // MATHLIB_SIMD_X86
+
+//==============================================================================
+// ARM kernels
+//==============================================================================
+
+#if MATHLIB_SIMD_NEON
+
+/// Loads two elements as doubles
+float64x2_t load_neon(const double* p) {
+    return vld1q_f64(p);
+}
+
+float64x2_t load_neon(const float* p) {
+    return vcvt_f64_f32(vld1_f32(p));
+}
+
+template <Term T>
+float64x2_t base_neon(float64x2_t a, float64x2_t b, float64x2_t c) {
+    if constexpr (T == Term::Value || T == Term::Square) {
+        return a;
+    } else if constexpr (T == Term::ScaledSquare) {
+        return vmulq_f64(a, c);
+    } else if constexpr (T == Term::Deviation) {
+        return vsubq_f64(a, c);
+    } else if constexpr (T == Term::Difference) {
+        return vsubq_f64(a, b);
+    } else {
+        return vsubq_f64(vmulq_f64(a, c), vmulq_f64(b, c));
+    }
+}
+
+template <Term T, bool Kahan>
+void accumulate_neon(float64x2_t& sum, float64x2_t& comp, float64x2_t a, float64x2_t b,
+                     float64x2_t c) {
+    const float64x2_t d = base_neon<T>(a, b, c);
+    if constexpr (Kahan) {
+        const float64x2_t t = T == Term::Value ? d : vmulq_f64(d, d);
+        const float64x2_t y = vsubq_f64(t, comp);
+        const float64x2_t s = vaddq_f64(sum, y);
+        const uint64x2_t finite = vcltq_f64(vabsq_f64(s), vdupq_n_f64(INF));
+        comp = vreinterpretq_f64_u64(
+            vandq_u64(vreinterpretq_u64_f64(vsubq_f64(vsubq_f64(s, sum), y)), finite));
+        sum = s;
+    } else if constexpr (T == Term::Value) {
+        sum = vaddq_f64(sum, d);
+    } else {
+        sum = vfmaq_f64(sum, d, d);
+    }
+}
+
+/// NEON kernel: four 2-wide accumulators (8 partial sums)
+template <Term T, bool Kahan, typename E>
+double reduce_neon(const E* a, const E* b, double c, std::size_t m) {
+    constexpr std::size_t VECTORS = 4;
+    const float64x2_t cv = vdupq_n_f64(c);
+    float64x2_t sum[VECTORS];
+    float64x2_t comp[VECTORS];
+    for (std::size_t v = 0; v < VECTORS; ++v) {
+        sum[v] = vdupq_n_f64(0.0);
+        comp[v] = vdupq_n_f64(0.0);
+    }
+    std::size_t i = 0;
+    for (; i + 2 * VECTORS <= m; i += 2 * VECTORS) {
+        for (std::size_t v = 0; v < VECTORS; ++v) {
+            const float64x2_t av = load_neon(a + i + 2 * v);
+            const float64x2_t bv = USES_B<T> ? load_neon(b + i + 2 * v) : vdupq_n_f64(0.0);
+            accumulate_neon<T, Kahan>(sum[v], comp[v], av, bv, cv);
+        }
+    }
+
+    double sums[2 * VECTORS];
+    double comps[2 * VECTORS];
+    for (std::size_t v = 0; v < VECTORS; ++v) {
+        vst1q_f64(sums + 2 * v, sum[v]);
+        vst1q_f64(comps + 2 * v, comp[v]);
+    }
+    for (; i < m; ++i) {
+        accumulate_scalar<T, Kahan>(sums[0], comps[0], a, b, c, i);
+    }
+    return combine_lanes<Kahan>(sums, comps, 2 * VECTORS);
+}
+
+#endif  // MATHLIB_SIMD_NEON
+
+/// Kernel of the active instruction set
+template <Term T, bool Kahan, typename E>
+BlockKernel<E> select_kernel() {
+    switch (active_simd_isa()) {
+#if MATHLIB_SIMD_X86
+        case SimdIsa::Avx512:
+            return &reduce_avx512<T, Kahan, E>;
+        case SimdIsa::Avx2:
+            return &reduce_avx2<T, Kahan, E>;
+#endif
+#if MATHLIB_SIMD_NEON
+        case SimdIsa::Neon:
+            return &reduce_neon<T, Kahan, E>;
+#endif
+        default:
+            return &reduce_scalar<T, Kahan, E>;
+    }
+}
+
+template <Term T, typename E>
+BlockKernel<E> select_kernel(Summation summation) {
+    return summation == Summation::Kahan ? select_kernel<T, true, E>()
+                                         : select_kernel<T, false, E>();
+}
+
+//==============================================================================
+// Blocked driver
+//==============================================================================
+
+/// Number of blocks of [0, n)
+std::size_t block_count(std::size_t n) { return (n + REDUCE_BLOCK - 1) / REDUCE_BLOCK; }
+
+/**
+ * @brief Stores the result of @p reduce_block for every block, in block order
+ *
+ * @param partials     block_count(n) results
+ * @param reduce_block Called with the first index and length of a block
+ */
+template <typename Partial, typename ReduceBlock>
+void reduce_blocks(Partial* partials, std::size_t n, std::size_t bytes_per_element, bool parallel,
+                   const ReduceBlock& reduce_block) {
+    const std::size_t blocks = block_count(n);
+    const auto body = [&](std::size_t first, std::size_t last) {
+        for (std::size_t k = first; k < last; ++k) {
+            const std::size_t begin = k * REDUCE_BLOCK;
+            partials[k] = reduce_block(begin, std::min(n - begin, REDUCE_BLOCK));
+        }
+    };
+    if (parallel && blocks > 1) {
+        parallel_for(blocks, REDUCE_BLOCK * bytes_per_element, body);
+    } else {
+        body(0, blocks);
+    }
+}
+
+/// Sum of the terms of [0, n), block by block
+template <Term T, typename E>
+double blocked_sum(const E* a, const E* b, double c, std::size_t n,
+                   const ReduceOptions& options) {
+    const BlockKernel<E> kernel = select_kernel<T, E>(options.summation);
+    if (n <= REDUCE_BLOCK) {
+        return kernel(a, b, c, n);
+    }
+    const std::size_t bytes = USES_B<T> ? 2 * sizeof(E) : sizeof(E);
+    const std::size_t blocks = block_count(n);
+    ScratchArena::Scope scratch(thread_scratch());
+    double* partials = scratch.allocate<double>(blocks);
+    reduce_blocks(partials, n, bytes, options.parallel,
+                  [&](std::size_t begin, std::size_t length) {
+                      return kernel(a + begin, USES_B<T> ? b + begin : b, c, length);
+                  });
+    if (options.summation == Summation::Kahan) {
+        double total = 0.0;
+        double error = 0.0;
+        for (std::size_t k = 0; k < blocks; ++k) {
+            kahan_add(total, error, partials[k]);
+        }
+        return total - error;
+    }
+    return combine_tree(partials, blocks, [](double x, double y) { return x + y; });
+}
+
+/// Largest |x_i| (NaN ignored)
+double max_abs(const double* x, std::size_t n) {
+    double largest = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        largest = std::fmax(largest, std::fabs(x[i]));
+    }
+    return largest;
+}
+
+/// Exponent e with largest ≤ 2^e, bounded so that 2^-e stays finite
+int scale_exponent(double largest) {
+    int exponent = 0;
+    std::frexp(largest, &exponent);
+    return std::max(exponent, std::numeric_limits<double>::min_exponent - 2);
+}
+
+/// Moments of [0, n), block by block
+template <typename E>
+Moments blocked_moments(const E* x, std::size_t n, const ReduceOptions& options) {
+    if (n == 0) {
+        return {};
+    }
+    const BlockKernel<E> sum_kernel = select_kernel<Term::Value, E>(options.summation);
+    const BlockKernel<E> deviation_kernel = select_kernel<Term::Deviation, E>(options.summation);
+
+    // Second pass over the block while it is still in L1
+    const auto reduce_block = [&](std::size_t begin, std::size_t length) {
+        Moments block;
+        block.count = length;
+        block.mean = sum_kernel(x + begin, nullptr, 0.0, length) / static_cast<double>(length);
+        block.m2 = deviation_kernel(x + begin, nullptr, block.mean, length);
+        return block;
+    };
+    if (n <= REDUCE_BLOCK) {
+        return reduce_block(0, n);
+    }
+    const std::size_t blocks = block_count(n);
+    ScratchArena::Scope scratch(thread_scratch());
+    Moments* partials = scratch.allocate<Moments>(blocks);
+    reduce_blocks(partials, n, sizeof(E), options.parallel, reduce_block);
+    return combine_tree(partials, blocks, [](Moments p, const Moments& q) {
+        p.merge(q);
+        return p;
+    });
+}
+
+}  // namespace
+
+void Moments::merge(const Moments& other) {
+    if (other.count == 0) {
+        return;
+    }
+    if (count == 0) {
+        *this = other;
+        return;
+    }
+    const double na = static_cast<double>(count);
+    const double nb = static_cast<double>(other.count);
+    const double total = na + nb;
+    const double delta = other.mean - mean;
+    mean += delta * (nb / total);
+    m2 += other.m2 + delta * delta * (na * nb / total);
+    count += other.count;
+}
+
+double sum(const double* x, std::size_t n, const ReduceOptions& options) {
+    return blocked_sum<Term::Value, double>(x, nullptr, 0.0, n, options);
+}
+
+double sum_of_squares(const double* x, std::size_t n, const ReduceOptions& options) {
+    return blocked_sum<Term::Square, double>(x, nullptr, 0.0, n, options);
+}
+
+double norm2(const double* x, std::size_t n, const ReduceOptions& options) {
+    const double s = blocked_sum<Term::Square, double>(x, nullptr, 0.0, n, options);
+    if (std::isnan(s) || (s >= UNSCALED_MIN && s <= std::numeric_limits<double>::max())) {
+        return std::sqrt(s);
+    }
+
+    // Overflow or possible underflow: scale the largest element to [0.5, 1)
+    const double largest = max_abs(x, n);
+    if (largest == 0.0 || std::isinf(largest)) {
+        return largest;
+    }
+    const int exponent = scale_exponent(largest);
+    const double scaled =
+        blocked_sum<Term::ScaledSquare, double>(x, nullptr, std::ldexp(1.0, -exponent), n, options);
+    return std::ldexp(std::sqrt(scaled), exponent);
+}
+
+double distance(const double* a, const double* b, std::size_t n, const ReduceOptions& options) {
+    const double s = blocked_sum<Term::Difference, double>(a, b, 0.0, n, options);
+    if (std::isnan(s) || (s >= UNSCALED_MIN && s <= std::numeric_limits<double>::max())) {
+        return std::sqrt(s);
+    }
+
+    // Both inputs scaled below 1, so that their differences cannot overflow either
+    const double largest = std::max(max_abs(a, n), max_abs(b, n));
+    if (largest == 0.0) {
+        return 0.0;
+    }
+    if (std::isinf(largest)) {
+        return std::numeric_limits<double>::infinity();
+    }
+    const int exponent = scale_exponent(largest);
+    const double scaled =
+        blocked_sum<Term::ScaledDifference, double>(a, b, std::ldexp(1.0, -exponent), n, options);
+    return std::ldexp(std::sqrt(scaled), exponent);
+}
+
+Moments moments(const double* x, std::size_t n, const ReduceOptions& options) {
+    return blocked_moments(x, n, options);
+}
+
+double sum(const float* x, std::size_t n, const ReduceOptions& options) {
+    return blocked_sum<Term::Value, float>(x, nullptr, 0.0, n, options);
+}
+
+double sum_of_squares(const float* x, std::size_t n, const ReduceOptions& options) {
+    return blocked_sum<Term::Square, float>(x, nullptr, 0.0, n, options);
+}
+
+double norm2(const float* x, std::size_t n, const ReduceOptions& options) {
+    // Squares of floats can neither overflow nor underflow in double
+    return std::sqrt(sum_of_squares(x, n, options));
+}
+
+double distance(const float* a, const float* b, std::size_t n, const ReduceOptions& options) {
+    return std::sqrt(blocked_sum<Term::Difference, float>(a, b, 0.0, n, options));
+}
+
+Moments moments(const float* x, std::size_t n, const ReduceOptions& options) {
+    return blocked_moments(x, n, options);
+}
+
+}  // namespace mathlib
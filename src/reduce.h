@@ -0,0 +1,190 @@
+/**
+ * @file reduce.h
+ * @brief Reductions: sums, sums of squares, norms, distances, mean and variance
+ *
+ * A plain `for` loop accumulating into one double is limited by the
+ * latency of the addition (one element every 4 cycles) and its rounding
+ * error grows with n. The reductions here keep several SIMD accumulators
+ * (16 to 32 independent partial sums), optionally with Kahan compensation,
+ * and can run on the library thread pool (see parallel.h). The per-block
+ * partial results live in the caller's thread_scratch() arena, so serial
+ * reductions perform no heap allocations once the arena has grown.
+ *
+ * @par Determinism:
+ * The input is always cut into blocks of REDUCE_BLOCK elements, each block
+ * is reduced by the SIMD kernel, and the block results are combined in a
+ * fixed order. The result therefore depends only on the data, the
+ * summation mode and the active instruction set (see simd.h): serial and
+ * parallel runs with any number of threads give bitwise identical results.
+ *
+ * @par Example:
+ * @code
+ * double e = 0.5 * mass * mathlib::sum_of_squares(v.data(), v.size());
+ * auto m = mathlib::moments(samples.data(), samples.size(), {mathlib::Summation::Kahan, true});
+ * std::cout << m.mean << " ± " << std::sqrt(m.sample_variance()) << '\n';
+ * @endcode
+ *
+ * @author Your Name
+ * @date 2026-01-05
+ * @version 1.0.0
+ */
+
+#ifndef REDUCE_H
+#define REDUCE_H
+
+#include <cstddef>
+
+namespace mathlib {
+
+/// Elements per block; blocks are reduced independently, then combined
+constexpr std::size_t REDUCE_BLOCK = 2048;
+
+/// How partial sums are accumulated
+enum class Summation {
+    /**
+     * Multiple accumulators per block, block results combined as a binary
+     * tree: error bound about \f$ (REDUCE\_BLOCK / lanes + \log_2 blocks)
+     * \cdot \varepsilon \f$ instead of \f$ n \varepsilon \f$ for a plain loop
+     */
+    Pairwise,
+    /**
+     * Kahan compensation in every accumulator and across blocks: error
+     * about \f$ 2\varepsilon \f$ independent of n, for 2-4 times the
+     * floating-point work (still memory bound for large arrays)
+     */
+    Kahan
+};
+
+/// Options of the reduction functions
+struct ReduceOptions {
+    Summation summation = Summation::Pairwise;
+    bool parallel = false;  ///< Run the blocks on the library-wide thread pool
+};
+
+/**
+ * @brief Sum of the elements, \f$ \sum_i x_i \f$
+ *
+ * @param x       Array of @p n values
+ * @param n       Number of elements (0 gives 0)
+ * @param options Summation mode and parallelism
+ */
+double sum(const double* x, std::size_t n, const ReduceOptions& options = {});
+
+/**
+ * @brief Sum of squares, \f$ \sum_i x_i^2 \f$
+ *
+ * @param x       Array of @p n values
+ * @param n       Number of elements (0 gives 0)
+ * @param options Summation mode and parallelism
+ *
+ * @note Overflows to infinity when the sum exceeds the double range; see
+ *       norm2() for a scaled computation
+ */
+double sum_of_squares(const double* x, std::size_t n, const ReduceOptions& options = {});
+
+/**
+ * @brief Euclidean (L2) norm, \f$ \sqrt{\sum_i x_i^2} \f$
+ *
+ * Like `std::hypot`, the result does not overflow or underflow when the
+ * squares would: if the unscaled sum of squares is infinite or tiny, it
+ * is computed again on the elements scaled by a power of two.
+ *
+ * @param x       Array of @p n values
+ * @param n       Number of elements (0 gives 0)
+ * @param options Summation mode and parallelism
+ * @return The norm; NaN if an element is NaN, otherwise infinity if one
+ *         is infinite
+ */
+double norm2(const double* x, std::size_t n, const ReduceOptions& options = {});
+
+/**
+ * @brief Euclidean distance, \f$ \sqrt{\sum_i (a_i - b_i)^2} \f$
+ *
+ * Scaled like norm2() when the squares overflow or underflow.
+ *
+ * @param a       First array of @p n values
+ * @param b       Second array of @p n values
+ * @param n       Number of elements (0 gives 0)
+ * @param options Summation mode and parallelism
+ */
+double distance(const double* a, const double* b, std::size_t n,
+                const ReduceOptions& options = {});
+
+/**
+ * @struct Moments
+ * @brief Count, mean and sum of squared deviations of a data set
+ *
+ * Partial results of separate data sets (other blocks, threads, files)
+ * combine with merge().
+ */
+struct Moments {
+    std::size_t count = 0;
+    double mean = 0.0;
+    double m2 = 0.0;  ///< \f$ \sum_i (x_i - \bar{x})^2 \f$
+
+    /// Population variance m2 / count (0 for no data)
+    double variance() const { return count == 0 ? 0.0 : m2 / static_cast<double>(count); }
+
+    /// Sample variance m2 / (count - 1) (0 for fewer than two values)
+    double sample_variance() const {
+        return count < 2 ? 0.0 : m2 / static_cast<double>(count - 1);
+    }
+
+    /**
+     * @brief Adds the data summarized by @p other
+     *
+     * Chan et al.'s pairwise form of Welford's update:
+     * \f$ \delta = \bar{x}_b - \bar{x}_a \f$,
+     * \f$ M_2 = M_{2,a} + M_{2,b} + \delta^2 n_a n_b / n \f$.
+     */
+    void merge(const Moments& other);
+};
+
+/**
+ * @brief Mean and variance in one call
+ *
+ * @details
+ * Each block (which stays in L1 cache) is reduced in two passes, its sum
+ * and then the squared deviations from its own mean, so that a large
+ * common offset of the data does not cancel the variance as in the
+ * one-pass formula \f$ E[x^2] - E[x]^2 \f$. The blocks are combined with
+ * Moments::merge().
+ *
+ * @param x       Array of @p n values
+ * @param n       Number of elements
+ * @param options Summation mode and parallelism
+ */
+Moments moments(const double* x, std::size_t n, const ReduceOptions& options = {});
+
+//==============================================================================
+// MIXED PRECISION
+// float storage, double accumulation: the kernels convert each loaded
+// vector to double, so a pass reads half the bytes of the double version
+// (the bandwidth-bound case for large arrays) with the accuracy of double
+// sums. Results are double.
+//==============================================================================
+
+/// sum() of single-precision values, accumulated in double
+double sum(const float* x, std::size_t n, const ReduceOptions& options = {});
+
+/// sum_of_squares() of single-precision values, accumulated in double
+double sum_of_squares(const float* x, std::size_t n, const ReduceOptions& options = {});
+
+/**
+ * @brief norm2() of single-precision values, accumulated in double
+ *
+ * No scaling is needed: squares of floats neither overflow nor underflow
+ * in double.
+ */
+double norm2(const float* x, std::size_t n, const ReduceOptions& options = {});
+
+/// distance() between single-precision arrays, accumulated in double
+double distance(const float* a, const float* b, std::size_t n,
+                const ReduceOptions& options = {});
+
+/// moments() of single-precision values, accumulated in double
+Moments moments(const float* x, std::size_t n, const ReduceOptions& options = {});
+
+}  // namespace mathlib
+
+#endif  // REDUCE_H
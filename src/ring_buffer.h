@@ -0,0 +1,159 @@
+/**
+ * @file ring_buffer.h
+ * @brief Lock-free bounded queue for passing work between threads
+ *
+ * @author Your Name
+ * @date 2026-01-05
+ * @version 1.0.0
+ */
+
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include "error.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace mathlib {
+
+/**
+ * @class RingBuffer
+ * @brief Fixed-capacity multi-producer multi-consumer queue
+ *
+ * Every slot carries a sequence number that tells producers and consumers
+ * whether it is free or filled for their current lap around the ring, so
+ * try_push() and try_pop() need a single compare-and-swap on the shared
+ * position and never take a lock. Neither operation waits: on a full or
+ * empty buffer they return false and the caller decides whether to retry,
+ * drop or block.
+ *
+ * @tparam T Element type; must be default-constructible and
+ *           move-assignable (slots are preallocated)
+ *
+ * @par Example:
+ * @code
+ * mathlib::RingBuffer<int> queue(1024);
+ * queue.try_push(42);    // producer thread
+ * int value;
+ * queue.try_pop(value);  // consumer thread
+ * @endcode
+ */
+template <typename T>
+class RingBuffer {
+  public:
+    /**
+     * @brief Creates an empty buffer
+     * @param capacity Minimum number of elements; rounded up to a power of two
+     * @throw std::invalid_argument if capacity is 0
+     */
+    explicit RingBuffer(std::size_t capacity) {
+        if (capacity == 0) {
+            detail::raise(std::invalid_argument("Ring buffer capacity must be positive"));
+        }
+        std::size_t size = 2;
+        while (size < capacity) {
+            size *= 2;
+        }
+        mask_ = size - 1;
+        slots_ = std::make_unique<Slot[]>(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    /// Number of slots
+    std::size_t capacity() const { return mask_ + 1; }
+
+    /**
+     * @brief Appends an element unless the buffer is full
+     * @param value Element to move into the buffer
+     * @return false if the buffer was full (value is left untouched)
+     */
+    bool try_push(T&& value) {
+        std::size_t pos = tail_.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& slot = slots_[pos & mask_];
+            const std::size_t seq = slot.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.value = std::move(value);
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // The slot still holds an element from the previous lap
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// Copying overload of try_push()
+    bool try_push(const T& value) {
+        T copy(value);
+        return try_push(std::move(copy));
+    }
+
+    /**
+     * @brief Removes the oldest element unless the buffer is empty
+     * @param value Receives the element
+     * @return false if the buffer was empty
+     */
+    bool try_pop(T& value) {
+        std::size_t pos = head_.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& slot = slots_[pos & mask_];
+            const std::size_t seq = slot.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    value = std::move(slot.value);
+                    slot.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // Not yet written in this lap
+            } else {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Approximate number of elements
+     *
+     * Exact only while no other thread pushes or pops.
+     */
+    std::size_t size() const {
+        const std::size_t head = head_.load(std::memory_order_acquire);
+        const std::size_t tail = tail_.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+  private:
+    /// Producers and consumers update different positions; keep them on
+    /// separate cache lines
+    static constexpr std::size_t CACHE_LINE_BYTES = 64;
+
+    struct Slot {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Slot[]> slots_;
+    std::size_t mask_ = 0;
+    alignas(CACHE_LINE_BYTES) std::atomic<std::size_t> tail_{0};
+    alignas(CACHE_LINE_BYTES) std::atomic<std::size_t> head_{0};
+};
+
+}  // namespace mathlib
+
+#endif  // RING_BUFFER_H
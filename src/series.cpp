@@ -0,0 +1,393 @@
+/**
+ * @file series.cpp
+ * @brief Implementation of polynomial evaluation and the batch series kernels
+ */
+
+#include "series.h"
+#include "error.h"
+#include "simd.h"
+#include "simd_internal.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace mathlib {
+
+namespace {
+
+/// Coefficients combined by one Estrin tree; longer polynomials chain several trees
+constexpr std::size_t ESTRIN_BLOCK = 64;
+
+/// x^k by repeated squaring (k is a small step or offset)
+double ipow(double x, unsigned k) {
+    double result = 1.0;
+    while (k != 0) {
+        if ((k & 1U) != 0) {
+            result *= x;
+        }
+        x *= x;
+        k >>= 1;
+    }
+    return result;
+}
+
+/// Estrin's scheme for 1 ≤ count ≤ ESTRIN_BLOCK coefficients
+double estrin_block(const double* c, std::size_t count, double x) {
+    if (count == 1) {
+        return c[0];
+    }
+    // The first round reads the coefficients, later rounds the buffer
+    double buffer[ESTRIN_BLOCK / 2];
+    const std::size_t pairs = count / 2;
+    for (std::size_t i = 0; i < pairs; ++i) {
+        buffer[i] = c[2 * i] + x * c[2 * i + 1];
+    }
+    if ((count & 1U) != 0) {
+        buffer[pairs] = c[count - 1];
+    }
+    count -= pairs;
+    x *= x;
+    while (count > 1) {
+        const std::size_t half = count / 2;
+        for (std::size_t i = 0; i < half; ++i) {
+            buffer[i] = buffer[2 * i] + x * buffer[2 * i + 1];
+        }
+        if ((count & 1U) != 0) {
+            buffer[half] = buffer[count - 1];
+        }
+        count -= half;
+        x *= x;
+    }
+    return buffer[0];
+}
+
+/// Coefficients and shape of the series, as passed to the kernels
+struct SeriesShape {
+    const double* c;
+    std::size_t count;  // ≥ 1
+    unsigned step;
+    unsigned offset;
+};
+
+double evaluate_one(const SeriesShape& s, double x) {
+    const double y = s.step == 1 ? x : ipow(x, s.step);
+    const double p = horner(s.c, s.count, y);
+    return s.offset == 0 ? p : p * ipow(x, s.offset);
+}
+
+//==============================================================================
+// Portable kernel
+//==============================================================================
+
+/**
+ * @brief Four independent Horner chains at a time
+ *
+ * @details
+ * The chains of different elements do not depend on each other, so the
+ * core overlaps their multiply-adds; the compiler may also vectorize them.
+ */
+void evaluate_scalar(const SeriesShape& s, const double* x, double* out, std::size_t n) {
+    constexpr std::size_t LANES = 4;
+    std::size_t i = 0;
+    for (; i + LANES <= n; i += LANES) {
+        double y[LANES];
+        double acc[LANES];
+        for (std::size_t l = 0; l < LANES; ++l) {
+            y[l] = s.step == 1 ? x[i + l] : ipow(x[i + l], s.step);
+            acc[l] = s.c[s.count - 1];
+        }
+        for (std::size_t k = s.count - 1; k-- > 0;) {
+            for (std::size_t l = 0; l < LANES; ++l) {
+                acc[l] = acc[l] * y[l] + s.c[k];
+            }
+        }
+        for (std::size_t l = 0; l < LANES; ++l) {
+            out[i + l] = s.offset == 0 ? acc[l] : acc[l] * ipow(x[i + l], s.offset);
+        }
+    }
+    for (; i < n; ++i) {
+        out[i] = evaluate_one(s, x[i]);
+    }
+}
+
+//==============================================================================
+// x86 kernels
+//==============================================================================
+
+#if MATHLIB_SIMD_X86
+
+MATHLIB_TARGET_AVX2 __m256d ipow_avx2(__m256d x, unsigned k) {
+    __m256d result = _mm256_set1_pd(1.0);
+    while (k != 0) {
+        if ((k & 1U) != 0) {
+            result = _mm256_mul_pd(result, x);
+        }
+        x = _mm256_mul_pd(x, x);
+        k >>= 1;
+    }
+    return result;
+}
+
+/**
+ * @brief AVX2 kernel: four 4-wide Horner chains per iteration
+ *
+ * @details
+ * Four vectors cover the latency of a fused multiply-add (4 cycles) at
+ * one FMA per cycle; the scalar kernel handles the last n % 16 elements.
+ */
+MATHLIB_TARGET_AVX2 void evaluate_avx2(const SeriesShape& s, const double* x, double* out,
+                                       std::size_t n) {
+    constexpr std::size_t VECTORS = 4;
+    std::size_t i = 0;
+    for (; i + 4 * VECTORS <= n; i += 4 * VECTORS) {
+        __m256d xs[VECTORS];
+        __m256d y[VECTORS];
+        __m256d acc[VECTORS];
+        const __m256d top = _mm256_set1_pd(s.c[s.count - 1]);
+        for (std::size_t v = 0; v < VECTORS; ++v) {
+            xs[v] = _mm256_loadu_pd(x + i + 4 * v);
+            y[v] = s.step == 1 ? xs[v] : ipow_avx2(xs[v], s.step);
+            acc[v] = top;
+        }
+        for (std::size_t k = s.count - 1; k-- > 0;) {
+            const __m256d c = _mm256_set1_pd(s.c[k]);
+            for (std::size_t v = 0; v < VECTORS; ++v) {
+                acc[v] = _mm256_fmadd_pd(acc[v], y[v], c);
+            }
+        }
+        for (std::size_t v = 0; v < VECTORS; ++v) {
+            if (s.offset != 0) {
+                acc[v] = _mm256_mul_pd(acc[v], ipow_avx2(xs[v], s.offset));
+            }
+            _mm256_storeu_pd(out + i + 4 * v, acc[v]);
+        }
+    }
+    evaluate_scalar(s, x + i, out + i, n - i);
+}
+
+MATHLIB_TARGET_AVX512 __m512d ipow_avx512(__m512d x, unsigned k) {
+    __m512d result = _mm512_set1_pd(1.0);
+    while (k != 0) {
+        if ((k & 1U) != 0) {
+            result = _mm512_mul_pd(result, x);
+        }
+        x = _mm512_mul_pd(x, x);
+        k >>= 1;
+    }
+    return result;
+}
+
+/// One 8-wide Horner chain on the (masked) elements [i, i + 8)
+MATHLIB_TARGET_AVX512 void evaluate_avx512_tail(const SeriesShape& s, const double* x,
+                                                double* out, __mmask8 mask) {
+    const __m512d xs = _mm512_maskz_loadu_pd(mask, x);
+    const __m512d y = s.step == 1 ? xs : ipow_avx512(xs, s.step);
+    __m512d acc = _mm512_set1_pd(s.c[s.count - 1]);
+    for (std::size_t k = s.count - 1; k-- > 0;) {
+        acc = _mm512_fmadd_pd(acc, y, _mm512_set1_pd(s.c[k]));
+    }
+    if (s.offset != 0) {
+        acc = _mm512_mul_pd(acc, ipow_avx512(xs, s.offset));
+    }
+    _mm512_mask_storeu_pd(out, mask, acc);
+}
+
+/**
+ * @brief AVX-512 kernel: four 8-wide Horner chains per iteration
+ *
+ * @details
+ * The remaining vectors are processed one at a time, the last one masked.
+ */
+MATHLIB_TARGET_AVX512 void evaluate_avx512(const SeriesShape& s, const double* x, double* out,
+                                           std::size_t n) {
+    constexpr std::size_t VECTORS = 4;
+    std::size_t i = 0;
+    for (; i + 8 * VECTORS <= n; i += 8 * VECTORS) {
+        __m512d xs[VECTORS];
+        __m512d y[VECTORS];
+        __m512d acc[VECTORS];
+        const __m512d top = _mm512_set1_pd(s.c[s.count - 1]);
+        for (std::size_t v = 0; v < VECTORS; ++v) {
+            xs[v] = _mm512_loadu_pd(x + i + 8 * v);
+            y[v] = s.step == 1 ? xs[v] : ipow_avx512(xs[v], s.step);
+            acc[v] = top;
+        }
+        for (std::size_t k = s.count - 1; k-- > 0;) {
+            const __m512d c = _mm512_set1_pd(s.c[k]);
+            for (std::size_t v = 0; v < VECTORS; ++v) {
+                acc[v] = _mm512_fmadd_pd(acc[v], y[v], c);
+            }
+        }
+        for (std::size_t v = 0; v < VECTORS; ++v) {
+            if (s.offset != 0) {
+                acc[v] = _mm512_mul_pd(acc[v], ipow_avx512(xs[v], s.offset));
+            }
+            _mm512_storeu_pd(out + i + 8 * v, acc[v]);
+        }
+    }
+    for (; i < n; i += 8) {
+        const std::size_t left = n - i;
+        const __mmask8 mask =
+            left >= 8 ? static_cast<__mmask8>(0xFF) : static_cast<__mmask8>((1U << left) - 1U);
+        evaluate_avx512_tail(s, x + i, out + i, mask);
+    }
+}
+
+#endif  // MATHLIB_SIMD_X86
+
+//==============================================================================
+// ARM kernels
+//==============================================================================
+
+#if MATHLIB_SIMD_NEON
+
+float64x2_t ipow_neon(float64x2_t x, unsigned k) {
+    float64x2_t result = vdupq_n_f64(1.0);
+    while (k != 0) {
+        if ((k & 1U) != 0) {
+            result = vmulq_f64(result, x);
+        }
+        x = vmulq_f64(x, x);
+        k >>= 1;
+    }
+    return result;
+}
+
+/// NEON kernel: four 2-wide Horner chains per iteration
+void evaluate_neon(const SeriesShape& s, const double* x, double* out, std::size_t n) {
+    constexpr std::size_t VECTORS = 4;
+    std::size_t i = 0;
+    for (; i + 2 * VECTORS <= n; i += 2 * VECTORS) {
+        float64x2_t xs[VECTORS];
+        float64x2_t y[VECTORS];
+        float64x2_t acc[VECTORS];
+        const float64x2_t top = vdupq_n_f64(s.c[s.count - 1]);
+        for (std::size_t v = 0; v < VECTORS; ++v) {
+            xs[v] = vld1q_f64(x + i + 2 * v);
+            y[v] = s.step == 1 ? xs[v] : ipow_neon(xs[v], s.step);
+            acc[v] = top;
+        }
+        for (std::size_t k = s.count - 1; k-- > 0;) {
+            const float64x2_t c = vdupq_n_f64(s.c[k]);
+            for (std::size_t v = 0; v < VECTORS; ++v) {
+                acc[v] = vfmaq_f64(c, acc[v], y[v]);
+            }
+        }
+        for (std::size_t v = 0; v < VECTORS; ++v) {
+            if (s.offset != 0) {
+                acc[v] = vmulq_f64(acc[v], ipow_neon(xs[v], s.offset));
+            }
+            vst1q_f64(out + i + 2 * v, acc[v]);
+        }
+    }
+    evaluate_scalar(s, x + i, out + i, n - i);
+}
+
+#endif  // MATHLIB_SIMD_NEON
+
+}  // namespace
+
+double horner(const double* c, std::size_t count, double x) noexcept {
+    if (count == 0) {
+        return 0.0;
+    }
+    double acc = c[count - 1];
+    for (std::size_t k = count - 1; k-- > 0;) {
+        acc = acc * x + c[k];
+    }
+    return acc;
+}
+
+double estrin(const double* c, std::size_t count, double x) noexcept {
+    if (count <= ESTRIN_BLOCK) {
+        return count == 0 ? 0.0 : estrin_block(c, count, x);
+    }
+    // Horner's scheme over blocks, in powers of x^ESTRIN_BLOCK
+    const double y = ipow(x, static_cast<unsigned>(ESTRIN_BLOCK));
+    std::size_t first = (count - 1) / ESTRIN_BLOCK * ESTRIN_BLOCK;
+    double acc = estrin_block(c + first, count - first, x);
+    while (first > 0) {
+        first -= ESTRIN_BLOCK;
+        acc = acc * y + estrin_block(c + first, ESTRIN_BLOCK, x);
+    }
+    return acc;
+}
+
+TaylorSeries::TaylorSeries(std::vector<double> coefficients, unsigned step, unsigned offset)
+    : coefficients_(std::move(coefficients)), step_(step), offset_(offset) {
+    if (step == 0) {
+        detail::raise(std::invalid_argument("Series step must be positive"));
+    }
+}
+
+TaylorSeries TaylorSeries::from_derivatives(const double* derivatives, std::size_t count) {
+    count = std::min<std::size_t>(count, FACTORIAL_MAX + 1);
+    std::vector<double> c(count);
+    for (std::size_t k = 0; k < count; ++k) {
+        c[k] = derivatives[k] * detail::INV_FACTORIAL_TABLE[k];
+    }
+    return TaylorSeries(std::move(c));
+}
+
+TaylorSeries TaylorSeries::exp(std::size_t terms) {
+    std::vector<double> c(terms);
+    for (std::size_t k = 0; k < terms; ++k) {
+        c[k] = inv_factorial(static_cast<int>(k));
+    }
+    return TaylorSeries(std::move(c));
+}
+
+TaylorSeries TaylorSeries::sin(std::size_t terms) {
+    std::vector<double> c(terms);
+    for (std::size_t k = 0; k < terms; ++k) {
+        const double sign = (k & 1U) != 0 ? -1.0 : 1.0;
+        c[k] = sign * inv_factorial(static_cast<int>(2 * k + 1));
+    }
+    return TaylorSeries(std::move(c), 2, 1);
+}
+
+TaylorSeries TaylorSeries::cos(std::size_t terms) {
+    std::vector<double> c(terms);
+    for (std::size_t k = 0; k < terms; ++k) {
+        const double sign = (k & 1U) != 0 ? -1.0 : 1.0;
+        c[k] = sign * inv_factorial(static_cast<int>(2 * k));
+    }
+    return TaylorSeries(std::move(c), 2, 0);
+}
+
+double TaylorSeries::evaluate(double x, SeriesScheme scheme) const noexcept {
+    const double y = step_ == 1 ? x : ipow(x, step_);
+    const double p = scheme == SeriesScheme::Estrin
+                         ? estrin(coefficients_.data(), coefficients_.size(), y)
+                         : horner(coefficients_.data(), coefficients_.size(), y);
+    return offset_ == 0 ? p : p * ipow(x, offset_);
+}
+
+void TaylorSeries::evaluate_n(const double* x, double* out, std::size_t n) const {
+    if (coefficients_.empty()) {
+        std::fill(out, out + n, 0.0);
+        return;
+    }
+    const SeriesShape shape{coefficients_.data(), coefficients_.size(), step_, offset_};
+    switch (active_simd_isa()) {
+#if MATHLIB_SIMD_X86
+        case SimdIsa::Avx512:
+            evaluate_avx512(shape, x, out, n);
+            return;
+        case SimdIsa::Avx2:
+            evaluate_avx2(shape, x, out, n);
+            return;
+#endif
+#if MATHLIB_SIMD_NEON
+        case SimdIsa::Neon:
+            evaluate_neon(shape, x, out, n);
+            return;
+#endif
+        default:
+            evaluate_scalar(shape, x, out, n);
+            return;
+    }
+}
+
+}  // namespace mathlib
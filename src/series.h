@@ -0,0 +1,179 @@
+/**
+ * @file series.h
+ * @brief Truncated power series and polynomial evaluation
+ *
+ * The usual way to evaluate a Taylor expansion such as
+ * \f$ e^x = \sum_{k=0}^{N-1} x^k / k! \f$ term by term costs a pow() and a
+ * factorial() per term. A TaylorSeries stores the coefficients
+ * \f$ c_k = f^{(k)}(0) / k! \f$ once, taken from a compile-time table of
+ * reciprocal factorials, and evaluates the polynomial with Horner's or
+ * Estrin's scheme; evaluate_n() runs on whole arrays with the active SIMD
+ * instruction set (see simd.h).
+ *
+ * @par Example:
+ * @code
+ * const auto exp_series = mathlib::TaylorSeries::exp(18);  // |error| < 2e-16 for |x| ≤ 1
+ * double y = exp_series(0.5);
+ * exp_series.evaluate_n(x.data(), y.data(), x.size());
+ * @endcode
+ *
+ * @author Your Name
+ * @date 2026-01-05
+ * @version 1.0.0
+ */
+
+#ifndef SERIES_H
+#define SERIES_H
+
+#include "mathlib.h"
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace mathlib {
+
+namespace detail {
+
+/**
+ * @brief Builds the table of 1/n! for n = 0 ... FACTORIAL_MAX at compile time
+ *
+ * Each entry is the correctly rounded quotient 1 / FACTORIAL_TABLE[n].
+ */
+constexpr std::array<double, FACTORIAL_MAX + 1> make_inv_factorial_table() {
+    std::array<double, FACTORIAL_MAX + 1> table{};
+    for (int i = 0; i <= FACTORIAL_MAX; ++i) {
+        table[i] = 1.0 / FACTORIAL_TABLE[i];
+    }
+    return table;
+}
+
+/// 1/n! for n = 0 ... FACTORIAL_MAX
+inline constexpr std::array<double, FACTORIAL_MAX + 1> INV_FACTORIAL_TABLE =
+    make_inv_factorial_table();
+
+}  // namespace detail
+
+/**
+ * @brief Reciprocal factorial 1/n!
+ *
+ * @param n Any integer
+ * @return 1/n!; 0 for n < 0 (the limit of 1/Γ(n + 1) at the poles) and for
+ *         n > FACTORIAL_MAX, where 1/n! underflows to 0 or a subnormal
+ *
+ * @par Example:
+ * @code
+ * static_assert(mathlib::inv_factorial(3) == 1.0 / 6.0);
+ * @endcode
+ */
+constexpr double inv_factorial(int n) noexcept {
+    return n < 0 || n > FACTORIAL_MAX ? 0.0 : detail::INV_FACTORIAL_TABLE[n];
+}
+
+/// Polynomial evaluation scheme
+enum class SeriesScheme {
+    Horner,  ///< n - 1 dependent multiply-adds: fewest operations, longest dependency chain
+    Estrin   ///< Independent pairs combined with x², x⁴, ...: depth O(log n), more parallelism
+};
+
+/**
+ * @brief Evaluates \f$ \sum_{k<count} c_k x^k \f$ with Horner's scheme
+ *
+ * @param c     Coefficients, constant term first
+ * @param count Number of coefficients (0 gives 0)
+ * @param x     Argument
+ */
+double horner(const double* c, std::size_t count, double x) noexcept;
+
+/**
+ * @brief Evaluates \f$ \sum_{k<count} c_k x^k \f$ with Estrin's scheme
+ *
+ * @details
+ * Adjacent coefficients are combined pairwise, \f$ c_{2i} + c_{2i+1} x \f$,
+ * then the pairs with \f$ x^2 \f$, and so on: the multiply-adds of each
+ * round are independent, so out-of-order cores overlap them. This
+ * shortens the latency of a single evaluation (by about 40% for 18
+ * coefficients); when many independent evaluations overlap anyway,
+ * horner() has the higher throughput. Results may differ from horner() in
+ * the last bits.
+ *
+ * @param c     Coefficients, constant term first
+ * @param count Number of coefficients (0 gives 0)
+ * @param x     Argument
+ */
+double estrin(const double* c, std::size_t count, double x) noexcept;
+
+/**
+ * @class TaylorSeries
+ * @brief Truncated power series \f$ x^{offset} \sum_k c_k x^{k \cdot step} \f$
+ *
+ * The step and offset describe series with only even or only odd powers
+ * (step 2, e.g. sin and cos) without storing or multiplying the zero
+ * coefficients.
+ */
+class TaylorSeries {
+  public:
+    /**
+     * @brief Series with the given coefficients
+     *
+     * @param coefficients c_k, constant term first
+     * @param step         Power of x between consecutive coefficients (≥ 1)
+     * @param offset       Power of x factored out of every term
+     *
+     * @throw std::invalid_argument if step is 0
+     */
+    explicit TaylorSeries(std::vector<double> coefficients, unsigned step = 1,
+                          unsigned offset = 0);
+
+    /**
+     * @brief Taylor polynomial of f around 0 from its derivatives
+     *
+     * @param derivatives \f$ f(0), f'(0), f''(0), ... \f$; at most
+     *                    FACTORIAL_MAX + 1 values are used
+     * @param count       Number of derivatives
+     * @return The series with \f$ c_k = f^{(k)}(0) / k! \f$
+     */
+    static TaylorSeries from_derivatives(const double* derivatives, std::size_t count);
+
+    /// \f$ e^x \approx \sum_{k<terms} x^k / k! \f$
+    static TaylorSeries exp(std::size_t terms);
+
+    /// \f$ \sin x \approx \sum_{k<terms} (-1)^k x^{2k+1} / (2k+1)! \f$
+    static TaylorSeries sin(std::size_t terms);
+
+    /// \f$ \cos x \approx \sum_{k<terms} (-1)^k x^{2k} / (2k)! \f$
+    static TaylorSeries cos(std::size_t terms);
+
+    const std::vector<double>& coefficients() const { return coefficients_; }
+    unsigned step() const { return step_; }
+    unsigned offset() const { return offset_; }
+
+    /// Evaluates the series at @p x with the chosen scheme
+    double evaluate(double x, SeriesScheme scheme = SeriesScheme::Horner) const noexcept;
+
+    /// Same as evaluate(x)
+    double operator()(double x) const noexcept { return evaluate(x); }
+
+    /**
+     * @brief Evaluates the series for every element of an array
+     *
+     * Every SIMD lane runs Horner's scheme on its own argument, several
+     * vectors at a time, so the dependency chains of different elements
+     * overlap. Fused multiply-adds are used where available: results may
+     * differ from evaluate() in the last bit.
+     *
+     * @param x   Input array of @p n arguments
+     * @param out Output array of @p n values (may be the same array as @p x)
+     * @param n   Number of elements
+     */
+    void evaluate_n(const double* x, double* out, std::size_t n) const;
+
+  private:
+    std::vector<double> coefficients_;
+    unsigned step_;
+    unsigned offset_;
+};
+
+}  // namespace mathlib
+
+#endif  // SERIES_H
@@ -0,0 +1,162 @@
+/**
+ * @file simd.cpp
+ * @brief Implementation of runtime SIMD detection
+ */
+
+#include "simd.h"
+#include "simd_internal.h"
+
+#include <atomic>
+#include <cstdint>
+
+#if MATHLIB_SIMD_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace mathlib {
+
+namespace {
+
+#if MATHLIB_SIMD_X86
+
+struct CpuidRegs {
+    std::uint32_t eax = 0;
+    std::uint32_t ebx = 0;
+    std::uint32_t ecx = 0;
+    std::uint32_t edx = 0;
+};
+
+CpuidRegs cpuid(std::uint32_t leaf, std::uint32_t subleaf) {
+    CpuidRegs r;
+#if defined(_MSC_VER)
+    int regs[4];
+    __cpuidex(regs, static_cast<int>(leaf), static_cast<int>(subleaf));
+    r.eax = static_cast<std::uint32_t>(regs[0]);
+    r.ebx = static_cast<std::uint32_t>(regs[1]);
+    r.ecx = static_cast<std::uint32_t>(regs[2]);
+    r.edx = static_cast<std::uint32_t>(regs[3]);
+#else
+    __cpuid_count(leaf, subleaf, r.eax, r.ebx, r.ecx, r.edx);
+#endif
+    return r;
+}
+
+/// Reads XCR0, i.e. which register states the OS saves on context switch
+std::uint64_t read_xcr0() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    std::uint32_t lo = 0;
+    std::uint32_t hi = 0;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return (static_cast<std::uint64_t>(hi) << 32U) | lo;
+#endif
+}
+
+/**
+ * @brief Detects the widest usable x86 instruction set
+ *
+ * @details
+ * A CPU flag alone is not enough: the OS must also save the wider
+ * registers (YMM for AVX2, ZMM and opmask for AVX-512), which is checked
+ * through OSXSAVE and XCR0.
+ */
+SimdIsa detect_x86() {
+    const std::uint32_t max_leaf = cpuid(0, 0).eax;
+    if (max_leaf < 7) {
+        return SimdIsa::Scalar;
+    }
+
+    const CpuidRegs leaf1 = cpuid(1, 0);
+    const bool osxsave = (leaf1.ecx & (1U << 27U)) != 0;
+    const bool fma = (leaf1.ecx & (1U << 12U)) != 0;
+    if (!osxsave) {
+        return SimdIsa::Scalar;
+    }
+
+    const std::uint64_t xcr0 = read_xcr0();
+    const bool ymm_state = (xcr0 & 0x6U) == 0x6U;
+    const bool zmm_state = (xcr0 & 0xE6U) == 0xE6U;
+
+    const CpuidRegs leaf7 = cpuid(7, 0);
+    const bool avx2 = (leaf7.ebx & (1U << 5U)) != 0;
+    const bool avx512f = (leaf7.ebx & (1U << 16U)) != 0;
+
+    if (avx512f && zmm_state) {
+        return SimdIsa::Avx512;
+    }
+    if (avx2 && fma && ymm_state) {
+        return SimdIsa::Avx2;
+    }
+    return SimdIsa::Scalar;
+}
+
+#endif  // MATHLIB_SIMD_X86
+
+SimdIsa detect_best_isa() {
+#if MATHLIB_SIMD_X86
+    return detect_x86();
+#elif MATHLIB_SIMD_NEON
+    return SimdIsa::Neon;
+#else
+    return SimdIsa::Scalar;
+#endif
+}
+
+SimdIsa best_isa() {
+    static const SimdIsa best = detect_best_isa();
+    return best;
+}
+
+std::atomic<SimdIsa>& selected_isa() {
+    static std::atomic<SimdIsa> selected{best_isa()};
+    return selected;
+}
+
+}  // namespace
+
+SimdIsa active_simd_isa() {
+    return selected_isa().load(std::memory_order_relaxed);
+}
+
+bool simd_isa_supported(SimdIsa isa) {
+    switch (isa) {
+        case SimdIsa::Scalar:
+            return true;
+        case SimdIsa::Neon:
+            return MATHLIB_SIMD_NEON != 0;
+        case SimdIsa::Avx2:
+            return best_isa() == SimdIsa::Avx2 || best_isa() == SimdIsa::Avx512;
+        case SimdIsa::Avx512:
+            return best_isa() == SimdIsa::Avx512;
+    }
+    return false;
+}
+
+bool set_simd_isa(SimdIsa isa) {
+    if (!simd_isa_supported(isa)) {
+        return false;
+    }
+    selected_isa().store(isa, std::memory_order_relaxed);
+    return true;
+}
+
+const char* simd_isa_name(SimdIsa isa) {
+    switch (isa) {
+        case SimdIsa::Scalar:
+            return "scalar";
+        case SimdIsa::Neon:
+            return "neon";
+        case SimdIsa::Avx2:
+            return "avx2";
+        case SimdIsa::Avx512:
+            return "avx512";
+    }
+    return "unknown";
+}
+
+}  // namespace mathlib
@@ -0,0 +1,82 @@
+/**
+ * @file simd.h
+ * @brief Runtime SIMD instruction set detection and kernel selection
+ *
+ * The batch functions of mathlib (for example mathlib::square_n()) ship
+ * several hand-vectorized kernels in the same binary. At first use the
+ * library inspects the CPU and selects the widest instruction set that is
+ * both supported by the hardware and enabled by the operating system.
+ *
+ * @author Your Name
+ * @date 2026-01-05
+ * @version 1.0.0
+ */
+
+#ifndef SIMD_H
+#define SIMD_H
+
+namespace mathlib {
+
+/**
+ * @enum SimdIsa
+ * @brief Instruction sets for which mathlib provides batch kernels
+ *
+ * Values are ordered from narrowest to widest on each architecture, so
+ * comparisons such as `isa >= SimdIsa::Avx2` are meaningful on x86.
+ */
+enum class SimdIsa {
+    Scalar,  ///< Portable C++ loop, always available
+    Neon,    ///< ARMv8 Advanced SIMD (128-bit)
+    Avx2,    ///< x86 AVX2 (256-bit)
+    Avx512   ///< x86 AVX-512F (512-bit)
+};
+
+/**
+ * @brief Returns the instruction set currently used by the batch kernels
+ *
+ * On the first call the widest supported instruction set is detected and
+ * cached. The result can be changed later with set_simd_isa().
+ *
+ * @return The active instruction set
+ *
+ * @par Example:
+ * @code
+ * std::cout << mathlib::simd_isa_name(mathlib::active_simd_isa()) << '\n';
+ * @endcode
+ */
+SimdIsa active_simd_isa();
+
+/**
+ * @brief Checks whether an instruction set can be used on this machine
+ *
+ * @param isa The instruction set to query
+ * @return true if the CPU and operating system support @p isa and the
+ *         library was compiled with a kernel for it
+ */
+bool simd_isa_supported(SimdIsa isa);
+
+/**
+ * @brief Forces the batch kernels to use a specific instruction set
+ *
+ * Mainly useful for testing every kernel on one machine and for
+ * benchmarking the kernels against each other.
+ *
+ * @param isa The instruction set to select
+ * @return true on success, false if @p isa is not supported (the active
+ *         instruction set is left unchanged)
+ *
+ * @warning Not intended to be called while other threads run batch kernels
+ */
+bool set_simd_isa(SimdIsa isa);
+
+/**
+ * @brief Returns a human readable name for an instruction set
+ *
+ * @param isa The instruction set
+ * @return A static string such as "avx2" or "scalar"
+ */
+const char* simd_isa_name(SimdIsa isa);
+
+}  // namespace mathlib
+
+#endif  // SIMD_H
@@ -0,0 +1,47 @@
+/**
+ * @file simd_internal.h
+ * @brief Internal helpers for writing per-ISA kernels
+ *
+ * Not part of the public API. Kernels for wider instruction sets are
+ * compiled in the same translation unit as the portable code and tagged
+ * with a target attribute, so the library can be built without global
+ * `-mavx2` flags and still select AVX2/AVX-512 at runtime.
+ */
+
+#ifndef SIMD_INTERNAL_H
+#define SIMD_INTERNAL_H
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define MATHLIB_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define MATHLIB_SIMD_X86 0
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define MATHLIB_SIMD_NEON 1
+#include <arm_neon.h>
+#else
+#define MATHLIB_SIMD_NEON 0
+#endif
+
+// GCC and Clang need a per-function target attribute to emit instructions
+// beyond the baseline ISA; MSVC accepts any intrinsic unconditionally.
+#if defined(__GNUC__) || defined(__clang__)
+#define MATHLIB_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define MATHLIB_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+#define MATHLIB_TARGET_AVX2
+#define MATHLIB_TARGET_AVX512
+#endif
+
+// Software prefetch into all cache levels; a hint that never faults
+#if MATHLIB_SIMD_X86
+#define MATHLIB_PREFETCH(address) _mm_prefetch(reinterpret_cast<const char*>(address), _MM_HINT_T0)
+#elif defined(__GNUC__) || defined(__clang__)
+#define MATHLIB_PREFETCH(address) __builtin_prefetch(address)
+#else
+#define MATHLIB_PREFETCH(address) static_cast<void>(address)
+#endif
+
+#endif  // SIMD_INTERNAL_H
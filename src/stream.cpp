@@ -0,0 +1,112 @@
+/**
+ * @file stream.cpp
+ * @brief Implementation of chunked array-file processing
+ */
+
+#include "stream.h"
+#include "error.h"
+#include "mapped_file.h"
+#include "mathlib.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <stdexcept>
+#include <system_error>
+
+namespace mathlib {
+
+namespace detail {
+
+std::size_t stream_chunks(const std::vector<StreamInput>& inputs, const std::string& output,
+                          std::size_t output_element_size, const StreamOptions& options,
+                          const StreamKernel& kernel) {
+    if (options.chunk_elements == 0) {
+        detail::raise(std::invalid_argument("Stream chunk size must be positive"));
+    }
+
+    std::vector<MappedFile> files;
+    files.reserve(inputs.size());
+    std::size_t count = 0;
+    for (std::size_t k = 0; k < inputs.size(); ++k) {
+        files.push_back(MappedFile::open(*inputs[k].path));
+        const std::size_t size = files.back().size();
+        if (size % inputs[k].element_size != 0) {
+            detail::raise(
+                std::runtime_error(*inputs[k].path + " is not a whole number of elements"));
+        }
+        const std::size_t elements = size / inputs[k].element_size;
+        if (k == 0) {
+            count = elements;
+        } else if (elements != count) {
+            detail::raise(std::invalid_argument("Stream inputs have different lengths"));
+        }
+        files.back().advise(MapAdvice::Sequential);
+    }
+
+    // Creating the output truncates it: it must not be one of the mapped
+    // inputs (compared by device and inode, so links are caught too)
+    for (const StreamInput& input : inputs) {
+        std::error_code error;
+        if (std::filesystem::equivalent(output, *input.path, error)) {
+            detail::raise(std::invalid_argument("Stream output " + output + " is also an input"));
+        }
+    }
+
+    if (count == 0) {
+        // Mappings cannot be empty: create a minimal file and trim it
+        MappedFile::create(output, 1).close(0);
+        return 0;
+    }
+
+    MappedFile out = MappedFile::create(output, count * output_element_size);
+    out.advise(MapAdvice::Sequential);
+
+    std::vector<const char*> chunk_inputs(inputs.size());
+    for (std::size_t first = 0; first < count; first += options.chunk_elements) {
+        const std::size_t n = std::min(options.chunk_elements, count - first);
+
+        if (options.prefetch && first + n < count) {
+            for (std::size_t k = 0; k < inputs.size(); ++k) {
+                files[k].advise(MapAdvice::WillNeed, (first + n) * inputs[k].element_size,
+                                n * inputs[k].element_size);
+            }
+        }
+
+        for (std::size_t k = 0; k < inputs.size(); ++k) {
+            chunk_inputs[k] = files[k].data() + first * inputs[k].element_size;
+        }
+        kernel(chunk_inputs.data(), out.data() + first * output_element_size, n);
+
+        if (options.drop_behind) {
+            // Written output pages stay in the page cache until written back
+            for (std::size_t k = 0; k < inputs.size(); ++k) {
+                files[k].advise(MapAdvice::DontNeed, first * inputs[k].element_size,
+                                n * inputs[k].element_size);
+            }
+            out.advise(MapAdvice::DontNeed, first * output_element_size, n * output_element_size);
+        }
+    }
+
+    out.close(out.size());
+    return count;
+}
+
+}  // namespace detail
+
+std::size_t stream_square_n(const std::string& input, const std::string& output,
+                            const StreamOptions& options) {
+    return stream_transform<double, double>(
+        input, output,
+        [](const double* in, double* out, std::size_t n) { square_n(in, out, n); }, options);
+}
+
+std::size_t stream_factorial_n(const std::string& input, const std::string& output,
+                               const StreamOptions& options) {
+    static_assert(sizeof(int) == sizeof(std::int32_t), "stream_factorial_n reads 32-bit ints");
+    return stream_transform<int, double>(
+        input, output,
+        [](const int* in, double* out, std::size_t n) { factorial_n(in, out, n); }, options);
+}
+
+}  // namespace mathlib
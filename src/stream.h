@@ -0,0 +1,147 @@
+/**
+ * @file stream.h
+ * @brief Chunked processing of on-disk arrays larger than memory
+ *
+ * The stream functions map raw binary array files (native byte order, no
+ * header) with MappedFile and run a batch kernel over them chunk by chunk,
+ * writing the results into a mapped output file. Only the chunks in
+ * flight need to be resident: the next chunk is prefetched while the
+ * current one is computed, and finished chunks are released, so a
+ * multi-GB field never has to fit in RAM.
+ *
+ * @par Example:
+ * @code
+ * // Element-wise T² / P² of two 8 GB fields, fused with expr.h
+ * mathlib::stream_transform<double, double>(
+ *     "temperature.f64", "pressure.f64", "ratio.f64",
+ *     [](const double* t, const double* p, double* out, std::size_t n) {
+ *         using namespace mathlib::expr;
+ *         evaluate(square(view(t, n)) / square(view(p, n)), out);
+ *     });
+ * @endcode
+ *
+ * @author Your Name
+ * @date 2026-01-05
+ * @version 1.0.0
+ */
+
+#ifndef STREAM_H
+#define STREAM_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace mathlib {
+
+/**
+ * @brief Chunking and paging hints of a stream pass
+ */
+struct StreamOptions {
+    /// Elements per chunk (8 MiB of doubles by default)
+    std::size_t chunk_elements = std::size_t{1} << 20;
+
+    /// Ask the OS to read the next input chunk while the current one is processed
+    bool prefetch = true;
+
+    /// Release the pages of finished chunks instead of letting them accumulate
+    bool drop_behind = true;
+};
+
+namespace detail {
+
+/// An input file and the size of its elements
+struct StreamInput {
+    const std::string* path;
+    std::size_t element_size;
+};
+
+/// Processes @p count elements; pointers to the inputs in order, and to the output
+using StreamKernel =
+    std::function<void(const char* const* inputs, char* output, std::size_t count)>;
+
+/**
+ * @brief Maps the inputs, creates the output and runs @p kernel chunk by chunk
+ * @return Number of elements processed
+ */
+std::size_t stream_chunks(const std::vector<StreamInput>& inputs, const std::string& output,
+                          std::size_t output_element_size, const StreamOptions& options,
+                          const StreamKernel& kernel);
+
+}  // namespace detail
+
+/**
+ * @brief Applies a batch kernel to an array file, writing an array file
+ *
+ * @tparam In     Element type of the input file
+ * @tparam Out    Element type of the output file
+ * @param input   Raw array of In
+ * @param output  Created or truncated; receives one Out per input element.
+ *                Must not be the input file (not even through a link).
+ * @param kernel  Callable as `kernel(const In* in, Out* out, std::size_t n)`
+ * @param options Chunk size and paging hints
+ * @return Number of elements processed
+ *
+ * @throw std::invalid_argument if options.chunk_elements is 0, or if
+ *        @p output is the same file as @p input
+ * @throw std::runtime_error if the input size is not a multiple of sizeof(In)
+ * @throw std::system_error if a file cannot be opened, created or mapped
+ *
+ * @note An exception thrown by the kernel propagates; the output file
+ *       then holds the chunks completed so far.
+ */
+template <typename In, typename Out, typename Kernel>
+std::size_t stream_transform(const std::string& input, const std::string& output, Kernel kernel,
+                             const StreamOptions& options = {}) {
+    static_assert(std::is_trivially_copyable_v<In> && std::is_trivially_copyable_v<Out>,
+                  "Stream elements must be trivially copyable");
+    return detail::stream_chunks(
+        {{&input, sizeof(In)}}, output, sizeof(Out), options,
+        [&kernel](const char* const* in, char* out, std::size_t n) {
+            kernel(reinterpret_cast<const In*>(in[0]), reinterpret_cast<Out*>(out), n);
+        });
+}
+
+/**
+ * @brief Applies a batch kernel to two array files of equal length
+ *
+ * Same as the single-input version with
+ * `kernel(const In* a, const In* b, Out* out, std::size_t n)`.
+ *
+ * @throw std::invalid_argument if the inputs hold different numbers of elements
+ */
+template <typename In, typename Out, typename Kernel>
+std::size_t stream_transform(const std::string& input_a, const std::string& input_b,
+                             const std::string& output, Kernel kernel,
+                             const StreamOptions& options = {}) {
+    static_assert(std::is_trivially_copyable_v<In> && std::is_trivially_copyable_v<Out>,
+                  "Stream elements must be trivially copyable");
+    return detail::stream_chunks(
+        {{&input_a, sizeof(In)}, {&input_b, sizeof(In)}}, output, sizeof(Out), options,
+        [&kernel](const char* const* in, char* out, std::size_t n) {
+            kernel(reinterpret_cast<const In*>(in[0]), reinterpret_cast<const In*>(in[1]),
+                   reinterpret_cast<Out*>(out), n);
+        });
+}
+
+/**
+ * @brief Squares every double of an array file (square_n() per chunk)
+ * @see stream_transform()
+ */
+std::size_t stream_square_n(const std::string& input, const std::string& output,
+                            const StreamOptions& options = {});
+
+/**
+ * @brief Factorials of an array file of 32-bit ints, written as doubles
+ *
+ * @throw std::invalid_argument if an element is negative
+ * @see factorial_n(), stream_transform()
+ */
+std::size_t stream_factorial_n(const std::string& input, const std::string& output,
+                               const StreamOptions& options = {});
+
+}  // namespace mathlib
+
+#endif  // STREAM_H
@@ -0,0 +1,17 @@
+# Fails unless LIBRARY defines the demangled SYMBOL (run by CTest, see
+# CMakeLists.txt):
+#   cmake -DNM=nm -DLIBRARY=libmathlib.a -DSYMBOL="mathlib::square(double)" -P check_symbol.cmake
+execute_process(
+    COMMAND ${NM} -C --defined-only ${LIBRARY}
+    OUTPUT_VARIABLE symbols
+    RESULT_VARIABLE result
+)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "${NM} failed on ${LIBRARY}")
+endif()
+
+# Text symbols, weak ones included (inline functions are emitted as such)
+string(REGEX REPLACE "([][()*.+?^$])" "\\\\\\1" pattern "${SYMBOL}")
+if(NOT symbols MATCHES "[ \t][TW] ${pattern}\n")
+    message(FATAL_ERROR "${LIBRARY} does not define ${SYMBOL}")
+endif()
@@ -0,0 +1,148 @@
+#include "aligned_memory.h"
+#include "reduce.h"
+
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+
+bool is_aligned(const void* p, std::size_t alignment) {
+    return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+}
+
+}  // namespace
+
+TEST_CASE("Aligned allocation honors the alignment", "[memory]") {
+    for (std::size_t alignment : {1, 8, 64, 4096}) {
+        void* p = mathlib::allocate_aligned(100, alignment);
+        REQUIRE(p != nullptr);
+        REQUIRE(is_aligned(p, alignment));
+        mathlib::deallocate_aligned(p);
+    }
+
+    void* huge = mathlib::allocate_aligned(1000, 64, mathlib::PageSize::Huge);
+    REQUIRE(is_aligned(huge, mathlib::HUGE_PAGE_SIZE));
+    mathlib::deallocate_aligned(huge);
+
+    REQUIRE(mathlib::allocate_aligned(0) == nullptr);
+    mathlib::deallocate_aligned(nullptr);
+    REQUIRE_THROWS_AS(mathlib::allocate_aligned(8, 48), std::invalid_argument);
+}
+
+TEST_CASE("AlignedBuffer behaves like a numeric vector", "[memory]") {
+    mathlib::AlignedBuffer<double> empty;
+    REQUIRE(empty.empty());
+    REQUIRE(empty.data() == nullptr);
+
+    mathlib::AlignedBuffer<double> buffer(1000);
+    REQUIRE(buffer.size() == 1000);
+    REQUIRE(is_aligned(buffer.data(), mathlib::CACHE_LINE_SIZE));
+    for (double v : buffer) {
+        REQUIRE(v == 0.0);
+    }
+
+    mathlib::AlignedBuffer<int> filled(5, 7);
+    REQUIRE(filled[4] == 7);
+
+    SECTION("resize keeps elements and reuses capacity") {
+        buffer[999] = 3.0;
+        buffer.resize(10);
+        const double* data = buffer.data();
+        buffer.resize(1000);
+        REQUIRE(buffer.data() == data);
+        REQUIRE(buffer[9] == 0.0);
+        REQUIRE(buffer[999] == 0.0);
+
+        buffer[0] = 1.0;
+        buffer.resize(5000);
+        REQUIRE(buffer.capacity() == 5000);
+        REQUIRE(buffer[0] == 1.0);
+        REQUIRE(buffer[4999] == 0.0);
+    }
+
+    SECTION("move transfers ownership") {
+        const double* data = buffer.data();
+        mathlib::AlignedBuffer<double> moved(std::move(buffer));
+        REQUIRE(moved.data() == data);
+        REQUIRE(buffer.data() == nullptr);  // NOLINT(bugprone-use-after-move)
+        buffer = std::move(moved);
+        REQUIRE(buffer.data() == data);
+        REQUIRE(buffer.size() == 1000);
+    }
+
+    SECTION("huge pages") {
+        mathlib::AlignedBuffer<double> huge(100, mathlib::PageSize::Huge);
+        REQUIRE(huge.pages() == mathlib::PageSize::Huge);
+        REQUIRE(is_aligned(huge.data(), mathlib::HUGE_PAGE_SIZE));
+    }
+}
+
+TEST_CASE("ScratchArena allocates in stack order", "[memory][arena]") {
+    mathlib::ScratchArena arena(1024);
+    REQUIRE(arena.heap_allocations() == 1);
+    REQUIRE(arena.used() == 0);
+
+    double* a = arena.allocate<double>(3);
+    REQUIRE(is_aligned(a, mathlib::CACHE_LINE_SIZE));
+    const auto marker = arena.mark();
+    {
+        mathlib::ScratchArena::Scope scope(arena);
+        char* c = scope.allocate<char>(1);
+        REQUIRE(is_aligned(c, mathlib::CACHE_LINE_SIZE));
+        REQUIRE(c >= reinterpret_cast<char*>(a + 3));
+    }
+    REQUIRE(arena.mark().offset == marker.offset);
+
+    void* small = arena.allocate_bytes(1, 1);
+    REQUIRE(static_cast<char*>(small) == reinterpret_cast<char*>(a + 3));
+    REQUIRE_THROWS_AS(arena.allocate_bytes(8, 128), std::invalid_argument);
+
+    arena.reset();
+    REQUIRE(arena.used() == 0);
+    REQUIRE(arena.allocate<double>(3) == a);
+}
+
+TEST_CASE("ScratchArena reaches a steady state without allocations", "[memory][arena]") {
+    mathlib::ScratchArena arena;
+    REQUIRE(arena.capacity() == 0);
+
+    const auto step = [&arena] {
+        mathlib::ScratchArena::Scope scope(arena);
+        for (std::size_t n : {1000, 50000, 200000, 10}) {
+            double* p = scope.allocate<double>(n);
+            p[0] = 1.0;
+            p[n - 1] = 2.0;
+        }
+    };
+
+    step();  // grows through several chunks
+    REQUIRE(arena.heap_allocations() > 1);
+    REQUIRE(arena.peak() >= 251010 * sizeof(double));
+
+    step();  // merges them into one
+    const std::size_t allocations = arena.heap_allocations();
+    REQUIRE(arena.capacity() >= arena.peak());
+    for (int i = 0; i < 10; ++i) {
+        step();
+    }
+    REQUIRE(arena.heap_allocations() == allocations);
+}
+
+TEST_CASE("Reductions draw their scratch space from the thread arena", "[memory][reduce]") {
+    const std::vector<double> x(100000, 0.5);
+    (void)mathlib::sum(x.data(), x.size());
+
+    const std::size_t allocations = mathlib::thread_scratch().heap_allocations();
+    const std::size_t used = mathlib::thread_scratch().used();
+    for (int i = 0; i < 10; ++i) {
+        REQUIRE(mathlib::sum(x.data(), x.size()) == 50000.0);
+        REQUIRE(mathlib::moments(x.data(), x.size()).mean == 0.5);
+    }
+    REQUIRE(mathlib::thread_scratch().heap_allocations() == allocations);
+    REQUIRE(mathlib::thread_scratch().used() == used);
+}
@@ -0,0 +1,223 @@
+#include "async.h"
+#include "mathlib.h"
+#include "parallel.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+namespace {
+
+/// Occupies a pool thread until opened, so that submissions queue up
+class Gate {
+  public:
+    /// Blocks the only worker of @p pool; returns once it is blocked
+    void block(mathlib::ThreadPool& pool) {
+        pool.submit([this] {
+            std::unique_lock<std::mutex> lock(mutex_);
+            started_ = true;
+            cv_.notify_all();
+            cv_.wait(lock, [this] { return open_; });
+        });
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return started_; });
+    }
+
+    void open() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        open_ = true;
+        cv_.notify_all();
+    }
+
+  private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool started_ = false;
+    bool open_ = false;
+};
+
+mathlib::AsyncOptions options(const std::shared_ptr<mathlib::ThreadPool>& pool,
+                              std::size_t max_batch = 1 << 16) {
+    mathlib::AsyncOptions result;
+    result.pool = pool;
+    result.max_batch = max_batch;
+    return result;
+}
+
+}  // namespace
+
+TEST_CASE("Async jobs compute the batch results", "[async]") {
+    auto threads = GENERATE(1U, 2U, 4U);
+    auto pool = std::make_shared<mathlib::ThreadPool>(threads);
+    mathlib::AsyncBatcher batcher(options(pool));
+
+    const std::size_t jobs = 500;
+    const std::size_t len = 37;
+    std::vector<double> in(jobs * len);
+    std::vector<int> n(jobs * len);
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        in[i] = static_cast<double>(i % 101) - 50.5;
+        n[i] = static_cast<int>(i % 30);
+    }
+    std::vector<double> squares(in.size());
+    std::vector<double> factorials(in.size());
+
+    std::vector<mathlib::AsyncJob> submitted;
+    for (std::size_t j = 0; j < jobs; ++j) {
+        submitted.push_back(batcher.square(&in[j * len], &squares[j * len], len));
+        submitted.push_back(batcher.factorial(&n[j * len], &factorials[j * len], len));
+    }
+    for (const auto& job : submitted) {
+        job.wait();
+        REQUIRE(job.status() == mathlib::JobStatus::Done);
+    }
+
+    std::vector<double> expected(in.size());
+    mathlib::square_n(in.data(), expected.data(), in.size());
+    REQUIRE(squares == expected);
+    mathlib::factorial_n(n.data(), expected.data(), n.size());
+    REQUIRE(factorials == expected);
+    REQUIRE(batcher.jobs() == 2 * jobs);
+    REQUIRE(batcher.batches() <= batcher.jobs());
+}
+
+TEST_CASE("Async jobs queued behind a busy pool run as one batch", "[async]") {
+    auto pool = std::make_shared<mathlib::ThreadPool>(2);
+    mathlib::AsyncBatcher batcher(options(pool));
+    Gate gate;
+    gate.block(*pool);
+
+    std::vector<double> in(1000, 3.0);
+    std::vector<double> out(1000);
+    std::vector<mathlib::AsyncJob> submitted;
+    for (std::size_t i = 0; i < in.size(); i += 10) {
+        submitted.push_back(batcher.square(&in[i], &out[i], 10));
+    }
+    REQUIRE(submitted.front().status() == mathlib::JobStatus::Pending);
+
+    gate.open();
+    batcher.wait_all();
+    REQUIRE(batcher.batches() == 1);
+    for (const auto& job : submitted) {
+        REQUIRE(job.ready());
+    }
+    REQUIRE(out == std::vector<double>(1000, 9.0));
+}
+
+TEST_CASE("Async queues are handed over at max_batch elements", "[async]") {
+    auto pool = std::make_shared<mathlib::ThreadPool>(2);
+    mathlib::AsyncBatcher batcher(options(pool, 250));
+    Gate gate;
+    gate.block(*pool);
+
+    // Batches close after jobs 3, 6 and 9; job 10 waits for the drain task
+    std::vector<double> in(1000, 2.0);
+    std::vector<double> out(1000);
+    for (std::size_t i = 0; i < in.size(); i += 100) {
+        batcher.square(&in[i], &out[i], 100);
+    }
+    gate.open();
+    batcher.wait_all();
+    REQUIRE(batcher.batches() == 4);
+    REQUIRE(out == std::vector<double>(1000, 4.0));
+}
+
+TEST_CASE("Large async jobs are split over the pool", "[async]") {
+    auto pool = std::make_shared<mathlib::ThreadPool>(4);
+    mathlib::AsyncBatcher batcher(options(pool, 1000));
+
+    std::vector<double> in(200000);
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        in[i] = static_cast<double>(i) * 0.25;
+    }
+    std::vector<double> out(in.size());
+    batcher.square(in.data(), out.data(), in.size()).wait();
+
+    std::vector<double> expected(in.size());
+    mathlib::square_n(in.data(), expected.data(), in.size());
+    REQUIRE(out == expected);
+}
+
+TEST_CASE("Async jobs can be cancelled until they start", "[async]") {
+    auto pool = std::make_shared<mathlib::ThreadPool>(2);
+    mathlib::AsyncBatcher batcher(options(pool));
+    Gate gate;
+    gate.block(*pool);
+
+    const std::vector<double> in = {1.0, 2.0, 3.0};
+    std::vector<double> kept(3);
+    std::vector<double> dropped(3, -1.0);
+    auto keep = batcher.square(in.data(), kept.data(), in.size());
+    auto drop = batcher.square(in.data(), dropped.data(), in.size());
+
+    int notified = 0;
+    drop.on_complete([&] { ++notified; });
+    REQUIRE(drop.cancel());
+    REQUIRE(notified == 1);
+    REQUIRE_FALSE(drop.cancel());
+    REQUIRE(drop.status() == mathlib::JobStatus::Cancelled);
+    drop.wait();
+
+    gate.open();
+    keep.wait();
+    batcher.wait_all();
+    REQUIRE(keep.status() == mathlib::JobStatus::Done);
+    REQUIRE_FALSE(keep.cancel());
+    REQUIRE(kept == std::vector<double>{1.0, 4.0, 9.0});
+    REQUIRE(dropped == std::vector<double>(3, -1.0));
+}
+
+TEST_CASE("Failed async jobs rethrow without affecting their batch", "[async][exceptions]") {
+    auto pool = std::make_shared<mathlib::ThreadPool>(2);
+    mathlib::AsyncBatcher batcher(options(pool));
+    Gate gate;
+    gate.block(*pool);
+
+    const std::vector<int> good = {3, 4};
+    const std::vector<int> bad = {3, -1};
+    std::vector<double> good_out(2);
+    std::vector<double> bad_out(2);
+    auto first = batcher.factorial(bad.data(), bad_out.data(), bad.size());
+    auto second = batcher.factorial(good.data(), good_out.data(), good.size());
+    gate.open();
+
+    REQUIRE_THROWS_AS(first.wait(), std::invalid_argument);
+    REQUIRE(first.status() == mathlib::JobStatus::Failed);
+    second.wait();
+    REQUIRE(second.status() == mathlib::JobStatus::Done);
+    REQUIRE(good_out == std::vector<double>{6.0, 24.0});
+}
+
+TEST_CASE("Async completion callbacks run once per job", "[async]") {
+    auto threads = GENERATE(1U, 3U);
+    auto pool = std::make_shared<mathlib::ThreadPool>(threads);
+    std::atomic<int> callbacks{0};
+    std::vector<double> in(64, 1.5);
+    std::vector<double> out(64);
+    {
+        mathlib::AsyncBatcher batcher(options(pool));
+        for (std::size_t i = 0; i < in.size(); i += 8) {
+            batcher.square(&in[i], &out[i], 8).on_complete([&] { ++callbacks; });
+        }
+    }  // The destructor waits for the jobs
+    REQUIRE(callbacks.load() == 8);
+    REQUIRE(out == std::vector<double>(64, 2.25));
+
+    // A finished job calls back immediately
+    mathlib::AsyncBatcher batcher(options(pool));
+    auto job = batcher.square(in.data(), out.data(), 1);
+    job.wait();
+    bool called = false;
+    job.on_complete([&] { called = true; });
+    REQUIRE(called);
+    called = false;
+    REQUIRE_FALSE(job.on_complete_if_pending([&] { called = true; }));
+    REQUIRE_FALSE(called);
+}
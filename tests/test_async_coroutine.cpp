@@ -0,0 +1,80 @@
+// Built as C++20 (see CMakeLists.txt): co_await on AsyncJob
+
+#include "async.h"
+#include "parallel.h"
+
+#include <coroutine>
+#include <exception>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+static_assert(MATHLIB_HAS_COROUTINES, "C++20 coroutines expected");
+
+namespace {
+
+/// Minimal eagerly started coroutine reporting its result through a future
+struct Pipeline {
+    struct promise_type {
+        std::promise<std::vector<double>> result;
+
+        Pipeline get_return_object() { return Pipeline{result.get_future()}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_value(std::vector<double> value) { result.set_value(std::move(value)); }
+        void unhandled_exception() { result.set_exception(std::current_exception()); }
+    };
+
+    std::future<std::vector<double>> future;
+};
+
+/// Squares the inputs, then takes factorials of the rounded squares
+Pipeline square_then_factorial(mathlib::AsyncBatcher& batcher, std::vector<double> in) {
+    std::vector<double> squares(in.size());
+    const mathlib::JobStatus status = co_await batcher.square(in.data(), squares.data(), in.size());
+    if (status != mathlib::JobStatus::Done) {
+        throw std::logic_error("square job not done");
+    }
+
+    std::vector<int> n(squares.begin(), squares.end());
+    std::vector<double> factorials(n.size());
+    co_await batcher.factorial(n.data(), factorials.data(), n.size());
+    co_return factorials;
+}
+
+}  // namespace
+
+TEST_CASE("Coroutines co_await async jobs", "[async][coroutine]") {
+    auto threads = GENERATE(1U, 2U, 4U);
+    mathlib::AsyncOptions options;
+    options.pool = std::make_shared<mathlib::ThreadPool>(threads);
+    mathlib::AsyncBatcher batcher(options);
+
+    std::vector<Pipeline> pipelines;
+    for (int i = 0; i < 50; ++i) {
+        pipelines.push_back(square_then_factorial(batcher, {1.0, 2.0, -2.0, 3.0}));
+    }
+    for (auto& pipeline : pipelines) {
+        REQUIRE(pipeline.future.get() == std::vector<double>{1.0, 24.0, 24.0, 362880.0});
+    }
+}
+
+TEST_CASE("co_await rethrows the error of a failed job", "[async][coroutine][exceptions]") {
+    mathlib::AsyncOptions options;
+    options.pool = std::make_shared<mathlib::ThreadPool>(2);
+    mathlib::AsyncBatcher batcher(options);
+
+    auto failing = [&batcher]() -> Pipeline {
+        const std::vector<int> n = {2, -1};
+        std::vector<double> out(n.size());
+        co_await batcher.factorial(n.data(), out.data(), n.size());
+        co_return out;
+    };
+    auto pipeline = failing();
+    REQUIRE_THROWS_AS(pipeline.future.get(), std::invalid_argument);
+}
@@ -0,0 +1,256 @@
+#include "batch_service.h"
+#include "mathlib.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#if !defined(_WIN32)
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+std::string temp_path(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+std::string answer(mathlib::BatchService& service, const std::string& line) {
+    return std::string(service.process(line));
+}
+
+int file_descriptor(std::FILE* file) {
+#if defined(_WIN32)
+    return _fileno(file);
+#else
+    return fileno(file);
+#endif
+}
+
+/// Runs serve() from a file holding @p input into a file, returns what was written
+std::string serve_file(mathlib::BatchService& service, const std::string& input) {
+    const std::string in_path = temp_path("mathlib_batch_in.ndjson");
+    const std::string out_path = temp_path("mathlib_batch_out.ndjson");
+    std::ofstream(in_path, std::ios::binary) << input;
+
+    std::FILE* in = std::fopen(in_path.c_str(), "rb");
+    std::FILE* out = std::fopen(out_path.c_str(), "wb");
+    REQUIRE(in != nullptr);
+    REQUIRE(out != nullptr);
+    service.serve(file_descriptor(in), file_descriptor(out));
+    std::fclose(in);
+    std::fclose(out);
+
+    std::ostringstream written;
+    written << std::ifstream(out_path, std::ios::binary).rdbuf();
+    std::filesystem::remove(in_path);
+    std::filesystem::remove(out_path);
+    return written.str();
+}
+
+}  // namespace
+
+TEST_CASE("BatchService answers element-wise requests", "[batch_service]") {
+    mathlib::BatchService service;
+
+    REQUIRE(answer(service, R"({"id": 1, "op": "factorial", "values": [3, 5, 10]})") ==
+            "{\"id\":1,\"results\":[6,120,3628800]}\n");
+    REQUIRE(answer(service, R"({"op":"square","values":[1.5,-2,0]})") ==
+            "{\"results\":[2.25,4,0]}\n");
+    REQUIRE(answer(service, R"({"op":"log_factorial","values":[0,1]})") ==
+            "{\"results\":[0,0]}\n");
+    REQUIRE(answer(service, R"({"op":"log_gamma","values":[1,2]})") ==
+            "{\"results\":[0,0]}\n");
+    REQUIRE(answer(service, R"({"op":"square","values":[]})") == "{\"results\":[]}\n");
+    REQUIRE(service.requests() == 5);
+    REQUIRE(service.errors() == 0);
+}
+
+TEST_CASE("BatchService numbers round-trip", "[batch_service]") {
+    mathlib::BatchService service;
+
+    const std::string response = answer(service, R"({"op":"square","values":[0.1,1e-200,3e150]})");
+    // Shortest representations that read back to exactly the computed doubles
+    REQUIRE(response == "{\"results\":[0.010000000000000002,0,9.000000000000001e+300]}\n");
+    REQUIRE(std::stod("0.010000000000000002") == mathlib::square(0.1));
+    REQUIRE(std::stod("9.000000000000001e+300") == mathlib::square(3e150));
+}
+
+TEST_CASE("BatchService answers reductions", "[batch_service]") {
+    mathlib::BatchService service;
+
+    REQUIRE(answer(service, R"({"op":"sum","values":[0.5,1.5,2]})") == "{\"result\":4}\n");
+    REQUIRE(answer(service, R"({"op":"norm2","values":[3,4]})") == "{\"result\":5}\n");
+    REQUIRE(answer(service, R"({"op":"moments","values":[1,2,3,4]})") ==
+            "{\"result\":{\"count\":4,\"mean\":2.5,\"variance\":1.25}}\n");
+    REQUIRE(answer(service, R"({"op":"sum","values":[]})") == "{\"result\":0}\n");
+}
+
+TEST_CASE("BatchService writes unrepresentable values as null", "[batch_service]") {
+    mathlib::BatchService service;
+
+    // factorial(-1) is invalid (NaN), 171! overflows
+    REQUIRE(answer(service, R"({"op":"factorial","values":[-1,171,2]})") ==
+            "{\"results\":[null,null,2]}\n");
+    REQUIRE(answer(service, R"({"op":"log_gamma","values":[0]})") == "{\"results\":[null]}\n");
+    REQUIRE(answer(service, R"({"op":"square","values":[1e200]})") == "{\"results\":[null]}\n");
+}
+
+TEST_CASE("BatchService echoes ids", "[batch_service]") {
+    mathlib::BatchService service;
+
+    REQUIRE(answer(service, R"({"id":-2.5e3,"op":"sum","values":[1]})") ==
+            "{\"id\":-2.5e3,\"result\":1}\n");
+    REQUIRE(answer(service, R"({"id":"a\"b\\","op":"sum","values":[1]})") ==
+            "{\"id\":\"a\\\"b\\\\\",\"result\":1}\n");
+    // Order of the keys does not matter; unknown keys are skipped
+    REQUIRE(answer(service, R"( { "values" : [ 1 , 2 ] , "meta": {"a": [true, null, "x"]},
+                                  "op" : "sum" , "id" : 7 } )") ==
+            "{\"id\":7,\"result\":3}\n");
+}
+
+TEST_CASE("BatchService reports invalid requests and continues", "[batch_service]") {
+    mathlib::BatchService service;
+
+    const std::vector<std::pair<std::string, std::string>> cases = {
+        {"[1, 2]", "{\"error\":\"request must be a JSON object\"}\n"},
+        {R"({"id":1,"op":"cube","values":[1]})", "{\"id\":1,\"error\":\"unknown op\"}\n"},
+        {R"({"id":2,"values":[1]})", "{\"id\":2,\"error\":\"missing op\"}\n"},
+        {R"({"id":3,"op":"sum"})", "{\"id\":3,\"error\":\"missing values\"}\n"},
+        {R"({"id":4,"op":"sum","values":[1,"2"]})",
+         "{\"id\":4,\"error\":\"values must be an array of finite numbers\"}\n"},
+        {R"({"id":5,"op":"sum","values":[1e999]})",
+         "{\"id\":5,\"error\":\"values must be an array of finite numbers\"}\n"},
+        {R"({"id":6,"op":"sum","values":[inf]})",
+         "{\"id\":6,\"error\":\"values must be an array of finite numbers\"}\n"},
+        {R"({"id":7,"op":"factorial","values":[2.5]})",
+         "{\"id\":7,\"error\":\"factorial values must be integers\"}\n"},
+        {R"({"id":8,"op":"sum","values":[1]} x)",
+         "{\"id\":8,\"error\":\"unexpected data after the request object\"}\n"},
+        {R"({"id":9,"op":"sum","values":[1)",
+         "{\"id\":9,\"error\":\"values must be an array of finite numbers\"}\n"},
+        {R"({"id":true})", "{\"error\":\"id must be a number or a string\"}\n"},
+        {R"({"id":10 "op":"sum"})", "{\"id\":10,\"error\":\"malformed JSON\"}\n"},
+    };
+    for (const auto& [request, response] : cases) {
+        INFO(request);
+        REQUIRE(answer(service, request) == response);
+    }
+    REQUIRE(service.errors() == cases.size());
+
+    REQUIRE(answer(service, R"({"op":"sum","values":[1,2]})") == "{\"result\":3}\n");
+    REQUIRE(answer(service, "  \r") == "");
+    REQUIRE(service.requests() == cases.size() + 1);
+}
+
+TEST_CASE("BatchService reuses its buffers across requests", "[batch_service]") {
+    mathlib::BatchService service;
+
+    std::string large = R"({"op":"square","values":[)";
+    std::string expected = "{\"results\":[";
+    for (int i = 0; i < 5000; ++i) {
+        large += (i > 0 ? "," : "") + std::to_string(i);
+        expected += (i > 0 ? "," : "") + std::to_string(i * i);
+    }
+    large += "]}";
+    expected += "]}\n";
+
+    REQUIRE(answer(service, large) == expected);
+    REQUIRE(answer(service, R"({"op":"square","values":[3]})") == "{\"results\":[9]}\n");
+    REQUIRE(answer(service, large) == expected);
+}
+
+TEST_CASE("BatchService serves a stream of requests", "[batch_service]") {
+    // A small limit forces lines to span reads and the read buffer to grow
+    mathlib::BatchServiceOptions options;
+    options.max_request_bytes = 200;
+    mathlib::BatchService service(options);
+
+    std::string input;
+    std::string expected;
+    for (int i = 0; i < 100; ++i) {
+        input += R"({"id":)" + std::to_string(i) + R"(,"op":"square","values":[)" +
+                 std::to_string(i) + "]}\n";
+        expected += "{\"id\":" + std::to_string(i) + ",\"results\":[" +
+                    std::to_string(i * i) + "]}\n";
+        if (i == 50) {
+            input += "\n   \n";  // blank lines get no response
+        }
+    }
+    input += R"({"op":"sum","values":[)" + std::string(300, '1') + "]}\n";
+    expected += "{\"error\":\"request too long\"}\n";
+    input += R"({"op":"sum","values":[1,2]})";  // no trailing newline
+    expected += "{\"result\":3}\n";
+
+    REQUIRE(serve_file(service, input) == expected);
+    REQUIRE(service.requests() == 101);
+}
+
+#if !defined(_WIN32)
+TEST_CASE("BatchService keeps serving after a connection breaks mid-stream", "[batch_service]") {
+    mathlib::BatchService service;
+    int broken[2];
+    REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, broken) == 0);
+
+    // The client stalls inside its second request; the receive timeout
+    // makes the server's read fail with EAGAIN rather than end the input
+    const std::string sent = R"({"op":"square","values":[2]})"
+                             "\n"
+                             R"({"op":"sum","val)";
+    REQUIRE(::write(broken[1], sent.data(), sent.size()) == static_cast<ssize_t>(sent.size()));
+    timeval timeout{};
+    timeout.tv_usec = 20000;
+    REQUIRE(::setsockopt(broken[0], SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) == 0);
+    REQUIRE_THROWS_AS(service.serve(broken[0], broken[0]), std::system_error);
+
+    char received[64];
+    const ssize_t got = ::read(broken[1], received, sizeof(received));
+    REQUIRE(std::string(received, got > 0 ? static_cast<std::size_t>(got) : 0) ==
+            "{\"results\":[4]}\n");
+    ::close(broken[0]);
+    ::close(broken[1]);
+
+    // The next connection starts from a clean state
+    int next[2];
+    REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, next) == 0);
+    const std::string request = R"({"op":"sum","values":[1,2]})"
+                                "\n";
+    REQUIRE(::write(next[1], request.data(), request.size()) ==
+            static_cast<ssize_t>(request.size()));
+    ::shutdown(next[1], SHUT_WR);
+    REQUIRE(service.serve(next[0], next[0]) == 1);
+    ::close(next[0]);
+    const ssize_t answered = ::read(next[1], received, sizeof(received));
+    REQUIRE(std::string(received, answered > 0 ? static_cast<std::size_t>(answered) : 0) ==
+            "{\"result\":3}\n");
+    ::close(next[1]);
+    REQUIRE(service.requests() == 2);
+}
+#endif
+
+TEST_CASE("BatchService parallel mode gives the same answers", "[batch_service]") {
+    mathlib::BatchServiceOptions options;
+    options.parallel = true;
+    mathlib::BatchService parallel(options);
+    mathlib::BatchService serial;
+
+    std::string request = R"({"op":"OP","values":[)";
+    for (int i = 0; i < 100000; ++i) {
+        request += (i > 0 ? "," : "") + std::to_string(i % 977) + ".25";
+    }
+    request += "]}";
+    for (const char* op : {"square", "sum", "norm2", "moments"}) {
+        std::string line = request;
+        line.replace(line.find("OP"), 2, op);
+        INFO(op);
+        REQUIRE(answer(parallel, line) == answer(serial, line));
+    }
+}
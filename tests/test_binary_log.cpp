@@ -0,0 +1,174 @@
+#include "binary_log.h"
+#include "logger.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+
+std::string temp_path(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+std::vector<std::string> decode_messages(const std::string& path) {
+    mathlib::BinaryLogReader reader(path);
+    mathlib::BinaryLogRecord record;
+    std::vector<std::string> messages;
+    while (reader.next(record)) {
+        messages.push_back(mathlib::format_record(record));
+    }
+    return messages;
+}
+
+struct Point {
+    int x;
+    int y;
+};
+
+}  // namespace
+
+template <>
+struct fmt::formatter<Point> : fmt::formatter<std::string_view> {
+    template <typename FormatContext>
+    auto format(const Point& p, FormatContext& ctx) const -> decltype(ctx.out()) {
+        return fmt::format_to(ctx.out(), "({}, {})", p.x, p.y);
+    }
+};
+
+TEST_CASE("Binary log round-trips arguments of every type", "[binary_log]") {
+    const std::string path = temp_path("mathlib_test_types.mlog");
+    {
+        mathlib::BinaryLogWriter writer(path);
+        const std::string name = "gamma";
+        writer.log(spdlog::level::info, "int {} unsigned {} double {:.3f}", -42, 7U, 3.14159);
+        writer.log(spdlog::level::warn, "bool {} char {} strings {} {}", true, 'x', "literal",
+                   name);
+        writer.log(spdlog::level::err, "custom {} lazy {:.1f}", Point{1, 2},
+                   mathlib::lazy([] { return 2.25; }));
+        writer.log(spdlog::level::info, "int {} unsigned {} double {:.3f}", 1, 2U, 0.5);
+        REQUIRE(writer.dropped() == 0);
+    }
+
+    mathlib::BinaryLogReader reader(path);
+    mathlib::BinaryLogRecord record;
+    REQUIRE(reader.next(record));
+    REQUIRE(record.level == spdlog::level::info);
+    REQUIRE(record.args.size() == 3);
+    REQUIRE(std::get<std::int64_t>(record.args[0]) == -42);
+    REQUIRE(std::get<std::uint64_t>(record.args[1]) == 7);
+    REQUIRE(std::get<double>(record.args[2]) == 3.14159);
+    REQUIRE(mathlib::format_record(record) == "int -42 unsigned 7 double 3.142");
+    const std::uint32_t first_id = record.format_id;
+
+    REQUIRE(reader.next(record));
+    REQUIRE(record.level == spdlog::level::warn);
+    REQUIRE(mathlib::format_record(record) == "bool true char x strings literal gamma");
+
+    REQUIRE(reader.next(record));
+    REQUIRE(mathlib::format_record(record) == "custom (1, 2) lazy 2.2");
+
+    REQUIRE(reader.next(record));
+    REQUIRE(record.format_id == first_id);  // Format strings are stored once
+    REQUIRE(mathlib::format_record(record) == "int 1 unsigned 2 double 0.500");
+
+    REQUIRE_FALSE(reader.next(record));
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Binary log drops messages beyond its capacity", "[binary_log]") {
+    const std::string path = temp_path("mathlib_test_full.mlog");
+    {
+        mathlib::BinaryLogWriter writer(path, 256);
+        for (int i = 0; i < 20; ++i) {
+            writer.log(spdlog::level::info, "message {}", i);
+        }
+        REQUIRE(writer.dropped() > 0);
+        REQUIRE(writer.bytes_written() <= 256);
+    }
+    REQUIRE(std::filesystem::file_size(path) <= 256);
+
+    const auto messages = decode_messages(path);
+    REQUIRE_FALSE(messages.empty());
+    REQUIRE(messages.size() < 20);
+    REQUIRE(messages.back() == "message " + std::to_string(messages.size() - 1));
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Binary log keeps every message from concurrent threads", "[binary_log]") {
+    const std::string path = temp_path("mathlib_test_threads.mlog");
+    constexpr int THREADS = 4;
+    constexpr int PER_THREAD = 2000;
+    {
+        mathlib::BinaryLogWriter writer(path);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; ++t) {
+            threads.emplace_back([&writer, t] {
+                for (int i = 0; i < PER_THREAD; ++i) {
+                    writer.log(spdlog::level::info, "thread {} message {}", t, i);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+    REQUIRE(decode_messages(path).size() == THREADS * PER_THREAD);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Logger binary mode defers formatting to the decoder", "[binary_log][logger]") {
+    const std::string path = temp_path("mathlib_test_logger.mlog");
+    mathlib::Logger::init_binary(spdlog::level::info, path);
+    mathlib::Logger::info("square({}) = {:.2f}", 1.5, 2.25);
+    mathlib::Logger::debug("filtered {}", 1);
+    REQUIRE(mathlib::Logger::binary_log_size() > 0);
+    mathlib::Logger::shutdown();
+
+    const auto messages = decode_messages(path);
+    REQUIRE(messages.size() == 2);  // Initialization message first
+    REQUIRE(messages[1] == "square(1.5) = 2.25");
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Logger binary mode can shut down while threads are logging", "[binary_log][logger]") {
+    const std::string path = temp_path("mathlib_test_shutdown.mlog");
+    constexpr int THREADS = 4;
+    for (int round = 0; round < 20; ++round) {
+        mathlib::Logger::init_binary(spdlog::level::info, path);
+        std::atomic<bool> done{false};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; ++t) {
+            threads.emplace_back([&done, t] {
+                for (int i = 0; !done.load(std::memory_order_relaxed); ++i) {
+                    mathlib::Logger::info("thread {} message {} of {}", t, i, "round");
+                }
+            });
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        mathlib::Logger::shutdown();
+        done.store(true, std::memory_order_relaxed);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        REQUIRE_FALSE(decode_messages(path).empty());
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Binary log reader rejects other files", "[binary_log]") {
+    const std::string path = temp_path("mathlib_test_not_a_log.mlog");
+    {
+        auto file = mathlib::MappedFile::create(path, 32);
+        std::memcpy(file.data(), "plain text, not a binary log...", 32);
+    }
+    REQUIRE_THROWS_AS(mathlib::BinaryLogReader(path), std::runtime_error);
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,210 @@
+#include "columnar.h"
+#include "mathlib.h"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+namespace {
+
+std::string temp_path(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+/// Results of the example program's pattern: input, square, factorial
+struct Results {
+    std::vector<double> input;
+    std::vector<double> square;
+    std::vector<double> factorial;
+    std::vector<std::int32_t> n;
+    std::vector<std::uint8_t> invalid;
+};
+
+Results make_results(std::size_t rows) {
+    Results r;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> k(-5, 200);
+    for (std::size_t i = 0; i < rows; ++i) {
+        r.n.push_back(k(rng));
+        r.input.push_back(static_cast<double>(r.n.back()) + 0.5);
+        r.square.push_back(mathlib::square(r.input.back()));
+    }
+    r.factorial.resize(rows);
+    r.invalid.resize(rows);
+    mathlib::try_factorial_n(r.n.data(), r.factorial.data(), r.invalid.data(), rows);
+    return r;
+}
+
+void write_results(const std::string& path, const Results& r, mathlib::Compression compression) {
+    mathlib::ColumnarWriter writer(r.input.size(), compression);
+    writer.add("input", r.input.data());
+    writer.add("square", r.square.data());
+    writer.add("factorial", r.factorial.data());
+    writer.add("n", r.n.data());
+    writer.add("invalid", r.invalid.data());
+    writer.write(path);
+}
+
+template <typename T>
+bool same_bits(const T* a, const std::vector<T>& b) {
+    return std::memcmp(a, b.data(), b.size() * sizeof(T)) == 0;
+}
+
+}  // namespace
+
+TEST_CASE("Columnar files round-trip every column type", "[columnar]") {
+    const auto compression = GENERATE(mathlib::Compression::None, mathlib::Compression::Shuffle);
+    const auto rows = GENERATE(std::size_t{0}, std::size_t{1}, std::size_t{1000});
+    const std::string path = temp_path("mathlib_columnar_roundtrip.mlcol");
+    const Results r = make_results(rows);
+    write_results(path, r, compression);
+
+    {
+        mathlib::ColumnarReader reader(path);
+        REQUIRE(reader.rows() == rows);
+        REQUIRE(reader.columns() == 5);
+        REQUIRE(reader.column(1).name == "square");
+        REQUIRE(reader.column(3).type == mathlib::ColumnType::Int32);
+        REQUIRE(reader.find("factorial") == 2);
+
+        // NaN (invalid) and infinite factorials come back bit for bit
+        REQUIRE(same_bits(reader.values<double>("input"), r.input));
+        REQUIRE(same_bits(reader.values<double>("square"), r.square));
+        REQUIRE(same_bits(reader.values<double>("factorial"), r.factorial));
+        REQUIRE(same_bits(reader.values<std::int32_t>("n"), r.n));
+        REQUIRE(same_bits(reader.values<std::uint8_t>("invalid"), r.invalid));
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Columnar uncompressed columns are aligned views of the file", "[columnar]") {
+    const std::string path = temp_path("mathlib_columnar_aligned.mlcol");
+    const std::vector<float> x = {1.5F, -2.0F, 3.25F};
+    const std::vector<std::int64_t> big = {std::numeric_limits<std::int64_t>::min(), 0, 42};
+    mathlib::ColumnarWriter writer(x.size());
+    writer.add("x", x.data());
+    writer.add("big", big.data());
+    writer.write(path);
+
+    {
+        mathlib::ColumnarReader reader(path);
+        const float* view = reader.values<float>(0);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(view) % 64 == 0);
+        REQUIRE(same_bits(view, x));
+        REQUIRE(same_bits(reader.values<std::int64_t>(1), big));
+        // Header, directory (one line per column), then the data
+        REQUIRE(std::filesystem::file_size(path) == 64 + 2 * 64 + 2 * 64);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Columnar shuffle compression shrinks regular data", "[columnar]") {
+    const std::string path = temp_path("mathlib_columnar_compressed.mlcol");
+    const std::size_t rows = 100000;
+    std::vector<std::int32_t> small(rows);
+    std::vector<double> steps(rows);
+    std::vector<std::int64_t> noise(rows);
+    std::mt19937_64 rng(3);
+    for (std::size_t i = 0; i < rows; ++i) {
+        small[i] = static_cast<std::int32_t>(i % 100);
+        steps[i] = static_cast<double>(i / 1000);
+        noise[i] = static_cast<std::int64_t>(rng());
+    }
+    mathlib::ColumnarWriter writer(rows, mathlib::Compression::Shuffle);
+    writer.add("small", small.data());
+    writer.add("steps", steps.data());
+    writer.add("noise", noise.data());
+    writer.write(path);
+
+    {
+        mathlib::ColumnarReader reader(path);
+        REQUIRE(reader.column(0).compression == mathlib::Compression::Shuffle);
+        REQUIRE(reader.column(0).stored_bytes < rows * 4 / 3);
+        REQUIRE(reader.column(1).compression == mathlib::Compression::Shuffle);
+        REQUIRE(reader.column(1).stored_bytes < rows * 8 / 20);
+        // Random bits do not compress: stored raw and still mappable
+        REQUIRE(reader.column(2).compression == mathlib::Compression::None);
+        REQUIRE(same_bits(reader.values<std::int32_t>(0), small));
+        REQUIRE(same_bits(reader.values<double>(1), steps));
+        REQUIRE(same_bits(reader.values<std::int64_t>(2), noise));
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Columnar writer validates column names", "[columnar]") {
+    const std::vector<double> x = {1.0};
+    mathlib::ColumnarWriter writer(1);
+    REQUIRE_THROWS_AS(writer.add("", x.data()), std::invalid_argument);
+    REQUIRE_THROWS_AS(writer.add(std::string(40, 'a'), x.data()), std::invalid_argument);
+    writer.add(std::string(39, 'a'), x.data());
+    REQUIRE_THROWS_AS(writer.add(std::string(39, 'a'), x.data()), std::invalid_argument);
+    REQUIRE(writer.columns() == 1);
+}
+
+TEST_CASE("Columnar reader checks types and rejects invalid files", "[columnar]") {
+    const std::string path = temp_path("mathlib_columnar_invalid.mlcol");
+    const std::vector<double> x = {1.0, 2.0, 3.0, 3.0, 3.0, 3.0};
+    mathlib::ColumnarWriter writer(x.size(), mathlib::Compression::Shuffle);
+    writer.add("x", x.data());
+    writer.write(path);
+
+    {
+        mathlib::ColumnarReader reader(path);
+        REQUIRE_THROWS_AS(reader.values<float>("x"), std::invalid_argument);
+        REQUIRE_THROWS_AS(reader.find("y"), std::invalid_argument);
+    }
+
+    // Corrupt the compressed data: decoding fails instead of overrunning
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(128);
+        const char garbage[4] = {'\x7f', '\x7f', '\x7f', '\x7f'};
+        file.write(garbage, sizeof(garbage));
+    }
+    {
+        mathlib::ColumnarReader reader(path);
+        REQUIRE_THROWS_AS(reader.values<double>("x"), std::runtime_error);
+    }
+
+    std::ofstream(path, std::ios::binary) << "not a columnar file, but long enough to have a header"
+                                          << std::string(64, ' ');
+    REQUIRE_THROWS_AS(mathlib::ColumnarReader(path), std::runtime_error);
+    std::filesystem::remove(path);
+    REQUIRE_THROWS_AS(mathlib::ColumnarReader(path), std::system_error);
+}
+
+TEST_CASE("Columnar files convert to JSON rows", "[columnar]") {
+    const std::string path = temp_path("mathlib_columnar_json.mlcol");
+    const std::vector<double> input = {2.0, 0.1, 171.0};
+    const std::vector<double> factorial = {2.0, std::numeric_limits<double>::quiet_NaN(),
+                                           std::numeric_limits<double>::infinity()};
+    const std::vector<std::uint8_t> flag = {0, 1, 255};
+    mathlib::ColumnarWriter writer(input.size(), mathlib::Compression::Shuffle);
+    writer.add("input", input.data());
+    writer.add("fact\"orial", factorial.data());
+    writer.add("flag", flag.data());
+    writer.write(path);
+
+    {
+        mathlib::ColumnarReader reader(path);
+        std::ostringstream json;
+        mathlib::write_json(reader, json);
+        REQUIRE(json.str() == "[\n"
+                              "{\"input\":2,\"fact\\\"orial\":2,\"flag\":0},\n"
+                              "{\"input\":0.1,\"fact\\\"orial\":null,\"flag\":1},\n"
+                              "{\"input\":171,\"fact\\\"orial\":null,\"flag\":255}\n"
+                              "]\n");
+    }
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,116 @@
+#include "combinatorics.h"
+#include "mathlib.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+using Catch::Approx;
+
+TEST_CASE("Integer factorial", "[factorial_u64]") {
+    REQUIRE(mathlib::factorial_u64(0) == 1);
+    REQUIRE(mathlib::factorial_u64(5) == 120);
+    REQUIRE(mathlib::factorial_u64(20) == 2432902008176640000ULL);
+    for (int n = 1; n <= mathlib::FACTORIAL_U64_MAX; ++n) {
+        REQUIRE(mathlib::factorial_u64(n) ==
+                mathlib::factorial_u64(n - 1) * static_cast<std::uint64_t>(n));
+    }
+    REQUIRE_THROWS_AS(mathlib::factorial_u64(21), std::overflow_error);
+    REQUIRE_THROWS_AS(mathlib::factorial_u64(-1), std::invalid_argument);
+}
+
+TEST_CASE("Binomial coefficient small values", "[binomial]") {
+    REQUIRE(mathlib::binomial(0, 0) == 1);
+    REQUIRE(mathlib::binomial(5, 0) == 1);
+    REQUIRE(mathlib::binomial(5, 5) == 1);
+    REQUIRE(mathlib::binomial(10, 3) == 120);
+    REQUIRE(mathlib::binomial(52, 5) == 2598960);
+
+    SECTION("Out of range k") {
+        REQUIRE(mathlib::binomial(5, -1) == 0);
+        REQUIRE(mathlib::binomial(5, 6) == 0);
+    }
+
+    SECTION("Negative n throws") {
+        REQUIRE_THROWS_AS(mathlib::binomial(-1, 0), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Binomial coefficient matches Pascal's rule", "[binomial][properties]") {
+    // Crosses the table boundary at n = 67 for coefficients that still fit
+    for (int n = 1; n <= 90; ++n) {
+        for (int k = 1; k < n && k <= 12; ++k) {
+            REQUIRE(mathlib::binomial(n, k) ==
+                    mathlib::binomial(n - 1, k - 1) + mathlib::binomial(n - 1, k));
+            REQUIRE(mathlib::binomial(n, k) == mathlib::binomial(n, n - k));
+        }
+    }
+}
+
+TEST_CASE("Binomial coefficient 64-bit limits", "[binomial][edge_cases]") {
+    REQUIRE(mathlib::binomial(67, 33) == UINT64_C(14226520737620288370));
+    REQUIRE_THROWS_AS(mathlib::binomial(68, 34), std::overflow_error);
+
+    // Far beyond the factorial range, small k still fits
+    REQUIRE(mathlib::binomial(1000, 3) == UINT64_C(166167000));
+    REQUIRE(mathlib::binomial(1000000, 3) == UINT64_C(166666166667000000));
+    REQUIRE_THROWS_AS(mathlib::binomial(1000000, 4), std::overflow_error);
+}
+
+TEST_CASE("Log-binomial coefficient", "[binomial][log_binomial]") {
+    REQUIRE(mathlib::log_binomial(10, 3) == Approx(std::log(120.0)).epsilon(1e-15));
+    REQUIRE(mathlib::log_binomial(100000, 50000) == Approx(69308.73579940939).epsilon(1e-13));
+    REQUIRE(mathlib::log_binomial(1000000000, 3) == Approx(60.37803803861118).epsilon(1e-14));
+    REQUIRE(mathlib::log_binomial(2000, 700) == Approx(1290.9140493430773).epsilon(1e-13));
+    REQUIRE(mathlib::log_binomial(7, 0) == 0.0);
+    REQUIRE(mathlib::log_binomial(7, 8) == -std::numeric_limits<double>::infinity());
+
+    SECTION("Agrees with exact values inside the table") {
+        for (int k = 0; k <= 40; ++k) {
+            const double exact = static_cast<double>(mathlib::binomial(40, k));
+            REQUIRE(mathlib::log_binomial(40, k) == Approx(std::log(exact)).epsilon(1e-14));
+        }
+    }
+}
+
+TEST_CASE("Pascal rows", "[binomial][pascal]") {
+    SECTION("Integer row") {
+        std::vector<std::uint64_t> row(11);
+        mathlib::pascal_row(10, row.data());
+        const std::vector<std::uint64_t> expected = {1, 10, 45, 120, 210, 252, 210, 120, 45, 10, 1};
+        REQUIRE(row == expected);
+
+        std::vector<std::uint64_t> last(68);
+        mathlib::pascal_row(67, last.data());
+        REQUIRE(last[33] == mathlib::binomial(67, 33));
+        REQUIRE_THROWS_AS(mathlib::pascal_row(68, last.data()), std::overflow_error);
+    }
+
+    SECTION("Double row beyond the table") {
+        std::vector<double> row(201);
+        mathlib::pascal_row(200, row.data());
+        REQUIRE(row[0] == 1.0);
+        REQUIRE(row[200] == 1.0);
+        REQUIRE(row[3] == 1313400.0);
+        REQUIRE(std::log(row[100]) == Approx(mathlib::log_binomial(200, 100)).epsilon(1e-13));
+    }
+}
+
+TEST_CASE("Batch binomial coefficients", "[binomial][batch]") {
+    const std::vector<int> n = {10, 67, 100, 5, 1000};
+    const std::vector<int> k = {3, 33, 2, 7, 3};
+    std::vector<std::uint64_t> out(n.size());
+    mathlib::binomial_n(n.data(), k.data(), out.data(), n.size());
+    for (size_t i = 0; i < n.size(); ++i) {
+        REQUIRE(out[i] == mathlib::binomial(n[i], k[i]));
+    }
+
+    std::vector<double> logs(n.size());
+    mathlib::log_binomial_n(n.data(), k.data(), logs.data(), n.size());
+    REQUIRE(logs[0] == mathlib::log_binomial(10, 3));
+}
@@ -0,0 +1,97 @@
+#include "expr.h"
+#include "mathlib.h"
+#include "parallel.h"
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+using mathlib::expr::Array;
+using mathlib::expr::view;
+
+TEST_CASE("Expression evaluates element-wise", "[expr]") {
+    const std::vector<double> t = {300.0, 400.0, 500.0};
+    const std::vector<double> p = {1e5, 2e5, 4e5};
+
+    Array ratio = square(view(t)) / square(view(p));
+    REQUIRE(ratio.size() == 3);
+    for (std::size_t i = 0; i < t.size(); ++i) {
+        REQUIRE(ratio[i] == mathlib::square(t[i]) / mathlib::square(p[i]));
+    }
+}
+
+TEST_CASE("Expression operators and scalars", "[expr]") {
+    const std::vector<double> a = {1.0, 2.0, 3.0, 4.0};
+    const std::vector<double> b = {4.0, 3.0, 2.0, 1.0};
+
+    SECTION("Arithmetic between arrays") {
+        Array sum = view(a) + view(b);
+        Array diff = view(a) - view(b);
+        Array prod = view(a) * view(b);
+        Array neg = -view(a);
+        REQUIRE(sum.values() == std::vector<double>{5.0, 5.0, 5.0, 5.0});
+        REQUIRE(diff.values() == std::vector<double>{-3.0, -1.0, 1.0, 3.0});
+        REQUIRE(prod.values() == std::vector<double>{4.0, 6.0, 6.0, 4.0});
+        REQUIRE(neg.values() == std::vector<double>{-1.0, -2.0, -3.0, -4.0});
+    }
+
+    SECTION("Scalars on either side") {
+        Array x = 2.0 * view(a) + 1.0;
+        REQUIRE(x.values() == std::vector<double>{3.0, 5.0, 7.0, 9.0});
+        Array y = 12.0 / view(a) - view(b) / 2.0;
+        REQUIRE(y.values() == std::vector<double>{10.0, 4.5, 3.0, 2.5});
+    }
+
+    SECTION("Arrays are usable as operands without copies") {
+        Array x(a);
+        Array y = square(x) + x;
+        REQUIRE(y.values() == std::vector<double>{2.0, 6.0, 12.0, 20.0});
+
+        // Self-assignment reads each element before writing it
+        x = x * 2.0;
+        REQUIRE(x.values() == std::vector<double>{2.0, 4.0, 6.0, 8.0});
+    }
+}
+
+TEST_CASE("Expression length mismatch is rejected", "[expr][exceptions]") {
+    const std::vector<double> a(3, 1.0);
+    const std::vector<double> b(4, 1.0);
+    REQUIRE_THROWS_AS(view(a) + view(b), std::invalid_argument);
+}
+
+TEST_CASE("Expression evaluation into caller memory", "[expr]") {
+    const std::size_t n = 200000;
+    std::vector<double> t(n);
+    std::vector<double> p(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        t[i] = 300.0 + static_cast<double>(i % 1700);
+        p[i] = 1e5 + static_cast<double>(i % 900) * 1000.0;
+    }
+    const auto e = square(view(t)) / square(view(p));
+
+    std::vector<double> serial(n);
+    mathlib::expr::evaluate(e, serial.data());
+
+    mathlib::set_num_threads(4);
+    std::vector<double> threaded(n);
+    mathlib::expr::parallel_evaluate(e, threaded.data());
+    mathlib::set_num_threads(0);
+
+    REQUIRE(serial == threaded);
+    REQUIRE(serial[n - 1] == mathlib::square(t[n - 1]) / mathlib::square(p[n - 1]));
+}
+
+TEST_CASE("Expression keeps temporary Arrays alive", "[expr]") {
+    const std::vector<double> a = {1.0, 2.0, 3.0};
+    const auto make_array = [] { return Array(std::vector<double>{4.0, 5.0, 6.0}); };
+
+    // The temporaries are destroyed at the end of each declaration
+    const auto squared = square(Array(std::vector<double>{1.0, 2.0, 3.0}));
+    const auto sum = view(a) + make_array();
+    const auto copy = sum;
+
+    const Array result = squared + copy;
+    REQUIRE(result.values() == std::vector<double>{6.0, 11.0, 18.0});
+}
@@ -0,0 +1,171 @@
+#include "bigint.h"
+#include "factorial_exact.h"
+#include "mathlib.h"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+using Catch::Approx;
+
+namespace {
+
+// Residue modulo the largest 32-bit prime, to compare huge values with
+// reference results
+std::uint64_t residue(const mathlib::BigUInt& x) {
+    constexpr std::uint64_t P = 4294967291ULL;
+    std::uint64_t r = 0;
+    const auto& limbs = x.limbs();
+    for (std::size_t i = limbs.size(); i-- > 0;) {
+        r = ((r << 32) | limbs[i]) % P;
+    }
+    return r;
+}
+
+mathlib::BigUInt power(std::uint32_t base, int exponent) {
+    mathlib::BigUInt x(1);
+    for (int i = 0; i < exponent; ++i) {
+        x *= base;
+    }
+    return x;
+}
+
+}  // namespace
+
+TEST_CASE("BigUInt basic operations", "[bigint]") {
+    REQUIRE(mathlib::BigUInt().is_zero());
+    REQUIRE(mathlib::BigUInt().to_string() == "0");
+    REQUIRE(mathlib::BigUInt(18446744073709551615ULL).to_string() == "18446744073709551615");
+    REQUIRE(mathlib::BigUInt(1000000000).to_string() == "1000000000");  // Inner zero chunks
+
+    mathlib::BigUInt x(3);
+    x <<= 100;
+    REQUIRE(x.bit_length() == 102);
+    REQUIRE(x.to_string() == "3802951800684688204490109616128");
+    REQUIRE(x.to_double() == 3.0 * 1267650600228229401496703205376.0);
+
+    x *= 0;
+    REQUIRE(x.is_zero());
+    REQUIRE(power(2, 1100).to_double() == std::numeric_limits<double>::infinity());
+}
+
+TEST_CASE("BigUInt Karatsuba multiplication matches reference values", "[bigint]") {
+    // Operands of about 100 and 130 limbs: Karatsuba with an unbalanced split
+    const auto product = power(3, 2000) * power(7, 1500);
+    REQUIRE(residue(product) == (1469335541ULL + 4294967291ULL - 12345) % 4294967291ULL);
+
+    // Same product accumulated with 32-bit factors only (schoolbook path)
+    auto expected = power(3, 2000);
+    for (int i = 0; i < 1500; ++i) {
+        expected *= 7;
+    }
+    REQUIRE(product == expected);
+}
+
+TEST_CASE("compute_factorial_exact matches known factorials", "[factorial][exact]") {
+    for (int n = 0; n <= 20; ++n) {
+        REQUIRE(mathlib::compute_factorial_exact(n).to_double() == mathlib::factorial(n));
+    }
+    REQUIRE(mathlib::compute_factorial_exact(25).to_string() == "15511210043330985984000000");
+    REQUIRE(mathlib::compute_factorial_exact(100).to_string() ==
+            "93326215443944152681699238856266700490715968264381621468592963895217599993229915608"
+            "941463976156518286253697920827223758251185210916864000000000000000000000000");
+
+    const auto f1000 = mathlib::compute_factorial_exact(1000);
+    REQUIRE(f1000.bit_length() == 8530);
+    const std::string digits = f1000.to_string();
+    REQUIRE(digits.size() == 2568);
+    REQUIRE(digits.substr(0, 20) == "40238726007709377354");
+
+    const auto f20000 = mathlib::compute_factorial_exact(20000);
+    REQUIRE(f20000.bit_length() == 256909);
+    REQUIRE(residue(f20000) == 1941899605);
+
+    // Double results agree up to rounding while they are finite
+    REQUIRE(mathlib::compute_factorial_exact(170).to_double() ==
+            Approx(mathlib::factorial(170)).epsilon(1e-15));
+
+    REQUIRE_THROWS_AS(mathlib::compute_factorial_exact(-1), std::invalid_argument);
+}
+
+TEST_CASE("FactorialCache returns cached results", "[factorial][exact][cache]") {
+    mathlib::FactorialCache cache;
+    const auto first = cache.get(500);
+    const auto again = cache.get(500);
+    REQUIRE(first == again);  // The same object, not a copy
+
+    auto stats = cache.stats();
+    REQUIRE(stats.hits == 1);
+    REQUIRE(stats.misses == 1);
+    REQUIRE(stats.entries == 1);
+    REQUIRE(stats.bytes == first->limbs().size() * sizeof(std::uint32_t));
+
+    // Extended from the cached 500!
+    REQUIRE(*cache.get(900) == mathlib::compute_factorial_exact(900));
+    // Computed from scratch (no cached m with m >= n / 2)
+    REQUIRE(*cache.get(2000) == mathlib::compute_factorial_exact(2000));
+
+    cache.clear();
+    stats = cache.stats();
+    REQUIRE(stats.entries == 0);
+    REQUIRE(stats.bytes == 0);
+    REQUIRE(stats.hits == 0);
+
+    REQUIRE_THROWS_AS(cache.get(-3), std::invalid_argument);
+}
+
+TEST_CASE("FactorialCache evicts the least recently used entries", "[factorial][exact][cache]") {
+    // Room for three of 1000! ... 1003! (1003! being the largest)
+    mathlib::FactorialCache cache(3 * mathlib::compute_factorial_exact(1003).limbs().size() * 4);
+
+    const auto kept = cache.get(1000);
+    cache.get(1001);
+    cache.get(1002);
+    cache.get(1000);  // Now the most recently used
+    cache.get(1003);  // Evicts 1001
+    REQUIRE(cache.stats().entries == 3);
+    REQUIRE(cache.stats().bytes <= cache.stats().capacity_bytes);
+
+    const auto hits = cache.stats().hits;
+    cache.get(1000);
+    REQUIRE(cache.stats().hits == hits + 1);
+    cache.get(1001);
+    REQUIRE(cache.stats().hits == hits + 1);  // Was evicted
+
+    // Results larger than the capacity are returned but not stored
+    REQUIRE(*cache.get(5000) == mathlib::compute_factorial_exact(5000));
+    REQUIRE(cache.stats().entries == 3);
+
+    cache.set_capacity(0);
+    REQUIRE(cache.stats().entries == 0);
+    REQUIRE(*kept == mathlib::compute_factorial_exact(1000));  // Still valid after eviction
+}
+
+TEST_CASE("factorial_exact is safe to call from several threads", "[factorial][exact][cache]") {
+    mathlib::factorial_cache().clear();
+    std::vector<std::thread> threads;
+    std::vector<std::shared_ptr<const mathlib::BigUInt>> results(8);
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&results, t] {
+            for (int round = 0; round < 20; ++round) {
+                results[t] = mathlib::factorial_exact(300 + (t + round) % 4);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (int t = 0; t < 8; ++t) {
+        REQUIRE(*results[t] == mathlib::compute_factorial_exact(300 + (t + 19) % 4));
+    }
+    const auto stats = mathlib::factorial_cache().stats();
+    REQUIRE(stats.hits + stats.misses == 160);
+    REQUIRE(stats.entries == 4);
+}
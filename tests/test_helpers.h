@@ -0,0 +1,17 @@
+/**
+ * @file test_helpers.h
+ * @brief Helpers shared by the test files
+ */
+
+#ifndef TEST_HELPERS_H
+#define TEST_HELPERS_H
+
+#include "simd.h"
+
+/// Restores the default instruction set when a test forces another one
+struct IsaGuard {
+    mathlib::SimdIsa saved = mathlib::active_simd_isa();
+    ~IsaGuard() { mathlib::set_simd_isa(saved); }
+};
+
+#endif  // TEST_HELPERS_H
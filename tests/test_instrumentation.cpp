@@ -0,0 +1,150 @@
+#include "instrumentation.h"
+#include "mathlib.h"
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#ifdef USE_VCPKG_DEPENDENCIES
+#include <nlohmann/json.hpp>
+#endif
+
+using mathlib::InstrumentedFunction;
+
+namespace {
+
+// Expected count: the real one when instrumentation is compiled in, else 0
+std::uint64_t expected(std::uint64_t count) {
+    return mathlib::INSTRUMENTATION_ENABLED ? count : 0;
+}
+
+std::uint64_t histogram_total(const mathlib::FunctionStats& stats) {
+    std::uint64_t total = 0;
+    for (std::uint64_t bucket : stats.histogram) {
+        total += bucket;
+    }
+    return total;
+}
+
+}  // namespace
+
+TEST_CASE("Snapshot lists every instrumented function", "[instrumentation]") {
+    const auto snapshot = mathlib::instrumentation_snapshot();
+    REQUIRE(snapshot.enabled == mathlib::INSTRUMENTATION_ENABLED);
+    REQUIRE(snapshot.functions.size() == mathlib::INSTRUMENTED_FUNCTION_COUNT);
+    REQUIRE(std::string(snapshot[InstrumentedFunction::Square].name) == "square");
+    REQUIRE(std::string(snapshot[InstrumentedFunction::Factorial].name) == "factorial");
+    REQUIRE(std::string(snapshot[InstrumentedFunction::SquareN].name) == "square_n");
+    REQUIRE(std::string(snapshot[InstrumentedFunction::FactorialN].name) == "factorial_n");
+}
+
+TEST_CASE("Calls and elements are counted", "[instrumentation]") {
+    mathlib::reset_instrumentation();
+
+    for (int i = 0; i < 100; ++i) {
+        mathlib::square(static_cast<double>(i));
+    }
+    for (int i = 0; i < 10; ++i) {
+        mathlib::factorial(i);
+    }
+    std::vector<double> data(1000, 2.0);
+    mathlib::square_n(data.data(), data.size());
+    mathlib::square_n(data.data(), 10);
+    const std::vector<int> n{1, 2, 3};
+    std::vector<double> out(n.size());
+    mathlib::factorial_n(n.data(), out.data(), n.size());
+
+    const auto snapshot = mathlib::instrumentation_snapshot();
+    const auto& square = snapshot[InstrumentedFunction::Square];
+    REQUIRE(square.calls == expected(100));
+    REQUIRE(square.elements == expected(100));
+    REQUIRE(snapshot[InstrumentedFunction::Factorial].calls == expected(10));
+    REQUIRE(snapshot[InstrumentedFunction::SquareN].calls == expected(2));
+    REQUIRE(snapshot[InstrumentedFunction::SquareN].elements == expected(1010));
+    REQUIRE(snapshot[InstrumentedFunction::FactorialN].elements == expected(3));
+
+    // One call in LATENCY_SAMPLE_PERIOD is timed, the first one included
+    const std::uint64_t timed = (100 + mathlib::LATENCY_SAMPLE_PERIOD - 1) /
+                                mathlib::LATENCY_SAMPLE_PERIOD;
+    REQUIRE(square.timed_calls == expected(timed));
+    REQUIRE(histogram_total(square) == square.timed_calls);
+}
+
+TEST_CASE("Reset starts counting from zero", "[instrumentation]") {
+    mathlib::square(3.0);
+    mathlib::reset_instrumentation();
+    REQUIRE(mathlib::instrumentation_snapshot()[InstrumentedFunction::Square].calls == 0);
+
+    mathlib::square(3.0);
+    REQUIRE(mathlib::instrumentation_snapshot()[InstrumentedFunction::Square].calls ==
+            expected(1));
+}
+
+TEST_CASE("Counts of other threads are kept after they exit", "[instrumentation]") {
+    constexpr int THREADS = 4;
+    constexpr int CALLS = 1000;
+    mathlib::reset_instrumentation();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([] {
+            for (int i = 0; i < CALLS; ++i) {
+                mathlib::square(1.5);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(mathlib::instrumentation_snapshot()[InstrumentedFunction::Square].calls ==
+            expected(THREADS * CALLS));
+}
+
+TEST_CASE("A thread can start with a noexcept instrumented call", "[instrumentation]") {
+    STATIC_REQUIRE(noexcept(mathlib::try_factorial(5)));
+    mathlib::reset_instrumentation();
+
+    // Registers the counters of the new thread from inside a noexcept function
+    double value = 0.0;
+    std::thread([&value] { value = mathlib::try_factorial(5).value(); }).join();
+
+    REQUIRE(value == 120.0);
+    REQUIRE(mathlib::instrumentation_snapshot()[InstrumentedFunction::Factorial].calls ==
+            expected(1));
+}
+
+TEST_CASE("Latency statistics are derived from the histogram", "[instrumentation]") {
+    mathlib::FunctionStats stats;
+    REQUIRE(stats.mean_ns() == 0.0);
+    REQUIRE(stats.percentile_ns(0.5) == 0.0);
+
+    // 90 calls of 8..15 ns (bucket 3), 10 calls of 1..2 us (bucket 10)
+    stats.histogram[3] = 90;
+    stats.histogram[10] = 10;
+    stats.timed_calls = 100;
+    stats.timed_ns = 90 * 10 + 10 * 1500;
+
+    REQUIRE(stats.mean_ns() == 159.0);
+    REQUIRE(stats.percentile_ns(0.0) == 16.0);
+    REQUIRE(stats.percentile_ns(0.5) == 16.0);
+    REQUIRE(stats.percentile_ns(0.99) == 2048.0);
+    REQUIRE(stats.percentile_ns(1.0) == 2048.0);
+}
+
+#ifdef USE_VCPKG_DEPENDENCIES
+TEST_CASE("Snapshot converts to JSON", "[instrumentation]") {
+    mathlib::reset_instrumentation();
+    mathlib::square(2.0);
+
+    const nlohmann::json j = mathlib::instrumentation_snapshot();
+    REQUIRE(j["enabled"] == mathlib::INSTRUMENTATION_ENABLED);
+    REQUIRE(j["functions"].size() == mathlib::INSTRUMENTED_FUNCTION_COUNT);
+    REQUIRE(j["functions"][0]["name"] == "square");
+    REQUIRE(j["functions"][0]["calls"] == expected(1));
+    REQUIRE(j["functions"][0]["histogram"].size() == mathlib::LATENCY_BUCKETS);
+}
+#endif
@@ -0,0 +1,200 @@
+#include "logger.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <spdlog/sinks/base_sink.h>
+
+namespace {
+
+// Records message texts; while `hold` is set the writer thread is parked
+// inside the sink, so the queue fills up
+class CollectingSink : public spdlog::sinks::base_sink<std::mutex> {
+  public:
+    std::atomic<bool> hold{false};
+    std::atomic<bool> holding{false};
+
+    std::vector<std::string> messages() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return messages_;
+    }
+
+  protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override {
+        while (hold.load()) {
+            holding.store(true);
+            std::this_thread::yield();
+        }
+        messages_.emplace_back(msg.payload.data(), msg.payload.size());
+    }
+
+    void flush_() override {}
+
+  private:
+    std::vector<std::string> messages_;
+};
+
+// Starts an asynchronous logger whose writer is blocked on its first message
+std::shared_ptr<CollectingSink> init_held(mathlib::OverflowPolicy policy) {
+    auto sink = std::make_shared<CollectingSink>();
+    sink->hold = true;
+    mathlib::Logger::init_async(spdlog::level::info, {4, policy}, sink);
+    while (!sink->holding.load()) {
+        std::this_thread::yield();
+    }
+    return sink;
+}
+
+std::vector<std::string> numbered(int first, int last) {
+    std::vector<std::string> result;
+    for (int i = first; i < last; ++i) {
+        result.push_back("message " + std::to_string(i));
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST_CASE("Asynchronous logger drops the newest messages when full", "[logger]") {
+    auto sink = init_held(mathlib::OverflowPolicy::DropNewest);
+    for (int i = 0; i < 20; ++i) {
+        mathlib::Logger::info("message {}", i);
+    }
+    REQUIRE(mathlib::Logger::dropped_messages() == 16);
+
+    sink->hold = false;
+    mathlib::Logger::flush();
+    auto messages = sink->messages();
+    REQUIRE(messages.size() == 5);  // Initialization message + queue capacity
+    messages.erase(messages.begin());
+    REQUIRE(messages == numbered(0, 4));
+    mathlib::Logger::shutdown();
+}
+
+TEST_CASE("Asynchronous logger drops the oldest messages when full", "[logger]") {
+    auto sink = init_held(mathlib::OverflowPolicy::DropOldest);
+    for (int i = 0; i < 20; ++i) {
+        mathlib::Logger::info("message {}", i);
+    }
+    REQUIRE(mathlib::Logger::dropped_messages() == 16);
+
+    sink->hold = false;
+    mathlib::Logger::flush();
+    auto messages = sink->messages();
+    REQUIRE(messages.size() == 5);
+    messages.erase(messages.begin());
+    REQUIRE(messages == numbered(16, 20));
+    mathlib::Logger::shutdown();
+}
+
+TEST_CASE("Asynchronous logger blocks instead of dropping", "[logger]") {
+    auto sink = init_held(mathlib::OverflowPolicy::Block);
+    std::thread release([&sink] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        sink->hold = false;
+    });
+    for (int i = 0; i < 20; ++i) {
+        mathlib::Logger::info("message {}", i);
+    }
+    release.join();
+
+    mathlib::Logger::shutdown();
+    REQUIRE(mathlib::Logger::dropped_messages() == 0);
+    auto messages = sink->messages();
+    REQUIRE(messages.size() == 21);
+    messages.erase(messages.begin());
+    REQUIRE(messages == numbered(0, 20));
+}
+
+TEST_CASE("Asynchronous logger keeps messages logged during shutdown", "[logger]") {
+    constexpr int THREADS = 4;
+    constexpr int PER_THREAD = 2000;
+    auto sink = std::make_shared<CollectingSink>();
+    mathlib::Logger::init_async(spdlog::level::info, {4, mathlib::OverflowPolicy::Block}, sink);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([t] {
+            for (int i = 0; i < PER_THREAD; ++i) {
+                mathlib::Logger::info("thread {} message {}", t, i);
+            }
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    mathlib::Logger::shutdown();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Nothing lost, and each thread's messages in order
+    const auto messages = sink->messages();
+    REQUIRE(messages.size() == 1 + THREADS * PER_THREAD);
+    for (int t = 0; t < THREADS; ++t) {
+        const std::string prefix = "thread " + std::to_string(t) + " ";
+        int next = 0;
+        for (const auto& message : messages) {
+            if (message.rfind(prefix, 0) == 0) {
+                REQUIRE(message == prefix + "message " + std::to_string(next++));
+            }
+        }
+    }
+}
+
+TEST_CASE("Asynchronous logger filters by level before queueing", "[logger]") {
+    auto sink = std::make_shared<CollectingSink>();
+    mathlib::Logger::init_async(spdlog::level::warn, {}, sink);
+    mathlib::Logger::info("hidden");
+    mathlib::Logger::warn("shown {}", 1);
+    mathlib::Logger::shutdown();
+
+    // After shutdown messages are written synchronously
+    mathlib::Logger::error("direct");
+    REQUIRE(sink->messages() == std::vector<std::string>{"shown 1", "direct"});
+}
+
+TEST_CASE("Logger levels below the compile-time minimum are compiled out", "[logger]") {
+    STATIC_REQUIRE(mathlib::Logger::compiled_in(spdlog::level::critical) ==
+                   (MATHLIB_ACTIVE_LOG_LEVEL <= SPDLOG_LEVEL_CRITICAL));
+    STATIC_REQUIRE(mathlib::Logger::compiled_in(spdlog::level::trace) ==
+                   (MATHLIB_ACTIVE_LOG_LEVEL <= SPDLOG_LEVEL_TRACE));
+
+    auto sink = std::make_shared<CollectingSink>();
+    mathlib::Logger::init(spdlog::level::trace, sink);
+    mathlib::Logger::trace("trace {}", 1);
+    const bool trace_written = sink->messages().size() == 2;
+    REQUIRE(trace_written == mathlib::Logger::compiled_in(spdlog::level::trace));
+}
+
+TEST_CASE("Logging macros evaluate arguments only for written messages", "[logger]") {
+    auto sink = std::make_shared<CollectingSink>();
+    mathlib::Logger::init(spdlog::level::info, sink);
+    int evaluations = 0;
+    auto expensive = [&evaluations] { return ++evaluations; };
+
+    MATHLIB_LOG_DEBUG("debug {}", expensive());
+    REQUIRE(evaluations == 0);
+    REQUIRE_FALSE(mathlib::Logger::enabled(spdlog::level::debug));
+
+    MATHLIB_LOG_WARN("warn {}", expensive());
+    REQUIRE(evaluations == 1);
+    REQUIRE(sink->messages().back() == "warn 1");
+}
+
+TEST_CASE("Lazy log arguments are computed only when formatted", "[logger]") {
+    auto sink = std::make_shared<CollectingSink>();
+    mathlib::Logger::init(spdlog::level::info, sink);
+    int evaluations = 0;
+    auto value = mathlib::lazy([&evaluations] { return ++evaluations * 1.5; });
+
+    mathlib::Logger::debug("debug {}", value);
+    REQUIRE(evaluations == 0);
+
+    mathlib::Logger::info("info {:.2f}", value);
+    REQUIRE(evaluations == 1);
+    REQUIRE(sink->messages().back() == "info 1.50");
+}
@@ -0,0 +1,76 @@
+#include "mapped_file.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+
+std::string temp_path(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+}  // namespace
+
+TEST_CASE("MappedFile writes, trims and reads back a file", "[mapped_file]") {
+    const std::string path = temp_path("mathlib_test_mapped_file.bin");
+    const char text[] = "mapped file contents";
+
+    auto out = mathlib::MappedFile::create(path, 1 << 16);
+    REQUIRE(out.is_open());
+    REQUIRE(out.size() == 1 << 16);
+    REQUIRE(out.data()[100] == 0);  // New files are zero-filled
+    std::memcpy(out.data(), text, sizeof(text));
+    out.sync();
+    out.close(sizeof(text));
+    REQUIRE_FALSE(out.is_open());
+    REQUIRE(std::filesystem::file_size(path) == sizeof(text));
+
+    auto in = mathlib::MappedFile::open(path);
+    REQUIRE(in.size() == sizeof(text));
+    REQUIRE(std::memcmp(in.data(), text, sizeof(text)) == 0);
+
+    // Moving transfers the mapping
+    mathlib::MappedFile moved = std::move(in);
+    REQUIRE(moved.is_open());
+    REQUIRE_FALSE(in.is_open());  // NOLINT(bugprone-use-after-move)
+    moved = mathlib::MappedFile();
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("MappedFile handles empty and missing files", "[mapped_file]") {
+    const std::string path = temp_path("mathlib_test_mapped_file_empty.bin");
+    std::fclose(std::fopen(path.c_str(), "wb"));
+    auto empty = mathlib::MappedFile::open(path);
+    REQUIRE(empty.size() == 0);
+    REQUIRE(empty.data() == nullptr);
+    empty = mathlib::MappedFile();
+    std::filesystem::remove(path);
+
+    REQUIRE_THROWS_AS(mathlib::MappedFile::open(temp_path("mathlib_no_such_file.bin")),
+                      std::system_error);
+    REQUIRE_THROWS_AS(mathlib::MappedFile::create(path, 0), std::invalid_argument);
+}
+
+TEST_CASE("MappedFile::advise keeps the contents", "[mapped_file]") {
+    const std::string path = temp_path("mathlib_test_mapped_file_advise.bin");
+    auto out = mathlib::MappedFile::create(path, 3 << 16);
+    std::memset(out.data(), 7, out.size());
+    out.advise(mathlib::MapAdvice::Sequential);
+    out.advise(mathlib::MapAdvice::DontNeed, 100, 1 << 16);  // Unaligned start
+    out.advise(mathlib::MapAdvice::WillNeed, out.size() + 1, 10);  // Out of range: ignored
+    REQUIRE(out.data()[100] == 7);
+    REQUIRE(out.data()[out.size() - 1] == 7);
+    out.close(out.size());
+
+    auto in = mathlib::MappedFile::open(path);
+    in.advise(mathlib::MapAdvice::DontNeed);
+    REQUIRE(in.data()[1 << 16] == 7);
+    in = mathlib::MappedFile();
+    std::filesystem::remove(path);
+}
@@ -1,6 +1,12 @@
 #include "mathlib.h"
 
 #include <cmath>
+#include <complex>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
 
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
@@ -46,6 +52,228 @@ TEST_CASE("Factorial values are correct", "[factorial][parameterized]") {
     REQUIRE(mathlib::factorial(n) == expected[n]);
 }
 
+// Table-based factorial must reproduce the iterative product exactly
+TEST_CASE("Factorial matches iterative product over the double range", "[factorial][table]") {
+    double expected = 1.0;
+    for (int n = 0; n <= mathlib::FACTORIAL_MAX; ++n) {
+        if (n > 1) {
+            expected *= n;
+        }
+        REQUIRE(mathlib::factorial(n) == expected);
+    }
+}
+
+TEST_CASE("Factorial overflow boundary", "[factorial][table][edge_cases]") {
+    REQUIRE(mathlib::factorial(20) == 2432902008176640000.0);
+    REQUIRE(mathlib::factorial(170) == Approx(7.257415615307994e306));
+    REQUIRE(std::isfinite(mathlib::factorial(170)));
+    REQUIRE(std::isinf(mathlib::factorial(171)));
+    REQUIRE(std::isinf(mathlib::factorial(100000)));
+}
+
+TEST_CASE("Compile-time factorial", "[factorial][constexpr]") {
+    static_assert(mathlib::factorial<0>() == 1.0);
+    static_assert(mathlib::factorial<5>() == 120.0);
+    static_assert(mathlib::factorial<10>() == 3628800.0);
+
+    constexpr double f170 = mathlib::factorial<170>();
+    REQUIRE(f170 == mathlib::factorial(170));
+    REQUIRE(std::isinf(mathlib::factorial<171>()));
+}
+
+TEST_CASE("Log-factorial against known values", "[log_factorial][accuracy]") {
+    REQUIRE(mathlib::log_factorial(0) == 0.0);
+    REQUIRE(mathlib::log_factorial(1) == 0.0);
+    REQUIRE(mathlib::log_factorial(10) == Approx(15.104412573075514).epsilon(1e-15));
+    REQUIRE(mathlib::log_factorial(170) == Approx(706.5730622457874).epsilon(1e-15));
+
+    SECTION("Beyond the double range of factorial()") {
+        REQUIRE(mathlib::log_factorial(171) == Approx(711.71472580229).epsilon(1e-15));
+        REQUIRE(mathlib::log_factorial(1000) == Approx(5912.128178488163).epsilon(1e-15));
+        REQUIRE(mathlib::log_factorial(1000000) == Approx(12815518.384658169).epsilon(1e-15));
+    }
+
+    SECTION("Consistent with log(factorial(n))") {
+        for (int n = 0; n <= mathlib::FACTORIAL_MAX; ++n) {
+            REQUIRE(mathlib::log_factorial(n) ==
+                    Approx(std::log(mathlib::factorial(n))).epsilon(1e-15));
+        }
+    }
+
+    SECTION("Table and series agree across the switch point") {
+        // ln((n+1)!) - ln(n!) = ln(n+1)
+        for (int n = 160; n < 190; ++n) {
+            const double step = mathlib::log_factorial(n + 1) - mathlib::log_factorial(n);
+            REQUIRE(step == Approx(std::log(n + 1.0)).epsilon(1e-12));
+        }
+    }
+
+    REQUIRE_THROWS_AS(mathlib::log_factorial(-1), std::invalid_argument);
+}
+
+TEST_CASE("Log-gamma against known values", "[log_gamma][accuracy]") {
+    REQUIRE(mathlib::log_gamma(1.0) == 0.0);
+    REQUIRE(mathlib::log_gamma(2.0) == 0.0);
+    REQUIRE(mathlib::log_gamma(0.5) == Approx(0.5723649429247001).epsilon(1e-14));
+    REQUIRE(mathlib::log_gamma(2.5) == Approx(0.2846828704729192).epsilon(1e-14));
+    REQUIRE(mathlib::log_gamma(-0.5) == Approx(1.2655121234846454).epsilon(1e-14));
+    REQUIRE(mathlib::log_gamma(1e-3) == Approx(6.907178885383854).epsilon(1e-14));
+    REQUIRE(mathlib::log_gamma(11.0) == Approx(mathlib::log_factorial(10)).epsilon(1e-15));
+
+    SECTION("Matches std::lgamma over a wide range") {
+        for (double x = -20.25; x < 500.0; x += 0.37) {
+            const double expected = std::lgamma(x);
+            // Absolute tolerance near the zeros at x = 1 and x = 2
+            REQUIRE(mathlib::log_gamma(x) ==
+                    Approx(expected).epsilon(1e-13).margin(1e-14));
+        }
+    }
+
+    SECTION("Special values") {
+        REQUIRE(std::isinf(mathlib::log_gamma(0.0)));
+        REQUIRE(std::isinf(mathlib::log_gamma(-3.0)));
+        REQUIRE(std::isinf(mathlib::log_gamma(INFINITY)));
+        REQUIRE(std::isnan(mathlib::log_gamma(NAN)));
+    }
+}
+
+TEST_CASE("Batch log-factorial and log-gamma", "[log_factorial][log_gamma][batch]") {
+    const std::vector<int> n = {0, 5, 170, 171, 5000};
+    std::vector<double> out(n.size());
+    mathlib::log_factorial_n(n.data(), out.data(), n.size());
+    for (size_t i = 0; i < n.size(); ++i) {
+        REQUIRE(out[i] == mathlib::log_factorial(n[i]));
+    }
+
+    const std::vector<double> x = {0.25, 1.0, 7.5, -2.5, 1e4};
+    mathlib::log_gamma_n(x.data(), out.data(), x.size());
+    for (size_t i = 0; i < x.size(); ++i) {
+        REQUIRE(out[i] == mathlib::log_gamma(x[i]));
+    }
+
+    const std::vector<int> bad = {3, -1};
+    REQUIRE_THROWS_AS(mathlib::log_factorial_n(bad.data(), out.data(), bad.size()),
+                      std::invalid_argument);
+}
+
+TEST_CASE("Non-throwing factorials report invalid input", "[factorial][log_factorial][status]") {
+    const auto f = mathlib::try_factorial(10);
+    REQUIRE(f.ok());
+    REQUIRE(f.value() == mathlib::factorial(10));
+    REQUIRE(mathlib::try_factorial(0).value() == 1.0);
+    REQUIRE(std::isinf(mathlib::try_factorial(171).value()));
+
+    const auto bad = mathlib::try_factorial(-1);
+    REQUIRE_FALSE(bad);
+    REQUIRE(bad.status() == mathlib::Status::InvalidArgument);
+    REQUIRE(bad.value_or(-1.0) == -1.0);
+    REQUIRE(std::string(mathlib::status_message(bad.status())) == "Invalid argument");
+
+    REQUIRE(mathlib::try_log_factorial(1000).value() == mathlib::log_factorial(1000));
+    REQUIRE(mathlib::try_log_factorial(-5).status() == mathlib::Status::InvalidArgument);
+
+    STATIC_REQUIRE(std::is_trivially_copyable_v<mathlib::Result<double>>);
+    STATIC_REQUIRE(noexcept(mathlib::try_factorial(3)));
+}
+
+TEST_CASE("Non-throwing batch factorials mask invalid elements", "[factorial][batch][status]") {
+    const std::vector<int> n = {3, -1, 170, 171, -7, 0};
+    std::vector<double> out(n.size());
+    std::vector<std::uint8_t> invalid(n.size(), 2);
+
+    SECTION("factorial") {
+        REQUIRE(mathlib::try_factorial_n(n.data(), out.data(), invalid.data(), n.size()) == 2);
+        for (size_t i = 0; i < n.size(); ++i) {
+            const auto expected = mathlib::try_factorial(n[i]);
+            REQUIRE(invalid[i] == (expected.ok() ? 0 : 1));
+            if (expected.ok()) {
+                REQUIRE(out[i] == expected.value());
+            } else {
+                REQUIRE(std::isnan(out[i]));
+            }
+        }
+    }
+
+    SECTION("log-factorial") {
+        REQUIRE(mathlib::try_log_factorial_n(n.data(), out.data(), invalid.data(), n.size()) ==
+                2);
+        for (size_t i = 0; i < n.size(); ++i) {
+            const auto expected = mathlib::try_log_factorial(n[i]);
+            REQUIRE(invalid[i] == (expected.ok() ? 0 : 1));
+            if (expected.ok()) {
+                REQUIRE(out[i] == expected.value());
+            } else {
+                REQUIRE(std::isnan(out[i]));
+            }
+        }
+    }
+
+    SECTION("Without a mask") {
+        REQUIRE(mathlib::try_factorial_n(n.data(), out.data(), nullptr, n.size()) == 2);
+        REQUIRE(mathlib::try_factorial_n(n.data(), out.data(), nullptr, 1) == 0);
+        REQUIRE(out[0] == 6.0);
+    }
+}
+
+TEST_CASE("Single-precision factorials and log-gamma", "[factorial][log_gamma][float]") {
+    STATIC_REQUIRE(std::is_same_v<decltype(mathlib::factorialf(3)), float>);
+    REQUIRE(mathlib::factorialf(0) == 1.0F);
+    REQUIRE(mathlib::factorialf(10) == 3628800.0F);
+    REQUIRE(mathlib::factorialf(mathlib::FACTORIAL_MAX_FLOAT) ==
+            static_cast<float>(mathlib::factorial(mathlib::FACTORIAL_MAX_FLOAT)));
+    REQUIRE(std::isfinite(mathlib::factorialf(mathlib::FACTORIAL_MAX_FLOAT)));
+    REQUIRE(std::isinf(mathlib::factorialf(mathlib::FACTORIAL_MAX_FLOAT + 1)));
+    REQUIRE_THROWS_AS(mathlib::factorialf(-1), std::invalid_argument);
+
+    REQUIRE(mathlib::log_factorialf(1000) == static_cast<float>(mathlib::log_factorial(1000)));
+    REQUIRE_THROWS_AS(mathlib::log_factorialf(-2), std::invalid_argument);
+
+    REQUIRE(mathlib::log_gammaf(0.5F) == Approx(0.5723649429247001).epsilon(1e-7));
+    REQUIRE(std::isinf(mathlib::log_gammaf(0.0F)));
+    REQUIRE(std::isnan(mathlib::log_gammaf(std::nanf(""))));
+    REQUIRE(std::isinf(mathlib::log_gammaf(3e38F)));  // beyond the float range
+
+    REQUIRE(mathlib::try_factorialf(5).value() == 120.0F);
+    REQUIRE(mathlib::try_factorialf(-5).status() == mathlib::Status::InvalidArgument);
+    REQUIRE(mathlib::try_log_factorialf(-5).status() == mathlib::Status::InvalidArgument);
+    REQUIRE(mathlib::try_log_factorialf(20).value() == mathlib::log_factorialf(20));
+}
+
+TEST_CASE("Single-precision batch operations match the scalar ones", "[batch][float]") {
+    const std::vector<int> n = {0, 1, 12, 34, 35, 200, 100000};
+    std::vector<float> out(n.size());
+
+    mathlib::factorial_n(n.data(), out.data(), n.size());
+    for (size_t i = 0; i < n.size(); ++i) {
+        REQUIRE(out[i] == mathlib::factorialf(n[i]));
+    }
+    mathlib::log_factorial_n(n.data(), out.data(), n.size());
+    for (size_t i = 0; i < n.size(); ++i) {
+        REQUIRE(out[i] == mathlib::log_factorialf(n[i]));
+    }
+
+    const std::vector<float> x = {0.25F, 1.0F, 7.5F, -2.5F, 1e4F};
+    mathlib::log_gamma_n(x.data(), out.data(), x.size());
+    for (size_t i = 0; i < x.size(); ++i) {
+        REQUIRE(out[i] == mathlib::log_gammaf(x[i]));
+    }
+
+    const std::vector<int> bad = {3, -1, 4};
+    REQUIRE_THROWS_AS(mathlib::factorial_n(bad.data(), out.data(), bad.size()),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(mathlib::log_factorial_n(bad.data(), out.data(), bad.size()),
+                      std::invalid_argument);
+
+    std::vector<std::uint8_t> invalid(bad.size());
+    REQUIRE(mathlib::try_factorial_n(bad.data(), out.data(), invalid.data(), bad.size()) == 1);
+    REQUIRE(out[0] == 6.0F);
+    REQUIRE(std::isnan(out[1]));
+    REQUIRE(invalid == std::vector<std::uint8_t>{0, 1, 0});
+    REQUIRE(mathlib::try_log_factorial_n(bad.data(), out.data(), nullptr, bad.size()) == 1);
+    REQUIRE(out[2] == mathlib::log_factorialf(4));
+    REQUIRE(std::isnan(out[1]));
+}
+
 // Test mathematical properties
 TEST_CASE("Square function mathematical properties", "[square][properties]") {
     SECTION("Symmetry: square(-x) == square(x)") {
@@ -93,4 +321,42 @@ TEST_CASE("Square of integers", "[square][integers]") {
     REQUIRE(mathlib::square(2.0) == 4.0);
     REQUIRE(mathlib::square(3.0) == 9.0);
     REQUIRE(mathlib::square(4.0) == 16.0);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Generic square keeps the argument type", "[square][generic]") {
+    STATIC_REQUIRE(std::is_same_v<decltype(mathlib::square(2.0)), double>);
+    STATIC_REQUIRE(std::is_same_v<decltype(mathlib::square(2.0F)), float>);
+    STATIC_REQUIRE(std::is_same_v<decltype(mathlib::square(2.0L)), long double>);
+    STATIC_REQUIRE(std::is_same_v<decltype(mathlib::square<int>(2)), int>);
+    STATIC_REQUIRE(mathlib::square<double>(1.5) == 2.25);
+    STATIC_REQUIRE(mathlib::square<float>(3) == 9.0F);
+    STATIC_REQUIRE(mathlib::square<int>(-12) == 144);
+    STATIC_REQUIRE(mathlib::square<std::int64_t>(3000000000) == 9000000000000000000);
+    STATIC_REQUIRE(mathlib::square<std::uint16_t>(65535) == 1);  // Wraps, no signed overflow
+#ifndef MATHLIB_ENABLE_INSTRUMENTATION
+    STATIC_REQUIRE(mathlib::square(3.0) == 9.0);
+#endif
+
+    REQUIRE(mathlib::square(0.1F) == 0.1F * 0.1F);
+    REQUIRE(mathlib::square(1.5L) == 2.25L);
+
+    const std::complex<double> z(1.0, 2.0);
+    const std::complex<double> z2 = mathlib::square(z);
+    REQUIRE(z2.real() == -3.0);
+    REQUIRE(z2.imag() == 4.0);
+}
+
+TEST_CASE("Square of an integer argument is still a double", "[square][generic]") {
+    // Call sites written before the generic overload keep their meaning
+    STATIC_REQUIRE(std::is_same_v<decltype(mathlib::square(3)), double>);
+    STATIC_REQUIRE(std::is_same_v<decltype(mathlib::square(std::int64_t{3})), double>);
+    REQUIRE(mathlib::square(3) / 2 == 4.5);
+    REQUIRE(mathlib::square(50000) == 2.5e9);
+}
+
+TEST_CASE("Square through a function pointer", "[square]") {
+    // Not constant-folded. The library symbol itself is checked by the
+    // square_symbol_exported test (see tests/CMakeLists.txt)
+    double (*volatile out_of_line)(double) = &mathlib::square;
+    REQUIRE(out_of_line(-3.0) == 9.0);
+}
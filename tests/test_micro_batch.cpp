@@ -0,0 +1,103 @@
+#include "mathlib.h"
+#include "micro_batch.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+namespace {
+
+mathlib::MicroBatchOptions options(std::size_t shards, std::size_t batch_size,
+                                   std::chrono::nanoseconds deadline) {
+    mathlib::MicroBatchOptions result;
+    result.shards = shards;
+    result.batch_size = batch_size;
+    result.deadline = deadline;
+    return result;
+}
+
+}  // namespace
+
+TEST_CASE("Micro-batched scalar calls match the direct ones", "[micro_batch]") {
+    mathlib::MicroBatcher batcher(options(0, 64, std::chrono::nanoseconds(0)));
+    REQUIRE(batcher.shards() >= 1);
+
+    REQUIRE(batcher.square(3.0) == 9.0);
+    REQUIRE(batcher.square(-1.5) == 2.25);
+    REQUIRE(batcher.factorial(0) == 1.0);
+    REQUIRE(batcher.factorial(20) == mathlib::factorial(20));
+    REQUIRE(std::isinf(batcher.factorial(171)));
+    REQUIRE_THROWS_AS(batcher.factorial(-1), std::invalid_argument);
+
+    // The rejected request was never queued
+    REQUIRE(batcher.requests() == 5);
+    REQUIRE(batcher.flushes() == 5);
+}
+
+TEST_CASE("Micro-batches flush when full and at the deadline", "[micro_batch]") {
+    mathlib::MicroBatcher batcher(options(1, 4, std::chrono::nanoseconds(0)));
+    std::vector<mathlib::MicroBatcher::Completion> completions(10);
+    for (std::size_t i = 0; i < completions.size(); ++i) {
+        if (i % 2 == 0) {
+            batcher.submit_square(static_cast<double>(i), completions[i]);
+        } else {
+            batcher.submit_factorial(static_cast<int>(i), completions[i]);
+        }
+    }
+
+    // Two full batches ran on submission; the last two requests wait
+    REQUIRE(batcher.flushes() == 2);
+    for (std::size_t i = 0; i < 8; ++i) {
+        REQUIRE(completions[i].ready());
+    }
+    REQUIRE_FALSE(completions[8].ready());
+    REQUIRE_FALSE(completions[9].ready());
+
+    // Past the deadline, waiting flushes the rest as one batch
+    REQUIRE(completions[9].wait() == mathlib::factorial(9));
+    REQUIRE(completions[8].ready());
+    REQUIRE(batcher.flushes() == 3);
+    REQUIRE(batcher.requests() == 10);
+
+    for (std::size_t i = 0; i < completions.size(); ++i) {
+        const double expected = i % 2 == 0 ? mathlib::square(static_cast<double>(i))
+                                           : mathlib::factorial(static_cast<int>(i));
+        REQUIRE(completions[i].wait() == expected);
+    }
+}
+
+TEST_CASE("Micro-batcher serves many threads", "[micro_batch]") {
+    const auto shards = GENERATE(std::size_t{1}, std::size_t{3});
+    mathlib::MicroBatcher batcher(options(shards, 16, std::chrono::microseconds(50)));
+
+    const unsigned threads = 8;
+    const int calls = 2000;
+    std::atomic<int> wrong{0};
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            for (int i = 0; i < calls; ++i) {
+                const int k = static_cast<int>((t * 31 + static_cast<unsigned>(i)) % 171);
+                if (i % 3 == 0) {
+                    wrong += batcher.factorial(k) != mathlib::factorial(k);
+                } else {
+                    wrong += batcher.square(k * 0.5) != mathlib::square(k * 0.5);
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    REQUIRE(wrong.load() == 0);
+    REQUIRE(batcher.requests() == threads * calls);
+    REQUIRE(batcher.flushes() <= batcher.requests());
+}
@@ -0,0 +1,145 @@
+#include "combinatorics.h"
+#include "modular.h"
+
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+namespace {
+
+constexpr std::uint64_t P = 1000000007;
+
+std::uint64_t mul_mod(std::uint64_t a, std::uint64_t b, std::uint64_t m) {
+    std::uint64_t hi;
+    std::uint64_t lo;
+    mathlib::detail::mul_wide(a % m, b % m, hi, lo);
+    // Long division of hi:lo by m, one bit at a time
+    std::uint64_t r = hi % m;
+    for (int bit = 63; bit >= 0; --bit) {
+        const bool carry = (r >> 63) != 0;
+        r = (r << 1) | ((lo >> bit) & 1);
+        if (carry || r >= m) {
+            r -= m;
+        }
+    }
+    return r;
+}
+
+std::uint64_t naive_factorial_mod(int n, std::uint64_t m) {
+    std::uint64_t result = 1 % m;
+    for (int i = 2; i <= n; ++i) {
+        result = mul_mod(result, static_cast<std::uint64_t>(i), m);
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST_CASE("Montgomery multiplication matches 128-bit arithmetic", "[modular][montgomery]") {
+    const auto m = GENERATE(std::uint64_t{3}, P, std::uint64_t{998244353},
+                            (std::uint64_t{1} << 61) - 1, mathlib::Montgomery::MODULUS_MAX);
+    const mathlib::Montgomery mont(m);
+    REQUIRE(mont.from_montgomery(mont.one()) == 1);
+
+    std::mt19937_64 rng(m);
+    for (int i = 0; i < 1000; ++i) {
+        const std::uint64_t a = rng();
+        const std::uint64_t b = rng() % m;
+        const std::uint64_t am = mont.to_montgomery(a);
+        const std::uint64_t bm = mont.to_montgomery(b);
+        REQUIRE(mont.from_montgomery(am) == a % m);
+        REQUIRE(mont.from_montgomery(mont.mul(am, bm)) == mul_mod(a, b, m));
+        REQUIRE(mont.from_montgomery(mont.add(am, bm)) == (a % m + b) % m);
+    }
+    // Fermat: a^(p-1) = 1 for the primes among the moduli
+    if (m != mathlib::Montgomery::MODULUS_MAX) {
+        REQUIRE(mont.from_montgomery(mont.pow(mont.to_montgomery(2), m - 1)) == 1);
+    }
+}
+
+TEST_CASE("Montgomery rejects unsupported moduli", "[modular][montgomery]") {
+    REQUIRE_THROWS_AS(mathlib::Montgomery(1), std::invalid_argument);
+    REQUIRE_THROWS_AS(mathlib::Montgomery(1000), std::invalid_argument);
+    REQUIRE_THROWS_AS(mathlib::Montgomery(mathlib::Montgomery::MODULUS_MAX + 2),
+                      std::invalid_argument);
+}
+
+TEST_CASE("Modular factorial", "[modular][factorial_mod]") {
+    SECTION("Matches the naive product") {
+        const auto m = GENERATE(std::uint64_t{7}, P, (std::uint64_t{1} << 61) - 1,
+                                std::uint64_t{1} << 40, std::uint64_t{1000000});
+        for (int n : {0, 1, 2, 3, 4, 5, 6, 7, 19, 20, 100, 1001, 2999}) {
+            REQUIRE(mathlib::factorial_mod(n, m) == naive_factorial_mod(n, m));
+        }
+    }
+
+    SECTION("Small and dividing moduli") {
+        REQUIRE(mathlib::factorial_mod(0, 1) == 0);
+        REQUIRE(mathlib::factorial_mod(1, 2) == 1);
+        REQUIRE(mathlib::factorial_mod(5, 2) == 0);
+        REQUIRE(mathlib::factorial_mod(5, 6) == 0);  // 6 | 5!
+        REQUIRE(mathlib::factorial_mod(20, 1ULL << 62) == mathlib::factorial_u64(20));
+    }
+
+    SECTION("Wilson's theorem: (p-1)! = -1 mod p") {
+        const std::uint64_t p = 1000003;
+        REQUIRE(mathlib::factorial_mod(static_cast<int>(p - 1), p) == p - 1);
+        REQUIRE(mathlib::factorial_mod(static_cast<int>(p), p) == 0);
+    }
+
+    SECTION("Invalid arguments") {
+        REQUIRE_THROWS_AS(mathlib::factorial_mod(-1, P), std::invalid_argument);
+        REQUIRE_THROWS_AS(mathlib::factorial_mod(5, 0), std::invalid_argument);
+        REQUIRE_THROWS_AS(mathlib::factorial_mod(5, ~std::uint64_t{0}), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Modular factorial tables", "[modular][binomial]") {
+    const mathlib::ModularFactorials table(3000, P);
+    REQUIRE(table.max_n() == 3000);
+    REQUIRE(table.modulus() == P);
+    REQUIRE(table.memory_bytes() == 2 * 3001 * sizeof(std::uint64_t));
+
+    for (int n : {0, 1, 2, 17, 20, 999, 3000}) {
+        REQUIRE(table.factorial(n) == mathlib::factorial_mod(n, P));
+        REQUIRE(mul_mod(table.factorial(n), table.inverse_factorial(n), P) == 1);
+    }
+
+    // Exact coefficients where they fit, Pascal's rule beyond
+    for (int n = 0; n <= mathlib::BINOMIAL_TABLE_MAX; ++n) {
+        for (int k = 0; k <= n; ++k) {
+            REQUIRE(table.binomial(n, k) == mathlib::binomial(n, k) % P);
+        }
+    }
+    for (int n = 1; n <= 3000; n += 37) {
+        for (int k = 1; k < n; k += 11) {
+            REQUIRE(table.binomial(n, k) ==
+                    (table.binomial(n - 1, k - 1) + table.binomial(n - 1, k)) % P);
+        }
+    }
+    REQUIRE(table.binomial(10, -1) == 0);
+    REQUIRE(table.binomial(10, 11) == 0);
+    REQUIRE_THROWS_AS(table.binomial(3001, 1), std::out_of_range);
+    REQUIRE_THROWS_AS(table.factorial(-1), std::out_of_range);
+
+    const std::vector<int> n = {52, 3000, 7};
+    const std::vector<int> k = {5, 1500, 9};
+    std::vector<std::uint64_t> out(n.size());
+    table.binomial_n(n.data(), k.data(), out.data(), n.size());
+    REQUIRE(out == std::vector<std::uint64_t>{2598960, table.binomial(3000, 1500), 0});
+}
+
+TEST_CASE("Modular factorial tables need a prime above max_n", "[modular][binomial]") {
+    REQUIRE_NOTHROW(mathlib::ModularFactorials(0, 3));
+    REQUIRE_NOTHROW(mathlib::ModularFactorials(100, 101));
+    REQUIRE_THROWS_AS(mathlib::ModularFactorials(101, 101), std::invalid_argument);
+    REQUIRE_THROWS_AS(mathlib::ModularFactorials(-1, P), std::invalid_argument);
+    REQUIRE_THROWS_AS(mathlib::ModularFactorials(10, 561), std::invalid_argument);
+    // Strong pseudoprime to bases 2, 3, 5 and 7
+    REQUIRE_THROWS_AS(mathlib::ModularFactorials(10, 3215031751ULL), std::invalid_argument);
+    REQUIRE_THROWS_AS(mathlib::ModularFactorials(10, 1000000008), std::invalid_argument);
+}
@@ -0,0 +1,77 @@
+// Checks of a library built with -DMATHLIB_NO_EXCEPTIONS=ON. Catch2 and the
+// main suite rely on exceptions, so this is a plain program compiled with
+// -fno-exceptions: it exits with 0 when every check passes.
+
+#include "async.h"
+#include "batch_service.h"
+#include "error.h"
+#include "mathlib.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const char* what) {
+    if (!condition) {
+        std::fprintf(stderr, "FAILED: %s\n", what);
+        ++failures;
+    }
+}
+
+// Reached instead of a throw; ends the program since the handler must not return
+void expected_error(const char* message) {
+    const bool ok = std::strcmp(message, "Factorial of negative number is undefined") == 0;
+    check(ok, "error handler receives the exception message");
+    std::exit(failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+}  // namespace
+
+int main() {
+    check(mathlib::try_factorial(5).value() == 120.0, "try_factorial(5)");
+    check(mathlib::try_factorial(-1).status() == mathlib::Status::InvalidArgument,
+          "try_factorial(-1)");
+    check(mathlib::try_log_factorial(-1).status() == mathlib::Status::InvalidArgument,
+          "try_log_factorial(-1)");
+
+    const std::vector<int> n = {4, -2, 171};
+    std::vector<double> out(n.size());
+    std::vector<std::uint8_t> invalid(n.size());
+    check(mathlib::try_factorial_n(n.data(), out.data(), invalid.data(), n.size()) == 1,
+          "try_factorial_n count");
+    check(out[0] == 24.0 && std::isnan(out[1]) && std::isinf(out[2]), "try_factorial_n values");
+    check(invalid[0] == 0 && invalid[1] == 1 && invalid[2] == 0, "try_factorial_n mask");
+
+    // Invalid requests are answered with an error, not raised
+    mathlib::BatchService service;
+    check(service.process(R"({"op":"factorial","values":[-1,3]})") ==
+              "{\"results\":[null,6]}\n",
+          "BatchService factorial");
+    check(service.process("not json") == "{\"error\":\"request must be a JSON object\"}\n",
+          "BatchService error response");
+
+    // Async jobs complete without exception support in the library
+    {
+        mathlib::AsyncBatcher batcher;
+        const std::vector<double> x = {1.5, -2.0};
+        std::vector<double> squares(x.size());
+        auto job = batcher.square(x.data(), squares.data(), x.size());
+        job.wait();
+        check(job.status() == mathlib::JobStatus::Done && squares[0] == 2.25 && squares[1] == 4.0,
+              "AsyncBatcher square");
+    }
+
+    // The throwing API ends in the error handler
+    mathlib::set_error_handler(&expected_error);
+    volatile int negative = -1;
+    mathlib::factorial(negative);
+    std::fprintf(stderr, "FAILED: factorial(-1) returned\n");
+    return EXIT_FAILURE;
+}
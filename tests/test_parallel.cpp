@@ -0,0 +1,193 @@
+#include "mathlib.h"
+#include "parallel.h"
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+namespace {
+
+// Restores the library-wide thread count when a test changes it
+struct ThreadCountGuard {
+    unsigned saved = mathlib::get_num_threads();
+    ~ThreadCountGuard() { mathlib::set_num_threads(saved); }
+};
+
+}  // namespace
+
+TEST_CASE("ThreadPool parallel_for visits every index once", "[parallel][thread_pool]") {
+    auto threads = GENERATE(1U, 2U, 4U, 7U);
+    mathlib::ThreadPool pool(threads);
+    REQUIRE(pool.num_threads() == (threads > 1 ? threads : 1));
+
+    auto grain = GENERATE(std::size_t{1}, std::size_t{7}, std::size_t{1000}, std::size_t{5000});
+    const std::size_t n = 4321;
+    std::vector<std::atomic<int>> hits(n);
+    std::atomic<std::size_t> longest{0};
+    pool.parallel_for(0, n, grain, [&](std::size_t begin, std::size_t end) {
+        // Catch2 assertions are not thread-safe: record, check afterwards
+        std::size_t len = end - begin;
+        std::size_t seen = longest.load();
+        while (len > seen && !longest.compare_exchange_weak(seen, len)) {
+        }
+        for (std::size_t i = begin; i < end; ++i) {
+            hits[i].fetch_add(1);
+        }
+    });
+
+    REQUIRE(longest.load() <= grain);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        REQUIRE(hits[i].load() == 1);
+    }
+}
+
+TEST_CASE("ThreadPool handles empty ranges and offsets", "[parallel][thread_pool]") {
+    mathlib::ThreadPool pool(3);
+    int calls = 0;
+    pool.parallel_for(5, 5, 1, [&](std::size_t, std::size_t) { ++calls; });
+    REQUIRE(calls == 0);
+
+    std::atomic<std::size_t> sum{0};
+    pool.parallel_for(10, 20, 3, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            sum += i;
+        }
+    });
+    REQUIRE(sum.load() == 145);
+}
+
+TEST_CASE("ThreadPool supports nested parallel loops", "[parallel][thread_pool]") {
+    mathlib::ThreadPool pool(4);
+    std::atomic<int> total{0};
+    pool.parallel_for(0, 8, 1, [&](std::size_t, std::size_t) {
+        pool.parallel_for(0, 100, 10, [&](std::size_t begin, std::size_t end) {
+            total += static_cast<int>(end - begin);
+        });
+    });
+    REQUIRE(total.load() == 800);
+}
+
+TEST_CASE("ThreadPool rethrows exceptions from the loop body", "[parallel][thread_pool][exceptions]") {
+    mathlib::ThreadPool pool(4);
+    std::atomic<int> completed{0};
+    REQUIRE_THROWS_AS(pool.parallel_for(0, 64, 1,
+                                        [&](std::size_t begin, std::size_t) {
+                                            if (begin == 13) {
+                                                throw std::runtime_error("chunk failed");
+                                            }
+                                            ++completed;
+                                        }),
+                      std::runtime_error);
+    // The remaining chunks still ran to completion
+    REQUIRE(completed.load() == 63);
+}
+
+TEST_CASE("ThreadPool submit runs tasks", "[parallel][thread_pool]") {
+    std::atomic<int> count{0};
+    {
+        mathlib::ThreadPool pool(3);
+        for (int i = 0; i < 100; ++i) {
+            pool.submit([&] { ++count; });
+        }
+    }  // Destructor drains the queues
+    REQUIRE(count.load() == 100);
+}
+
+TEST_CASE("Library-wide thread count is configurable", "[parallel]") {
+    ThreadCountGuard guard;
+    mathlib::set_num_threads(3);
+    REQUIRE(mathlib::get_num_threads() == 3);
+    mathlib::set_num_threads(1);
+    REQUIRE(mathlib::get_num_threads() == 1);
+    mathlib::set_num_threads(0);
+    REQUIRE(mathlib::get_num_threads() >= 1);
+}
+
+TEST_CASE("Chunk size follows cache size and thread count", "[parallel]") {
+    const std::size_t big = mathlib::parallel_grain(100000000, 16, 4);
+    REQUIRE(big >= 1);
+    REQUIRE(big * 16 <= 64 * 1024 * 1024);
+
+    // Plenty of chunks per thread for mid-sized arrays
+    const std::size_t n = 1 << 20;
+    REQUIRE(mathlib::parallel_grain(n, 16, 8) <= n / 8);
+    REQUIRE(mathlib::parallel_grain(10, 16, 8) >= 1);
+}
+
+TEST_CASE("Parallel batch operations match the serial ones", "[parallel][batch]") {
+    ThreadCountGuard guard;
+    auto threads = GENERATE(1U, 4U);
+    mathlib::set_num_threads(threads);
+
+    const std::size_t n = 300000;
+    std::vector<double> in(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        in[i] = static_cast<double>(i % 1000) - 500.0;
+    }
+
+    SECTION("square") {
+        std::vector<double> out(n);
+        std::vector<double> expected(n);
+        mathlib::parallel_square_n(in.data(), out.data(), n);
+        mathlib::square_n(in.data(), expected.data(), n);
+        REQUIRE(out == expected);
+
+        std::vector<float> single(in.begin(), in.end());
+        std::vector<float> single_out(n);
+        std::vector<float> single_expected(n);
+        mathlib::parallel_square_n(single.data(), single_out.data(), n);
+        mathlib::square_n(single.data(), single_expected.data(), n);
+        REQUIRE(single_out == single_expected);
+    }
+
+    SECTION("factorial") {
+        std::vector<int> k(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            k[i] = static_cast<int>(i % 200);
+        }
+        std::vector<double> out(n);
+        mathlib::parallel_factorial_n(k.data(), out.data(), n);
+        for (std::size_t i = 0; i < n; i += 997) {
+            REQUIRE(out[i] == mathlib::factorial(k[i]));
+        }
+        std::vector<float> single(n);
+        mathlib::parallel_factorial_n(k.data(), single.data(), n);
+        for (std::size_t i = 0; i < n; i += 997) {
+            REQUIRE(single[i] == mathlib::factorialf(k[i]));
+        }
+
+        k[n / 2] = -1;
+        REQUIRE_THROWS_AS(mathlib::parallel_factorial_n(k.data(), out.data(), n),
+                          std::invalid_argument);
+    }
+
+    SECTION("element-wise expressions") {
+        std::vector<double> p(n, 2.0);
+        std::vector<double> out(n);
+        mathlib::parallel_transform(in.data(), p.data(), out.data(), n, [](double t, double q) {
+            return mathlib::square(t) / mathlib::square(q);
+        });
+        for (std::size_t i = 0; i < n; i += 1013) {
+            REQUIRE(out[i] == in[i] * in[i] / 4.0);
+        }
+
+        std::vector<float> single(n);
+        mathlib::parallel_transform(in.data(), single.data(), n,
+                                    [](double x) { return static_cast<float>(x); });
+        REQUIRE(single[n - 1] == static_cast<float>(in[n - 1]));
+    }
+}
+
+TEST_CASE("Serial factorial_n matches factorial()", "[factorial][batch]") {
+    const std::vector<int> n = {0, 1, 5, 20, 170, 171};
+    std::vector<double> out(n.size());
+    mathlib::factorial_n(n.data(), out.data(), n.size());
+    for (std::size_t i = 0; i < n.size(); ++i) {
+        REQUIRE(out[i] == mathlib::factorial(n[i]));
+    }
+}
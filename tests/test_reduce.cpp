@@ -0,0 +1,229 @@
+#include "parallel.h"
+#include "reduce.h"
+#include "simd.h"
+#include "test_helpers.h"
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+using Catch::Approx;
+
+namespace {
+
+std::vector<double> random_values(std::size_t n, double low, double high) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> dist(low, high);
+    std::vector<double> x(n);
+    for (auto& v : x) {
+        v = dist(rng);
+    }
+    return x;
+}
+
+}  // namespace
+
+TEST_CASE("Reductions match reference loops for every kernel", "[reduce][simd]") {
+    IsaGuard guard;
+    auto isa = GENERATE(mathlib::SimdIsa::Scalar, mathlib::SimdIsa::Neon, mathlib::SimdIsa::Avx2,
+                        mathlib::SimdIsa::Avx512);
+    if (!mathlib::set_simd_isa(isa)) {
+        SKIP("instruction set not supported on this machine");
+    }
+    auto summation = GENERATE(mathlib::Summation::Pairwise, mathlib::Summation::Kahan);
+    const mathlib::ReduceOptions options{summation, false};
+
+    // Sizes around the vector widths and the block size
+    for (std::size_t n : {0, 1, 7, 31, 33, 2047, 2048, 2049, 10000}) {
+        const auto a = random_values(n, -2.0, 3.0);
+        const auto b = random_values(n, 1.0, 2.0);
+        long double s = 0.0L;
+        long double ss = 0.0L;
+        long double dd = 0.0L;
+        for (std::size_t i = 0; i < n; ++i) {
+            s += a[i];
+            ss += static_cast<long double>(a[i]) * a[i];
+            const long double d = static_cast<long double>(a[i]) - b[i];
+            dd += d * d;
+        }
+        REQUIRE(mathlib::sum(a.data(), n, options) ==
+                Approx(static_cast<double>(s)).epsilon(1e-13).margin(1e-12));
+        REQUIRE(mathlib::sum_of_squares(a.data(), n, options) ==
+                Approx(static_cast<double>(ss)).epsilon(1e-14));
+        REQUIRE(mathlib::norm2(a.data(), n, options) ==
+                Approx(std::sqrt(static_cast<double>(ss))).epsilon(1e-14));
+        REQUIRE(mathlib::distance(a.data(), b.data(), n, options) ==
+                Approx(std::sqrt(static_cast<double>(dd))).epsilon(1e-14));
+
+        const auto m = mathlib::moments(a.data(), n, options);
+        REQUIRE(m.count == n);
+        if (n > 0) {
+            const long double mean = s / static_cast<long double>(n);
+            long double m2 = 0.0L;
+            for (double v : a) {
+                m2 += (v - mean) * (v - mean);
+            }
+            REQUIRE(m.mean == Approx(static_cast<double>(mean)).epsilon(1e-13).margin(1e-14));
+            REQUIRE(m.m2 == Approx(static_cast<double>(m2)).epsilon(1e-13));
+        }
+    }
+}
+
+TEST_CASE("Single-precision inputs are accumulated in double", "[reduce][float][simd]") {
+    IsaGuard guard;
+    auto isa = GENERATE(mathlib::SimdIsa::Scalar, mathlib::SimdIsa::Neon, mathlib::SimdIsa::Avx2,
+                        mathlib::SimdIsa::Avx512);
+    if (!mathlib::set_simd_isa(isa)) {
+        SKIP("instruction set not supported on this machine");
+    }
+    auto summation = GENERATE(mathlib::Summation::Pairwise, mathlib::Summation::Kahan);
+    const mathlib::ReduceOptions options{summation, false};
+
+    for (std::size_t n : {0, 1, 7, 31, 33, 2047, 2049, 10000}) {
+        const auto a64 = random_values(n, -2.0, 3.0);
+        const auto b64 = random_values(n, 1.0, 2.0);
+        const std::vector<float> a(a64.begin(), a64.end());
+        const std::vector<float> b(b64.begin(), b64.end());
+        // The same values as doubles: the results must agree to double accuracy
+        const std::vector<double> a_exact(a.begin(), a.end());
+        const std::vector<double> b_exact(b.begin(), b.end());
+
+        REQUIRE(mathlib::sum(a.data(), n, options) ==
+                Approx(mathlib::sum(a_exact.data(), n, options)).epsilon(1e-13).margin(1e-12));
+        REQUIRE(mathlib::sum_of_squares(a.data(), n, options) ==
+                Approx(mathlib::sum_of_squares(a_exact.data(), n, options)).epsilon(1e-14));
+        REQUIRE(mathlib::norm2(a.data(), n, options) ==
+                Approx(mathlib::norm2(a_exact.data(), n, options)).epsilon(1e-14));
+        REQUIRE(mathlib::distance(a.data(), b.data(), n, options) ==
+                Approx(mathlib::distance(a_exact.data(), b_exact.data(), n, options))
+                    .epsilon(1e-14));
+        const auto m = mathlib::moments(a.data(), n, options);
+        const auto m_exact = mathlib::moments(a_exact.data(), n, options);
+        REQUIRE(m.count == n);
+        REQUIRE(m.mean == Approx(m_exact.mean).epsilon(1e-13).margin(1e-14));
+        REQUIRE(m.m2 == Approx(m_exact.m2).epsilon(1e-13));
+    }
+}
+
+TEST_CASE("Mixed precision keeps the accuracy of double sums", "[reduce][float][accuracy]") {
+    // 16M ones: a float accumulator stops growing at 2^24
+    const std::vector<float> ones(std::size_t{1} << 25, 1.0F);
+    float naive = 0.0F;
+    for (float v : ones) {
+        naive += v;
+    }
+    REQUIRE(naive == 16777216.0F);
+    REQUIRE(mathlib::sum(ones.data(), ones.size()) == 33554432.0);
+
+    const std::vector<float> big = {3e37F, 4e37F};
+    REQUIRE(mathlib::norm2(big.data(), 2) == Approx(5e37).epsilon(1e-7));
+    const std::vector<float> tiny = {3e-45F, 4e-45F};
+    REQUIRE(mathlib::norm2(tiny.data(), 2) > 0.0);
+}
+
+TEST_CASE("Kahan summation keeps small terms", "[reduce][accuracy]") {
+    // 1 followed by a million values far below its rounding unit
+    std::vector<double> x(1000001, 1e-17);
+    x[0] = 1.0;
+    const double exact = 1.0 + 1e6 * 1e-17;
+    double naive = 0.0;
+    for (double v : x) {
+        naive += v;
+    }
+    REQUIRE(naive == 1.0);
+    REQUIRE(mathlib::sum(x.data(), x.size(), {mathlib::Summation::Kahan, false}) ==
+            Approx(exact).epsilon(1e-15));
+    REQUIRE(mathlib::sum(x.data(), x.size()) == Approx(exact).epsilon(1e-14));
+}
+
+TEST_CASE("Variance is not cancelled by a large offset", "[reduce][moments]") {
+    const std::vector<double> x = {1e9 + 4, 1e9 + 7, 1e9 + 13, 1e9 + 16};
+    const auto m = mathlib::moments(x.data(), x.size());
+    REQUIRE(m.mean == 1e9 + 10);
+    REQUIRE(m.variance() == 22.5);
+    REQUIRE(m.sample_variance() == 30.0);
+
+    REQUIRE(mathlib::moments(x.data(), 0).variance() == 0.0);
+    REQUIRE(mathlib::moments(x.data(), 1).sample_variance() == 0.0);
+
+    // Merging partial moments equals the moments of the whole
+    mathlib::Moments left = mathlib::moments(x.data(), 1);
+    left.merge(mathlib::moments(x.data() + 1, 3));
+    REQUIRE(left.count == 4);
+    REQUIRE(left.mean == Approx(m.mean));
+    REQUIRE(left.m2 == Approx(m.m2));
+    left.merge(mathlib::Moments{});
+    REQUIRE(left.count == 4);
+}
+
+TEST_CASE("Norm and distance do not overflow or underflow", "[reduce][norm]") {
+    IsaGuard guard;
+    auto isa = GENERATE(mathlib::SimdIsa::Scalar, mathlib::SimdIsa::Neon, mathlib::SimdIsa::Avx2,
+                        mathlib::SimdIsa::Avx512);
+    if (!mathlib::set_simd_isa(isa)) {
+        SKIP("instruction set not supported on this machine");
+    }
+    auto summation = GENERATE(mathlib::Summation::Pairwise, mathlib::Summation::Kahan);
+    const mathlib::ReduceOptions options{summation, false};
+
+    const std::vector<double> big = {3e200, 4e200};
+    REQUIRE(std::isinf(mathlib::sum_of_squares(big.data(), 2, options)));
+    REQUIRE(mathlib::norm2(big.data(), 2, options) == Approx(5e200));
+    const std::vector<double> many_big(100, 1e200);
+    REQUIRE(mathlib::norm2(many_big.data(), 100, options) == Approx(1e201));
+
+    const std::vector<double> tiny = {3e-200, -4e-200};
+    REQUIRE(mathlib::norm2(tiny.data(), 2, options) == Approx(5e-200));
+    const std::vector<double> subnormal = {3e-320, 4e-320};
+    REQUIRE(mathlib::norm2(subnormal.data(), 2, options) == Approx(5e-320).epsilon(1e-3));
+
+    const std::vector<double> a = {2e200, 0.0};
+    const std::vector<double> b = {-1e200, 4e200};
+    REQUIRE(mathlib::distance(a.data(), b.data(), 2, options) == Approx(5e200));
+    REQUIRE(mathlib::distance(tiny.data(), tiny.data(), 2, options) == 0.0);
+    const std::vector<double> zeros_100(100, 0.0);
+    REQUIRE(mathlib::distance(many_big.data(), zeros_100.data(), 100, options) ==
+            Approx(1e201));
+
+    const double inf = std::numeric_limits<double>::infinity();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const std::vector<double> with_inf = {1.0, -inf};
+    const std::vector<double> with_nan = {1.0, nan};
+    const std::vector<double> zeros(5, 0.0);
+    REQUIRE(std::isinf(mathlib::norm2(with_inf.data(), 2, options)));
+    REQUIRE(std::isinf(mathlib::distance(with_inf.data(), zeros.data(), 2, options)));
+    REQUIRE(std::isinf(mathlib::sum(with_inf.data(), 2, options)));
+    REQUIRE(std::isnan(mathlib::norm2(with_nan.data(), 2, options)));
+    REQUIRE(mathlib::norm2(zeros.data(), 5, options) == 0.0);
+}
+
+TEST_CASE("Parallel reductions are bitwise reproducible", "[reduce][parallel]") {
+    const auto x = random_values(1000003, -1.0, 1.0);
+    const auto y = random_values(1000003, 0.0, 1.0);
+    auto summation = GENERATE(mathlib::Summation::Pairwise, mathlib::Summation::Kahan);
+    const mathlib::ReduceOptions serial{summation, false};
+    const mathlib::ReduceOptions parallel{summation, true};
+
+    const double s = mathlib::sum(x.data(), x.size(), serial);
+    const double ss = mathlib::sum_of_squares(x.data(), x.size(), serial);
+    const double d = mathlib::distance(x.data(), y.data(), x.size(), serial);
+    const auto m = mathlib::moments(x.data(), x.size(), serial);
+
+    const unsigned saved = mathlib::get_num_threads();
+    for (unsigned threads : {1U, 2U, 3U, 8U}) {
+        mathlib::set_num_threads(threads);
+        REQUIRE(mathlib::sum(x.data(), x.size(), parallel) == s);
+        REQUIRE(mathlib::sum_of_squares(x.data(), x.size(), parallel) == ss);
+        REQUIRE(mathlib::distance(x.data(), y.data(), x.size(), parallel) == d);
+        const auto pm = mathlib::moments(x.data(), x.size(), parallel);
+        REQUIRE(pm.mean == m.mean);
+        REQUIRE(pm.m2 == m.m2);
+    }
+    mathlib::set_num_threads(saved);
+}
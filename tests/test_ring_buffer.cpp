@@ -0,0 +1,79 @@
+#include "ring_buffer.h"
+
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("RingBuffer capacity is rounded up to a power of two", "[ring_buffer]") {
+    REQUIRE(mathlib::RingBuffer<int>(1).capacity() == 2);
+    REQUIRE(mathlib::RingBuffer<int>(8).capacity() == 8);
+    REQUIRE(mathlib::RingBuffer<int>(1000).capacity() == 1024);
+    REQUIRE_THROWS_AS(mathlib::RingBuffer<int>(0), std::invalid_argument);
+}
+
+TEST_CASE("RingBuffer is FIFO and bounded", "[ring_buffer]") {
+    mathlib::RingBuffer<int> queue(4);
+    int value = -1;
+    REQUIRE_FALSE(queue.try_pop(value));
+
+    // Several laps around the ring
+    for (int lap = 0; lap < 3; ++lap) {
+        for (int i = 0; i < 4; ++i) {
+            REQUIRE(queue.try_push(lap * 10 + i));
+        }
+        REQUIRE(queue.size() == 4);
+        REQUIRE_FALSE(queue.try_push(99));
+
+        for (int i = 0; i < 4; ++i) {
+            REQUIRE(queue.try_pop(value));
+            REQUIRE(value == lap * 10 + i);
+        }
+        REQUIRE_FALSE(queue.try_pop(value));
+        REQUIRE(queue.size() == 0);
+    }
+}
+
+TEST_CASE("RingBuffer delivers every element across threads", "[ring_buffer]") {
+    constexpr int PRODUCERS = 4;
+    constexpr int PER_PRODUCER = 20000;
+    mathlib::RingBuffer<int> queue(64);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&queue, p] {
+            for (int i = 0; i < PER_PRODUCER; ++i) {
+                while (!queue.try_push(p * PER_PRODUCER + i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Each producer's elements must arrive in order, and exactly once
+    std::vector<int> next(PRODUCERS, 0);
+    std::size_t received = 0;
+    bool in_order = true;
+    int value = 0;
+    while (received < std::size_t{PRODUCERS} * PER_PRODUCER) {
+        if (queue.try_pop(value)) {
+            const int producer = value / PER_PRODUCER;
+            in_order = in_order && value % PER_PRODUCER == next[producer];
+            ++next[producer];
+            ++received;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    for (auto& t : producers) {
+        t.join();
+    }
+
+    REQUIRE(in_order);
+    for (int count : next) {
+        REQUIRE(count == PER_PRODUCER);
+    }
+    REQUIRE_FALSE(queue.try_pop(value));
+}
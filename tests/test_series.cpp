@@ -0,0 +1,106 @@
+#include "mathlib.h"
+#include "series.h"
+#include "simd.h"
+#include "test_helpers.h"
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+using Catch::Approx;
+
+TEST_CASE("Reciprocal factorials", "[series][factorial]") {
+    STATIC_REQUIRE(mathlib::inv_factorial(0) == 1.0);
+    STATIC_REQUIRE(mathlib::inv_factorial(3) == 1.0 / 6.0);
+    STATIC_REQUIRE(mathlib::inv_factorial(-1) == 0.0);
+    STATIC_REQUIRE(mathlib::inv_factorial(171) == 0.0);
+
+    for (int n = 0; n <= mathlib::FACTORIAL_MAX; ++n) {
+        REQUIRE(mathlib::inv_factorial(n) == 1.0 / mathlib::factorial(n));
+    }
+    REQUIRE(mathlib::inv_factorial(mathlib::FACTORIAL_MAX) > 0.0);
+}
+
+TEST_CASE("Horner and Estrin evaluate polynomials", "[series][polynomial]") {
+    const std::vector<double> c = {1.0, 2.0, 3.0};
+    REQUIRE(mathlib::horner(c.data(), 3, 2.0) == 17.0);
+    REQUIRE(mathlib::estrin(c.data(), 3, 2.0) == 17.0);
+    REQUIRE(mathlib::horner(c.data(), 0, 2.0) == 0.0);
+    REQUIRE(mathlib::estrin(c.data(), 0, 2.0) == 0.0);
+    REQUIRE(mathlib::estrin(c.data(), 1, 2.0) == 1.0);
+
+    // Lengths around the Estrin block size, where several trees are chained
+    auto count = GENERATE(2, 7, 8, 9, 63, 64, 65, 128, 129, 200);
+    std::vector<double> coefficients(static_cast<std::size_t>(count));
+    for (std::size_t k = 0; k < coefficients.size(); ++k) {
+        coefficients[k] = static_cast<double>(k % 7) - 3.0;
+    }
+    for (double x : {-1.0, -0.5, 0.0, 0.75, 1.0}) {
+        const double h = mathlib::horner(coefficients.data(), coefficients.size(), x);
+        double direct = 0.0;
+        for (std::size_t k = 0; k < coefficients.size(); ++k) {
+            direct += coefficients[k] * std::pow(x, static_cast<double>(k));
+        }
+        REQUIRE(h == Approx(direct).margin(1e-12));
+        REQUIRE(mathlib::estrin(coefficients.data(), coefficients.size(), x) ==
+                Approx(h).margin(1e-12));
+    }
+}
+
+TEST_CASE("Taylor series of exp, sin and cos", "[series][taylor]") {
+    const auto exp_series = mathlib::TaylorSeries::exp(18);
+    const auto sin_series = mathlib::TaylorSeries::sin(11);
+    const auto cos_series = mathlib::TaylorSeries::cos(11);
+    REQUIRE(sin_series.step() == 2);
+    REQUIRE(sin_series.offset() == 1);
+
+    auto scheme = GENERATE(mathlib::SeriesScheme::Horner, mathlib::SeriesScheme::Estrin);
+    for (double x = -1.0; x <= 1.0; x += 0.0625) {
+        REQUIRE(exp_series.evaluate(x, scheme) == Approx(std::exp(x)).epsilon(1e-15));
+        const double t = 1.5 * x;  // Up to about pi / 2
+        REQUIRE(sin_series.evaluate(t, scheme) == Approx(std::sin(t)).margin(1e-15));
+        REQUIRE(cos_series.evaluate(t, scheme) == Approx(std::cos(t)).margin(1e-15));
+    }
+    REQUIRE(exp_series(0.0) == 1.0);
+
+    // exp has all derivatives equal to 1 at 0
+    const std::vector<double> ones(18, 1.0);
+    const auto from_derivatives = mathlib::TaylorSeries::from_derivatives(ones.data(), 18);
+    REQUIRE(from_derivatives.coefficients() == exp_series.coefficients());
+
+    REQUIRE_THROWS_AS(mathlib::TaylorSeries({1.0}, 0), std::invalid_argument);
+}
+
+TEST_CASE("evaluate_n matches evaluate for every kernel", "[series][batch][simd]") {
+    IsaGuard guard;
+    auto isa = GENERATE(mathlib::SimdIsa::Scalar, mathlib::SimdIsa::Neon, mathlib::SimdIsa::Avx2,
+                        mathlib::SimdIsa::Avx512);
+    if (!mathlib::set_simd_isa(isa)) {
+        SKIP("instruction set not supported on this machine");
+    }
+
+    const auto series = GENERATE(mathlib::TaylorSeries::exp(18), mathlib::TaylorSeries::sin(11),
+                                 mathlib::TaylorSeries({2.0}, 3, 2), mathlib::TaylorSeries({}));
+
+    // Sizes around the vector widths and unrolling factors
+    for (std::size_t n : {0, 1, 3, 8, 15, 16, 33, 100}) {
+        std::vector<double> x(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            x[i] = static_cast<double>(i) * 0.02 - 1.0;
+        }
+        std::vector<double> out(n, -1.0);
+        series.evaluate_n(x.data(), out.data(), n);
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(out[i] == Approx(series.evaluate(x[i])).epsilon(1e-15).margin(1e-300));
+        }
+
+        // In place
+        series.evaluate_n(x.data(), x.data(), n);
+        REQUIRE(x == out);
+    }
+}
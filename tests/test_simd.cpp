@@ -0,0 +1,105 @@
+#include "mathlib.h"
+#include "simd.h"
+#include "test_helpers.h"
+
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+namespace {
+
+std::vector<double> make_input(std::size_t n) {
+    std::vector<double> v(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        v[i] = static_cast<double>(i) * 0.5 - 7.25;
+    }
+    return v;
+}
+
+}  // namespace
+
+TEST_CASE("SIMD instruction set detection", "[simd]") {
+    REQUIRE(mathlib::simd_isa_supported(mathlib::SimdIsa::Scalar));
+    REQUIRE(mathlib::simd_isa_supported(mathlib::active_simd_isa()));
+    REQUIRE(std::string(mathlib::simd_isa_name(mathlib::SimdIsa::Avx2)) == "avx2");
+}
+
+TEST_CASE("Unsupported instruction set is rejected", "[simd]") {
+    IsaGuard guard;
+    for (auto isa : {mathlib::SimdIsa::Neon, mathlib::SimdIsa::Avx2, mathlib::SimdIsa::Avx512}) {
+        if (!mathlib::simd_isa_supported(isa)) {
+            const auto before = mathlib::active_simd_isa();
+            REQUIRE_FALSE(mathlib::set_simd_isa(isa));
+            REQUIRE(mathlib::active_simd_isa() == before);
+        }
+    }
+}
+
+TEST_CASE("square_n matches square() for every kernel", "[square][batch][simd]") {
+    IsaGuard guard;
+    auto isa = GENERATE(mathlib::SimdIsa::Scalar, mathlib::SimdIsa::Neon, mathlib::SimdIsa::Avx2,
+                        mathlib::SimdIsa::Avx512);
+    if (!mathlib::set_simd_isa(isa)) {
+        SKIP("instruction set not supported on this machine");
+    }
+
+    // Sizes around the vector widths exercise both main loops and tails
+    auto n = GENERATE(std::size_t{0}, std::size_t{1}, std::size_t{3}, std::size_t{7},
+                      std::size_t{8}, std::size_t{17}, std::size_t{33}, std::size_t{1000});
+
+    SECTION("double, out of place") {
+        const auto in = make_input(n);
+        std::vector<double> out(n, -1.0);
+        mathlib::square_n(in.data(), out.data(), n);
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(out[i] == mathlib::square(in[i]));
+        }
+    }
+
+    SECTION("double, in place") {
+        auto data = make_input(n);
+        const auto expected = data;
+        mathlib::square_n(data.data(), n);
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(data[i] == expected[i] * expected[i]);
+        }
+    }
+
+    SECTION("float, out of place and in place") {
+        std::vector<float> in(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            in[i] = static_cast<float>(i) * 0.25F - 3.0F;
+        }
+        std::vector<float> out(n);
+        mathlib::square_n(in.data(), out.data(), n);
+        mathlib::square_n(in.data(), n);
+        for (std::size_t i = 0; i < n; ++i) {
+            const float x = static_cast<float>(i) * 0.25F - 3.0F;
+            REQUIRE(out[i] == x * x);
+            REQUIRE(in[i] == x * x);
+        }
+    }
+}
+
+TEST_CASE("square_n does not write past the end", "[square][batch]") {
+    std::vector<double> in(13, 2.0);
+    std::vector<double> out(16, -1.0);
+    mathlib::square_n(in.data(), out.data(), in.size());
+    REQUIRE(out[12] == 4.0);
+    REQUIRE(out[13] == -1.0);
+    REQUIRE(out[15] == -1.0);
+}
+
+TEST_CASE("square_n propagates special values", "[square][batch]") {
+    std::vector<double> in = {INFINITY, -INFINITY, NAN, -0.0};
+    std::vector<double> out(in.size());
+    mathlib::square_n(in.data(), out.data(), in.size());
+    REQUIRE(std::isinf(out[0]));
+    REQUIRE(std::isinf(out[1]));
+    REQUIRE(std::isnan(out[2]));
+    REQUIRE(out[3] == 0.0);
+}
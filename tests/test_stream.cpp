@@ -0,0 +1,187 @@
+#include "expr.h"
+#include "mapped_file.h"
+#include "mathlib.h"
+#include "stream.h"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+
+std::string temp_path(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+template <typename T>
+void write_array(const std::string& path, const std::vector<T>& values) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(values.data()),
+               static_cast<std::streamsize>(values.size() * sizeof(T)));
+}
+
+template <typename T>
+std::vector<T> read_array(const std::string& path) {
+    const auto file = mathlib::MappedFile::open(path);
+    std::vector<T> values(file.size() / sizeof(T));
+    if (!values.empty()) {
+        std::memcpy(values.data(), file.data(), file.size());
+    }
+    return values;
+}
+
+}  // namespace
+
+TEST_CASE("stream_square_n squares a file chunk by chunk", "[stream]") {
+    const std::string input = temp_path("mathlib_test_stream_in.f64");
+    const std::string output = temp_path("mathlib_test_stream_out.f64");
+
+    // Several chunks spanning many pages, with a partial last chunk
+    std::vector<double> values(100003);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<double>(i) * 0.5 - 1000.0;
+    }
+    write_array(input, values);
+
+    mathlib::StreamOptions options;
+    options.chunk_elements = 4099;
+    REQUIRE(mathlib::stream_square_n(input, output, options) == values.size());
+
+    const auto squares = read_array<double>(output);
+    REQUIRE(squares.size() == values.size());
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        REQUIRE(squares[i] == values[i] * values[i]);
+    }
+
+    // Without paging hints the result is the same
+    options.prefetch = false;
+    options.drop_behind = false;
+    REQUIRE(mathlib::stream_square_n(input, output, options) == values.size());
+    REQUIRE(read_array<double>(output) == squares);
+
+    std::filesystem::remove(input);
+    std::filesystem::remove(output);
+}
+
+TEST_CASE("stream_factorial_n converts an int file to doubles", "[stream]") {
+    const std::string input = temp_path("mathlib_test_stream_in.i32");
+    const std::string output = temp_path("mathlib_test_stream_factorial.f64");
+    write_array(input, std::vector<std::int32_t>{0, 1, 5, 10, 171});
+
+    mathlib::StreamOptions options;
+    options.chunk_elements = 2;
+    REQUIRE(mathlib::stream_factorial_n(input, output, options) == 5);
+
+    const auto results = read_array<double>(output);
+    REQUIRE(results.size() == 5);
+    REQUIRE(results[2] == 120.0);
+    REQUIRE(results[3] == 3628800.0);
+    REQUIRE(results[4] == mathlib::factorial(171));
+
+    write_array(input, std::vector<std::int32_t>{1, -1});
+    REQUIRE_THROWS_AS(mathlib::stream_factorial_n(input, output), std::invalid_argument);
+
+    std::filesystem::remove(input);
+    std::filesystem::remove(output);
+}
+
+TEST_CASE("stream_transform fuses two input files", "[stream]") {
+    const std::string t_path = temp_path("mathlib_test_stream_t.f64");
+    const std::string p_path = temp_path("mathlib_test_stream_p.f64");
+    const std::string output = temp_path("mathlib_test_stream_ratio.f64");
+
+    std::vector<double> t(5000);
+    std::vector<double> p(5000);
+    for (std::size_t i = 0; i < t.size(); ++i) {
+        t[i] = 250.0 + static_cast<double>(i % 100);
+        p[i] = 1.0 + static_cast<double>(i % 7);
+    }
+    write_array(t_path, t);
+    write_array(p_path, p);
+
+    mathlib::StreamOptions options;
+    options.chunk_elements = 1024;
+    const std::size_t n = mathlib::stream_transform<double, double>(
+        t_path, p_path, output,
+        [](const double* a, const double* b, double* out, std::size_t count) {
+            using namespace mathlib::expr;
+            evaluate(square(view(a, count)) / square(view(b, count)), out);
+        },
+        options);
+    REQUIRE(n == t.size());
+
+    const auto ratio = read_array<double>(output);
+    for (std::size_t i = 0; i < t.size(); ++i) {
+        REQUIRE(ratio[i] == (t[i] * t[i]) / (p[i] * p[i]));
+    }
+
+    // Inputs of different lengths
+    write_array(p_path, std::vector<double>(10, 1.0));
+    auto copy = [](const double* a, const double*, double* out, std::size_t count) {
+        std::memcpy(out, a, count * sizeof(double));
+    };
+    auto mismatched = [&] {
+        return mathlib::stream_transform<double, double>(t_path, p_path, output, copy);
+    };
+    REQUIRE_THROWS_AS(mismatched(), std::invalid_argument);
+
+    std::filesystem::remove(t_path);
+    std::filesystem::remove(p_path);
+    std::filesystem::remove(output);
+}
+
+TEST_CASE("stream functions validate their input", "[stream]") {
+    const std::string input = temp_path("mathlib_test_stream_bad.f64");
+    const std::string output = temp_path("mathlib_test_stream_bad_out.f64");
+
+    // Empty input, empty output
+    write_array(input, std::vector<double>{});
+    REQUIRE(mathlib::stream_square_n(input, output) == 0);
+    REQUIRE(std::filesystem::file_size(output) == 0);
+
+    // Not a whole number of doubles
+    write_array(input, std::vector<char>(12, 0));
+    REQUIRE_THROWS_AS(mathlib::stream_square_n(input, output), std::runtime_error);
+
+    mathlib::StreamOptions options;
+    options.chunk_elements = 0;
+    REQUIRE_THROWS_AS(mathlib::stream_square_n(input, output, options), std::invalid_argument);
+
+    std::filesystem::remove(input);
+    std::filesystem::remove(output);
+}
+
+TEST_CASE("stream functions refuse to overwrite an input", "[stream]") {
+    const std::string input = temp_path("mathlib_test_stream_alias.f64");
+    const std::string other = temp_path("mathlib_test_stream_alias_b.f64");
+    const std::string link = temp_path("mathlib_test_stream_alias_link.f64");
+    const std::vector<double> values = {1.0, 2.0, 3.0};
+    write_array(input, values);
+    write_array(other, values);
+
+    REQUIRE_THROWS_AS(mathlib::stream_square_n(input, input), std::invalid_argument);
+    REQUIRE_THROWS_AS((mathlib::stream_transform<double, double>(
+                          other, input, input,
+                          [](const double*, const double*, double*, std::size_t) {})),
+                      std::invalid_argument);
+
+    // The same file under another name
+    std::filesystem::remove(link);
+    std::error_code error;
+    std::filesystem::create_hard_link(input, link, error);
+    if (!error) {
+        REQUIRE_THROWS_AS(mathlib::stream_square_n(input, link), std::invalid_argument);
+        std::filesystem::remove(link);
+    }
+    REQUIRE(read_array<double>(input) == values);
+
+    std::filesystem::remove(input);
+    std::filesystem::remove(other);
+}
@@ -0,0 +1,63 @@
+#include "mathlib.h"
+#include "simd.h"
+#include "strided.h"
+#include "test_helpers.h"
+
+#include <cstddef>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+TEST_CASE("square_strided matches a naive loop for every kernel", "[square][strided][simd]") {
+    IsaGuard guard;
+    auto isa = GENERATE(mathlib::SimdIsa::Scalar, mathlib::SimdIsa::Neon, mathlib::SimdIsa::Avx2,
+                        mathlib::SimdIsa::Avx512);
+    if (!mathlib::set_simd_isa(isa)) {
+        SKIP("instruction set not supported on this machine");
+    }
+
+    // Sizes around the vector widths and the prefetch distance
+    auto n = GENERATE(std::size_t{0}, std::size_t{1}, std::size_t{5}, std::size_t{8},
+                      std::size_t{33}, std::size_t{41}, std::size_t{1000});
+    auto stride = GENERATE(std::size_t{0}, std::size_t{1}, std::size_t{2}, std::size_t{3},
+                           std::size_t{17}, std::size_t{64});
+
+    // Exactly (n - 1) * stride + 1 elements: no reads past the last one
+    std::vector<double> data(n == 0 ? 0 : (n - 1) * stride + 1);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<double>(i) * 0.25 - 3.0;
+    }
+    std::vector<double> out(n, -1.0);
+    mathlib::square_strided(data.data(), stride, n, out.data());
+    for (std::size_t i = 0; i < n; ++i) {
+        REQUIRE(out[i] == data[i * stride] * data[i * stride]);
+    }
+}
+
+TEST_CASE("AoS and SoA conversions are inverse", "[strided][layout]") {
+    auto fields = GENERATE(std::size_t{1}, std::size_t{3}, std::size_t{8}, std::size_t{300});
+    const std::size_t n = 2500;  // Several tiles with a partial last one
+
+    std::vector<double> aos(n * fields);
+    for (std::size_t i = 0; i < aos.size(); ++i) {
+        aos[i] = static_cast<double>(i);
+    }
+
+    std::vector<std::vector<double>> columns(fields, std::vector<double>(n));
+    std::vector<double*> soa;
+    for (auto& column : columns) {
+        soa.push_back(column.data());
+    }
+    mathlib::aos_to_soa(aos.data(), fields, n, soa.data());
+    for (std::size_t f = 0; f < fields; ++f) {
+        for (std::size_t i = 0; i < n; i += 97) {
+            REQUIRE(columns[f][i] == aos[i * fields + f]);
+        }
+    }
+
+    std::vector<double> back(n * fields);
+    std::vector<const double*> const_soa(soa.begin(), soa.end());
+    mathlib::soa_to_aos(const_soa.data(), fields, n, back.data());
+    REQUIRE(back == aos);
+}
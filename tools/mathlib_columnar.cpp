@@ -0,0 +1,89 @@
+/**
+ * @file mathlib_columnar.cpp
+ * @brief Describes columnar result files or converts them to JSON
+ *
+ * Usage: `mathlib_columnar [--json] <file>`
+ *
+ * Without options, prints the row count and, per column, the name, type,
+ * encoding and stored size. With `--json`, writes the rows as a JSON array
+ * of objects (see write_json()) for inspection and debugging.
+ */
+
+#include "columnar.h"
+
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace {
+
+const char* type_name(mathlib::ColumnType type) {
+    switch (type) {
+        case mathlib::ColumnType::Float64:
+            return "float64";
+        case mathlib::ColumnType::Float32:
+            return "float32";
+        case mathlib::ColumnType::Int32:
+            return "int32";
+        case mathlib::ColumnType::Int64:
+            return "int64";
+        case mathlib::ColumnType::UInt8:
+            return "uint8";
+    }
+    return "unknown";
+}
+
+void describe(const mathlib::ColumnarReader& reader) {
+    std::cout << reader.rows() << " rows, " << reader.columns() << " columns\n";
+    for (std::size_t c = 0; c < reader.columns(); ++c) {
+        const mathlib::ColumnInfo& column = reader.column(c);
+        const std::size_t raw = reader.rows() * mathlib::column_type_size(column.type);
+        std::cout << "  " << std::left << std::setw(40) << column.name << std::setw(8)
+                  << type_name(column.type) << std::setw(8)
+                  << (column.compression == mathlib::Compression::None ? "raw" : "shuffle")
+                  << std::right << std::setw(14) << column.stored_bytes << " bytes";
+        if (raw > 0) {
+            std::cout << std::fixed << std::setprecision(1) << "  ("
+                      << 100.0 * static_cast<double>(column.stored_bytes) /
+                             static_cast<double>(raw)
+                      << "%)";
+        }
+        std::cout << '\n';
+    }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    bool json = false;
+    std::string path;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--json") {
+            json = true;
+        } else if (path.empty() && !arg.empty() && arg[0] != '-') {
+            path = arg;
+        } else {
+            path.clear();
+            break;
+        }
+    }
+    if (path.empty()) {
+        std::cerr << "Usage: mathlib_columnar [--json] <file>\n";
+        return 2;
+    }
+
+    try {
+        mathlib::ColumnarReader reader(path);
+        if (json) {
+            mathlib::write_json(reader, std::cout);
+        } else {
+            describe(reader);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "mathlib_columnar: " << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,110 @@
+/**
+ * @file mathlib_logdecode.cpp
+ * @brief Renders binary logs written by Logger::init_binary() as text or JSON
+ *
+ * Usage: `mathlib_logdecode [--json] <file>`
+ *
+ * Text output uses the same pattern as the console logger. With `--json`
+ * every message becomes one JSON object per line (time, level, thread,
+ * format string, arguments and rendered message).
+ */
+
+#include "binary_log.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <variant>
+
+#include <fmt/chrono.h>
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+namespace {
+
+std::string render(const mathlib::BinaryLogRecord& record) {
+    try {
+        return mathlib::format_record(record);
+    } catch (const std::exception& e) {
+        // Keep the raw data visible rather than losing the message
+        return fmt::format("{} <format error: {}>", record.format, e.what());
+    }
+}
+
+std::string format_time(std::uint64_t time_ns) {
+    const std::chrono::system_clock::time_point time{std::chrono::duration_cast<
+        std::chrono::system_clock::duration>(std::chrono::nanoseconds(time_ns))};
+    const std::tm local = fmt::localtime(std::chrono::system_clock::to_time_t(time));
+    return fmt::format("{:%Y-%m-%d %H:%M:%S}.{:03}", local, time_ns / 1000000 % 1000);
+}
+
+void print_text(const mathlib::BinaryLogRecord& record) {
+    // Same layout as the console pattern: [timestamp] [level] message
+    const auto level = spdlog::level::to_string_view(record.level);
+    std::cout << '[' << format_time(record.time_ns) << "] ["
+              << std::string(level.data(), level.size()) << "] " << render(record) << '\n';
+}
+
+void print_json(const mathlib::BinaryLogRecord& record) {
+    nlohmann::json args = nlohmann::json::array();
+    for (const auto& arg : record.args) {
+        std::visit(
+            [&args](const auto& value) {
+                using T = std::decay_t<decltype(value)>;
+                if constexpr (std::is_same_v<T, std::string_view>) {
+                    args.push_back(std::string(value));
+                } else if constexpr (std::is_same_v<T, char>) {
+                    args.push_back(std::string(1, value));
+                } else {
+                    args.push_back(value);
+                }
+            },
+            arg);
+    }
+    const auto level = spdlog::level::to_string_view(record.level);
+    const nlohmann::json line = {{"time_ns", record.time_ns},
+                                 {"level", std::string(level.data(), level.size())},
+                                 {"thread", record.thread_id},
+                                 {"format", std::string(record.format)},
+                                 {"args", args},
+                                 {"message", render(record)}};
+    std::cout << line.dump() << '\n';
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    bool json = false;
+    const char* path = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else {
+            path = argv[i];
+        }
+    }
+    if (path == nullptr) {
+        std::cerr << "Usage: " << argv[0] << " [--json] <file>\n";
+        return 2;
+    }
+
+    try {
+        mathlib::BinaryLogReader reader(path);
+        mathlib::BinaryLogRecord record;
+        while (reader.next(record)) {
+            if (json) {
+                print_json(record);
+            } else {
+                print_text(record);
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << argv[0] << ": " << e.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
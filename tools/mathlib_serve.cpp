@@ -0,0 +1,138 @@
+/**
+ * @file mathlib_serve.cpp
+ * @brief Answers newline-delimited JSON batch requests (see batch_service.h)
+ *
+ * Usage: `mathlib_serve [--parallel] [--socket <path>]`
+ *
+ * Without `--socket`, requests are read from stdin and answered on stdout
+ * until end of input. With `--socket`, the server listens on a Unix domain
+ * socket and answers each connection on its own thread with its own
+ * BatchService, so an idle or slow client does not hold up the others; a
+ * connection failing with an I/O error is logged and closed. `--parallel`
+ * runs the large kernels on the library thread pool.
+ */
+
+#include "batch_service.h"
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#if !defined(_WIN32)
+#include <csignal>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+int usage() {
+    std::cerr << "Usage: mathlib_serve [--parallel] [--socket <path>]\n";
+    return 2;
+}
+
+#if !defined(_WIN32)
+/// Answers one client until it disconnects, then closes the connection
+void serve_connection(const mathlib::BatchServiceOptions& options, int connection) {
+    mathlib::BatchService service(options);
+    try {
+        service.serve(connection, connection);
+    } catch (const std::system_error& e) {
+        // A broken connection (ETIMEDOUT, ...) ends only that client
+        std::cerr << "mathlib_serve: connection dropped: " << e.what() << '\n';
+    }
+    ::close(connection);
+}
+
+int serve_socket(const mathlib::BatchServiceOptions& options, const std::string& path) {
+    sockaddr_un address{};
+    if (path.size() >= sizeof(address.sun_path)) {
+        std::cerr << "mathlib_serve: socket path too long: " << path << '\n';
+        return 1;
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    const int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        std::cerr << "mathlib_serve: cannot create a socket: " << std::strerror(errno) << '\n';
+        return 1;
+    }
+
+    // Replace the socket file of an earlier run, but never another file
+    struct stat existing {};
+    if (::lstat(path.c_str(), &existing) == 0) {
+        if (!S_ISSOCK(existing.st_mode)) {
+            std::cerr << "mathlib_serve: " << path << " exists and is not a socket\n";
+            ::close(listener);
+            return 1;
+        }
+        ::unlink(path.c_str());
+    }
+    if (::bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listener, SOMAXCONN) != 0) {
+        std::cerr << "mathlib_serve: cannot listen on " << path << ": " << std::strerror(errno)
+                  << '\n';
+        ::close(listener);
+        return 1;
+    }
+    std::cerr << "mathlib_serve: listening on " << path << '\n';
+
+    for (;;) {
+        const int connection = ::accept(listener, nullptr, nullptr);
+        if (connection < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            std::cerr << "mathlib_serve: accept failed: " << std::strerror(errno) << '\n';
+            ::close(listener);
+            return 1;
+        }
+        try {
+            std::thread(serve_connection, options, connection).detach();
+        } catch (const std::system_error& e) {
+            std::cerr << "mathlib_serve: cannot start a thread: " << e.what() << '\n';
+            ::close(connection);
+        }
+    }
+}
+#endif
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    mathlib::BatchServiceOptions options;
+    std::string socket_path;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--parallel") {
+            options.parallel = true;
+        } else if (arg == "--socket" && i + 1 < argc) {
+            socket_path = argv[++i];
+        } else {
+            return usage();
+        }
+    }
+
+#if !defined(_WIN32)
+    // A client disconnecting must end its stream, not the server
+    std::signal(SIGPIPE, SIG_IGN);
+    if (!socket_path.empty()) {
+        return serve_socket(options, socket_path);
+    }
+#else
+    if (!socket_path.empty()) {
+        std::cerr << "mathlib_serve: Unix sockets are not supported on this platform\n";
+        return 1;
+    }
+#endif
+    mathlib::BatchService service(options);
+    service.serve(0, 1);
+    return 0;
+}